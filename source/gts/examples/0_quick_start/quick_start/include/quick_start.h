@@ -157,6 +157,12 @@ void basicMacroSchedulerNodeGraph()
         pMacroScheduler->executeSchedule(pSchedule, microSchedulerCompResource.id());
     }
 
+    pMacroScheduler->freeSchedule(pSchedule);
+
+    // Nodes are allocated from the MacroScheduler, so destroy them first.
+    pMacroScheduler->destroyGraph(pA);
+    delete pMacroScheduler;
+
     printf("SUCCESS!\n\n");
 }
 
@@ -261,6 +267,11 @@ void basicMacroSchedulerNodeGraphWithParallelFor()
         GTS_ASSERT(*iter == 5);
     }
 
+    pMacroScheduler->freeSchedule(pSchedule);
+
+    // Nodes are allocated from the MacroScheduler, so destroy them first.
+    pMacroScheduler->destroyGraph(pA);
+    delete pMacroScheduler;
 
     printf("SUCCESS!\n\n");
 }
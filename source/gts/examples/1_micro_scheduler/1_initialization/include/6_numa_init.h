@@ -138,4 +138,40 @@ void numaInit()
 
 }
 
+void numaAwareInit()
+{
+    printf ("================\n");
+    printf ("numaAwareInit\n");
+    printf ("================\n");
+
+    // This example demonstrates the single WorkerPool alternative to numaInit. The WorkerPool pins its
+    // Workers node by node and gives each node its own Task memory. Workers steal from their own node
+    // first and only go to another node after several failed attempts.
+
+    // Pin the Master thread to the first hardware thread of the first node, since the Worker Pool
+    // does not own it.
+    SystemTopology sysTopo;
+    Thread::getSystemTopology(sysTopo);
+    AffinitySet masterAffinity;
+    masterAffinity.set(sysTopo.pGroupInfoArray[0].pCoreInfoArray[0].pHardwareThreadIds[0]);
+    gts::ThisThread::setAffinity(0, masterAffinity);
+
+    WorkerPoolDesc workerPoolDesc;
+    workerPoolDesc.workerDescs.resize(Thread::getHardwareThreadCount());
+    workerPoolDesc.numaAware = true;
+
+    WorkerPool workerPool;
+    bool result = workerPool.initialize(workerPoolDesc);
+    GTS_ASSERT(result);
+
+    MicroScheduler microScheduler;
+    result = microScheduler.initialize(&workerPool);
+    GTS_ASSERT(result);
+
+    // schedule stuff ...
+
+    microScheduler.shutdown();
+    workerPool.shutdown();
+}
+
 } // namespace gts_examples
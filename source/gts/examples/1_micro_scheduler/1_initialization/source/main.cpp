@@ -37,6 +37,7 @@ int main()
     isolationInit();
     partitionInit();
     numaInit();
+    numaAwareInit();
     heteroInit();
 
     return 0;
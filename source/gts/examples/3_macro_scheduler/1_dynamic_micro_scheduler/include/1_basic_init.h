@@ -136,6 +136,9 @@ void initDynamicMicroScheduler()
     pMacroScheduler->executeSchedule(pSchedule, microSchedulerCompResource[1].id());
 
     pMacroScheduler->freeSchedule(pSchedule);
+
+    // Nodes are allocated from the MacroScheduler, so destroy them first.
+    pMacroScheduler->destroyGraph(pA);
     delete pMacroScheduler;
 
     printf("SUCCESS!\n\n");
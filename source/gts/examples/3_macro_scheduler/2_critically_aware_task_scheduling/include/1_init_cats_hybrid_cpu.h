@@ -209,6 +209,8 @@ void initCatsForHybridCpu()
     pMacroScheduler->executeSchedule(pSchedule, computeResourcesByEfficiency[0]->id());
     pMacroScheduler->freeSchedule(pSchedule);
 
+    // Nodes are allocated from the MacroScheduler, so destroy them first.
+    pMacroScheduler->destroyGraph(nodes.front());
     delete pMacroScheduler;
 
     for (size_t ii = 0; ii < numEfficiencyClasses; ++ii)
@@ -21,33 +21,35 @@
  ******************************************************************************/
 #pragma once
 
-#if GTS_ENABLE_COUNTER == 1
-
-#include <unordered_map>
-#include <iomanip>
-#include <fstream>
-#include <string>
-
-#include "gts/platform/Thread.h"
-#include "gts/synchronization/SpinMutex.h"
-#include "gts/containers/Vector.h"
 #include "gts/platform/Assert.h"
 #include "gts/platform/Atomic.h"
+#include "gts/platform/Memory.h"
 #include "gts/platform/Utils.h"
+#include "gts/containers/Vector.h"
 
-#define GTS_WP_COUNTER_INC(ownedId, counter) gts::analysis::WorkerPoolCounter::inst().countOccurance(ownedId, counter)
-#define GTS_WP_COUNTER_DUMP_TO(ownerId, filename) gts::analysis::WorkerPoolCounter::inst().print(ownerId, filename)
+// Counters are cheap enough to leave on. Define as 0 to compile them out.
+#ifndef GTS_ENABLE_COUNTER
+#define GTS_ENABLE_COUNTER 1
+#endif
 
-#define GTS_MS_COUNTER_INC(ownedId, counter) gts::analysis::MicroSchedulerCounter::inst().countOccurance(ownedId, counter)
-#define GTS_MS_COUNTER_DUMP_TO(ownerId, filename) gts::analysis::MicroSchedulerCounter::inst().print(ownerId, filename)
+#if GTS_ENABLE_COUNTER == 1
 
-#else
+// INC and ADD are for the thread that owns the slot. INC_SHARED is for slots
+// that other threads also write.
+#define GTS_WP_COUNTER_INC(pCounters, counter) (pCounters)->increment(counter)
+#define GTS_WP_COUNTER_INC_SHARED(pCounters, counter) (pCounters)->incrementShared(counter)
+#define GTS_MS_COUNTER_INC(pCounters, counter) (pCounters)->increment(counter)
+#define GTS_MS_COUNTER_ADD(pCounters, counter, value) (pCounters)->add(counter, value)
+#define GTS_MS_COUNTER_INC_SHARED(pCounters, counter) (pCounters)->incrementShared(counter)
 
-#define GTS_WP_COUNTER_INC(ownedId, counter)
-#define GTS_WP_COUNTER_DUMP_TO(ownerId, filename)
+#else
 
-#define GTS_MS_COUNTER_INC(ownedId, counter)
-#define GTS_MS_COUNTER_DUMP_TO(ownerId, filename)
+// Unevaluated, but keeps the arguments referenced.
+#define GTS_WP_COUNTER_INC(pCounters, counter) (void)sizeof((pCounters)->count(counter))
+#define GTS_WP_COUNTER_INC_SHARED(pCounters, counter) (void)sizeof((pCounters)->count(counter))
+#define GTS_MS_COUNTER_INC(pCounters, counter) (void)sizeof((pCounters)->count(counter))
+#define GTS_MS_COUNTER_ADD(pCounters, counter, value) (void)sizeof((pCounters)->count(counter) + (value))
+#define GTS_MS_COUNTER_INC_SHARED(pCounters, counter) (void)sizeof((pCounters)->count(counter))
 
 #endif
 
@@ -61,8 +63,6 @@
  * @{
  */
 
-#if GTS_ENABLE_COUNTER == 1
-
 namespace gts {
 namespace analysis {
 
@@ -70,8 +70,6 @@ namespace analysis {
 ////////////////////////////////////////////////////////////////////////////////
 struct WorkerPoolCounters
 {
-    WorkerPoolCounters();
-
     enum
     {
         NUM_ALLOCATIONS,
@@ -96,15 +94,16 @@ struct WorkerPoolCounters
         COUNT
     };
 
-    const char* m_counterStringByCounter[COUNT];
+    /**
+     * @return The display name of 'counter'.
+     */
+    static const char* name(size_t counter);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 struct MicroSchedulerCounters
 {
-    MicroSchedulerCounters();
-
     enum
     {
         NUM_SPAWNS,
@@ -120,6 +119,15 @@ struct MicroSchedulerCounters
         NUM_DEQUE_STEAL_SUCCESSES,
 
         NUM_FAILED_CAS_IN_DEQUE_STEAL,
+        NUM_DEQUE_STEAL_BATCHED_TASKS,
+
+        NUM_SMT_SIBLING_STEAL_ATTEMPTS,
+        NUM_SMT_SIBLING_STEAL_SUCCESSES,
+        NUM_SAME_NODE_STEAL_ATTEMPTS,
+        NUM_SAME_NODE_STEAL_SUCCESSES,
+        NUM_REMOTE_STEAL_ATTEMPTS,
+        NUM_REMOTE_STEAL_SUCCESSES,
+        NUM_CROSS_NODE_STEALS,
 
         NUM_QUEUE_POP_ATTEMPTS,
         NUM_QUEUE_POP_SUCCESSES,
@@ -143,180 +151,214 @@ struct MicroSchedulerCounters
         COUNT
     };
 
-    const char* m_counterStringByCounter[COUNT];
+    /**
+     * @return The display name of 'counter'.
+     */
+    static const char* name(size_t counter);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 /**
  * @brief
- *  A set of thread local counters.
+ *  One Worker's set of counters, padded to avoid false sharing.
  * @tparam TCounters
  *  The definition of the counters and their string mappings.
  */
 template<typename TCounters>
-class Counter
+class GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) CounterSlot
 {
-    using mutex_type = UnfairSpinMutex<>;
-
-    struct OwnedIdHash
-    { 
-        size_t operator()(OwnedId const& id) const
-        { 
-            return murmur_hash3(id.uid());
-        }
-    }; 
+public:
 
-    struct ThreadInfo
+    GTS_INLINE CounterSlot()
     {
-        using array_type = uint64_t[uint32_t(TCounters::COUNT)];
-        using map_type = std::unordered_map<OwnedId, array_type, OwnedIdHash>;
-        ThreadId tid = 0;
-        map_type countsByOwnedId;
-    };
+        for (size_t ii = 0; ii < TCounters::COUNT; ++ii)
+        {
+            m_counts[ii].store(0, memory_order::relaxed);
+        }
+    }
 
-    struct ThreadInfoPtr
+    /**
+     * Increments 'counter' from the slot's only writer. A plain load and
+     * store keeps the hot paths free of locked instructions.
+     */
+    GTS_INLINE void increment(size_t counter)
     {
-        GTS_INLINE ThreadInfoPtr() = default;
-        GTS_INLINE ~ThreadInfoPtr() { if (ptr) { delete ptr; } }
-        ThreadInfo* ptr = nullptr;
-    };
-
-public:
+        add(counter, 1);
+    }
 
     /**
-     * @return The singleton instance of a Counter.
+     * Adds 'value' to 'counter' from the slot's only writer.
      */
-    static Counter& inst()
+    GTS_INLINE void add(size_t counter, uint64_t value)
     {
-        static Counter instance;
-        return instance;
+        GTS_ASSERT(counter < TCounters::COUNT);
+        m_counts[counter].store(m_counts[counter].load(memory_order::relaxed) + value, memory_order::relaxed);
     }
 
-public:
-
     /**
-     * Increment an occurrence of 'type' for this thread.
+     * Increments 'counter' from any thread.
      */
-    void countOccurance(OwnedId const& id, size_t counter)
+    GTS_INLINE void incrementShared(size_t counter)
     {
-        ThreadInfo* pInfo = getThreadInfo();
-        pInfo->countsByOwnedId[id][counter]++;
+        GTS_ASSERT(counter < TCounters::COUNT);
+        m_counts[counter].fetch_add(1, memory_order::relaxed);
     }
 
     /**
-     * Prints the counters from the specified ownerId to the specified file.
+     * @return The current value of 'counter'. Thread-safe.
      */
-    void print(SubIdType const& ownerId, const char* file)
+    GTS_INLINE uint64_t count(size_t counter) const
     {
-        static const size_t COUNT_WIDTH = 20;
+        GTS_ASSERT(counter < TCounters::COUNT);
+        return m_counts[counter].load(memory_order::relaxed);
+    }
 
-        std::ofstream outFile;
-        outFile.open(file, std::ios_base::out);
-        outFile << std::setfill('_');
+private:
 
-        //
-        // Collect all the counters by owner ID.
+    Atomic<uint64_t> m_counts[TCounters::COUNT];
+};
 
-        std::unordered_map<SubIdType, std::unordered_map<gts::OwnedId, ThreadInfo::array_type, OwnedIdHash>> counterMapsByOwnedId;
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A point in time copy of a Counters object.
+ */
+template<typename TCounters>
+struct CounterSnapshot
+{
+    struct Counts
+    {
+        uint64_t counts[TCounters::COUNT] = {};
+    };
 
-        for (size_t iThread = 0; iThread < m_threadInfo.size(); ++iThread)
-        {
-            ThreadInfo* pInfo = m_threadInfo[iThread];
-            for (auto mapIter = pInfo->countsByOwnedId.begin(); mapIter != pInfo->countsByOwnedId.end(); ++mapIter)
-            {
-                auto& countersArray = counterMapsByOwnedId[mapIter->first.ownerId()][mapIter->first];
+    /**
+     * @brief
+     *  The counts of each Worker indexed by local Worker ID. The last entry
+     *  holds the counts from threads that are not Workers.
+     */
+    Vector<Counts> countsByWorker;
 
-                // Accumulate the counts.
-                for(size_t ii = 0; ii < TCounters::COUNT; ++ii)
-                {
-                    countersArray[ii] += mapIter->second[ii];
-                }
-            }
-        }
+    /**
+     * @brief
+     *  The sum of countsByWorker.
+     */
+    Counts totals;
+};
 
-        //
-        // Print counters by owner Id.
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  Fixed size, always-on counters with a slot per Worker and a shared slot for
+ *  all other threads. Readers take snapshots without stopping the Workers.
+ * @tparam TCounters
+ *  The definition of the counters and their string mappings.
+ */
+template<typename TCounters>
+class Counters
+{
+public:
 
-        uint64_t totals[TCounters::COUNT] = {0};
+    using slot_type = CounterSlot<TCounters>;
+    using snapshot_type = CounterSnapshot<TCounters>;
 
-        for (auto localMapIter = counterMapsByOwnedId.begin(); localMapIter != counterMapsByOwnedId.end(); ++localMapIter)
-        {
-            if (localMapIter->first != UNKNOWN_SUBID && localMapIter->first != ownerId)
-            {
-                continue;
-            }
+    GTS_INLINE Counters() = default;
 
-            outFile << "=============\n";
-            outFile << "OWNER ID: " << localMapIter->first << "\n";
-            outFile << "=============\n";
+    GTS_INLINE ~Counters()
+    {
+        shutdown();
+    }
 
-            for (auto countersIter = localMapIter->second.begin(); countersIter != localMapIter->second.end(); ++countersIter)
-            {
-                outFile << "=============\n";
-                outFile << "Local ID: " << countersIter->first.localId() << "\n";
-                outFile << "=============\n";
-
-                for (size_t iCounter = 0; iCounter < TCounters::COUNT; ++iCounter)
-                {
-                    uint64_t count = countersIter->second[iCounter];
-                    outFile << m_counters.m_counterStringByCounter[iCounter] << std::setw(COUNT_WIDTH) << count << "\n";
-                    totals[iCounter] += count;
-                }
-            }
-        }
+    Counters(Counters const&) = delete;
+    Counters& operator=(Counters const&) = delete;
+
+    /**
+     * Creates the slots for 'workerCount' Workers plus the external slot.
+     */
+    GTS_INLINE void initialize(uint32_t workerCount)
+    {
+        shutdown();
+
+        m_workerCount = workerCount;
+        m_pSlots      = alignedVectorNew<slot_type, GTS_NO_SHARING_CACHE_LINE_SIZE>(workerCount + 1);
+    }
 
-        outFile << "=============\n";
-        outFile << "TOTALS\n";
-        outFile << "=============\n";
-        for (size_t iCounter = 0; iCounter < TCounters::COUNT; ++iCounter)
+    /**
+     * Frees the slots. Must not overlap with increments or snapshots.
+     */
+    GTS_INLINE void shutdown()
+    {
+        if (m_pSlots)
         {
-            uint64_t count = totals[iCounter];
-            outFile << m_counters.m_counterStringByCounter[iCounter] << std::setw(COUNT_WIDTH) << count << "\n";
+            alignedVectorDelete(m_pSlots, m_workerCount + 1);
+            m_pSlots      = nullptr;
+            m_workerCount = 0;
         }
-
-        outFile.close();
     }
 
+    /**
+     * @return The slot owned by Worker 'localId'.
+     */
+    GTS_INLINE slot_type* workerSlot(SubIdType localId)
+    {
+        GTS_ASSERT(localId < m_workerCount);
+        return m_pSlots + localId;
+    }
 
-private:
+    /**
+     * @return The slot shared by threads that are not Workers. Increment it
+     * with incrementShared.
+     */
+    GTS_INLINE slot_type* externalSlot()
+    {
+        GTS_ASSERT(m_pSlots);
+        return m_pSlots + m_workerCount;
+    }
 
     /**
-     * Get this thread TL counter info. Creates and tracks the TL info if not present.
+     * Copies all the counts into 'out'. Lock-free and thread-safe; each count
+     * is read atomically, but the set of counts is not read at one instant.
      */
-    ThreadInfo* getThreadInfo()
+    GTS_INLINE void snapshot(snapshot_type& out) const
     {
-        if (s_tlThreadInfo.ptr == nullptr)
-        {
-            s_tlThreadInfo.ptr = new ThreadInfo;
-        }
-        if(s_tlThreadInfo.ptr->tid == 0)
+        const uint32_t slotCount = m_pSlots ? m_workerCount + 1 : 0;
+        out.countsByWorker.resize(slotCount);
+        out.totals = typename snapshot_type::Counts();
+
+        for (uint32_t iSlot = 0; iSlot < slotCount; ++iSlot)
         {
-            s_tlThreadInfo.ptr->tid = ThisThread::getId();
-            Lock<mutex_type> lock(m_threadInfoMutex);
-            m_threadInfo.push_back(s_tlThreadInfo.ptr);
+            for (size_t iCounter = 0; iCounter < TCounters::COUNT; ++iCounter)
+            {
+                const uint64_t count = m_pSlots[iSlot].count(iCounter);
+                out.countsByWorker[iSlot].counts[iCounter] = count;
+                out.totals.counts[iCounter] += count;
+            }
         }
-        return s_tlThreadInfo.ptr;
     }
 
-    Counter() = default;
+    /**
+     * @return The number of Worker slots.
+     */
+    GTS_INLINE uint32_t workerCount() const
+    {
+        return m_workerCount;
+    }
 
 private:
 
-    static thread_local ThreadInfoPtr s_tlThreadInfo;
-    
-    TCounters m_counters;
-    UnfairSpinMutex<> m_threadInfoMutex;
-    Vector<ThreadInfo*> m_threadInfo;
+    slot_type* m_pSlots = nullptr;
+    uint32_t m_workerCount = 0;
 };
 
-template<typename TCounters>
-thread_local typename Counter<TCounters>::ThreadInfoPtr Counter<TCounters>::s_tlThreadInfo;
-
-using WorkerPoolCounter = Counter<WorkerPoolCounters>;
-using MicroSchedulerCounter = Counter<MicroSchedulerCounters>;
+using WorkerPoolCounterSlot         = CounterSlot<WorkerPoolCounters>;
+using WorkerPoolCounterSnapshot     = CounterSnapshot<WorkerPoolCounters>;
+using MicroSchedulerCounterSlot     = CounterSlot<MicroSchedulerCounters>;
+using MicroSchedulerCounterSnapshot = CounterSnapshot<MicroSchedulerCounters>;
 
 } // namespace analysis
 } // namespace gts
 
-#endif
+/** @} */ // end of Counters
+/** @} */ // end of Analysis
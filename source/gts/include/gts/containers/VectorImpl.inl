@@ -112,8 +112,8 @@ Vector<T, TAllocator>& Vector<T, TAllocator>::operator=(Vector const& other)
         clear();
         allocator_type::deallocate(m_pBegin, m_capacity);
 
-        m_capacity            = other.m_capacity;
-        (allocator_type)*this = other.get_allocator();
+        m_capacity = other.m_capacity;
+        static_cast<allocator_type&>(*this) = other.get_allocator();
 
         _deepCopy(*this, other);
     }
@@ -132,7 +132,7 @@ Vector<T, TAllocator>& Vector<T, TAllocator>::operator=(Vector&& other)
         m_pBegin              = std::move(other.m_pBegin);
         m_size                = std::move(other.m_size);
         m_capacity            = std::move(other.m_capacity);
-        (allocator_type)*this = std::move(other.get_allocator());
+        static_cast<allocator_type&>(*this) = std::move(other.get_allocator());
 
         other.m_pBegin   = nullptr;
         other.m_size     = 0;
@@ -442,7 +442,9 @@ void Vector<T, TAllocator>::_shrink(size_type capacity)
 template<typename T, typename TAllocator>
 void Vector<T, TAllocator>::_deepCopy(Vector& dst, Vector const& src)
 {
-    dst.m_pBegin = allocator_type::template allocate<value_type>(src.size());
+    // Allocate the whole capacity, since it is what gets deallocated.
+    GTS_ASSERT(dst.m_capacity >= src.size());
+    dst.m_pBegin = allocator_type::template allocate<value_type>(dst.m_capacity);
     ::memcpy(dst.m_pBegin, src.m_pBegin, sizeof(value_type) * src.size());
     dst.m_size = src.size();
 }
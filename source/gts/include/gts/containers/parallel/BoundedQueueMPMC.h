@@ -0,0 +1,245 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include <type_traits>
+
+#include "gts/platform/Machine.h"
+#include "gts/platform/Assert.h"
+#include "gts/platform/Utils.h"
+#include "gts/platform/Atomic.h"
+#include "gts/containers/AlignedAllocator.h"
+
+#ifdef GTS_MSVC
+#pragma warning( push )
+#pragma warning( disable : 4324) // alignment padding warning
+#endif
+
+namespace gts {
+
+/** 
+ * @addtogroup Containers
+ * @{
+ */
+
+/** 
+ * @addtogroup ParallelContainers
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A multi-producer, multi-consumer queue based on Dmitry Vyukov's bounded
+ *  MPMC queue. Each slot carries a sequence number that tells producers and
+ *  consumers whose turn it is, so pushes and pops only contend on a CAS of
+ *  the back or front index. Properties:
+    - Lock-free.
+    - Bound. Pushing into a full queue fails.
+    - Contiguous memory.
+ * @tparam T
+ *  The type stored in the container.
+ * @tparam TAllocator
+ *  The allocator used by the storage backing.
+ */
+template<
+    typename T,
+    typename TAllocator = AlignedAllocator<GTS_NO_SHARING_CACHE_LINE_SIZE>>
+class BoundedQueueMPMC : private TAllocator
+{
+public:
+
+    using value_type     = T;
+    using size_type      = size_t;
+    using allocator_type = TAllocator;
+
+public: // STRUCTORS
+
+    /**
+     * Constructs an empty container with no capacity and the given
+     * 'allocator'. Call reserve before pushing.
+     * @remark
+     *  Thread-safe.
+     */
+    explicit BoundedQueueMPMC(allocator_type const& allocator = allocator_type());
+
+    /**
+     * Constructs an empty container that can hold at least 'capacity' elements
+     * with the given 'allocator'.
+     * @remark
+     *  Thread-safe.
+     */
+    explicit BoundedQueueMPMC(size_type capacity, allocator_type const& allocator = allocator_type());
+
+    /**
+     * Destructs the container. The destructors of the elements are called and the
+     * used storage is deallocated.
+     * @remark
+     *  Not thread-safe.
+     */
+    ~BoundedQueueMPMC();
+
+    /**
+     * Copy constructor. Constructs the container with the copy of the contents
+     * of 'other'.
+     * @remark
+     *  Not thread-safe.
+     */
+    BoundedQueueMPMC(BoundedQueueMPMC const& other);
+
+    /**
+     * Move constructor. Constructs the container with the contents of other
+     * using move semantics. After the move, other is empty with no capacity.
+     * @remark
+     *  Not thread-safe.
+     */
+    BoundedQueueMPMC(BoundedQueueMPMC&& other);
+
+    /**
+     * Copy assignment operator. Replaces the contents with a copy of the
+     * contents of 'other'.
+     * @remark
+     *  Not thread-safe.
+     */
+    BoundedQueueMPMC& operator=(BoundedQueueMPMC const& other);
+
+    /**
+     * Move assignment operator. Replaces the contents with those of other using
+     * move semantics. After the move, other is empty with no capacity.
+     * @remark
+     *  Not thread-safe.
+     */
+    BoundedQueueMPMC& operator=(BoundedQueueMPMC&& other);
+
+public: // ACCESSORS
+
+    /**
+     * @return True of the queue is empty, false otherwise.
+     * @remark Thread-safe, but may return a stale result.
+     */
+    bool empty() const;
+
+    /**
+     * @return The number of elements in the queue.
+     * @remark Thread-safe, but may return a stale result.
+     */
+    size_type size() const;
+
+    /**
+     * @return The capacity of the queue.
+     * @remark Not thread-safe.
+     */
+    size_type capacity() const;
+
+    /**
+     * @return This queue's allocator.
+     * @remark Thread-safe.
+     */
+    allocator_type get_allocator() const;
+
+public: // MUTATORS
+
+    /**
+     * Increases the capacity of the queue to at least 'capacity', rounded up to
+     * a power of two no smaller than 2. Does nothing if 'capacity' <= capacity().
+     * @remark Not thread-safe.
+     */
+    void reserve(size_type capacity);
+
+    /**
+     * Removes all elements from the queue. The capacity is unchanged.
+     * @remark Not thread-safe.
+     */
+    void clear();
+
+    /**
+     * Copies 'val' into the queue.
+     * @return True if the push succeeded, false if the queue is full.
+     * @remark Thread-safe.
+     */
+    bool tryPush(const value_type& val);
+
+    /**
+     * Moves 'val' into the queue.
+     * @return True if the push succeeded, false if the queue is full.
+     * @remark Thread-safe.
+     */
+    bool tryPush(value_type&& val);
+
+    /**
+     * Pops an element from the queue and moves it into 'out'.
+     * @return True if the pop succeeded, false if the queue is empty.
+     * @remark Thread-safe.
+     */
+    bool tryPop(value_type& out);
+
+private:
+
+    struct Cell
+    {
+        //! The turn of this Cell. Equals the push index when the Cell is free
+        //! and the push index + 1 when it holds a value.
+        Atomic<size_type> sequence;
+
+        //! Uninitialized storage for the value.
+        typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type storage;
+
+        GTS_INLINE value_type* value() { return reinterpret_cast<value_type*>(&storage); }
+    };
+
+    template<typename... TArgs>
+    bool _insert(TArgs&&... args);
+
+    void _allocate(size_type capacityPow2);
+
+    void _deallocate();
+
+    void _copyFrom(BoundedQueueMPMC const& src);
+
+    void _moveFrom(BoundedQueueMPMC& src);
+
+private:
+
+    //! The next item to pop.
+    GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Atomic<size_type> m_front;
+
+    //! The next item to push.
+    GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Atomic<size_type> m_back;
+
+    //! The storage ring buffer.
+    GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Cell* m_pCells;
+
+    //! The size of m_pCells - 1.
+    size_type m_mask;
+};
+
+#ifdef GTS_MSVC
+#pragma warning( pop )
+#endif
+
+/** @} */ // end of ParallelContainers
+/** @} */ // end of Containers
+
+} // namespace gts
+
+#include "BoundedQueueMPMC.inl"
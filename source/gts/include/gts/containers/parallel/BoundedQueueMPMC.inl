@@ -0,0 +1,364 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+******************************************************************************/
+
+namespace gts {
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>::BoundedQueueMPMC(allocator_type const& allocator)
+    : allocator_type(allocator)
+    , m_front(0)
+    , m_back(0)
+    , m_pCells(nullptr)
+    , m_mask(0)
+{}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>::BoundedQueueMPMC(size_type capacity, allocator_type const& allocator)
+    : allocator_type(allocator)
+    , m_front(0)
+    , m_back(0)
+    , m_pCells(nullptr)
+    , m_mask(0)
+{
+    reserve(capacity);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>::~BoundedQueueMPMC()
+{
+    _deallocate();
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>::BoundedQueueMPMC(BoundedQueueMPMC const& other)
+    : allocator_type(other.get_allocator())
+    , m_front(0)
+    , m_back(0)
+    , m_pCells(nullptr)
+    , m_mask(0)
+{
+    _copyFrom(other);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>::BoundedQueueMPMC(BoundedQueueMPMC&& other)
+    : allocator_type(std::move(other.get_allocator()))
+    , m_front(0)
+    , m_back(0)
+    , m_pCells(nullptr)
+    , m_mask(0)
+{
+    _moveFrom(other);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>& BoundedQueueMPMC<T, TAllocator>::operator=(BoundedQueueMPMC const& other)
+{
+    if (this != &other)
+    {
+        _deallocate();
+        (allocator_type&)*this = other.get_allocator();
+        _copyFrom(other);
+    }
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+BoundedQueueMPMC<T, TAllocator>& BoundedQueueMPMC<T, TAllocator>::operator=(BoundedQueueMPMC&& other)
+{
+    if (this != &other)
+    {
+        _deallocate();
+        (allocator_type&)*this = std::move(other.get_allocator());
+        _moveFrom(other);
+    }
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+bool BoundedQueueMPMC<T, TAllocator>::empty() const
+{
+    return size() == 0;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+typename BoundedQueueMPMC<T, TAllocator>::size_type
+BoundedQueueMPMC<T, TAllocator>::size() const
+{
+    size_type front = m_front.load(memory_order::acquire);
+    size_type back  = m_back.load(memory_order::acquire);
+
+    // A pop may have claimed past a stale back.
+    return back > front ? back - front : 0;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+typename BoundedQueueMPMC<T, TAllocator>::size_type
+BoundedQueueMPMC<T, TAllocator>::capacity() const
+{
+    return m_pCells ? m_mask + 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+typename BoundedQueueMPMC<T, TAllocator>::allocator_type
+BoundedQueueMPMC<T, TAllocator>::get_allocator() const
+{
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+void BoundedQueueMPMC<T, TAllocator>::reserve(size_type capacity)
+{
+    if (capacity <= this->capacity())
+    {
+        return;
+    }
+
+    // Move the elements into a bigger queue. A single cell cannot tell a full
+    // ring from an empty one, since both turns map onto the same sequence.
+    BoundedQueueMPMC other(get_allocator());
+    other._allocate(size_type(nextPow2(uint64_t(gtsMax(capacity, size_type(2))))));
+
+    if (m_pCells)
+    {
+        size_type back = m_back.load(memory_order::relaxed);
+        for (size_type ii = m_front.load(memory_order::relaxed); ii != back; ++ii)
+        {
+            value_type* pValue = m_pCells[ii & m_mask].value();
+            other.tryPush(std::move(*pValue));
+            allocator_type::destroy(pValue);
+        }
+        m_front.store(back, memory_order::relaxed);
+    }
+
+    _deallocate();
+    _moveFrom(other);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+void BoundedQueueMPMC<T, TAllocator>::clear()
+{
+    if (!m_pCells)
+    {
+        return;
+    }
+
+    size_type back = m_back.load(memory_order::relaxed);
+    for (size_type ii = m_front.load(memory_order::relaxed); ii != back; ++ii)
+    {
+        allocator_type::destroy(m_pCells[ii & m_mask].value());
+    }
+
+    // Restart the turns from zero.
+    for (size_type ii = 0; ii <= m_mask; ++ii)
+    {
+        m_pCells[ii].sequence.store(ii, memory_order::relaxed);
+    }
+    m_front.store(0, memory_order::relaxed);
+    m_back.store(0, memory_order::relaxed);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+bool BoundedQueueMPMC<T, TAllocator>::tryPush(const value_type& val)
+{
+    return _insert(val);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+bool BoundedQueueMPMC<T, TAllocator>::tryPush(value_type&& val)
+{
+    return _insert(std::move(val));
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+bool BoundedQueueMPMC<T, TAllocator>::tryPop(value_type& out)
+{
+    if (!m_pCells)
+    {
+        return false;
+    }
+
+    Cell* pCell;
+    size_type front = m_front.load(memory_order::relaxed);
+    for (;;)
+    {
+        pCell = m_pCells + (front & m_mask);
+        size_type seq = pCell->sequence.load(memory_order::acquire);
+        intptr_t diff = intptr_t(seq) - intptr_t(front + 1);
+
+        if (diff == 0)
+        {
+            // The Cell holds the value for this turn, so try to claim it.
+            if (m_front.compare_exchange_weak(front, front + 1, memory_order::relaxed, memory_order::relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The Cell has not been published for this turn, so we're empty.
+            return false;
+        }
+        else
+        {
+            // Another consumer claimed this turn.
+            front = m_front.load(memory_order::relaxed);
+        }
+    }
+
+    out = std::move(*pCell->value());
+    allocator_type::destroy(pCell->value());
+
+    // Free the Cell for the producer one lap ahead.
+    pCell->sequence.store(front + m_mask + 1, memory_order::release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+template<typename... TArgs>
+bool BoundedQueueMPMC<T, TAllocator>::_insert(TArgs&&... args)
+{
+    if (!m_pCells)
+    {
+        return false;
+    }
+
+    Cell* pCell;
+    size_type back = m_back.load(memory_order::relaxed);
+    for (;;)
+    {
+        pCell = m_pCells + (back & m_mask);
+        size_type seq = pCell->sequence.load(memory_order::acquire);
+        intptr_t diff = intptr_t(seq) - intptr_t(back);
+
+        if (diff == 0)
+        {
+            // The Cell is free for this turn, so try to claim it.
+            if (m_back.compare_exchange_weak(back, back + 1, memory_order::relaxed, memory_order::relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The Cell still holds the value from the previous lap, so we're full.
+            return false;
+        }
+        else
+        {
+            // Another producer claimed this turn.
+            back = m_back.load(memory_order::relaxed);
+        }
+    }
+
+    allocator_type::construct(pCell->value(), std::forward<TArgs>(args)...);
+
+    // Publish the value to the consumer.
+    pCell->sequence.store(back + 1, memory_order::release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+void BoundedQueueMPMC<T, TAllocator>::_allocate(size_type capacityPow2)
+{
+    GTS_ASSERT(isPow2(capacityPow2));
+
+    m_pCells = allocator_type::template allocate<Cell>(capacityPow2);
+    m_mask   = capacityPow2 - 1;
+
+    for (size_type ii = 0; ii < capacityPow2; ++ii)
+    {
+        new (&m_pCells[ii].sequence) Atomic<size_type>(ii);
+    }
+
+    m_front.store(0, memory_order::relaxed);
+    m_back.store(0, memory_order::relaxed);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+void BoundedQueueMPMC<T, TAllocator>::_deallocate()
+{
+    if (m_pCells)
+    {
+        clear();
+        allocator_type::deallocate(m_pCells, m_mask + 1);
+    }
+
+    m_pCells = nullptr;
+    m_mask   = 0;
+    m_front.store(0, memory_order::relaxed);
+    m_back.store(0, memory_order::relaxed);
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+void BoundedQueueMPMC<T, TAllocator>::_copyFrom(BoundedQueueMPMC const& src)
+{
+    if (!src.m_pCells)
+    {
+        return;
+    }
+
+    _allocate(src.m_mask + 1);
+
+    size_type back = src.m_back.load(memory_order::relaxed);
+    for (size_type ii = src.m_front.load(memory_order::relaxed); ii != back; ++ii)
+    {
+        tryPush(*src.m_pCells[ii & src.m_mask].value());
+    }
+}
+
+//------------------------------------------------------------------------------
+template<typename T, typename TAllocator>
+void BoundedQueueMPMC<T, TAllocator>::_moveFrom(BoundedQueueMPMC& src)
+{
+    m_front.store(src.m_front.load(memory_order::relaxed), memory_order::relaxed);
+    m_back.store(src.m_back.load(memory_order::relaxed), memory_order::relaxed);
+    m_pCells = src.m_pCells;
+    m_mask   = src.m_mask;
+
+    src.m_front.store(0, memory_order::relaxed);
+    src.m_back.store(0, memory_order::relaxed);
+    src.m_pCells = nullptr;
+    src.m_mask   = 0;
+}
+
+} // namespace gts
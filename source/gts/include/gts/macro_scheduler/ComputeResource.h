@@ -75,6 +75,18 @@ public: // ACCESORS:
      */
     virtual uint32_t processorCount() const = 0;
 
+    /**
+     * @returns The number of threads that can pull Nodes from a Schedule for
+     *  this ComputeResource at once.
+     */
+    virtual uint32_t workerCount() const { return 1; }
+
+    /**
+     * @returns The index in [0, workerCount()) of the calling thread, or
+     *  UINT32_MAX if it is not one of this ComputeResource's threads.
+     */
+    virtual uint32_t thisWorkerIndex() const { return 0; }
+
     /**
      * @returns The maximum Node rank this ComputeResouce can execute.
      */
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+
+#include "gts/platform/Assert.h"
+#include "gts/platform/Memory.h"
+#include "gts/synchronization/SpinMutex.h"
+#include "gts/containers/Vector.h"
+
+namespace gts {
+
+/** 
+ * @addtogroup MacroScheduler
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  Carves a MacroScheduler's graph objects from contiguous blocks so that a
+ *  DAG built in one go is laid out sequentially. Freed chunks are recycled
+ *  by size. Once every chunk is freed, e.g. when a graph is torn down, the
+ *  arena rewinds to its first block without returning memory to the OS.
+ *  Blocks are released when the arena is destroyed.
+ */
+class GraphArena
+{
+public: // STRUCTORS:
+
+    enum { DEFAULT_BLOCK_SIZE = 64 * 1024 };
+
+    /**
+     * @param granularity
+     *  The alignment of each allocation. Sizes are rounded up to it. Must be a
+     *  power of 2 of at least the size of a pointer.
+     * @param blockSize
+     *  The size of each block. Allocations larger than a quarter of a block
+     *  bypass the arena.
+     */
+    explicit GraphArena(size_t granularity, size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    ~GraphArena();
+
+    GraphArena(GraphArena const&) = delete;
+    GraphArena& operator=(GraphArena const&) = delete;
+
+public: // ACCESSORS:
+
+    /**
+     * @returns The number of chunks carved from the blocks that are not
+     *  freed yet.
+     */
+    size_t liveCount() const;
+
+    /**
+     * @returns The number of blocks owned by the arena.
+     */
+    size_t blockCount() const;
+
+    /**
+     * @returns The alignment of each allocation.
+     */
+    GTS_INLINE size_t granularity() const { return m_granularity; }
+
+public: // MUTATORS:
+
+    /**
+     * Allocates 'size' bytes.
+     * @remark Thread-safe.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Frees 'ptr', which was allocated with 'size' bytes.
+     * @remark Thread-safe.
+     */
+    void deallocate(void* ptr, size_t size);
+
+private:
+
+    struct FreeChunk
+    {
+        FreeChunk* pNext;
+    };
+
+    void* _carve(size_t size);
+
+    void _rewind();
+
+    //! The blocks in allocation order.
+    Vector<uint8_t*> m_blocks;
+
+    //! The freed chunks of each size, indexed by size / m_granularity.
+    Vector<FreeChunk*> m_freeListsBySize;
+
+    //! The next free byte in the current block.
+    uint8_t* m_pCursor;
+
+    //! One past the end of the current block.
+    uint8_t* m_pBlockEnd;
+
+    //! The index of the current block in m_blocks.
+    size_t m_blockIdx;
+
+    //! The number of chunks carved from the blocks that are not freed yet.
+    size_t m_liveCount;
+
+    size_t m_granularity;
+    size_t m_blockSize;
+    size_t m_maxChunkSize;
+
+    mutable UnfairSpinMutex<> m_mutex;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A container allocator that carves storage from a GraphArena. A default
+ *  constructed allocator uses the heap.
+ */
+class GraphArenaAllocator
+{
+public: // STRUCTORS:
+
+    GraphArenaAllocator() = default;
+
+    GTS_INLINE explicit GraphArenaAllocator(GraphArena* pArena)
+        : m_pArena(pArena) {}
+
+    //--------------------------------------------------------------------------
+    template<typename T>
+    size_t max_size() const
+    {
+        return SIZE_MAX / sizeof(T);
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename T, typename... TArgs>
+    void construct(T* ptr, TArgs&&... args)
+    {
+        void* const pv = static_cast<void*>(ptr);
+        new (pv) T(std::forward<TArgs>(args)...);
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename T>
+    void destroy(T* const ptr)
+    {
+        ptr->~T();
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename T>
+    T* allocate(const size_t n) const
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+
+        if (n > max_size<T>())
+        {
+            GTS_ASSERT(0 && "Integer overflow.");
+            return nullptr;
+        }
+
+        void* const pv = m_pArena
+            ? m_pArena->allocate(n * sizeof(T))
+            : GTS_ALIGNED_MALLOC(n * sizeof(T), GTS_NO_SHARING_CACHE_LINE_SIZE);
+
+        if (pv == nullptr)
+        {
+            GTS_ASSERT(0 && "Failed Allocation.");
+            return nullptr;
+        }
+
+        return static_cast<T*>(pv);
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename T>
+    void deallocate(T* const ptr, size_t n) const
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (m_pArena)
+        {
+            m_pArena->deallocate(ptr, n * sizeof(T));
+        }
+        else
+        {
+            GTS_ALIGNED_FREE(ptr);
+        }
+    }
+
+private:
+
+    GraphArena* m_pArena = nullptr;
+};
+
+/** @} */ // end of MacroScheduler
+
+} // namespace gts
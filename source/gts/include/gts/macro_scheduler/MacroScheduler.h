@@ -22,7 +22,11 @@
 #pragma once
 
 #include <cstdint>
+#include "gts/platform/Atomic.h"
+#include "gts/platform/Utils.h"
+#include "gts/synchronization/SpinMutex.h"
 #include "gts/containers/Vector.h"
+#include "gts/macro_scheduler/GraphArena.h"
 #include "gts/macro_scheduler/MacroSchedulerTypes.h"
 
 namespace gts {
@@ -71,6 +75,23 @@ public: // ACCESSORS:
      */
     ComputeResource* findComputeResource(ComputeResourceId id);
 
+    /**
+     * @return The CpuMicroScheduler ComputeResource that drives the
+     *  MicroScheduler 'microSchedulerId' or nullptr if DNE.
+     */
+    ComputeResource* findMicroSchedulerComputeResource(SubIdType microSchedulerId);
+
+    /**
+     * @return The index of ComputeResource 'id' in computeResources() or
+     *  UINT32_MAX if DNE.
+     */
+    GTS_INLINE uint32_t computeResourceIndex(ComputeResourceId id) const
+    {
+        // Ids below the minimum wrap to large offsets.
+        uint32_t offset = id - m_minComputeResourceId;
+        return offset < m_computeResourceIdxById.size() ? m_computeResourceIdxById[offset] : UINT32_MAX;
+    }
+
     /**
      * @return Get a list of all the ComputeResource.
      */
@@ -84,8 +105,11 @@ public: // MUTATORS:
     Vector<ComputeResource*>& computeResources();
 
     /**
-     * Allocate a Node that can be inserted into a DAG.
+     * Allocate a Node that can be inserted into a DAG. Nodes, their Workloads
+     * and their edges are carved from this MacroScheduler's arenas, so Nodes
+     * allocated together are adjacent in memory.
      * @remark Adding a Node to multiple DAGs is undefined.
+     * @remark All Nodes must be destroyed before their MacroScheduler.
      */
     Node* allocateNode();
 
@@ -95,9 +119,20 @@ public: // MUTATORS:
     void destroyNode(Node* pNode);
 
     /**
-     * Free an existing Schedule from memory.
+     * Destroys every Node reachable from 'pSource', including sub-graphs.
+     * Once no Node is left, the arenas rewind so that the next graph is laid
+     * out sequentially again.
+     * @remark Not thread-safe.
      */
-    virtual void freeSchedule(Schedule* pSchedule) = 0;
+    void destroyGraph(Node* pSource);
+
+    /**
+     * Returns an existing Schedule to this MacroScheduler's pool. Does not
+     * block: a Schedule still referenced by running Tasks is recycled by a
+     * later buildSchedule once its reference count drops to zero. Pooled
+     * Schedules are destroyed with the MacroScheduler.
+     */
+    virtual void freeSchedule(Schedule* pSchedule);
 
     /**
      * Builds a schedule from the specified DAG that begins at 'pStart' and ends
@@ -119,11 +154,62 @@ protected:
     friend class Node;
 
     void* _allocateWorkload(size_t size);
-    void _freeWorkload(void* ptr);
+    void _freeWorkload(void* ptr, size_t size);
+
+    GTS_INLINE GraphArenaAllocator _edgeAllocator()
+    {
+        return GraphArenaAllocator(&m_edgeArena);
+    }
+
+    /**
+     * Builds the id lookup tables for m_computeResources. Must be called after
+     * m_computeResources changes.
+     */
+    void _buildComputeResourceLookups();
+
+    /**
+     * @returns A freed Schedule that no Task references anymore, or nullptr if
+     *  there is none. The Schedule is still registered with every
+     *  ComputeResource.
+     */
+    Schedule* _acquirePooledSchedule();
+
+    /**
+     * Registers a newly allocated 'pSchedule' with every ComputeResource.
+     */
+    void _registerSchedule(Schedule* pSchedule);
 
 protected:
 
     Vector<ComputeResource*> m_computeResources;
+
+    //! Indices into m_computeResources offset by m_minComputeResourceId.
+    Vector<uint32_t> m_computeResourceIdxById;
+
+    //! CpuMicroScheduler ComputeResources offset by m_minMicroSchedulerId.
+    Vector<ComputeResource*> m_computeResourcesByMicroSchedulerId;
+
+    ComputeResourceId m_minComputeResourceId;
+    SubIdType m_minMicroSchedulerId;
+
+private:
+
+    void _destroySchedule(Schedule* pSchedule);
+
+    //! Freed Schedules that are ready to be rebuilt.
+    Vector<Schedule*> m_freeSchedules;
+
+    //! Freed Schedules that may still be referenced by running Tasks.
+    Vector<Schedule*> m_retiredSchedules;
+
+    UnfairSpinMutex<> m_schedulePoolMutex;
+
+    //! Nodes and their Workloads. Carved on no-sharing boundaries so that
+    //! neighbouring Nodes do not falsely share their counters.
+    GraphArena m_graphArena;
+
+    //! The edge arrays of the Nodes.
+    GraphArena m_edgeArena;
 };
 
 /** @} */ // end of MacroScheduler
@@ -26,6 +26,13 @@
 
 #define GTS_GUIDED_WORK_STEALING 0
 
+#ifndef GTS_MACRO_SCHEDULER_BOUNDED_READY_QUEUES
+//! Use lock-free ready queues sized to each Schedule's Node count instead of
+//! the unbounded, spin-locked QueueMPMC. Nodes appended while a Schedule
+//! executes spill into a QueueMPMC.
+#define GTS_MACRO_SCHEDULER_BOUNDED_READY_QUEUES 1
+#endif
+
 namespace gts {
 
 class ComputeResource;
@@ -52,6 +52,13 @@ public: // STRUCTORS:
 
     enum { NODE_NAME_MAX = 64 };
 
+    //! The edge capacity reserved when a Node is created, so that most Nodes
+    //! never grow their edge arrays.
+    enum { RESERVED_EDGE_COUNT = 4 };
+
+    //! An array of edges carved from the MacroScheduler's edge arena.
+    using EdgeVector = Vector<Node*, GraphArenaAllocator>;
+
     Node(MacroScheduler* pMyScheduler);
     ~Node();
 
@@ -77,7 +84,7 @@ public: // ACCESSORS:
     /**
      * @return The predecessor nodes of this Node.
      */ 
-    GTS_INLINE Vector<Node*> const& predecessors() const
+    GTS_INLINE EdgeVector const& predecessors() const
     {
         return m_predecessors;
     }
@@ -85,11 +92,61 @@ public: // ACCESSORS:
     /**
      * @return The successor nodes of this Node.
      */ 
-    GTS_INLINE Vector<Node*> const& successors() const
+    GTS_INLINE EdgeVector const& successors() const
     {
         return m_successors;
     }
 
+    /**
+     * @return The first Node of this Node's sub-graph or nullptr if it has
+     *  none.
+     */
+    GTS_INLINE Node* subGraphSource() const
+    {
+        return m_subGraphSource.empty() ? nullptr : m_subGraphSource[0];
+    }
+
+    /**
+     * @return The last Node of this Node's sub-graph or nullptr if it has
+     *  none.
+     */
+    GTS_INLINE Node* subGraphSink() const { return m_pSubGraphSink; }
+
+    /**
+     * @return The Node whose sub-graph ends at this Node or nullptr if this
+     *  Node is not a sub-graph sink.
+     */
+    GTS_INLINE Node* subGraphOwner() const { return m_pSubGraphOwner; }
+
+    /**
+     * @return The Nodes released when this Node completes, with sub-graphs
+     *  flattened into the enclosing DAG: this Node's sub-graph source if it
+     *  has a sub-graph, otherwise the successors of flatExit().
+     */
+    GTS_INLINE EdgeVector const& flatSuccessors() const
+    {
+        if (!m_subGraphSource.empty())
+        {
+            return m_subGraphSource;
+        }
+        return flatExit()->m_successors;
+    }
+
+    /**
+     * @return The Node whose successors this Node releases. That is this
+     *  Node, unless it is a sub-graph sink without successors, in which case
+     *  its owner completes with it.
+     */
+    GTS_INLINE Node const* flatExit() const
+    {
+        Node const* pExit = this;
+        while (pExit->m_successors.empty() && pExit->m_pSubGraphOwner)
+        {
+            pExit = pExit->m_pSubGraphOwner;
+        }
+        return pExit;
+    }
+
     /**
      * @return True if pChild is a child of this Node.
      */
@@ -141,14 +198,17 @@ public: // MUTATORS:
     /**
      * @brief
      *  Resets all Nodes in the graph.
+     * @param pOutExitCount
+     *  If not null, receives the number of Nodes without flattened successors.
+     * @return The number of Nodes in the graph.
      * @remark Not thread-safe.
      */ 
-    static void resetGraph(Node* pSource);
+    static size_t resetGraph(Node* pSource, uint32_t* pOutExitCount = nullptr);
 
     /**
      * @return The predecessor nodes of this Node.
      */ 
-    GTS_INLINE Vector<Node*>& predecessors()
+    GTS_INLINE EdgeVector& predecessors()
     {
         return m_predecessors;
     }
@@ -156,7 +216,7 @@ public: // MUTATORS:
     /**
      * @return The successor nodes of this Node.
      */ 
-    GTS_INLINE Vector<Node*>& successors()
+    GTS_INLINE EdgeVector& successors()
     {
         return m_successors;
     }
@@ -173,6 +233,8 @@ public: // MUTATORS:
     template<typename TWorkload, typename... TArgs>
     GTS_INLINE TWorkload* addWorkload(TArgs&&... args)
     {
+        static_assert(alignof(TWorkload) <= GTS_NO_SHARING_CACHE_LINE_SIZE, "TWorkload is over-aligned.");
+
         TWorkload* pWorkload = new (m_pMyScheduler->_allocateWorkload(sizeof(TWorkload))) TWorkload(std::forward<TArgs>(args)...);
         if (!pWorkload)
         {
@@ -182,6 +244,8 @@ public: // MUTATORS:
         GTS_ASSERT(m_workloadsByType[pWorkload->type()] == nullptr);
         m_workloadsByType[pWorkload->type()] = pWorkload;
         pWorkload->m_pMyNode = this;
+        pWorkload->m_allocSize = (uint32_t)sizeof(TWorkload);
+        _onTopologyChanged();
         return pWorkload;
     }
 
@@ -197,6 +261,8 @@ public: // MUTATORS:
     template<typename TLambdaWorkload, typename TFunc, typename... TArgs>
     GTS_INLINE TLambdaWorkload* addWorkload(TFunc&& func, TArgs&&... args)
     {
+        static_assert(alignof(TLambdaWorkload) <= GTS_NO_SHARING_CACHE_LINE_SIZE, "TLambdaWorkload is over-aligned.");
+
         // Size of TLambdaWorkload plus space for the lambda.
         constexpr size_t size = sizeof(TLambdaWorkload) + sizeof(std::tuple<TFunc, TArgs...>);
 
@@ -211,6 +277,8 @@ public: // MUTATORS:
         GTS_ASSERT(m_workloadsByType[pWorkload->type()] == nullptr);
         m_workloadsByType[pWorkload->type()] = pWorkload;
         pWorkload->m_pMyNode = this;
+        pWorkload->m_allocSize = (uint32_t)size;
+        _onTopologyChanged();
         return pWorkload;
     }
 
@@ -244,11 +312,39 @@ public: // MUTATORS:
      */
     void removeSuccessor(Node* pNode);
 
+    /**
+     * @brief
+     *  Nests the DAG from 'pSource' to 'pSink' inside this Node. The sub-graph
+     *  runs after this Node's Workloads, and this Node's successors wait for
+     *  'pSink'. The sub-graph's Nodes are scheduled and ranked by the
+     *  enclosing Schedule like any other Node, so they share its ready queues
+     *  instead of blocking a Worker.
+     * @remark 'pSource' must not have predecessors and 'pSink' must not have
+     *  successors. A sub-graph can only be nested in one Node.
+     * @remark Not thread-safe.
+     */
+    void setSubGraph(Node* pSource, Node* pSink);
+
+    /**
+     * @brief
+     *  Removes this Node's sub-graph, if any.
+     * @remark Not thread-safe.
+     */
+    void clearSubGraph();
+
     /**
      * @brief Set the name of this Node.
      */
     void setName(const char* format, ...);
 
+    /**
+     * @return The Node whose successors this Node releases.
+     */
+    GTS_INLINE Node* flatExit()
+    {
+        return const_cast<Node*>(static_cast<Node const*>(this)->flatExit());
+    }
+
     /**
      * @return The up-rank of this Node.
      */
@@ -334,9 +430,45 @@ public: // INTERNAL USE
      */
     GTS_INLINE void _setExecutionCost(uint64_t exeCost) { m_executionCost = exeCost; }
 
+    /**
+     * @return The index of this Node in its compiled Schedule.
+     * @remark Internal use only.
+     */
+    GTS_INLINE uint32_t _scheduleIndex() const { return m_scheduleIndex; }
+
+    /**
+     * @brief
+     *  Sets the index of this Node in its compiled Schedule.
+     * @remark Internal use only.
+     * @remark Not thread-safe.
+     */
+    GTS_INLINE void _setScheduleIndex(uint32_t index) { m_scheduleIndex = index; }
+
+    /**
+     * @brief
+     *  Gathers the Nodes reachable from 'pSource', including sub-graphs, into
+     *  'out' in breadth-first order.
+     * @remark Internal use only.
+     * @remark Not thread-safe.
+     */
+    static void _collectGraph(Node* pSource, Vector<Node*>& out);
+
 private:
 
     friend class CriticiallyAware_Schedule;
+    friend class Schedule;
+
+    void _destroyWorkload(WorkloadType::Enum type);
+
+    // Adds the edge to 'pNode' without reporting a topology change.
+    void _linkSuccessor(Node* pNode);
+
+    // Removes the edge to 'pNode' without reporting a topology change.
+    // Returns false if there is no such edge.
+    bool _unlinkSuccessor(Node* pNode);
+
+    // Tells this Node's Schedule that the DAG changed.
+    void _onTopologyChanged();
 
     //! The Schedule this node belongs to.
     MacroScheduler* m_pMyScheduler;
@@ -348,10 +480,20 @@ private:
     Workload* m_workloadsByType[WorkloadType::COUNT];
 
     //! The predecessors nodes of this Node.
-    Vector<Node*> m_predecessors;
+    EdgeVector m_predecessors;
 
     //! The successor nodes of this Node.
-    Vector<Node*> m_successors;
+    EdgeVector m_successors;
+
+    //! The first Node of this Node's sub-graph. Kept in an EdgeVector so that
+    //! flatSuccessors() can return it.
+    EdgeVector m_subGraphSource;
+
+    //! The last Node of this Node's sub-graph.
+    Node* m_pSubGraphSink;
+
+    //! The Node whose sub-graph ends at this Node.
+    Node* m_pSubGraphOwner;
 
     //! The up-rank of this Node.
     Atomic<uint64_t> m_upRank;
@@ -374,6 +516,12 @@ private:
     //! The ID of the ComputeResource that must execute this Node.
     ComputeResourceId m_affinity;
 
+    //! The index of this Node in its compiled Schedule.
+    uint32_t m_scheduleIndex;
+
+    //! Marks this Node as visited during a graph traversal.
+    bool m_isVisited;
+
     char m_name[NODE_NAME_MAX];
 
     //! Flag true if the Node must be executed in isolation.
@@ -23,6 +23,9 @@
 
 #include "gts/platform/Machine.h"
 #include "gts/synchronization/SpinMutex.h"
+#include "gts/containers/Vector.h"
+#include "gts/containers/parallel/QueueMPMC.h"
+#include "gts/containers/parallel/BoundedQueueMPMC.h"
 #include "gts/macro_scheduler/MacroSchedulerTypes.h"
 
 namespace gts {
@@ -35,6 +38,101 @@ class MacroScheduler;
  * @{
  */
 
+#if GTS_MACRO_SCHEDULER_BOUNDED_READY_QUEUES
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A queue of ready Nodes. Must be reserved to the Schedule's Node count so
+ *  that the compiled Nodes fit the lock-free bounded queue. Nodes appended
+ *  while the Schedule executes may spill into an unbounded queue.
+ */
+class ReadyNodeQueue
+{
+public: // STRUCTORS:
+
+    GTS_INLINE ReadyNodeQueue()
+        : m_spillCount(0) {}
+
+    /**
+     * @remark Not thread-safe.
+     */
+    GTS_INLINE ReadyNodeQueue(ReadyNodeQueue const& other)
+        : m_queue(other.m_queue)
+        , m_spill(other.m_spill)
+        , m_spillCount(other.m_spillCount.load(memory_order::relaxed)) {}
+
+    /**
+     * @remark Not thread-safe.
+     */
+    GTS_INLINE ReadyNodeQueue(ReadyNodeQueue&& other)
+        : m_queue(std::move(other.m_queue))
+        , m_spill(std::move(other.m_spill))
+        , m_spillCount(other.m_spillCount.exchange(0, memory_order::relaxed)) {}
+
+public: // ACCESSORS:
+
+    GTS_INLINE bool empty() const
+    {
+        return m_queue.empty() && m_spillCount.load(memory_order::acquire) == 0;
+    }
+
+public: // MUTATORS:
+
+    /**
+     * Reserves the bounded queue.
+     * @remark Not thread-safe.
+     */
+    GTS_INLINE void reserve(size_t capacity)
+    {
+        m_queue.reserve(capacity);
+    }
+
+    GTS_INLINE bool tryPush(Node* pNode)
+    {
+        if (m_queue.tryPush(pNode))
+        {
+            return true;
+        }
+
+        if (!m_spill.tryPush(pNode))
+        {
+            return false;
+        }
+
+        m_spillCount.fetch_add(1, memory_order::acq_rel);
+        return true;
+    }
+
+    GTS_INLINE bool tryPop(Node*& pNode)
+    {
+        if (m_queue.tryPop(pNode))
+        {
+            return true;
+        }
+
+        // Only touch the spill queue's locks if something spilled.
+        if (m_spillCount.load(memory_order::acquire) > 0 && m_spill.tryPop(pNode))
+        {
+            m_spillCount.fetch_sub(1, memory_order::acq_rel);
+            return true;
+        }
+        return false;
+    }
+
+private:
+
+    BoundedQueueMPMC<Node*> m_queue;
+    QueueMPMC<Node*> m_spill;
+    Atomic<uint32_t> m_spillCount;
+};
+
+#else
+//! A queue of ready Nodes.
+using ReadyNodeQueue = QueueMPMC<Node*>;
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 /**
@@ -47,7 +145,9 @@ public: // STRUCTORS:
 
     GTS_INLINE Schedule(MacroScheduler* pMyScheduler)
         : m_pMyScheduler(pMyScheduler)
-        , m_refCount{0} {}
+        , m_refCount{0}
+        , m_topologyVersion{0}
+        , m_openExitCount{0} {}
 
     /**
      * For polymorphic destruction.
@@ -62,18 +162,41 @@ public: // ACCESSORS:
     GTS_INLINE MacroScheduler* getScheduler() { return m_pMyScheduler; }
 
     /**
-     * @returns The current reference count.
+     * @returns The current reference count. Each Task built for one of this
+     *  Schedule's Nodes holds a reference until it finishes, so a Schedule
+     *  with references cannot be recycled.
      */
     GTS_INLINE int32_t refCount() const
     {
         return m_refCount.load(memory_order::acquire);
     }
 
+    /**
+     * @returns A value that changes each time an edge or Workload is added to
+     *  or removed from one of this Schedule's Nodes. A Node reports to the
+     *  Schedule that last compiled or executed it, so edits to other DAGs
+     *  leave the value alone. appendNode and appendEdge do not change it.
+     */
+    GTS_INLINE uint64_t topologyVersion() const
+    {
+        return m_topologyVersion.load(memory_order::acquire);
+    }
+
     /**
      * @returns The next Node for the ComputeResource to execute.
      */
     virtual Node* popNextNode(ComputeResource* pComputeResource, bool myQueuesOnly) = 0;
 
+    /**
+     * Checks if the ready Node 'pNode' can skip the ready queues and execute
+     * directly on 'pComputeResource'.
+     * @param outPriority
+     *  The Node's bypass priority. Larger values are more urgent.
+     * @returns True if 'pNode' can be bypassed to 'pComputeResource'. By
+     *  default no Node is bypassed, so all ready Nodes go through the queues.
+     */
+    virtual bool canBypass(ComputeResource* /*pComputeResource*/, Node* /*pNode*/, uint64_t& /*outPriority*/) const { return false; }
+
     /**
      * @returns True if the schedule is completed.
      */
@@ -94,30 +217,124 @@ public: // MUTATORS:
      * Removes refCount from the current reference count.
      * @returns The new reference count.
      */
-    GTS_INLINE uint32_t removeRef(uint32_t refCount)
+    GTS_INLINE int32_t removeRef(uint32_t refCount)
     {
-        return m_refCount.fetch_sub(refCount, memory_order::acq_rel) + refCount;
+        return m_refCount.fetch_sub(refCount, memory_order::acq_rel) - int32_t(refCount);
     }
 
     /**
-     * If 'pNode' is the last Node, mark the schedule as done.
+     * Called when 'pNode', a Node without successors, completes. Marks the
+     * Schedule as done once all such Nodes, including appended ones, have
+     * completed.
      */
     virtual void tryMarkDone(Node* pNode) = 0;
 
+    /**
+     * Appends the new Node 'pNode' to this executing Schedule as a successor
+     * of 'pPredecessor'. The Schedule is not done until appended Nodes
+     * complete. An appended Node inherits its predecessor's rank.
+     * @remark Appended Nodes and edges only belong to the current execution.
+     *  They are detached when executeSchedule returns or, if it did not
+     *  block, when the Schedule next executes or is freed. The DAG is not
+     *  recompiled for them, and a detached Node can be appended again or
+     *  destroyed.
+     * @remark Thread-safe if 'pPredecessor' is either executing, and this is
+     *  called before its Workload returns, or an appended Node that is not
+     *  ready yet. 'pNode' must not have edges or a sub-graph.
+     */
+    void appendNode(Node* pPredecessor, Node* pNode);
+
+    /**
+     * Adds an edge from the appended Node 'pPredecessor' to 'pSuccessor'
+     * while this Schedule executes.
+     * @remark Thread-safe if neither Node is ready yet, e.g. if 'pSuccessor'
+     *  depends on the executing Node that appended 'pPredecessor'.
+     */
+    void appendEdge(Node* pPredecessor, Node* pSuccessor);
+
     /**
      * Insert 'pNode' into the schedule.
      */
     virtual void insertReadyNode(Node* pNode) = 0;
 
+    /**
+     * Removes one predecessor reference from 'pNode'. By default it only
+     * decrements the Node's predecessor count.
+     * @returns True if 'pNode' is ready to run.
+     */
+    virtual bool removePredecessorRef(Node* pNode);
+
     /**
      * Share the current Node's execution cost on the specified compute resource.
      */
     virtual void observeExecutionCost(ComputeResourceId /*id*/, uint64_t /*cost*/) {}
 
+protected:
+
+    /**
+     * Called with the append lock held after the edge from 'pPredecessor' to
+     * 'pSuccessor' is added to the Nodes.
+     */
+    virtual void _onEdgeAppended(Node* /*pPredecessor*/, Node* /*pSuccessor*/) {}
+
+    /**
+     * Removes the Nodes and edges appended during the last execution. Waits
+     * for the Tasks of that execution to release this Schedule first.
+     * @remark Not thread-safe. The Schedule must be done.
+     */
+    void _detachAppendedNodes();
+
+    /**
+     * Sets the number of Nodes without successors at the start of an
+     * execution.
+     */
+    GTS_INLINE void _resetOpenExits(uint32_t count)
+    {
+        m_openExitCount.store(count, memory_order::release);
+    }
+
+    /**
+     * Closes an exit Node.
+     * @returns True if it was the last open exit.
+     */
+    GTS_INLINE bool _closeExit()
+    {
+        uint32_t prevCount = m_openExitCount.fetch_sub(1, memory_order::acq_rel);
+        GTS_ASSERT(prevCount != 0);
+        return prevCount == 1;
+    }
+
 private:
 
+    friend class Node;
+    friend class MacroScheduler;
+
+    struct AppendedEdge
+    {
+        Node* pPredecessor;
+        Node* pSuccessor;
+    };
+
+    GTS_INLINE void _onTopologyChanged()
+    {
+        m_topologyVersion.fetch_add(1, memory_order::acq_rel);
+    }
+
     MacroScheduler* m_pMyScheduler;
     Atomic<int32_t> m_refCount;
+
+    //! Bumped on each edge or Workload change to this Schedule's Nodes so
+    //! that a compiled DAG can detect that it is stale.
+    Atomic<uint64_t> m_topologyVersion;
+
+    //! The Nodes without successors that have not completed.
+    Atomic<uint32_t> m_openExitCount;
+
+    //! The edges appended during the current execution, in append order.
+    Vector<AppendedEdge> m_appendedEdges;
+
+    //! Serializes appends.
+    UnfairSpinMutex<> m_appendMutex;
 };
 
 /** @} */ // end of MacroScheduler
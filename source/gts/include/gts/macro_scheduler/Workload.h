@@ -55,6 +55,7 @@ public: // STRUCTORS:
     GTS_INLINE explicit Workload(WorkloadType::Enum type)
         : m_pMyNode(nullptr)
         , m_type(type)
+        , m_allocSize(0)
     {}
 
     /**
@@ -88,6 +89,12 @@ protected:
 
     //! The Workloads type.
     WorkloadType::Enum m_type;
+
+private:
+
+    //! The size of this Workload's allocation, including any trailing
+    //! storage.
+    uint32_t m_allocSize;
 };
 
 /** @} */ // end of MacroScheduler
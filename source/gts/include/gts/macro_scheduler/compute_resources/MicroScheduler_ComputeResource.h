@@ -75,13 +75,23 @@ public:
 
     virtual uint32_t processorCount() const final;
 
+    virtual uint32_t workerCount() const final;
+
+    virtual uint32_t thisWorkerIndex() const final;
+
     virtual void notify(Schedule* pSchedule) final;
 
     virtual void registerSchedule(Schedule* pSchedulue) final;
 
     virtual void unregisterSchedule(Schedule* pSchedulue) final;
 
-    virtual void spawnReadyChildren(WorkloadContext const& workloadContext, Task* pCurrentTask);
+    /**
+     * Releases the successors of the Node in 'workloadContext' and queues the
+     * ones that become ready.
+     * @returns The most urgent ready successor this ComputeResource can run
+     *  next as a bypass Task, or nullptr if there is none.
+     */
+    virtual Task* spawnReadyChildren(WorkloadContext const& workloadContext, Task* pCurrentTask);
 
 protected:
 
@@ -111,6 +121,8 @@ private:
 
     MicroScheduler_Workload* _findWorkload(Node* pNode) const;
 
+    bool _canBypass(Schedule* pSchedule, Node* pNode, uint64_t& outPriority);
+
     Atomic<Schedule*> m_pCurrentSchedule{ nullptr };
     ParallelHashTable<Schedule*, CheckForTasksData>* m_pCheckForTasksDataBySchedule;
     uint32_t m_vectorWidth;
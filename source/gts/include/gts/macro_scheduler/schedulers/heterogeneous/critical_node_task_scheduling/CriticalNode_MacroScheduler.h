@@ -54,6 +54,10 @@ class Cats_WorkQueue;
 /**
  * @brief
  *  A generalized DAG scheduler utilizing "Critically Aware Task Scheduling."
+ *  buildSchedule compiles the DAG into flat arrays. executeSchedule reuses
+ *  them and only recompiles after an edge changes. Each Node's cost is
+ *  tracked as a moving average, and only the sub-DAG affected by Nodes whose
+ *  average drifted is re-ranked.
  */
 class CriticalNode_MacroScheduler : public MacroScheduler
 {
@@ -65,11 +69,32 @@ public: // LIFETIME:
 
 public: // MUTATORS:
 
-    virtual Schedule* buildSchedule(Node* pStart, Node* pEnd) final;
+    /**
+     * Sets the weight, in (0, 1], of the newest observed cost in each Node's
+     * moving average cost. Defaults to 0.25.
+     */
+    void setCostSmoothingFactor(double factor);
+
+    /**
+     * Sets how far a Node's average cost may drift, relative to the cost it
+     * was ranked with, before it is re-ranked. Defaults to 0.25.
+     */
+    void setRerankThreshold(double threshold);
+
+    /**
+     * If false, any drift re-ranks the whole DAG. Defaults to true.
+     */
+    void setIncrementalRanking(bool enable);
 
-    virtual void freeSchedule(Schedule* pSchedule) final;
+    virtual Schedule* buildSchedule(Node* pStart, Node* pEnd) final;
 
     virtual void executeSchedule(Schedule* pSchedule, ComputeResourceId uid) final;
+
+private:
+
+    double m_costSmoothingFactor = 0.25;
+    double m_rerankThreshold = 0.25;
+    bool m_isRankingIncremental = true;
 };
 
 /** @} */ // end of CriticalNodeTaskScheduling
@@ -63,6 +63,8 @@ public: // STRUCTORS:
 
     CriticalNode_Schedule(MacroScheduler* pMyScheduler, Node* pSource, Node* pSink);
 
+    ~CriticalNode_Schedule();
+
 public: // ACCESSORS:
 
     /**
@@ -75,14 +77,21 @@ public: // ACCESSORS:
      */
     virtual Node* popNextNode(ComputeResource* pCompResource, bool myQueuesOnly) final;
 
+    /**
+     * @returns True if 'pNode' can skip the ready queues and execute directly
+     *  on 'pComputeResource'.
+     */
+    virtual bool canBypass(ComputeResource* pComputeResource, Node* pNode, uint64_t& outPriority) const final;
+
 public: // MUTATORS:
 
     /**
-     * If 'pNode' is the last Node, mark the schedule as done.
+     * Marks the schedule as done once the last Node without successors
+     * completes.
      */
-    GTS_INLINE virtual void tryMarkDone(Node* pNode) final
+    GTS_INLINE virtual void tryMarkDone(Node*) final
     {
-        if (pNode == m_pSink)
+        if (_closeExit())
         {
             m_isDone.exchange(true, memory_order::acq_rel);
         }
@@ -93,6 +102,16 @@ public: // MUTATORS:
      */
     virtual void insertReadyNode(Node* pNode) final;
 
+    /**
+     * Removes one predecessor reference from 'pNode'.
+     * @returns True if 'pNode' is ready to run.
+     */
+    virtual bool removePredecessorRef(Node* pNode) final;
+
+protected:
+
+    virtual void _onEdgeAppended(Node* pPredecessor, Node* pSuccessor) final;
+
 private:
 
     friend class CriticalNode_MacroScheduler;
@@ -103,25 +122,138 @@ private:
         ComputeResource* pComputeResource = nullptr;
 
         //! All the Nodes ready to be executed.
-        QueueMPMC<Node*> queue;
+        ReadyNodeQueue queue;
     };
 
+    //! Points a recycled Schedule at a new DAG.
+    GTS_INLINE void _rebind(Node* pSource, Node* pSink)
+    {
+        GTS_ASSERT(isDone() && refCount() == 0);
+        m_pSource = pSource;
+        m_pSink   = pSink;
+    }
+
     void _insertReadyNode(Node* pNode, ReadyQueue& readyQueue);
 
     void _notifyQueuesOfReadyNode(size_t lastQueueIdx);
 
-    void _rankNodes(
-        Vector<ComputeResource*> const& computeResources,
-        Node* pSource,
-        Node* pSink);
+    size_t _findReadyQueueIdx(Node* pNode) const;
+
+    uint64_t _downRank(Node* pNode) const;
 
-    void _upRankNodes(Node* pSink);
+    bool _compile();
 
-    bool _downRankNodes(Node* pSource, uint32_t rank, uint32_t numToRank);
+    bool _isStale();
+
+    bool _smoothCosts(double smoothingFactor, double rerankThreshold);
+
+    void _resetPredecessorCounts();
+
+    void _rankNodes(Vector<ComputeResource*> const& computeResources);
+
+    void _rerankDriftedNodes(Vector<ComputeResource*> const& computeResources);
+
+    uint64_t _upRank(uint32_t pass, uint32_t idx) const;
+
+    void _propagateUpRanks(uint32_t pass);
+
+    void _downRankDepth(uint32_t pass, uint32_t depth, uint32_t downRank, uint32_t numToRank);
+
+    void _markDepthDirty(uint32_t depth);
+
+    void _addSeed(uint32_t idx);
 
     //! Ready Node queues ordered by rank.
     Vector<ReadyQueue> m_queuesByRank;
 
+    //! The index of each queue's ComputeResource in the MacroScheduler.
+    Vector<uint32_t> m_resourceIdxByQueue;
+
+    //! Offsets into m_queuesByRank for each ComputeResource, one past the end
+    //! for the last ComputeResource.
+    Vector<uint32_t> m_queueOffsetsByResource;
+
+    //
+    // The compiled DAG. Nodes are indexed in topological order.
+
+    //! The Nodes in topological order.
+    Vector<Node*> m_nodes;
+
+    //! CSR offsets into m_successorIdxs, one past the end for the last Node.
+    Vector<uint32_t> m_successorOffsets;
+
+    //! The successor indices of each Node.
+    Vector<uint32_t> m_successorIdxs;
+
+    //! CSR offsets into m_predecessorIdxs, one past the end for the last Node.
+    Vector<uint32_t> m_predecessorOffsets;
+
+    //! The predecessor indices of each Node.
+    Vector<uint32_t> m_predecessorIdxs;
+
+    //! The BFS depth of each Node from the source.
+    Vector<uint32_t> m_depths;
+
+    //! CSR offsets into m_nodeIdxsByDepth for each BFS depth from the source.
+    Vector<uint32_t> m_depthOffsets;
+
+    //! The Node indices grouped by BFS depth.
+    Vector<uint32_t> m_nodeIdxsByDepth;
+
+    //! A bit per ComputeResource that can execute each Node. Empty if there
+    //! are too many ComputeResources for a mask.
+    Vector<uint64_t> m_executableMasks;
+
+    //! The predecessor count each Node starts an execution with.
+    Vector<uint32_t> m_initPredecessorCounts;
+
+    //! The live predecessor counts. Reset from m_initPredecessorCounts.
+    Atomic<uint32_t>* m_pPredecessorCounts;
+
+    //! The number of Nodes without successors.
+    uint32_t m_exitCount;
+
+    //
+    // Ranking state, cached between executions.
+
+    //! The moving average of each Node's execution cost.
+    Vector<double> m_smoothedCosts;
+
+    //! The cost each Node was last ranked with.
+    Vector<uint64_t> m_rankedCosts;
+
+    //! The up-rank of each Node for each ranking pass, pass major.
+    Vector<uint64_t> m_upRanks;
+
+    //! The pass that down-ranked each Node, or UINT32_MAX if none did.
+    Vector<uint32_t> m_rankPasses;
+
+    //! The cached down-rank of each Node.
+    Vector<uint32_t> m_downRanks;
+
+    //
+    // Scratch space for ranking.
+
+    //! Nodes whose up-rank must be recomputed. Seeds each pass's propagation.
+    Vector<uint32_t> m_seeds;
+    Vector<uint8_t> m_isSeed;
+
+    //! A max-heap of Node indices waiting for their up-rank to be recomputed.
+    Vector<uint32_t> m_pending;
+    Vector<uint8_t> m_isPending;
+
+    //! Depths that must be down-ranked again.
+    Vector<uint32_t> m_dirtyDepths;
+    Vector<uint8_t> m_isDepthDirty;
+
+    Vector<uint32_t> m_rankCandidates;
+
+    //! The number of ranking passes, one per ComputeResource but the last.
+    uint32_t m_passCount;
+
+    //! The topology version this Schedule was compiled against.
+    uint64_t m_compiledTopologyVersion;
+
     //! The first Node in the Schedule.
     Node* m_pSource;
 
@@ -64,8 +64,6 @@ public: // MUTATORS:
 
     virtual Schedule* buildSchedule(Node* pStart, Node* pEnd) final;
 
-    virtual void freeSchedule(Schedule* pSchedule) final;
-
     virtual void executeSchedule(Schedule* pSchedule, ComputeResourceId id) final;
 };
 
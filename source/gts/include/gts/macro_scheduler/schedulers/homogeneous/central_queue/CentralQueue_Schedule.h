@@ -75,14 +75,21 @@ public: // ACCESSORS:
      */
     virtual Node* popNextNode(ComputeResource* pCompResource, bool myQueuesOnly) final;
 
+    /**
+     * @returns True if 'pNode' can skip the ready queues and execute directly
+     *  on 'pComputeResource'.
+     */
+    virtual bool canBypass(ComputeResource* pComputeResource, Node* pNode, uint64_t& outPriority) const final;
+
 public: // MUTATORS:
 
     /**
-     * If 'pNode' is the last Node, mark the schedule as done.
+     * Marks the schedule as done once the last Node without successors
+     * completes.
      */
-    GTS_INLINE virtual void tryMarkDone(Node* pNode) final
+    GTS_INLINE virtual void tryMarkDone(Node*) final
     {
-        if (pNode == m_pSink)
+        if (_closeExit())
         {
             m_isDone.exchange(true, memory_order::acq_rel);
         }
@@ -93,6 +100,12 @@ public: // MUTATORS:
      */
     virtual void insertReadyNode(Node* pNode) final;
 
+    /**
+     * Removes one predecessor reference from 'pNode'.
+     * @returns True if 'pNode' is ready to run.
+     */
+    virtual bool removePredecessorRef(Node* pNode) final;
+
 private:
 
     friend class CentralQueue_MacroScheduler;
@@ -103,11 +116,21 @@ private:
         ComputeResource* pComputeResource = nullptr;
 
         //! All the Nodes ready to be executed.
-        QueueMPMC<Node*> readyQueue;
+        ReadyNodeQueue readyQueue;
     };
 
+    //! Points a recycled Schedule at a new DAG.
+    GTS_INLINE void _rebind(Node* pSource, Node* pSink)
+    {
+        GTS_ASSERT(isDone() && refCount() == 0);
+        m_pSource = pSource;
+        m_pSink   = pSink;
+    }
+
+    void _reserveReadyQueues(size_t nodeCount);
+
     //! The queue of ready Nodes that the ComputeResources will pop from.
-    QueueMPMC<Node*> m_readyQueue;
+    ReadyNodeQueue m_readyQueue;
 
     //! Queue of affinitized ready Nodes and their ComputeResources.
     Vector<AffinityQueue> m_affinityQueues;
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include "gts/platform/Machine.h"
+
+#include "gts/macro_scheduler/Schedule.h"
+
+namespace gts {
+
+/** 
+ * @addtogroup MacroScheduler
+ * @{
+ */
+
+/** 
+ * @addtogroup Implementations
+ * @{
+ */
+
+/** 
+ * @addtogroup Schedulers
+ * @{
+ */
+
+/** 
+ * @addtogroup WorkStealing
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A schedule produced by a WorkStealing_MacroScheduler.
+ */
+class WorkStealing_Schedule : public Schedule
+{
+public: // STRUCTORS:
+
+    WorkStealing_Schedule(MacroScheduler* pMyScheduler, Node* pSource, Node* pSink);
+
+public: // ACCESSORS:
+
+    /**
+     * @returns True if the schedule is completed.
+     */
+    GTS_INLINE virtual bool isDone() const final { return m_isDone.load(memory_order::acquire); }
+
+    /**
+     * @returns The next Node to execute. Pops the calling Worker's queue
+     *  first and only steals from other Workers if 'myQueuesOnly' is false.
+     */
+    virtual Node* popNextNode(ComputeResource* pCompResource, bool myQueuesOnly) final;
+
+    /**
+     * @returns True if 'pNode' can skip the ready queues and execute directly
+     *  on 'pComputeResource'.
+     */
+    virtual bool canBypass(ComputeResource* pComputeResource, Node* pNode, uint64_t& outPriority) const final;
+
+public: // MUTATORS:
+
+    /**
+     * Marks the schedule as done once the last Node without successors
+     * completes.
+     */
+    GTS_INLINE virtual void tryMarkDone(Node*) final
+    {
+        if (_closeExit())
+        {
+            m_isDone.exchange(true, memory_order::acq_rel);
+        }
+    }
+
+    /**
+     * Inserts a ready Node into the calling Worker's queue.
+     */
+    virtual void insertReadyNode(Node* pNode) final;
+
+    /**
+     * Removes one predecessor reference from 'pNode'.
+     * @returns True if 'pNode' is ready to run.
+     */
+    virtual bool removePredecessorRef(Node* pNode) final;
+
+private:
+
+    friend class WorkStealing_MacroScheduler;
+
+    struct AffinityQueue
+    {
+        //! The ComputeResource associated with this queue.
+        ComputeResource* pComputeResource = nullptr;
+
+        //! All the Nodes ready to be executed.
+        ReadyNodeQueue readyQueue;
+    };
+
+    //! Points a recycled Schedule at a new DAG.
+    GTS_INLINE void _rebind(Node* pSource, Node* pSink)
+    {
+        GTS_ASSERT(isDone() && refCount() == 0);
+        m_pSource = pSource;
+        m_pSink   = pSink;
+    }
+
+    uint32_t _thisWorkerQueueIdx(ComputeResource* pComputeResource);
+
+    uint32_t _thisWorkerQueueIdx();
+
+    void _reserveReadyQueues(size_t nodeCount);
+
+    //! The ready Nodes of each ComputeResource Worker, grouped by
+    //! ComputeResource.
+    Vector<ReadyNodeQueue> m_workerQueues;
+
+    //! Offsets into m_workerQueues for each ComputeResource, one past the end
+    //! for the last ComputeResource.
+    Vector<uint32_t> m_workerQueueOffsets;
+
+    //! Ready Nodes inserted by threads that are not Workers.
+    ReadyNodeQueue m_injectionQueue;
+
+    //! Queue of affinitized ready Nodes and their ComputeResources.
+    Vector<AffinityQueue> m_affinityQueues;
+
+    //! The first Node in the Schedule.
+    Node* m_pSource;
+
+    //! The last Node in the Schedule.
+    Node* m_pSink;
+
+    // Flags the Schedule as executed.
+    Atomic<bool> m_isDone;
+};
+
+/** @} */ // end of WorkStealing
+/** @} */ // end of Schedulers
+/** @} */ // end of Implementations
+/** @} */ // end of MacroScheduler
+
+} // namespace gts
@@ -23,6 +23,7 @@
 
 #include <fenv.h>
 
+#include "gts/analysis/Counter.h"
 #include "gts/platform/Assert.h"
 #include "gts/platform/Atomic.h"
 #include "gts/platform/Thread.h"
@@ -47,6 +48,7 @@ class LocalSchedulerBackoff;
 
 class WorkerPool;
 class MicroScheduler;
+class MicroSchedulerAlgorithm;
 
 #ifdef GTS_MSVC
 #pragma warning(push)
@@ -59,7 +61,8 @@ class MicroScheduler;
 /**
  * @brief
  *  A work-stealing task scheduler. The scheduler is executed by the WorkerPool
- *  it is initialized with.
+ *  it is initialized with. The work-stealing policy can be replaced with a
+ *  MicroSchedulerAlgorithm through MicroSchedulerDesc.
  *
  * Supports:
  * -Help-first work-stealing
@@ -74,8 +77,6 @@ class MicroScheduler;
  * -Task execution isolation
  * -Hierarchical work-stealing via external victims.
  *
- * @todo Abstract into interface and make a concrete WorkStealingMicroScheduler. Interface will allow other algorithms to be explored.
- * @todo Explore making priorities global to the scheduler. Currently they are only local to each thread.
  */
 class MicroScheduler
 {
@@ -164,6 +165,27 @@ public: // MUTATORS:
             LambdaTaskWrapper<TFunc, TArgs...>(std::forward<TFunc>(func), std::forward<TArgs>(args)...);
     }
 
+    /**
+     * @brief
+     *  Allocates 'count' Task objects of type TTask, each constructed from
+     *  'args'. Cheaper than calling allocateTask 'count' times.
+     * @param ppTasks
+     *  Receives the allocated Tasks.
+     * @param count
+     *  The number of Tasks to allocate.
+     * @param args
+     *  The arguments for each TTask constructor.
+     */
+    template<typename TTask, typename... TArgs>
+    GTS_INLINE void allocateTasks(Task** ppTasks, size_t count, TArgs const&... args)
+    {
+        _allocateRawTasks(sizeof(TTask), (void**)ppTasks, count);
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            ppTasks[ii] = new (ppTasks[ii]) TTask(args...);
+        }
+    }
+
     /**
      * @brief
      *  Spawns the specified 'pTask' to be executed by the scheduler. Spawned
@@ -178,6 +200,25 @@ public: // MUTATORS:
      */
     void spawnTask(Task* pTask, uint32_t priority = 0);
 
+    /**
+     * @brief
+     *  Spawns 'count' independent Tasks at once. Cheaper than calling
+     *  spawnTask 'count' times: the Tasks are published to thieves together
+     *  and sleeping Workers are woken in one pass.
+     * @param ppTasks
+     *  The Tasks to spawn. Executed in LIFO order, and stolen in FIFO order.
+     * @param count
+     *  The number of Tasks in ppTasks.
+     * @param priority
+     *  The priority of the Tasks.
+     * @returns
+     *  The number of Tasks spawned. It is less than 'count' only if a Task
+     *  queue failed to grow, in which case the Tasks from
+     *  ppTasks[returned value] on were not spawned and still belong to the
+     *  caller.
+     */
+    size_t spawnTasks(Task** ppTasks, size_t count, uint32_t priority = 0);
+
     /**
      * @brief
      *  Spawns the specified 'pTask' to be executed by the scheduler and then
@@ -350,6 +391,16 @@ public: // ACCESSORS:
      */
     void wakeWorker();
 
+    /**
+     * @brief
+     *  Copies the scheduler's counters into 'out' without stopping the Workers.
+     *  The counts only grow, so diff two snapshots to get rates.
+     * @remark
+     *  Thread-safe. The counts stay readable after shutdown until the
+     *  scheduler is reinitialized or destroyed.
+     */
+    void getCounters(analysis::MicroSchedulerCounterSnapshot& out) const;
+
     /**
      * @brief
      *  Checks if the scheduler is active.
@@ -373,10 +424,14 @@ public: // ACCESSORS:
 private: // SCHEDULING:
 
     void* _allocateRawTask(uint32_t size);
+    void _allocateRawTasks(uint32_t size, void** ppOut, size_t count);
     void _freeTask(Task* pTask);
     void _wait(Worker* pWorker, Task* pTask, Task* pChild);
     void _addTask(Worker* pWorker, Task* pTask, uint32_t priority);
+    size_t _addTasks(Worker* pWorker, Task** ppTasks, size_t count, uint32_t priority);
     void _wakeWorkers(Worker* pThisWorker, uint32_t count, bool reset, bool wakeExternalVictims);
+    analysis::MicroSchedulerCounterSlot* _counters(Worker* pWorker);
+    static void _signalWaiter(Task* pWaiterTask);
 
     void _registerWithWorkerPool(WorkerPool* pWorkerPool);
     void _unRegisterFromWorkerPool(WorkerPool* pWorkerPool, bool lockWorkerPool);
@@ -452,12 +507,86 @@ private: // DATA:
         rw_lock_type m_mutex;
     };
 
+    class GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) WaitEvents
+    {
+    public:
+        ~WaitEvents();
+        BinarySemaphore* acquire();
+        void release(BinarySemaphore* pEvent);
+
+        Vector<BinarySemaphore*> m_freeEvents;
+        using mutex_type = UnfairSpinMutex<>;
+        mutex_type m_mutex;
+    };
+
+    /**
+     * @brief
+     *  Tracks which LocalSchedulers have Tasks at each priority so that thieves
+     *  can find the highest priority Task across the MicroScheduler without
+     *  probing every deque. The bits are hints: a set bit may refer to an
+     *  empty deque and, rarely, a non-empty deque may be unmarked. The random
+     *  steal guarantees progress in either case.
+     */
+    class GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) GlobalPriorities
+    {
+    public:
+
+        GlobalPriorities(uint32_t priorityCount, uint32_t localSchedulerCount);
+        ~GlobalPriorities();
+
+        GTS_INLINE void markOccupied(uint32_t priority, SubIdType localId)
+        {
+            Atomic<uint64_t>& mask = _word(priority, localId);
+            const uint64_t bit = _bit(localId);
+            if ((mask.load(memory_order::relaxed) & bit) == 0) // Race OK.
+            {
+                mask.fetch_or(bit, memory_order::seq_cst);
+            }
+        }
+
+        GTS_INLINE void markEmpty(uint32_t priority, SubIdType localId)
+        {
+            Atomic<uint64_t>& mask = _word(priority, localId);
+            const uint64_t bit = _bit(localId);
+            if ((mask.load(memory_order::relaxed) & bit) != 0) // Race OK.
+            {
+                mask.fetch_and(~bit, memory_order::seq_cst);
+            }
+        }
+
+        /**
+         * @returns The ID of a LocalScheduler other than 'thiefId' that has
+         *  Tasks at 'priority', searching from 'startId', or UNKNOWN_SUBID if
+         *  there are none.
+         */
+        SubIdType findVictim(uint32_t priority, SubIdType thiefId, SubIdType startId) const;
+
+        GTS_INLINE Atomic<uint64_t>& _word(uint32_t priority, SubIdType localId)
+        {
+            return m_pOccupancyMasks[priority * m_wordStride + (localId >> 6)];
+        }
+
+        GTS_INLINE static uint64_t _bit(SubIdType localId)
+        {
+            return uint64_t(1) << (localId & 63);
+        }
+
+        Atomic<uint64_t>* m_pOccupancyMasks;
+        uint32_t m_priorityCount;
+        uint32_t m_wordCount;
+        uint32_t m_wordStride;
+    };
+
     PriorityTaskQueue* m_pPriorityTaskQueue;
     WorkerPool* m_pWorkerPool;
     Worker* m_pMyMaster;
     LocalScheduler** m_ppLocalSchedulersByIdx;
     ExternalSchedulers* m_pExternalSchedulers;
     Callbacks* m_pCallbacks;
+    WaitEvents* m_pWaitEvents;
+    GlobalPriorities* m_pGlobalPriorities;
+    MicroSchedulerAlgorithm* m_pAlgorithm;
+    analysis::Counters<analysis::MicroSchedulerCounters> m_counters;
     ThreadId m_creationThreadId;
     uint32_t m_localSchedulerCount;
     SubIdType m_schedulerId;
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include "gts/platform/Utils.h"
+
+namespace gts {
+
+class Task;
+
+/** 
+ * @addtogroup MicroScheduler
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  The policy that stores ready Tasks and selects the next Task for each
+ *  Worker of a MicroScheduler. A MicroScheduler uses its built-in per-Worker
+ *  work-stealing deques unless a MicroSchedulerAlgorithm is set in
+ *  MicroSchedulerDesc::pAlgorithm.
+ *
+ *  The MicroScheduler still owns everything else: Task allocation and
+ *  reference counting, continuations, waiting, affinitized Tasks, Worker
+ *  sleeping and waking, and external victims.
+ *
+ * @remark
+ *  push and pop are called concurrently from any Worker and from threads
+ *  outside the WorkerPool, so implementations must be thread-safe.
+ */
+class MicroSchedulerAlgorithm
+{
+public: // STRUCTORS:
+
+    /**
+     * For polymorphic destruction.
+     */
+    virtual ~MicroSchedulerAlgorithm() = default;
+
+public: // LIFETIME:
+
+    /**
+     * Called once by MicroScheduler::initialize before any Task is spawned.
+     * @param workerCount
+     *  The number of Workers. Worker indices are in [0, workerCount).
+     * @param priorityCount
+     *  The number of priorities. Priority 0 is the highest.
+     * @returns False if the algorithm cannot run with these parameters.
+     */
+    virtual bool initialize(uint32_t workerCount, uint32_t priorityCount) = 0;
+
+    /**
+     * Called once by MicroScheduler::shutdown after all Workers have stopped
+     * accessing the algorithm.
+     */
+    virtual void shutdown() = 0;
+
+public: // MUTATORS:
+
+    /**
+     * Stores a Task that is ready to execute.
+     * @param workerIdx
+     *  The index of the spawning Worker, or UNKNOWN_SUBID if the Task was
+     *  spawned by a thread that does not execute this MicroScheduler.
+     * @returns False if the Task could not be stored.
+     */
+    virtual bool push(Task* pTask, uint32_t priority, SubIdType workerIdx) = 0;
+
+    /**
+     * Removes the next Task to execute.
+     * @param workerIdx
+     *  The index of the Worker that will execute the Task, or UNKNOWN_SUBID
+     *  if the caller is an external MicroScheduler stealing work.
+     * @returns The Task or nullptr if there is nothing to execute.
+     */
+    virtual Task* pop(SubIdType workerIdx) = 0;
+
+public: // ACCESSORS:
+
+    /**
+     * @returns True if there may be Tasks to pop. Used to decide whether
+     *  Workers can sleep, so a false negative can stall the scheduler.
+     */
+    virtual bool hasTasks() const = 0;
+
+    /**
+     * @returns A human readable name for profiling output.
+     */
+    virtual const char* name() const = 0;
+};
+
+/** @} */ // end of MicroScheduler
+
+} // namespace gts
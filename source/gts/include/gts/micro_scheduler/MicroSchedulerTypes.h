@@ -40,6 +40,7 @@ namespace gts {
 class MicroScheduler;
 class WorkerPool;
 class Task;
+class MicroSchedulerAlgorithm;
 
 //! The fixed size for descriptive names.
 constexpr size_t DESC_NAME_SIZE = 64;
@@ -217,6 +218,31 @@ struct WorkerPoolDesc
      */
     uint32_t initialTaskCountPerWorker = 0;
 
+    /**
+     * @brief
+     *  Spreads the Workers across the NUMA nodes, node by node, and gives each
+     *  node its own Task memory. Steals prefer Workers on the same node.
+     * @remark
+     *  Workers with an affinity in workerDescs keep it. The master thread is
+     *  not pinned, but it is treated as the first hardware thread of the first
+     *  node, so pin it there for the best locality.
+     */
+    bool numaAware = false;
+
+    /**
+     * @brief
+     *  If numaAware, binds each node's Task memory to the node (Linux only).
+     *  Otherwise placement relies on the node's Workers touching it first.
+     */
+    bool numaBindMemory = false;
+
+    /**
+     * @brief
+     *  If numaAware, the number of consecutive failed node-local steals before
+     *  a Worker tries to steal from another node. 1 disables throttling.
+     */
+    uint32_t numaRemoteStealPeriod = 4;
+
     /**
      * @brief
      *  A name to help with debugging.
@@ -255,6 +281,22 @@ struct MicroSchedulerDesc
      */
     int16_t priorityBoostAge = INT16_MAX;
 
+    /**
+     * @brief
+     * Flag to make priorities global to the MicroScheduler. When true, a Worker
+     * runs the highest priority Task available across all Workers, stealing it
+     * if necessary, before it runs a lower priority Task from its own deque.
+     * When false, priorities only order the Tasks within each Worker.
+     */
+    bool useGlobalPriorities = false;
+
+    /**
+     * @brief
+     * The algorithm that stores and selects ready Tasks. If null, the built-in
+     * work-stealing algorithm is used. The algorithm must outlive the
+     * MicroScheduler. Ignores useGlobalPriorities when set.
+     */
+    MicroSchedulerAlgorithm* pAlgorithm = nullptr;
 
     /**
      * @brief
@@ -271,6 +313,16 @@ struct MicroSchedulerDesc
      */
     bool canStealBackTasks = false;
 
+    /**
+     * @brief
+     * The maximum number of Tasks a thief takes from a victim in one steal. A
+     * thief never takes more than half of the victim's Tasks at a priority.
+     * The first Task is executed and the rest are moved to the thief's deque.
+     * Values > 1 help wide, flat spawns. 1 disables batch stealing. Clamped
+     * to 64.
+     */
+    uint32_t maxStealBatchSize = 1;
+
     /**
      * @brief
      * A name to help with debugging.
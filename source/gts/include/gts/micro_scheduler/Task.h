@@ -42,6 +42,8 @@ class Task;
 class MicroScheduler;
 class LocalScheduler;
 class Worker;
+class TaskPool;
+class BinarySemaphore;
 
 constexpr uint32_t ANY_WORKER = UNKNOWN_UID;
 
@@ -85,12 +87,18 @@ struct GTS_ALIGN(GTS_CACHE_LINE_SIZE) TaskHeader
         TASK_IS_STOLEN       = 1 << 2,
         TASK_IS_WAITER       = 1 << 3,
         TASK_IS_SMALL        = 1 << 4,
+        TASK_IS_ARENA_MEMORY = 1 << 5,
     };
 
+    // Added to refCount while a non-worker thread is blocked on pWaitEvent.
+    enum { BLOCKED_WAIT_REF = 1 << 30 };
+
     Task*            pParent           = nullptr;
     Atomic<Task*>    pListNext         = { nullptr };
     LocalScheduler*  pMyLocalScheduler = nullptr;
-    Worker*          pMyWorker         = nullptr;
+    TaskPool*        pMyTaskPool       = nullptr;
+    // Set while a non-worker thread is blocked waiting on this task.
+    Atomic<BinarySemaphore*> pWaitEvent = { nullptr };
 #ifdef GTS_USE_TASK_NAME
     const char*      pName             = nullptr;
 #endif
@@ -121,6 +129,7 @@ class Task
     friend class MicroScheduler;
     friend class LocalScheduler;
     friend class Worker;
+    friend class TaskPool;
 
 public: // INTERFACE:
 
@@ -21,6 +21,7 @@
  ******************************************************************************/
 #pragma once
 
+#include "gts/analysis/Counter.h"
 #include "gts/platform/Assert.h"
 #include "gts/platform/Atomic.h"
 #include "gts/containers/Vector.h"
@@ -35,6 +36,9 @@ namespace gts {
  */
 
 class Worker;
+class TaskPool;
+class StealHierarchy;
+class TaskArena;
 class AllocatorManager;
 
 #ifdef GTS_MSVC
@@ -132,6 +136,16 @@ public: // ACCESSORS:
      */
     MicroScheduler* currentMicroScheduler() const;
 
+    /**
+     * @brief
+     *  Copies the pool's counters into 'out' without stopping the Workers.
+     *  The counts only grow, so diff two snapshots to get rates.
+     * @remark
+     *  Thread-safe. The counts stay readable after shutdown until the
+     *  pool is reinitialized or destroyed.
+     */
+    void getCounters(analysis::WorkerPoolCounterSnapshot& out) const;
+
 public: // MUTATORS:
 
     /**
@@ -141,14 +155,61 @@ public: // MUTATORS:
      */
     static void resetIdGenerator();
 
+    /**
+     * @brief
+     *  Gives the calling non-Worker thread its own Task cache, so that the
+     *  Tasks it allocates for MicroSchedulers on this WorkerPool are recycled
+     *  like a Worker's instead of going to the heap.
+     * @remark
+     *  Call unregisterExternalThread on the same thread before it exits. The
+     *  cache memory is reclaimed when the WorkerPool shuts down.
+     * @remark
+     *  A thread can only be registered with one WorkerPool at a time.
+     * @return False if the calling thread is a Worker or is already registered
+     *  with any WorkerPool.
+     */
+    bool registerExternalThread();
+
+    /**
+     * @brief
+     *  Releases the Task cache acquired by registerExternalThread on the
+     *  calling thread.
+     */
+    void unregisterExternalThread();
+
 private: // PRIVATE METHODS:
 
-    bool _initWorkers(WorkerPoolDesc& desc);
+    bool _initWorkers(
+        WorkerPoolDesc& desc,
+        WorkerThreadDesc::GroupAndAffinity const* pAffinities,
+        TaskArena* const* ppArenaByWorker);
+
+    void _initNuma(
+        WorkerPoolDesc const& desc,
+        SystemTopology const& topology,
+        Vector<WorkerThreadDesc::GroupAndAffinity>& affinities,
+        Vector<TaskArena*>& arenaByWorker);
+
+    void _initStealHierarchy(
+        WorkerPoolDesc const& desc,
+        SystemTopology const& topology,
+        Vector<WorkerThreadDesc::GroupAndAffinity> const& affinities);
     void _destroyWorkers();
 
     void _wakeWorker(Worker* pThisWorker, uint32_t count, bool reset);
     bool _wakeWorkerLoop(uint32_t startIdx, uint32_t endIdx, SubIdType thisWorkerId, uint32_t count, bool reset);
 
+    // Sets or clears workerId's bit in m_pSleepingWorkerMasks.
+    void _markSleeping(SubIdType workerId, bool isSleeping);
+
+    GTS_INLINE uint32_t _sleepingWorkerMaskCount() const
+    {
+        return (m_workerCount + SLEEP_MASK_BITS - 1) / SLEEP_MASK_BITS;
+    }
+
+    // The counters for workerId. Threads outside the pool share one slot.
+    analysis::WorkerPoolCounterSlot* _counters(OwnedId workerId);
+
     uint32_t _haltedWorkerCount() const;
     void _haltAllWorkers();
     void _resumeAllWorkers();
@@ -170,19 +231,34 @@ private:
 
     using MutexType = UnfairSpinMutex<Backoff<BackoffGrowth::Geometric, true>>;
 
+    static constexpr uint32_t SLEEP_MASK_BITS = 64;
+
     struct RegisteredSchedulers
     {
         MutexType mutex;
         Vector<MicroScheduler*> schedulers;
     };
 
+    struct ExternalTaskPools
+    {
+        MutexType mutex;
+        Vector<TaskPool*> pools;
+        Vector<TaskPool*> unboundPools;
+    };
+
     Worker* m_pWorkersByIdx;
     RegisteredSchedulers* m_pRegisteredSchedulers;
+    ExternalTaskPools* m_pExternalTaskPools;
+    StealHierarchy* m_pStealHierarchy;
+    Vector<TaskArena*> m_taskArenas;
+    // One bit per sleeping Worker, so wakers don't have to visit every Worker.
+    Atomic<uint64_t>* m_pSleepingWorkerMasks;
+    analysis::Counters<analysis::WorkerPoolCounters> m_counters;
     WorkerPoolDesc::GetThreadLocalStateFcn m_pGetThreadLocalStateFcn;
     WorkerPoolDesc::SetThreadLocalStateFcn m_pSetThreadLocalStateFcn;
+    uint32_t m_cachableTaskSize;
     uint16_t m_poolId;
     uint16_t m_workerCount;
-    Atomic<int16_t> m_sleepingWorkerCount;
     Atomic<int16_t> m_haltedWorkerCount;
     Atomic<bool> m_isRunning;
     Atomic<bool> m_ishalting;
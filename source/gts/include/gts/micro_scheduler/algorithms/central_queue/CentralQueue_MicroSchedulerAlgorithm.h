@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include "gts/containers/Vector.h"
+#include "gts/containers/AlignedAllocator.h"
+#include "gts/containers/parallel/QueueMPMC.h"
+#include "gts/micro_scheduler/MicroSchedulerAlgorithm.h"
+
+namespace gts {
+
+/** 
+ * @addtogroup MicroScheduler
+ * @{
+ */
+
+/** 
+ * @addtogroup Algorithms
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A MicroSchedulerAlgorithm where all Workers share one FIFO queue per
+ *  priority. Tasks execute in near spawn order, which favors breadth-first
+ *  workloads and gives a contended baseline to compare work-stealing against.
+ */
+class CentralQueue_MicroSchedulerAlgorithm : public MicroSchedulerAlgorithm
+{
+public: // LIFETIME:
+
+    virtual bool initialize(uint32_t workerCount, uint32_t priorityCount) final;
+
+    virtual void shutdown() final;
+
+public: // MUTATORS:
+
+    virtual bool push(Task* pTask, uint32_t priority, SubIdType workerIdx) final;
+
+    virtual Task* pop(SubIdType workerIdx) final;
+
+public: // ACCESSORS:
+
+    virtual bool hasTasks() const final;
+
+    virtual const char* name() const final;
+
+private:
+
+    using TaskQueue = QueueMPMC<Task*, UnfairSpinMutex<>, AlignedAllocator<GTS_NO_SHARING_CACHE_LINE_SIZE>>;
+
+    Vector<TaskQueue, AlignedAllocator<GTS_NO_SHARING_CACHE_LINE_SIZE>> m_queuesByPriority;
+};
+
+/** @} */ // end of Algorithms
+/** @} */ // end of MicroScheduler
+
+} // namespace gts
@@ -0,0 +1,396 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  Splits a TRange into the same sub-ranges on every call and sends each
+ *  sub-range back to the Worker that executed it on the previous call, so
+ *  that repeated passes over the same data find it in that Worker's cache.
+ * @details
+ *  Each sub-range with a recorded Worker is queued in that Worker's affinity
+ *  queue, and a stealable copy is spawned on the calling Worker. Idle Workers
+ *  steal the copy only once their own affinity queues are empty. The copy
+ *  that runs first claims the sub-range, joins the call, and records its
+ *  Worker for the next call. The other copy is not part of the call, so a
+ *  busy Worker never holds the call up. It exits when its Worker gets to it.
+ *
+ *  The user owns an AffinityPartitioner and passes it to every ParallelFor
+ *  call that iterates over the same data. The copies that the calls make
+ *  share the owner's record.
+ * @remark
+ *  An AffinityPartitioner must not be used by concurrent calls.
+ */
+class AffinityPartitioner
+{
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    // The last Worker to execute a sub-range.
+    struct Slot
+    {
+        //! The Worker that executed the sub-range last.
+        Atomic<uint32_t> workerIdx;
+
+        //! workerIdx when the current call started. The call offers the
+        //! sub-range by it, since the call's own copies update workerIdx.
+        uint32_t offeredIdx;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    // The record shared by an AffinityPartitioner and its copies.
+    struct AffinityMap
+    {
+        //----------------------------------------------------------------------
+        GTS_INLINE ~AffinityMap()
+        {
+            alignedVectorDelete(pSlots, slotCount);
+        }
+
+        //----------------------------------------------------------------------
+        GTS_INLINE void reset(uint32_t count)
+        {
+            alignedVectorDelete(pSlots, slotCount);
+            pSlots    = alignedVectorNew<Slot, GTS_NO_SHARING_CACHE_LINE_SIZE>(count);
+            slotCount = count;
+
+            for (uint32_t ii = 0; ii < count; ++ii)
+            {
+                pSlots[ii].workerIdx.store(ANY_WORKER, memory_order::relaxed);
+            }
+        }
+
+        Slot* pSlots       = nullptr;
+        uint32_t slotCount = 0;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    // The claims of the sub-ranges that one call offers twice. The call's
+    // continuation holds one reference per pair of copies, and the copy that
+    // claims the sub-range joins the continuation with it. Each copy releases
+    // the block after it checks its claim, so the losing copy never touches
+    // the call, which may be over.
+    struct ClaimBlock
+    {
+        //----------------------------------------------------------------------
+        GTS_INLINE ClaimBlock(Task* pContinuation, uint32_t slotCount, uint32_t copyCount)
+            : pContinuation(pContinuation)
+            , pClaims(alignedVectorNew<Atomic<uint32_t>, GTS_CACHE_LINE_SIZE>(slotCount))
+            , claimCount(slotCount)
+            , refCount(copyCount)
+        {
+            for (uint32_t ii = 0; ii < slotCount; ++ii)
+            {
+                pClaims[ii].store(0, memory_order::relaxed);
+            }
+        }
+
+        //----------------------------------------------------------------------
+        GTS_INLINE ~ClaimBlock()
+        {
+            alignedVectorDelete(pClaims, claimCount);
+        }
+
+        Task* pContinuation;
+        Atomic<uint32_t>* pClaims;
+        uint32_t claimCount;
+
+        //! The copies that have not checked their claim.
+        Atomic<uint32_t> refCount;
+    };
+
+    static constexpr uint32_t ROOT_SLOT = UINT32_MAX;
+
+public:
+
+    using splitter_type = EvenSplitter;
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief
+     *  Constructs an AffinityPartitioner object with an empty record.
+     * @param leavesPerWorker
+     *  The number of sub-ranges to create per Worker. More sub-ranges balance
+     *  irregular workloads better at the cost of more Tasks.
+     */
+    explicit GTS_INLINE AffinityPartitioner(uint16_t leavesPerWorker = 4)
+        : m_pMap(unalignedNew<AffinityMap>())
+        , m_pClaims(nullptr)
+        , m_slot(ROOT_SLOT)
+        , m_leavesPerWorker(leavesPerWorker)
+        , m_workerCount(0)
+        , m_ownsMap(true)
+    {
+        GTS_ASSERT(leavesPerWorker > 0);
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+     * @brief
+     *  Makes a copy that shares the record of 'other'.
+     */
+    GTS_INLINE AffinityPartitioner(AffinityPartitioner const& other)
+        : m_pMap(other.m_pMap)
+        , m_pClaims(other.m_pClaims)
+        , m_slot(other.m_slot)
+        , m_leavesPerWorker(other.m_leavesPerWorker)
+        , m_workerCount(other.m_workerCount)
+        , m_ownsMap(false)
+    {}
+
+    //--------------------------------------------------------------------------
+    template<typename TRange>
+    GTS_INLINE AffinityPartitioner(AffinityPartitioner& other, uint16_t, TRange const&)
+        : AffinityPartitioner(other)
+    {}
+
+    //--------------------------------------------------------------------------
+    GTS_INLINE ~AffinityPartitioner()
+    {
+        if (m_ownsMap)
+        {
+            unalignedDelete(m_pMap);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TPattern, typename TRange>
+    GTS_INLINE Task* execute(TaskContext const& ctx, TPattern* pPattern, TRange& range)
+    {
+        if (m_slot == ROOT_SLOT)
+        {
+            _offerSubRanges(ctx, pPattern, range);
+            return nullptr;
+        }
+
+        if (m_pClaims)
+        {
+            // Only the first copy of the sub-range to execute runs it.
+            ClaimBlock* pClaims = m_pClaims;
+            bool claimed = pClaims->pClaims[m_slot].exchange(1, memory_order::acq_rel) == 0;
+            Task* pContinuation = pClaims->pContinuation;
+            _releaseClaims(pClaims);
+
+            if (!claimed)
+            {
+                return nullptr;
+            }
+            pContinuation->addChildTaskWithoutRef(pPattern);
+        }
+
+        m_pMap->pSlots[m_slot].workerIdx.store(_workerIdx(ctx), memory_order::relaxed);
+        return doExecute(ctx, pPattern, range, splitter_type());
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TPattern, typename TRange>
+    GTS_INLINE void initialOffer(TaskContext const& ctx, TPattern* pPattern, TRange& range, splitter_type const& splitter)
+    {
+        pPattern->offerRange(ctx, range, splitter);
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TPattern, typename TRange>
+    GTS_INLINE Task* doExecute(TaskContext const& ctx, TPattern* pPattern, TRange& range, splitter_type const& splitter)
+    {
+        pPattern->run(ctx, range, splitter);
+        return nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TRange>
+    GTS_INLINE void adjustIfStolen(Task*) {}
+
+    //--------------------------------------------------------------------------
+    template<typename TRange>
+    GTS_INLINE void initialize(uint16_t workerCount)
+    {
+        GTS_ASSERT(workerCount > 0);
+        m_workerCount = workerCount;
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TRange>
+    static GTS_INLINE void split() {}
+
+    //--------------------------------------------------------------------------
+    template<typename TRange>
+    static GTS_INLINE uint16_t getSplit(AffinityPartitioner&) { return 0; }
+
+    //--------------------------------------------------------------------------
+    GTS_INLINE bool isDivisible() { return false; }
+
+private:
+
+    AffinityPartitioner& operator=(AffinityPartitioner const&) = delete;
+
+    //--------------------------------------------------------------------------
+    GTS_INLINE AffinityPartitioner(AffinityPartitioner const& root, uint32_t slot)
+        : AffinityPartitioner(root)
+    {
+        m_slot = slot;
+    }
+
+    //--------------------------------------------------------------------------
+    static GTS_INLINE void _releaseClaims(ClaimBlock* pClaims)
+    {
+        if (pClaims->refCount.fetch_sub(1, memory_order::acq_rel) == 1)
+        {
+            unalignedDelete(pClaims);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    GTS_INLINE uint32_t _workerIdx(TaskContext const& ctx) const
+    {
+        uint32_t workerIdx = ctx.workerId.localId();
+        return workerIdx < m_workerCount ? workerIdx : ANY_WORKER;
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TRange>
+    GTS_INLINE uint32_t _slotCount() const
+    {
+        // A whole number of splits of the TRange.
+        uint32_t targetCount = uint32_t(m_workerCount) * m_leavesPerWorker;
+        uint32_t slotCount = 1;
+        while (slotCount < targetCount)
+        {
+            slotCount *= uint32_t(TRange::SPLIT_FACTOR);
+        }
+        return slotCount;
+    }
+
+    //--------------------------------------------------------------------------
+    template<typename TPattern, typename TRange>
+    GTS_NO_INLINE void _offerSubRanges(TaskContext const& ctx, TPattern* pPattern, TRange& range)
+    {
+        GTS_TRACE_SCOPED_ZONE_P0(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::RoyalBlue1, "AFFINITY offerSubRanges");
+
+        uint32_t slotCount = _slotCount<TRange>();
+        if (m_pMap->slotCount != slotCount)
+        {
+            // The Worker count changed, so the record is stale.
+            m_pMap->reset(slotCount);
+        }
+
+        for (uint32_t ii = 0; ii < slotCount; ++ii)
+        {
+            // A recorded Worker may be gone if the Worker count changed
+            // without changing the slot count.
+            uint32_t workerIdx = m_pMap->pSlots[ii].workerIdx.load(memory_order::relaxed);
+            m_pMap->pSlots[ii].offeredIdx = workerIdx < m_workerCount ? workerIdx : ANY_WORKER;
+        }
+
+        uint32_t thisWorkerIdx = _workerIdx(ctx);
+        auto isOthers = [&](uint32_t slot)
+        {
+            uint32_t workerIdx = m_pMap->pSlots[slot].offeredIdx;
+            return workerIdx != ANY_WORKER && workerIdx != thisWorkerIdx;
+        };
+
+        pPattern->beginOffers(ctx);
+
+        // The sub-ranges of other Workers are offered twice. Give the
+        // continuation one reference per pair before any copy can run.
+        uint32_t pairCount = 0;
+        auto countOthers = [&](TRange const&, uint32_t slot)
+        {
+            pairCount += isOthers(slot) ? 1 : 0;
+        };
+        _forEachSubRange(range, slotCount, 0, countOthers);
+
+        ClaimBlock* pClaims = nullptr;
+        if (pairCount > 0)
+        {
+            Task* pContinuation = pPattern->parent();
+            pContinuation->addRef(pairCount);
+            pClaims = unalignedNew<ClaimBlock>(pContinuation, slotCount, pairCount * 2);
+        }
+
+        // Offer the sub-ranges of other Workers first, so that this Worker
+        // pops its own sub-ranges first and thieves steal the others last.
+        auto offerOthers = [&](TRange const& subRange, uint32_t slot)
+        {
+            if (isOthers(slot))
+            {
+                AffinityPartitioner partitioner(*this, slot);
+                partitioner.m_pClaims = pClaims;
+                pPattern->offerUnjoinedRange(ctx, subRange, partitioner, m_pMap->pSlots[slot].offeredIdx);
+                pPattern->offerUnjoinedRange(ctx, subRange, partitioner, ANY_WORKER);
+            }
+        };
+        _forEachSubRange(range, slotCount, 0, offerOthers);
+
+        auto offerMine = [&](TRange const& subRange, uint32_t slot)
+        {
+            if (!isOthers(slot))
+            {
+                AffinityPartitioner partitioner(*this, slot);
+                pPattern->offerRange(ctx, subRange, partitioner, ANY_WORKER);
+            }
+        };
+        _forEachSubRange(range, slotCount, 0, offerMine);
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+     * Splits 'range' the same way on every call and passes each sub-range to
+     * 'func' with its slot index. Each split divides [slot, slot + slotCount)
+     * among its pieces.
+     */
+    template<typename TRange, typename TFunc>
+    static void _forEachSubRange(TRange range, uint32_t slotCount, uint32_t slot, TFunc& func)
+    {
+        if (slotCount < TRange::SPLIT_FACTOR || !range.isDivisible())
+        {
+            func(range, slot);
+            return;
+        }
+
+        typename TRange::split_result splits;
+        range.split(splits, splitter_type());
+
+        uint32_t stride = slotCount / uint32_t(splits.size + 1);
+        _forEachSubRange(range, stride, slot, func);
+        for (uint32_t ii = 0; ii < uint32_t(splits.size); ++ii)
+        {
+            _forEachSubRange(splits.ranges[ii], stride, slot + (ii + 1) * stride, func);
+        }
+    }
+
+    //! The record shared with all copies.
+    AffinityMap* m_pMap;
+
+    //! The claims of this copy's call if its sub-range is offered twice.
+    ClaimBlock* m_pClaims;
+
+    //! The sub-range this copy executes, or ROOT_SLOT if it splits the range.
+    uint32_t m_slot;
+
+    uint16_t m_leavesPerWorker;
+    uint16_t m_workerCount;
+
+    //! True for the user's object, which frees the record.
+    bool m_ownsMap;
+};
@@ -211,6 +211,15 @@ private:
             , m_partitioner(parent.m_partitioner, depth, TRange())
         {}
 
+        //----------------------------------------------------------------------
+        ParallelForTask(ParallelForTask& parent, TRange const& range, TPartitioner const& partitioner)
+            : m_func(parent.m_func)
+            , m_pUserData(parent.m_pUserData)
+            , m_range(range)
+            , m_priority(parent.m_priority)
+            , m_partitioner(partitioner)
+        {}
+
         //----------------------------------------------------------------------
         ParallelForTask(ParallelForTask const&) = default;
 
@@ -272,6 +281,44 @@ private:
             m_partitioner.template split<TRange>();
         }
 
+        //----------------------------------------------------------------------
+        /**
+         * Makes a continuation the parent of this Task and of the ranges
+         * offered afterwards with a partitioner and Worker affinity.
+         */
+        void beginOffers(TaskContext const& ctx)
+        {
+            Task* pContinuation = ctx.pMicroScheduler->allocateTask<EmptyTask>();
+            pContinuation->addRef(1, gts::memory_order::relaxed);
+            setContinuationTask(pContinuation);
+            pContinuation->addChildTaskWithoutRef(this);
+        }
+
+        //----------------------------------------------------------------------
+        /**
+         * Offers 'range' as a sibling executed with 'partitioner'. The sibling
+         * goes to the affinity queue of 'workerIdx' unless it is ANY_WORKER.
+         */
+        void offerRange(TaskContext const& ctx, TRange const& range, TPartitioner const& partitioner, uint32_t workerIdx)
+        {
+            Task* pSibling = ctx.pMicroScheduler->allocateTask<ParallelForTask>(*this, range, partitioner);
+            pSibling->setAffinity(workerIdx);
+            parent()->addChildTaskWithRef(pSibling);
+            ctx.pMicroScheduler->spawnTask(pSibling);
+        }
+
+        //----------------------------------------------------------------------
+        /**
+         * Offers 'range' like offerRange, but the sibling has no parent. Its
+         * partitioner must join it to the continuation, with a reference
+         * already added, before it executes the range.
+         */
+        void offerUnjoinedRange(TaskContext const& ctx, TRange const& range, TPartitioner const& partitioner, uint32_t workerIdx)
+        {
+            Task* pSibling = ctx.pMicroScheduler->allocateTask<ParallelForTask>(*this, range, partitioner);
+            pSibling->setAffinity(workerIdx);
+            ctx.pMicroScheduler->spawnTask(pSibling);
+        }
 
         //----------------------------------------------------------------------
         void run(TaskContext const& ctx, TRange& range, typename TPartitioner::splitter_type const&)
@@ -0,0 +1,507 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "gts/platform/Assert.h"
+#include "gts/platform/Memory.h"
+#include "gts/containers/Vector.h"
+#include "gts/containers/parallel/QueueMPSC.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+
+namespace gts {
+
+/** 
+ * @addtogroup MicroScheduler
+ * @{
+ */
+
+/** 
+ * @addtogroup ParallelPatterns
+ * @{
+ */
+
+/**
+ * @brief
+ *  How tokens pass through a ParallelPipeline stage.
+ */
+enum class PipelineStageMode : uint8_t
+{
+    //! Any number of tokens run the stage at once.
+    PARALLEL,
+
+    //! One token runs the stage at a time, in input order.
+    SERIAL_IN_ORDER,
+
+    //! One token runs the stage at a time, in any order.
+    SERIAL_OUT_OF_ORDER
+};
+
+/**
+ * @brief
+ *  A ParallelPipeline stage. Create with ParallelPipeline::stage.
+ */
+template<typename TFunc>
+struct PipelineStage
+{
+    PipelineStageMode mode;
+    TFunc func;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A construct that maps pipeline behavior to a MicroScheduler.
+ * @details
+ *  Items are read by a serial input stage into tokens and then flow through
+ *  the remaining stages in order. The tokens are supplied by the caller and
+ *  reused for every item, so the token count bounds the items in flight and
+ *  any per-item buffers are allocated once.
+ *
+ *  A token is carried through its stages by one Task, so its data stays in
+ *  that Worker's cache. It only leaves the Task when it must wait for a
+ *  serial stage. The Task that finishes a serial stage hands the stage to the
+ *  next waiting token and spawns a Task for it. SERIAL_IN_ORDER stages park
+ *  waiting tokens by sequence number, and SERIAL_OUT_OF_ORDER stages and the
+ *  input stage queue them in a QueueMPSC.
+ */
+class ParallelPipeline
+{
+public:
+
+    /**
+     * Creates a ParallelPipeline object bound to the specified 'scheduler'.
+     * All pipeline Tasks will be scheduled with the specified 'priority'.
+     */
+    GTS_INLINE ParallelPipeline(MicroScheduler& scheduler, uint32_t priority = 0)
+        : m_microScheduler(scheduler)
+        , m_priority(priority)
+    {}
+
+    /**
+     * @brief
+     *  Creates a stage that runs 'func' on each token. Signature:
+     * @code
+     *  void(*)(TToken& token, TaskContext const&);
+     * @endcode
+     */
+    template<typename TFunc>
+    static GTS_INLINE PipelineStage<TFunc> stage(PipelineStageMode mode, TFunc func)
+    {
+        return PipelineStage<TFunc>{ mode, func };
+    }
+
+    /**
+     * @brief
+     *  Runs the pipeline until 'inputFunc' runs out of items.
+     * @param pTokens
+     *  The tokens that carry items through the pipeline.
+     * @param tokenCount
+     *  The number of tokens, which is the maximum number of items in flight.
+     * @param inputFunc
+     *  Reads the next item into a token. Runs serially. Returns false once
+     *  there are no more items. Signature:
+     * @code
+     *  bool(*)(TToken& token, TaskContext const&);
+     * @endcode
+     * @param stages
+     *  The stages each item runs through after the input stage.
+     */
+    template<typename TToken, typename TInputFunc, typename... TStageFuncs>
+    GTS_INLINE void operator()(
+        TToken* pTokens,
+        uint32_t tokenCount,
+        TInputFunc inputFunc,
+        PipelineStage<TStageFuncs>... stages)
+    {
+        GTS_ASSERT(m_microScheduler.isRunning());
+        GTS_ASSERT(pTokens != nullptr && tokenCount > 0);
+
+        PipelineRun<TToken, TInputFunc, TStageFuncs...> run(
+            m_microScheduler, m_priority, pTokens, tokenCount, inputFunc, stages...);
+        run.execute();
+    }
+
+private:
+
+    ParallelPipeline(ParallelPipeline const&) = delete;
+    ParallelPipeline* operator=(ParallelPipeline const&) = delete;
+
+    MicroScheduler& m_microScheduler;
+    uint32_t m_priority;
+
+private:
+
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    /**
+     * Controls which tokens may enter a stage.
+     */
+    struct GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) StageGate
+    {
+        PipelineStageMode mode = PipelineStageMode::PARALLEL;
+
+        //! SERIAL_IN_ORDER: The next sequence number to run, shifted up a bit.
+        //! The low bit is set while a token runs the stage.
+        Atomic<uint64_t> turn = { 0 };
+
+        //! SERIAL_IN_ORDER: The index plus one of each token waiting for its
+        //! turn, indexed by sequence number modulo the token count.
+        Atomic<uint32_t>* pParkedTokens = nullptr;
+
+        //! SERIAL_OUT_OF_ORDER: The number of tokens queued or running.
+        Atomic<uint32_t> waitingCount = { 0 };
+
+        //! SERIAL_OUT_OF_ORDER: The indices of the queued tokens.
+        QueueMPSC<uint32_t>* pWaitingTokens = nullptr;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    /**
+     * The state of one pipeline execution.
+     */
+    template<typename TToken, typename TInputFunc, typename... TStageFuncs>
+    class PipelineRun
+    {
+    public:
+
+        static_assert(sizeof...(TStageFuncs) > 0, "A pipeline needs at least one stage after the input.");
+
+        //! The input stage is gate 0 and stage N is gate N + 1.
+        enum : uint32_t { GATE_COUNT = sizeof...(TStageFuncs) + 1 };
+
+        enum : uint32_t { NO_TOKEN = UINT32_MAX };
+
+        using stages_type  = std::tuple<PipelineStage<TStageFuncs>...>;
+        using invoker_type = void(*)(stages_type&, TToken&, TaskContext const&);
+
+        //----------------------------------------------------------------------
+        PipelineRun(
+            MicroScheduler& microScheduler,
+            uint32_t priority,
+            TToken* pTokens,
+            uint32_t tokenCount,
+            TInputFunc& inputFunc,
+            PipelineStage<TStageFuncs> const&... stages)
+            : m_microScheduler(microScheduler)
+            , m_inputFunc(inputFunc)
+            , m_stages(stages...)
+            , m_pTokens(pTokens)
+            , m_tokenSeqs(tokenCount, 0)
+            , m_pRoot(nullptr)
+            , m_nextSeq(0)
+            , m_tokenCount(tokenCount)
+            , m_priority(priority)
+        {
+            _initInvokers(std::index_sequence_for<TStageFuncs...>());
+
+            PipelineStageMode modes[GATE_COUNT] = { PipelineStageMode::SERIAL_OUT_OF_ORDER, stages.mode... };
+
+            m_pGates = alignedVectorNew<StageGate, GTS_NO_SHARING_CACHE_LINE_SIZE>(GATE_COUNT);
+            for (uint32_t iGate = 0; iGate < GATE_COUNT; ++iGate)
+            {
+                StageGate& gate = m_pGates[iGate];
+                gate.mode = modes[iGate];
+
+                switch (gate.mode)
+                {
+                case PipelineStageMode::SERIAL_IN_ORDER:
+                    gate.pParkedTokens = alignedVectorNew<Atomic<uint32_t>, GTS_CACHE_LINE_SIZE>(tokenCount);
+                    for (uint32_t ii = 0; ii < tokenCount; ++ii)
+                    {
+                        gate.pParkedTokens[ii].store(0, memory_order::relaxed);
+                    }
+                    break;
+
+                case PipelineStageMode::SERIAL_OUT_OF_ORDER:
+                    gate.pWaitingTokens = alignedNew<QueueMPSC<uint32_t>, GTS_NO_SHARING_CACHE_LINE_SIZE>();
+                    gate.pWaitingTokens->reserve(nextPow2(tokenCount));
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        //----------------------------------------------------------------------
+        ~PipelineRun()
+        {
+            for (uint32_t iGate = 0; iGate < GATE_COUNT; ++iGate)
+            {
+                StageGate& gate = m_pGates[iGate];
+                if (gate.pParkedTokens)
+                {
+                    alignedVectorDelete(gate.pParkedTokens, m_tokenCount);
+                }
+                alignedDelete(gate.pWaitingTokens);
+            }
+            alignedVectorDelete(m_pGates, GATE_COUNT);
+        }
+
+        //----------------------------------------------------------------------
+        void execute()
+        {
+            m_pRoot = m_microScheduler.allocateTask<EmptyTask>();
+            m_pRoot->addRef(1, memory_order::relaxed);
+
+            // Queue every token for the input stage. The first one runs it.
+            uint32_t firstTokenIdx = _enterOutOfOrder(m_pGates[0], 0);
+            for (uint32_t iToken = 1; iToken < m_tokenCount; ++iToken)
+            {
+                _enterOutOfOrder(m_pGates[0], iToken);
+            }
+
+            Task* pTask = m_microScheduler.allocateTask<TokenTask>(this, firstTokenIdx, 0u);
+            m_pRoot->addChildTaskWithRef(pTask);
+            m_microScheduler.spawnTask(pTask, m_priority);
+
+            m_pRoot->waitForAll();
+            m_microScheduler.destoryTask(m_pRoot);
+        }
+
+        //----------------------------------------------------------------------
+        // Carries 'tokenIdx' through the pipeline, starting with the gate it
+        // was handed. Returns once the token has to wait or the input runs out.
+        Task* runToken(TaskContext const& ctx, uint32_t tokenIdx, uint32_t gateIdx)
+        {
+            bool ownsGate = true;
+            for (;;)
+            {
+                StageGate& gate = m_pGates[gateIdx];
+
+                if (!ownsGate)
+                {
+                    if (gate.mode == PipelineStageMode::SERIAL_IN_ORDER)
+                    {
+                        if (!_enterInOrder(gate, tokenIdx))
+                        {
+                            return nullptr;
+                        }
+                    }
+                    else if (gate.mode == PipelineStageMode::SERIAL_OUT_OF_ORDER)
+                    {
+                        // The queue may hand us an earlier token to carry.
+                        tokenIdx = _enterOutOfOrder(gate, tokenIdx);
+                        if (tokenIdx == NO_TOKEN)
+                        {
+                            return nullptr;
+                        }
+                    }
+                }
+                ownsGate = false;
+
+                TToken& token = m_pTokens[tokenIdx];
+
+                uint64_t seq;
+                if (gateIdx == 0)
+                {
+                    if (!m_inputFunc(token, ctx))
+                    {
+                        // Leave the input gate closed so that the remaining
+                        // tokens retire as they arrive.
+                        return nullptr;
+                    }
+                    seq = m_nextSeq++;
+                    m_tokenSeqs[tokenIdx] = seq;
+                }
+                else
+                {
+                    seq = m_tokenSeqs[tokenIdx];
+                    m_invokers[gateIdx - 1](m_stages, token, ctx);
+                }
+
+                // Hand a serial stage to the next token that waits for it.
+                uint32_t nextTokenIdx = NO_TOKEN;
+                if (gate.mode == PipelineStageMode::SERIAL_IN_ORDER)
+                {
+                    nextTokenIdx = _leaveInOrder(gate, seq);
+                }
+                else if (gate.mode == PipelineStageMode::SERIAL_OUT_OF_ORDER)
+                {
+                    nextTokenIdx = _leaveOutOfOrder(gate);
+                }
+
+                if (nextTokenIdx != NO_TOKEN)
+                {
+                    Task* pTask = ctx.pMicroScheduler->allocateTask<TokenTask>(this, nextTokenIdx, gateIdx);
+                    m_pRoot->addChildTaskWithRef(pTask);
+                    ctx.pMicroScheduler->spawnTask(pTask, m_priority);
+                }
+
+                // Finished tokens go back to the input stage.
+                gateIdx = gateIdx + 1 == GATE_COUNT ? 0 : gateIdx + 1;
+            }
+        }
+
+    private:
+
+        ////////////////////////////////////////////////////////////////////////
+        ////////////////////////////////////////////////////////////////////////
+        class TokenTask : public Task
+        {
+        public:
+
+            //------------------------------------------------------------------
+            GTS_INLINE TokenTask(PipelineRun* pRun, uint32_t tokenIdx, uint32_t gateIdx)
+                : m_pRun(pRun)
+                , m_tokenIdx(tokenIdx)
+                , m_gateIdx(gateIdx)
+            {}
+
+            //------------------------------------------------------------------
+            virtual Task* execute(TaskContext const& ctx) final
+            {
+                return m_pRun->runToken(ctx, m_tokenIdx, m_gateIdx);
+            }
+
+        private:
+
+            PipelineRun* m_pRun;
+            uint32_t m_tokenIdx;
+            uint32_t m_gateIdx;
+        };
+
+        //----------------------------------------------------------------------
+        template<size_t IDX>
+        static void _invokeStage(stages_type& stages, TToken& token, TaskContext const& ctx)
+        {
+            std::get<IDX>(stages).func(token, ctx);
+        }
+
+        //----------------------------------------------------------------------
+        template<size_t... IDXS>
+        GTS_INLINE void _initInvokers(std::index_sequence<IDXS...>)
+        {
+            invoker_type invokers[] = { &_invokeStage<IDXS>... };
+            for (uint32_t ii = 0; ii < GATE_COUNT - 1; ++ii)
+            {
+                m_invokers[ii] = invokers[ii];
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // Parks the token until its turn. Returns true if it is its turn.
+        GTS_INLINE bool _enterInOrder(StageGate& gate, uint32_t tokenIdx)
+        {
+            uint64_t seq = m_tokenSeqs[tokenIdx];
+
+            // Each parked token has a unique slot because there are only
+            // m_tokenCount sequence numbers in flight past the stage's turn.
+            Atomic<uint32_t>& slot = gate.pParkedTokens[seq % m_tokenCount];
+            slot.store(tokenIdx + 1, memory_order::seq_cst);
+
+            uint64_t turn = seq << 1;
+            if (gate.turn.compare_exchange_strong(turn, turn | 1, memory_order::seq_cst, memory_order::seq_cst))
+            {
+                slot.store(0, memory_order::relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        //----------------------------------------------------------------------
+        // Passes the turn on. Returns the next token if it already waits.
+        GTS_INLINE uint32_t _leaveInOrder(StageGate& gate, uint64_t seq)
+        {
+            uint64_t nextSeq = seq + 1;
+            gate.turn.store(nextSeq << 1, memory_order::seq_cst);
+
+            // Race the next token's own attempt to take its turn.
+            Atomic<uint32_t>& slot = gate.pParkedTokens[nextSeq % m_tokenCount];
+            uint32_t parked = slot.load(memory_order::seq_cst);
+            if (parked == 0)
+            {
+                return NO_TOKEN;
+            }
+
+            uint64_t turn = nextSeq << 1;
+            if (!gate.turn.compare_exchange_strong(turn, turn | 1, memory_order::seq_cst, memory_order::seq_cst))
+            {
+                return NO_TOKEN;
+            }
+            slot.store(0, memory_order::relaxed);
+            return parked - 1;
+        }
+
+        //----------------------------------------------------------------------
+        // Queues the token. Returns a queued token to run if the stage was
+        // idle.
+        GTS_INLINE uint32_t _enterOutOfOrder(StageGate& gate, uint32_t tokenIdx)
+        {
+            bool pushed = gate.pWaitingTokens->tryPush(tokenIdx);
+            GTS_ASSERT(pushed);
+            GTS_UNREFERENCED_PARAM(pushed);
+
+            if (gate.waitingCount.fetch_add(1, memory_order::acq_rel) != 0)
+            {
+                return NO_TOKEN;
+            }
+            return _popWaiting(gate);
+        }
+
+        //----------------------------------------------------------------------
+        // Returns the next queued token to run, if any.
+        GTS_INLINE uint32_t _leaveOutOfOrder(StageGate& gate)
+        {
+            if (gate.waitingCount.fetch_sub(1, memory_order::acq_rel) == 1)
+            {
+                return NO_TOKEN;
+            }
+            return _popWaiting(gate);
+        }
+
+        //----------------------------------------------------------------------
+        GTS_INLINE uint32_t _popWaiting(StageGate& gate)
+        {
+            // Counted tokens have been pushed, but a push that started earlier
+            // may still be in progress ahead of them.
+            uint32_t tokenIdx;
+            while (!gate.pWaitingTokens->tryPop(tokenIdx))
+            {
+                GTS_PAUSE();
+            }
+            return tokenIdx;
+        }
+
+        MicroScheduler& m_microScheduler;
+        TInputFunc& m_inputFunc;
+        stages_type m_stages;
+        invoker_type m_invokers[GATE_COUNT - 1];
+        TToken* m_pTokens;
+        Vector<uint64_t> m_tokenSeqs;
+        StageGate* m_pGates;
+        Task* m_pRoot;
+        uint64_t m_nextSeq;
+        uint32_t m_tokenCount;
+        uint32_t m_priority;
+    };
+};
+
+/** @} */ // end of ParallelPatterns
+/** @} */ // end of MicroScheduler
+
+} // namespace gts
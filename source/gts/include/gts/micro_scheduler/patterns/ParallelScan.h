@@ -0,0 +1,343 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include "gts/platform/Assert.h"
+#include "gts/containers/Vector.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/patterns/Partitioners.h"
+#include "gts/micro_scheduler/patterns/Range1d.h"
+#include "gts/micro_scheduler/patterns/ParallelFor.h"
+
+namespace gts {
+
+/** 
+ * @addtogroup MicroScheduler
+ * @{
+ */
+
+/** 
+ * @addtogroup ParallelPatterns
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A construct that maps parallel-prefix-scan behavior to a MicroScheduler.
+ * @details
+ *  A two-pass, work-efficient scan. The range is cut into a few blocks per
+ *  Worker. The first pass reduces each block, the block totals are scanned
+ *  serially, and the second pass scans each block from its prefix. The first
+ *  block needs no prefix, so it is scanned in the first pass, which keeps
+ *  the total work under 2n.
+ */
+class ParallelScan
+{
+public:
+
+    //! The number of blocks per Worker. More blocks balance better but
+    //! lengthen the serial scan of the block totals.
+    enum { BLOCKS_PER_WORKER = 4 };
+
+    //! The smallest block used by the convenience functions.
+    enum { DEFAULT_MIN_BLOCK_SIZE = 2048 };
+
+    /**
+     * Creates a ParallelScan object bound to the specified 'scheduler'. All
+     * parallel-scan operations will be scheduled with the specified 'priority'.
+     */
+    GTS_INLINE ParallelScan(MicroScheduler& scheduler, uint32_t priority = 0)
+        : m_microScheduler(scheduler)
+        , m_priority(priority)
+    {}
+
+    /**
+     * @brief
+     *  Scans 'range' with 'scanFunc'.
+     * @param range
+     *  The range to scan. Blocks are no smaller than range.minSize() and are
+     *  multiples of range.splitOnMultiplesOf().
+     * @param scanFunc
+     *  Scans a block starting from 'prefix', the combined value of everything
+     *  before the block. If 'isFinalPass' is false, it only has to return the
+     *  block's combined value. If it is true, it also writes the scan results.
+     *  Requires the signature:
+     * @code
+     *  TValue(*)(TRange& range, TValue const& prefix, bool isFinalPass, void* pUserData, TaskContext const&);
+     * @endcode
+     * @param joinFunc
+     *  Combines the values of two adjacent blocks. Must be associative.
+     *  Requires the signature:
+     * @code
+     *  TValue(*)(TValue const& lhs, TValue const& rhs, void* pUserData, TaskContext const&);
+     * @endcode
+     * @param identityValue
+     *  An identity value for the join function.
+     * @param partitioner
+     *  The partitioner object that determines when the blocks are subdivided
+     *  during scheduling.
+     * @param pUserData
+     *  Optional data to be used in the passed in functions.
+     * @return
+     *  The combined value of the whole range.
+     */
+    template<
+        typename TIter,
+        typename TValue,
+        typename TScanFunc,
+        typename TJoinFunc,
+        typename TPartitioner = AdaptivePartitioner
+    >
+    GTS_INLINE TValue operator()(
+        Range1d<TIter> const& range,
+        TScanFunc scanFunc,
+        TJoinFunc joinFunc,
+        TValue identityValue,
+        TPartitioner partitioner = AdaptivePartitioner(),
+        void* pUserData = nullptr)
+    {
+        GTS_ASSERT(m_microScheduler.isRunning());
+
+        using range_type = Range1d<TIter>;
+
+        if (range.empty())
+        {
+            return identityValue;
+        }
+
+        //
+        // Cut the range into blocks.
+
+        size_t size         = range.size();
+        size_t maxBlocks    = gtsMax(size_t(1), size_t(m_microScheduler.workerCount()) * BLOCKS_PER_WORKER);
+        size_t blockSize    = gtsMax(range.minSize(), (size + maxBlocks - 1) / maxBlocks);
+        blockSize           = alignUpTo(blockSize, range.splitOnMultiplesOf());
+        uint32_t blockCount = uint32_t((size + blockSize - 1) / blockSize);
+
+        auto makeBlock = [&](uint32_t iBlock)
+        {
+            TIter begin = range.begin() + iBlock * blockSize;
+            TIter end   = iBlock + 1 == blockCount ? range.end() : begin + blockSize;
+            return range_type(begin, end, range.minSize(), range.splitOnMultiplesOf());
+        };
+
+        //
+        // Pass 1: Scan the first block and reduce the rest, but the last.
+
+        Vector<TValue> blockValues(blockCount, identityValue);
+
+        ParallelFor parFor(m_microScheduler, m_priority);
+        parFor(
+            Range1d<uint32_t>(0, gtsMax(1u, blockCount - 1), 1),
+            [&](Range1d<uint32_t>& blocks, void*, TaskContext const& ctx)
+            {
+                for (uint32_t iBlock = blocks.begin(); iBlock != blocks.end(); ++iBlock)
+                {
+                    range_type block = makeBlock(iBlock);
+                    blockValues[iBlock] = scanFunc(block, identityValue, iBlock == 0, pUserData, ctx);
+                }
+            },
+            partitioner,
+            nullptr);
+
+        if (blockCount == 1)
+        {
+            return blockValues[0];
+        }
+
+        //
+        // Turn the block values into the prefixes of the blocks.
+
+        TaskContext ctx;
+        ctx.pMicroScheduler = &m_microScheduler;
+        ctx.workerId        = m_microScheduler.thisWorkerId();
+
+        TValue prefix = identityValue;
+        for (uint32_t iBlock = 0; iBlock < blockCount - 1; ++iBlock)
+        {
+            TValue blockValue   = blockValues[iBlock];
+            blockValues[iBlock] = prefix;
+            prefix              = joinFunc(prefix, blockValue, pUserData, ctx);
+        }
+        blockValues[blockCount - 1] = prefix;
+
+        //
+        // Pass 2: Scan the remaining blocks from their prefixes.
+
+        parFor(
+            Range1d<uint32_t>(1, blockCount, 1),
+            [&](Range1d<uint32_t>& blocks, void*, TaskContext const& ctx)
+            {
+                for (uint32_t iBlock = blocks.begin(); iBlock != blocks.end(); ++iBlock)
+                {
+                    range_type block = makeBlock(iBlock);
+                    TValue blockTotal = scanFunc(block, blockValues[iBlock], true, pUserData, ctx);
+                    if (iBlock + 1 == blockCount)
+                    {
+                        prefix = blockTotal;
+                    }
+                }
+            },
+            partitioner,
+            nullptr);
+
+        return prefix;
+    }
+
+// 1D CONVENIENCE FUNCTIONS:
+
+    /**
+     * @brief
+     *  Writes the inclusive scan of [begin, end) to 'out', that is
+     *  out[i] = join(in[0], ..., in[i]).
+     * @param joinFunc
+     *  An associative function. Signature:
+     * @code
+     *  TValue(*)(TValue const& lhs, TValue const& rhs);
+     * @endcode
+     * @return
+     *  The combined value of the whole range.
+     */
+    template<
+        typename TInIter,
+        typename TOutIter,
+        typename TValue,
+        typename TJoinFunc,
+        typename TPartitioner = AdaptivePartitioner
+    >
+    GTS_INLINE TValue inclusive(
+        TInIter begin,
+        TInIter end,
+        TOutIter out,
+        TValue identityValue,
+        TJoinFunc joinFunc,
+        TPartitioner partitioner = TPartitioner())
+    {
+        return _scan1d<true>(begin, end, out, identityValue, joinFunc, partitioner);
+    }
+
+    /**
+     * @brief
+     *  Writes the exclusive scan of [begin, end) to 'out', that is
+     *  out[0] = identityValue and out[i] = join(in[0], ..., in[i - 1]).
+     * @param joinFunc
+     *  An associative function. Signature:
+     * @code
+     *  TValue(*)(TValue const& lhs, TValue const& rhs);
+     * @endcode
+     * @return
+     *  The combined value of the whole range.
+     */
+    template<
+        typename TInIter,
+        typename TOutIter,
+        typename TValue,
+        typename TJoinFunc,
+        typename TPartitioner = AdaptivePartitioner
+    >
+    GTS_INLINE TValue exclusive(
+        TInIter begin,
+        TInIter end,
+        TOutIter out,
+        TValue identityValue,
+        TJoinFunc joinFunc,
+        TPartitioner partitioner = TPartitioner())
+    {
+        return _scan1d<false>(begin, end, out, identityValue, joinFunc, partitioner);
+    }
+
+private:
+
+    ParallelScan(ParallelScan const&) = delete;
+    ParallelScan* operator=(ParallelScan const&) = delete;
+
+    //--------------------------------------------------------------------------
+    template<
+        bool IS_INCLUSIVE,
+        typename TInIter,
+        typename TOutIter,
+        typename TValue,
+        typename TJoinFunc,
+        typename TPartitioner
+    >
+    GTS_INLINE TValue _scan1d(
+        TInIter begin,
+        TInIter end,
+        TOutIter out,
+        TValue identityValue,
+        TJoinFunc& joinFunc,
+        TPartitioner& partitioner)
+    {
+        if (begin == end)
+        {
+            return identityValue;
+        }
+
+        return this->operator()(
+            Range1d<TInIter>(begin, end, DEFAULT_MIN_BLOCK_SIZE),
+            [&](Range1d<TInIter>& range, TValue const& prefix, bool isFinalPass, void*, TaskContext const&)
+            {
+                TValue sum = prefix;
+                if (!isFinalPass)
+                {
+                    for (TInIter ii = range.begin(); ii != range.end(); ++ii)
+                    {
+                        sum = joinFunc(sum, *ii);
+                    }
+                    return sum;
+                }
+
+                TOutIter iOut = out + (range.begin() - begin);
+                for (TInIter ii = range.begin(); ii != range.end(); ++ii, ++iOut)
+                {
+                    if (IS_INCLUSIVE)
+                    {
+                        sum   = joinFunc(sum, *ii);
+                        *iOut = sum;
+                    }
+                    else
+                    {
+                        TValue value = *ii;
+                        *iOut = sum;
+                        sum   = joinFunc(sum, value);
+                    }
+                }
+                return sum;
+            },
+            [&](TValue const& lhs, TValue const& rhs, void*, TaskContext const&)
+            {
+                return joinFunc(lhs, rhs);
+            },
+            identityValue,
+            partitioner);
+    }
+
+    MicroScheduler& m_microScheduler;
+    uint32_t m_priority;
+};
+
+/** @} */ // end of ParallelPatterns
+/** @} */ // end of MicroScheduler
+
+} // namespace gts
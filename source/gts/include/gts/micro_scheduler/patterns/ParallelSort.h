@@ -0,0 +1,564 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+#include "gts/platform/Assert.h"
+#include "gts/containers/Vector.h"
+#include "gts/containers/AlignedAllocator.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/patterns/Partitioners.h"
+#include "gts/micro_scheduler/patterns/Range1d.h"
+#include "gts/micro_scheduler/patterns/ParallelFor.h"
+#include "gts/micro_scheduler/patterns/ParallelReduce.h"
+
+namespace gts {
+
+/** 
+ * @addtogroup MicroScheduler
+ * @{
+ */
+
+/** 
+ * @addtogroup ParallelPatterns
+ * @{
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A construct that maps parallel-sort behavior to a MicroScheduler.
+ * @details
+ *  Comparison sorts use a parallel merge sort: the halves are sorted as
+ *  forked Tasks and then merged by recursively splitting the merge. Sorts on
+ *  integral keys can use an LSD radix sort instead, which reads and writes
+ *  each element once per significant key byte. Both ping-pong between the
+ *  input and a scratch buffer of the same size.
+ */
+class ParallelSort
+{
+public:
+
+    //! The number of blocks per Worker.
+    enum { BLOCKS_PER_WORKER = 4 };
+
+    //! The smallest block that is sorted, merged or bucketed serially.
+    enum { DEFAULT_MIN_BLOCK_SIZE = 2048 };
+
+    //! The bits in each radix digit.
+    enum { RADIX_BITS = 8 };
+
+    //! The number of buckets in a radix pass.
+    enum { RADIX = 1 << RADIX_BITS };
+
+    /**
+     * Creates a ParallelSort object bound to the specified 'scheduler'. All
+     * parallel-sort operations will be scheduled with the specified 'priority'.
+     */
+    GTS_INLINE ParallelSort(MicroScheduler& scheduler, uint32_t priority = 0)
+        : m_microScheduler(scheduler)
+        , m_priority(priority)
+    {}
+
+    /**
+     * @brief
+     *  Sorts [begin, end) with 'compare' using a parallel merge sort.
+     * @details
+     *  The sort is not stable.
+     * @param compare
+     *  A strict weak ordering. Signature:
+     * @code
+     *  bool(*)(TValue const& lhs, TValue const& rhs);
+     * @endcode
+     * @param minBlockSize
+     *  The size below which ranges are sorted and merged serially.
+     * @remark
+     *  The values must be default constructible and move assignable.
+     */
+    template<typename TIter, typename TCompare>
+    GTS_INLINE void operator()(
+        TIter begin,
+        TIter end,
+        TCompare compare,
+        size_t minBlockSize = DEFAULT_MIN_BLOCK_SIZE)
+    {
+        GTS_ASSERT(m_microScheduler.isRunning());
+
+        using value_type = typename std::iterator_traits<TIter>::value_type;
+        using buffer_iter_type = value_type*;
+
+        size_t size      = size_t(end - begin);
+        size_t blockSize = _blockSize(size, gtsMax(size_t(2), minBlockSize));
+        if (size <= blockSize)
+        {
+            std::sort(begin, end, compare);
+            return;
+        }
+
+        scratch_type<value_type> scratch(size);
+
+        Task* pTask = m_microScheduler.allocateTask<MergeSortTask<TIter, buffer_iter_type, TCompare>>(
+            begin, end, scratch.data(), true, compare, blockSize);
+
+        m_microScheduler.spawnTaskAndWait(pTask, m_priority);
+    }
+
+    /**
+     * @brief
+     *  Sorts [begin, end) in ascending order using a parallel merge sort.
+     */
+    template<typename TIter>
+    GTS_INLINE void operator()(TIter begin, TIter end)
+    {
+        using value_type = typename std::iterator_traits<TIter>::value_type;
+        this->operator()(begin, end, std::less<value_type>());
+    }
+
+    /**
+     * @brief
+     *  Stable sorts [begin, end) in ascending order of the integral keys
+     *  returned by 'keyFunc', using a parallel LSD radix sort.
+     * @details
+     *  Key bytes that are the same for every value are skipped, so small keys
+     *  in wide types only pay for the bytes they use.
+     * @param keyFunc
+     *  Returns the sort key of a value. Signature:
+     * @code
+     *  TKey(*)(TValue const& value);
+     * @endcode
+     * @param minBlockSize
+     *  The smallest block of values bucketed by a single Task.
+     * @remark
+     *  The values must be default constructible and move assignable.
+     */
+    template<typename TIter, typename TKeyFunc>
+    GTS_INLINE void radix(
+        TIter begin,
+        TIter end,
+        TKeyFunc keyFunc,
+        size_t minBlockSize = DEFAULT_MIN_BLOCK_SIZE)
+    {
+        GTS_ASSERT(m_microScheduler.isRunning());
+
+        using value_type = typename std::iterator_traits<TIter>::value_type;
+        using key_type   = std::decay_t<decltype(keyFunc(*begin))>;
+        using radix_type = std::make_unsigned_t<key_type>;
+
+        static_assert(std::is_integral<key_type>::value && !std::is_same<key_type, bool>::value,
+            "Radix keys must be integers.");
+
+        size_t size = size_t(end - begin);
+        if (size < 2)
+        {
+            return;
+        }
+
+        auto radixKey = [&keyFunc](value_type const& value)
+        {
+            return _toRadixKey(keyFunc(value));
+        };
+
+        //
+        // Find the key bits that differ between the values.
+
+        radix_type firstKey = radixKey(*begin);
+
+        ParallelReduce parReduce(m_microScheduler, m_priority);
+        radix_type diffBits = parReduce(
+            Range1d<size_t>(0, size, gtsMax(size_t(1), minBlockSize)),
+            [&](Range1d<size_t>& range, void*, TaskContext const&)
+            {
+                radix_type bits = 0;
+                for (size_t ii = range.begin(); ii != range.end(); ++ii)
+                {
+                    bits |= radixKey(begin[ii]) ^ firstKey;
+                }
+                return bits;
+            },
+            [](radix_type const& lhs, radix_type const& rhs, void*, TaskContext const&)
+            {
+                return radix_type(lhs | rhs);
+            },
+            radix_type(0));
+
+        if (diffBits == 0)
+        {
+            return;
+        }
+
+        //
+        // Bucket by each differing digit, alternating between the input and
+        // the scratch buffer.
+
+        size_t blockSize    = _blockSize(size, gtsMax(size_t(1), minBlockSize));
+        uint32_t blockCount = uint32_t((size + blockSize - 1) / blockSize);
+
+        scratch_type<value_type> scratch(size);
+        Vector<size_t> offsets(blockCount * RADIX);
+
+        bool isInScratch = false;
+        for (uint32_t shift = 0; shift < sizeof(radix_type) * 8; shift += RADIX_BITS)
+        {
+            if (((diffBits >> shift) & (RADIX - 1)) == 0)
+            {
+                continue;
+            }
+
+            auto digit = [&radixKey, shift](value_type const& value)
+            {
+                return uint32_t((radixKey(value) >> shift) & (RADIX - 1));
+            };
+
+            if (isInScratch)
+            {
+                _radixPass(scratch.data(), begin, size, blockSize, blockCount, offsets, digit);
+            }
+            else
+            {
+                _radixPass(begin, scratch.data(), size, blockSize, blockCount, offsets, digit);
+            }
+            isInScratch = !isInScratch;
+        }
+
+        if (isInScratch)
+        {
+            ParallelFor parFor(m_microScheduler, m_priority);
+            parFor(
+                Range1d<size_t>(0, size, blockSize),
+                [&](Range1d<size_t>& range, void*, TaskContext const&)
+                {
+                    std::move(scratch.data() + range.begin(), scratch.data() + range.end(), begin + range.begin());
+                },
+                AdaptivePartitioner(),
+                nullptr);
+        }
+    }
+
+    /**
+     * @brief
+     *  Stable sorts the integers in [begin, end) in ascending order using a
+     *  parallel LSD radix sort.
+     */
+    template<typename TIter>
+    GTS_INLINE void radix(TIter begin, TIter end)
+    {
+        using value_type = typename std::iterator_traits<TIter>::value_type;
+        radix(begin, end, [](value_type const& value) { return value; });
+    }
+
+private:
+
+    ParallelSort(ParallelSort const&) = delete;
+    ParallelSort* operator=(ParallelSort const&) = delete;
+
+    template<typename T>
+    using scratch_type = Vector<T, AlignedAllocator<GTS_NO_SHARING_CACHE_LINE_SIZE>>;
+
+    //--------------------------------------------------------------------------
+    GTS_INLINE size_t _blockSize(size_t size, size_t minBlockSize) const
+    {
+        size_t maxBlocks = gtsMax(size_t(1), size_t(m_microScheduler.workerCount()) * BLOCKS_PER_WORKER);
+        return gtsMax(minBlockSize, (size + maxBlocks - 1) / maxBlocks);
+    }
+
+    //--------------------------------------------------------------------------
+    // Maps a key to an unsigned key with the same order.
+    template<typename TKey>
+    GTS_INLINE static std::make_unsigned_t<TKey> _toRadixKey(TKey key)
+    {
+        using radix_type = std::make_unsigned_t<TKey>;
+        radix_type radixKey = radix_type(key);
+        if (std::is_signed<TKey>::value)
+        {
+            // Flip the sign bit so negatives come first.
+            radixKey ^= radix_type(radix_type(1) << (sizeof(radix_type) * 8 - 1));
+        }
+        return radixKey;
+    }
+
+    //--------------------------------------------------------------------------
+    // Stable scatters [src, src + size) into dst by 'digit'.
+    template<typename TSrcIter, typename TDstIter, typename TDigitFunc>
+    GTS_INLINE void _radixPass(
+        TSrcIter src,
+        TDstIter dst,
+        size_t size,
+        size_t blockSize,
+        uint32_t blockCount,
+        Vector<size_t>& offsets,
+        TDigitFunc& digit)
+    {
+        ParallelFor parFor(m_microScheduler, m_priority);
+
+        //
+        // Histogram each block.
+
+        parFor(
+            Range1d<uint32_t>(0, blockCount, 1),
+            [&](Range1d<uint32_t>& blocks, void*, TaskContext const&)
+            {
+                for (uint32_t iBlock = blocks.begin(); iBlock != blocks.end(); ++iBlock)
+                {
+                    size_t* pCounts = offsets.data() + iBlock * RADIX;
+                    std::fill(pCounts, pCounts + RADIX, size_t(0));
+
+                    size_t blockEnd = gtsMin(size, (iBlock + 1) * blockSize);
+                    for (size_t ii = iBlock * blockSize; ii < blockEnd; ++ii)
+                    {
+                        ++pCounts[digit(src[ii])];
+                    }
+                }
+            },
+            AdaptivePartitioner(),
+            nullptr);
+
+        //
+        // Turn the counts into each block's write offset per bucket. Buckets
+        // are major so that earlier blocks write first, which keeps the pass
+        // stable.
+
+        size_t offset = 0;
+        for (uint32_t iDigit = 0; iDigit < RADIX; ++iDigit)
+        {
+            for (uint32_t iBlock = 0; iBlock < blockCount; ++iBlock)
+            {
+                size_t& count = offsets[iBlock * RADIX + iDigit];
+                size_t blockCountOfDigit = count;
+                count   = offset;
+                offset += blockCountOfDigit;
+            }
+        }
+        GTS_ASSERT(offset == size);
+
+        //
+        // Scatter each block.
+
+        parFor(
+            Range1d<uint32_t>(0, blockCount, 1),
+            [&](Range1d<uint32_t>& blocks, void*, TaskContext const&)
+            {
+                for (uint32_t iBlock = blocks.begin(); iBlock != blocks.end(); ++iBlock)
+                {
+                    size_t* pOffsets = offsets.data() + iBlock * RADIX;
+
+                    size_t blockEnd = gtsMin(size, (iBlock + 1) * blockSize);
+                    for (size_t ii = iBlock * blockSize; ii < blockEnd; ++ii)
+                    {
+                        dst[pOffsets[digit(src[ii])]++] = std::move(src[ii]);
+                    }
+                }
+            },
+            AdaptivePartitioner(),
+            nullptr);
+    }
+
+private:
+
+    MicroScheduler& m_microScheduler;
+    uint32_t m_priority;
+
+private:
+
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    /**
+     * Merges the sorted ranges [first1, last1) and [first2, last2) into 'out'.
+     * Large merges split the larger range at its middle, find the matching
+     * split of the other range, and merge both halves in parallel.
+     */
+    template<typename TInIter, typename TOutIter, typename TCompare>
+    class MergeTask : public Task
+    {
+    public:
+
+        //----------------------------------------------------------------------
+        GTS_INLINE MergeTask(
+            TInIter first1,
+            TInIter last1,
+            TInIter first2,
+            TInIter last2,
+            TOutIter out,
+            TCompare& compare,
+            size_t blockSize)
+            : m_first1(first1)
+            , m_last1(last1)
+            , m_first2(first2)
+            , m_last2(last2)
+            , m_out(out)
+            , m_compare(compare)
+            , m_blockSize(blockSize)
+        {}
+
+        //----------------------------------------------------------------------
+        virtual Task* execute(TaskContext const& ctx) final
+        {
+            size_t size1 = size_t(m_last1 - m_first1);
+            size_t size2 = size_t(m_last2 - m_first2);
+
+            if (size1 + size2 <= m_blockSize)
+            {
+                std::merge(
+                    std::make_move_iterator(m_first1), std::make_move_iterator(m_last1),
+                    std::make_move_iterator(m_first2), std::make_move_iterator(m_last2),
+                    m_out, m_compare);
+                return nullptr;
+            }
+
+            // Equal values of the first range stay ahead of the second's.
+            TInIter mid1, mid2;
+            if (size1 >= size2)
+            {
+                mid1 = m_first1 + size1 / 2;
+                mid2 = std::lower_bound(m_first2, m_last2, *mid1, m_compare);
+            }
+            else
+            {
+                mid2 = m_first2 + size2 / 2;
+                mid1 = std::upper_bound(m_first1, m_last1, *mid2, m_compare);
+            }
+
+            Task* pContinuation = ctx.pMicroScheduler->allocateTask<EmptyTask>();
+            setContinuationTask(pContinuation);
+            pContinuation->addRef(2, memory_order::relaxed);
+
+            Task* pLeftChild = ctx.pMicroScheduler->allocateTask<MergeTask>(
+                m_first1, mid1, m_first2, mid2, m_out, m_compare, m_blockSize);
+            pContinuation->addChildTaskWithoutRef(pLeftChild);
+            ctx.pMicroScheduler->spawnTask(pLeftChild);
+
+            // Merges are the continuations of sorts, so this task cannot be
+            // recycled into the right child.
+            Task* pRightChild = ctx.pMicroScheduler->allocateTask<MergeTask>(
+                mid1, m_last1, mid2, m_last2, m_out + ((mid1 - m_first1) + (mid2 - m_first2)),
+                m_compare, m_blockSize);
+            pContinuation->addChildTaskWithoutRef(pRightChild);
+
+            return pRightChild;
+        }
+
+    private:
+
+        TInIter m_first1;
+        TInIter m_last1;
+        TInIter m_first2;
+        TInIter m_last2;
+        TOutIter m_out;
+        TCompare& m_compare;
+        size_t m_blockSize;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////
+    /**
+     * Sorts [begin, end) in place or into 'buffer'. The halves are sorted
+     * into the other location, so that the merge continuation moves them to
+     * the requested one.
+     */
+    template<typename TIter, typename TBufferIter, typename TCompare>
+    class MergeSortTask : public Task
+    {
+    public:
+
+        //----------------------------------------------------------------------
+        GTS_INLINE MergeSortTask(
+            TIter begin,
+            TIter end,
+            TBufferIter buffer,
+            bool isInPlace,
+            TCompare& compare,
+            size_t blockSize)
+            : m_begin(begin)
+            , m_end(end)
+            , m_buffer(buffer)
+            , m_compare(compare)
+            , m_blockSize(blockSize)
+            , m_isInPlace(isInPlace)
+        {}
+
+        //----------------------------------------------------------------------
+        virtual Task* execute(TaskContext const& ctx) final
+        {
+            size_t size = size_t(m_end - m_begin);
+
+            if (size <= m_blockSize)
+            {
+                std::sort(m_begin, m_end, m_compare);
+                if (!m_isInPlace)
+                {
+                    std::move(m_begin, m_end, m_buffer);
+                }
+                return nullptr;
+            }
+
+            size_t halfSize       = size / 2;
+            TIter mid             = m_begin + halfSize;
+            TBufferIter bufferMid = m_buffer + halfSize;
+
+            Task* pContinuation;
+            if (m_isInPlace)
+            {
+                pContinuation = ctx.pMicroScheduler->allocateTask<MergeTask<TBufferIter, TIter, TCompare>>(
+                    m_buffer, bufferMid, bufferMid, m_buffer + size, m_begin, m_compare, m_blockSize);
+            }
+            else
+            {
+                pContinuation = ctx.pMicroScheduler->allocateTask<MergeTask<TIter, TBufferIter, TCompare>>(
+                    m_begin, mid, mid, m_end, m_buffer, m_compare, m_blockSize);
+            }
+            setContinuationTask(pContinuation);
+            pContinuation->addRef(2, memory_order::relaxed);
+
+            Task* pLeftChild = ctx.pMicroScheduler->allocateTask<MergeSortTask>(
+                m_begin, mid, m_buffer, !m_isInPlace, m_compare, m_blockSize);
+            pContinuation->addChildTaskWithoutRef(pLeftChild);
+            ctx.pMicroScheduler->spawnTask(pLeftChild);
+
+            // This task becomes the right child.
+            recycle();
+            pContinuation->addChildTaskWithoutRef(this);
+            m_begin     = mid;
+            m_buffer    = bufferMid;
+            m_isInPlace = !m_isInPlace;
+
+            return this;
+        }
+
+    private:
+
+        TIter m_begin;
+        TIter m_end;
+        TBufferIter m_buffer;
+        TCompare& m_compare;
+        size_t m_blockSize;
+        bool m_isInPlace;
+    };
+};
+
+/** @} */ // end of ParallelPatterns
+/** @} */ // end of MicroScheduler
+
+} // namespace gts
@@ -22,9 +22,11 @@
 #pragma once
 
 #include "gts/platform/Assert.h"
+#include "gts/platform/Memory.h"
 #include "gts/micro_scheduler/MicroScheduler.h"
 #include "gts/micro_scheduler/patterns/Partitioners.h"
 #include "gts/micro_scheduler/patterns/Range1d.h"
+#include "gts/micro_scheduler/patterns/RangeSplitters.h"
 
 namespace gts {
 
@@ -40,437 +42,108 @@ namespace gts {
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
-template<typename TValRange, typename TDepRange, uint32_t DIMENSIONALITY>
+/**
+ * @brief
+ *  The dependency counters of a wavefront's blocks, packed densely in one
+ *  allocation. Each block waits on its predecessor in every dimension.
+ */
+template<uint32_t DIMENSIONALITY>
 class DependencyArray
 {
-    static_assert(DIMENSIONALITY <= 3 && DIMENSIONALITY != 1, "Unsupported dimensionality");
-};
-
+    static_assert(DIMENSIONALITY != 1, "1D Wavefront not supported. Try ParallelScan.");
+    static_assert(DIMENSIONALITY == 2 || DIMENSIONALITY == 3, "Unsupported dimensionality.");
 
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-template<typename TValRange, typename TDepRange>
-class DependencyArray<TValRange, TDepRange, 2>
-{
 public:
 
-    DependencyArray() = default;
-
-    //--------------------------------------------------------------------------
-    DependencyArray(Atomic<uint8_t>** m_ppDependencies, size_t xSize, size_t ySize)
-        : m_ppDependencies(m_ppDependencies)
-        , m_xSize(xSize)
-        , m_ySize(ySize)
-    {}
+    //! The coordinates of a block.
+    struct Coords
+    {
+        size_t c[DIMENSIONALITY];
+    };
 
     //--------------------------------------------------------------------------
-    template<typename TSplitter>
-    void produceSplits(
-        TSplitter const& splitter,
-        TValRange const& valRange,
-        TValRange* pReadyRanges,
-        uint8_t& readyIdx)
+    DependencyArray(size_t const (&blockCounts)[DIMENSIONALITY])
     {
-        // Build the dependencies range
-
-        size_t xBegin = valRange.xRange().begin() / valRange.xRange().minSize();
-        size_t xEnd   = valRange.xRange().end() / valRange.xRange().minSize();
-        size_t yBegin = valRange.yRange().begin() / valRange.yRange().minSize();
-        size_t yEnd   = valRange.yRange().end() / valRange.yRange().minSize();
-        TDepRange depRange(xBegin, xEnd, 1, yBegin, yEnd, 1);
-        depRange.resetInitialSize(m_xSize, SubRangeIndex::X);
-        depRange.resetInitialSize(m_ySize, SubRangeIndex::Y);
-
-        // Get any ready x-neighbors
-
-        TValRange valNeighbor = valRange.xNeighbor();
-        if(!valNeighbor.xRange().empty())
+        size_t totalCount = 1;
+        for (int32_t iDim = DIMENSIONALITY - 1; iDim >= 0; --iDim)
         {
-            TDepRange const originalDepNeighbor = depRange.xNeighbor();
-            TDepRange depNeighbor = originalDepNeighbor;
-
-            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits check x-neighbor X", depNeighbor.xRange().begin(), depNeighbor.xRange().end());
-            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits check x-neighbor Y", depNeighbor.yRange().begin(), depNeighbor.yRange().end());
-
-            size_t x = depNeighbor.xRange().begin();
-            size_t y = depNeighbor.yRange().begin();
-
-            if(m_ppDependencies[x][y].load(memory_order::acquire) == 0)
-            {
-                GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "BOOM", x, y);
-                GTS_ASSERT(m_ppDependencies[x][y].load(memory_order::acquire) != 0);
-            }
-            
-            x = depNeighbor.xRange().begin();
-            y = depNeighbor.yRange().begin();
-            bool ready = m_ppDependencies[x][y].fetch_sub(1, memory_order::seq_cst) - 1 == 0;
-            for (++y; y < depNeighbor.yRange().end(); ++y)
-            {
-                m_ppDependencies[x][y].fetch_sub(1, memory_order::seq_cst);
-            }
-
-            if (ready)
-            {
-                Vector<uint8_t> topCounts(depNeighbor.xRange().size());
-                size_t topCountOffset = depNeighbor.xRange().begin();
-                x = depNeighbor.xRange().begin();
-                y = depNeighbor.yRange().begin();
-                for (; x < depNeighbor.xRange().end(); ++x)
-                {
-                    topCounts[x - topCountOffset] =
-                        m_ppDependencies[x][y].load(memory_order::acquire);
-                }
-
-                if (_splitToReady(
-                    splitter,
-                    topCounts,
-                    topCountOffset,
-                    depNeighbor,
-                    valNeighbor,
-                    SubRangeIndex::X))
-                {
-                    GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits got x-neighbor X", depNeighbor.xRange().begin(), depNeighbor.xRange().end());
-                    GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits got x-neighbor Y", depNeighbor.yRange().begin(), depNeighbor.yRange().end());
-
-                    pReadyRanges[readyIdx++] = valNeighbor;
-                }
-            }
-            else
-            {
-                GTS_TRACE_ZONE_MARKER_P0(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits x-neighbor not ready.");
-            }
+            m_blockCounts[iDim] = blockCounts[iDim];
+            m_strides[iDim]     = totalCount;
+            totalCount         *= blockCounts[iDim];
         }
 
-        // Get any ready y-neighbors
+        m_pCounts = alignedVectorNew<Atomic<uint8_t>, GTS_CACHE_LINE_SIZE>(totalCount);
+        m_totalCount = totalCount;
 
-        valNeighbor = valRange.yNeighbor();
-        if(!valNeighbor.yRange().empty())
+        for (size_t idx = 0; idx < totalCount; ++idx)
         {
-            TDepRange const originalDepNeighbor = depRange.yNeighbor();
-            TDepRange depNeighbor = originalDepNeighbor;
-
-            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits check y-neighbor X", depNeighbor.xRange().begin(), depNeighbor.xRange().end());
-            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits check y-neighbor Y", depNeighbor.yRange().begin(), depNeighbor.yRange().end());
-
-            size_t x = depNeighbor.xRange().begin();
-            size_t y = depNeighbor.yRange().begin();
-
-            if(m_ppDependencies[x][y].load(memory_order::acquire) == 0)
-            {
-                GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "BOOM", x, y);
-                GTS_ASSERT(m_ppDependencies[x][y].load(memory_order::acquire) != 0);
-            }
-
-            x = depNeighbor.xRange().begin();
-            y = depNeighbor.yRange().begin();
-            bool ready = m_ppDependencies[x][y].fetch_sub(1, memory_order::seq_cst) - 1 == 0;
-            for (++x; x < depNeighbor.xRange().end(); ++x)
-            {
-                m_ppDependencies[x][y].fetch_sub(1, memory_order::seq_cst);
-            }
-
-            if (ready)
-            {
-                Vector<uint8_t> sideCounts(depNeighbor.yRange().size());
-                size_t sideCountOffset = depNeighbor.yRange().begin();
-                x = depNeighbor.xRange().begin();
-                y = depNeighbor.yRange().begin();
-                for (; y < depNeighbor.yRange().end(); ++y)
-                {
-                    sideCounts[y - sideCountOffset] =
-                        m_ppDependencies[x][y].load(memory_order::acquire);
-                }
-
-                if (_splitToReady(
-                    splitter,
-                    sideCounts,
-                    sideCountOffset,
-                    depNeighbor,
-                    valNeighbor,
-                    SubRangeIndex::Y))
-                {
-                    GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits got y-neighbor X", depNeighbor.xRange().begin(), depNeighbor.xRange().end());
-                    GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits got y-neighbor Y", depNeighbor.yRange().begin(), depNeighbor.yRange().end());
-
-                    pReadyRanges[readyIdx++] = valNeighbor;
-                }
-            }
-            else
+            uint8_t count = 0;
+            for (uint32_t iDim = 0; iDim < DIMENSIONALITY; ++iDim)
             {
-                GTS_TRACE_ZONE_MARKER_P0(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "produceSplits y-neighbor not ready.");
+                count += (idx / m_strides[iDim]) % m_blockCounts[iDim] > 0;
             }
+            m_pCounts[idx].store(count, memory_order::relaxed);
         }
     }
 
-private:
+    //--------------------------------------------------------------------------
+    ~DependencyArray()
+    {
+        alignedVectorDelete(m_pCounts, m_totalCount);
+    }
 
     //--------------------------------------------------------------------------
-    template<typename TSplitter>
-    bool _splitToReady(
-        TSplitter const& splitter,
-        Vector<uint8_t> const& counts,
-        size_t countOffset,
-        TDepRange& depRange,
-        TValRange& valRange,
-        SubRangeIndex::Type idx)
+    GTS_INLINE size_t blockCount(uint32_t dim) const
     {
-        GTS_TRACE_SCOPED_ZONE_P0(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "_splitToReady");
+        return m_blockCounts[dim];
+    }
 
-        // If left-most column,
-        if (depRange.subRange((SubRangeIndex::Type)((idx + 1) % 2)).begin() == 0)
+    /**
+     * Marks the block at 'coords' as complete.
+     * @param pReady
+     *  Receives the successors that became ready. Must hold DIMENSIONALITY
+     *  elements.
+     * @return
+     *  The number of ready successors.
+     */
+    GTS_INLINE uint32_t complete(Coords const& coords, Coords* pReady)
+    {
+        size_t idx = 0;
+        for (uint32_t iDim = 0; iDim < DIMENSIONALITY; ++iDim)
         {
-            if (counts[0] > 1)
-            {
-                // not ready.
-                return false;
-            }
-
-            // range is ready.
-            return true;
+            idx += coords.c[iDim] * m_strides[iDim];
         }
-        // Otherwise, do full ready check.
-        else
+
+        uint32_t readyCount = 0;
+        for (uint32_t iDim = 0; iDim < DIMENSIONALITY; ++iDim)
         {
-            if (counts[0] != 0)
+            if (coords.c[iDim] + 1 == m_blockCounts[iDim])
             {
-                // Not ready.
-                return false;
+                continue;
             }
 
-            bool sideAllZeros = true;
-            for (size_t ii = depRange.subRange(idx).begin(); ii < depRange.subRange(idx).end(); ++ii)
-            {
-                if (counts[ii - countOffset] != 0)
-                {
-                    sideAllZeros = false;
-                    break;
-                }
-            }
+            Atomic<uint8_t>& count = m_pCounts[idx + m_strides[iDim]];
+            GTS_ASSERT(count.load(memory_order::relaxed) != 0);
 
-            // If the left row is not all zeros, split down to a
-            // successor that we won.
-            if (!sideAllZeros)
+            if (count.fetch_sub(1, memory_order::acq_rel) == 1)
             {
-                do
-                {
-                    if (!depRange.subRange(idx).isDivisible())
-                    {
-                        GTS_ASSERT(0);
-
-                        // Can't divide the top any further.
-                        return false;
-                    }
-
-                    typename TDepRange::split_result depSplits;
-                    depRange.split(depSplits, splitter);
-
-                    typename TValRange::split_result valSplits;
-                    valRange.split(valSplits, splitter);
-
-
-                    sideAllZeros = true;
-                    for (size_t ii = depRange.subRange(idx).begin(); ii < depRange.subRange(idx).end(); ++ii)
-                    {
-                        if (counts[ii - countOffset] != 0)
-                        {
-                            sideAllZeros = false;
-                            break;
-                        }
-                    }
-
-                } while(!sideAllZeros);
+                pReady[readyCount] = coords;
+                ++pReady[readyCount].c[iDim];
+                ++readyCount;
             }
         }
-
-        return true;
+        return readyCount;
     }
 
 private:
 
-    Atomic<uint8_t>** m_ppDependencies = nullptr;
-    size_t m_xSize = 0;
-    size_t m_ySize = 0;
-};
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-//template<typename TValRange, typename TDepRange>
-//class DependencyArray<TValRange, TDepRange, 3>
-//{
-//public:
-
-//    DependencyArray() = default;
-
-//    //--------------------------------------------------------------------------
-//    DependencyArray(Atomic<uint8_t>** pppDependencies, size_t xSize, size_t ySize, size_t zSize)
-//        : pppDependencies(m_pppDependencies)
-//        , m_xSize(xSize)
-//        , m_ySize(ySize)
-//        , m_zSize(zSize)
-//    {}
-
-//private:
-
-//    Atomic<uint8_t>*** pppDependencies = nullptr;
-//    size_t m_xSize = 0;
-//    size_t m_ySize = 0;
-//    size_t m_zSize = 0;
-//};
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-template<uint32_t DIMENSIONALITY>
-struct LaunchTask
-{
-    static_assert(DIMENSIONALITY != 1, "1D Wavefront not supported. Try ParallelScan.");
-    static_assert(DIMENSIONALITY <= 3, "Unsupported dimensionality.");
-    static_assert(DIMENSIONALITY != 3, "TODO: Add 3D support.");
-};
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-template<>
-struct LaunchTask<2>
-{
-    enum { DIMENSIONALITY = 2 };
-
-    template<
-        typename TWavefrontTask,
-        typename TFunc,
-        typename TPartitioner,
-        template<typename...> class TRange,
-        class... TArgs
-    >
-    static GTS_INLINE void launch(
-        MicroScheduler& microScheduler,
-        uint32_t priority,
-        TRange<TArgs...> const& range,
-        TFunc wavefrontFunc,
-        TPartitioner partitioner,
-        void* pUserData)
-    {
-        GTS_ASSERT(microScheduler.isRunning());
-
-        //
-        // Build the array of dependency counters.
-
-        using dep_arrary_type = DependencyArray<TRange<TArgs...>, TRange<size_t>, DIMENSIONALITY>;
-
-        size_t xSize = range.xRange().size() / range.xRange().minSize() +
-            (range.xRange().size() % range.xRange().minSize() != 0 ? 1 : 0);
-
-        size_t ySize = range.yRange().size() / range.yRange().minSize() +
-            (range.yRange().size() % range.yRange().minSize() != 0 ? 1 : 0);
-
-        Atomic<uint8_t>** ppDependencies = new Atomic<uint8_t>*[xSize];
-        for (size_t ii = 0; ii < xSize; ++ii)
-        {
-            ppDependencies[ii] = new Atomic<uint8_t>[xSize];
-            for (size_t jj = 0; jj < ySize; ++jj)
-            {
-                ppDependencies[ii][jj].store((ii > 0) + (jj > 0), memory_order::relaxed);
-            }
-        }
-
-        dep_arrary_type depArray(ppDependencies, xSize, ySize);
-
-        //
-        // Launch root task and wait.
-
-        Task* pTask = microScheduler.template allocateTask<TWavefrontTask>(
-            wavefrontFunc, pUserData, range, partitioner, priority, depArray);
-
-        microScheduler.spawnTaskAndWait(pTask, priority);
+    DependencyArray(DependencyArray const&) = delete;
+    DependencyArray& operator=(DependencyArray const&) = delete;
 
-        //
-        // Delete the array of dependency counters.
-
-        for (size_t ii = 0; ii < xSize; ++ii)
-        {
-            delete[] ppDependencies[ii];
-        }
-        delete[] ppDependencies;
-    }
-};
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-template<>
-struct LaunchTask<3>
-{
-    enum { DIMENSIONALITY = 3 };
-
-    //--------------------------------------------------------------------------
-    template<
-        typename TWavefrontTask,
-        typename TFunc,
-        typename TPartitioner,
-        template<typename...> class TRange,
-        class... TArgs
-    >
-    static GTS_INLINE void launch(
-        MicroScheduler& microScheduler,
-        uint32_t priority,
-        TRange<TArgs...> const& range,
-        TFunc wavefrontFunc,
-        TPartitioner partitioner,
-        void* pUserData)
-    {
-        using dep_arrary_type = DependencyArray<TRange<TArgs...>, TRange<size_t>, DIMENSIONALITY>;
-
-        GTS_ASSERT(microScheduler.isRunning());
-
-        //
-        // Build the array of dependency counters.
-
-        size_t xSize = range.xRange().size() / range.xRange().minSize() +
-            range.xRange().size() % range.xRange().minSize() != 0 ? 1 : 0;
-
-        size_t ySize = range.yRange().size() / range.yRange().minSize() +
-            range.yRange().size() % range.yRange().minSize() != 0 ? 1 : 0;
-
-        size_t zSize = range.zRange().size() / range.zRange().minSize() +
-            range.zRange().size() % range.zRange().minSize() != 0 ? 1 : 0;
-
-        Atomic<uint8_t>*** pppDependencies = new Atomic<uint8_t>**[xSize];
-        for (size_t ii = 0; ii < xSize; ++ii)
-        {
-            pppDependencies[ii] = new Atomic<uint8_t>*[ySize];
-
-            for (size_t jj = 0; jj < ySize; ++jj)
-            {
-                pppDependencies[ii][jj] = new Atomic<uint8_t>[zSize];
-
-                for (size_t kk = 0; kk < zSize; ++kk)
-                {
-                    pppDependencies[ii][jj][kk].store((ii > 0) + (jj > 0) + (kk > 0), memory_order::relaxed);
-                }
-            }
-        }
-
-        dep_arrary_type depArray(pppDependencies, xSize, ySize, zSize);
-
-        //
-        // Launch root task and wait.
-
-        Task* pTask = microScheduler.allocateTask<TWavefrontTask>(
-            wavefrontFunc, pUserData, range, partitioner, priority);
-
-        microScheduler.spawnTaskAndWait(pTask, priority);
-
-        //
-        // Delete the array of dependency counters.
-
-        for (size_t ii = 0; ii < xSize; ++ii)
-        {
-            for (size_t jj = 0; jj < ySize; ++jj)
-            {
-                delete[] pppDependencies[ii][jj];
-            }
-            delete[] pppDependencies[ii];
-        }
-        delete[] pppDependencies;
-    }
+    Atomic<uint8_t>* m_pCounts;
+    size_t m_totalCount;
+    size_t m_blockCounts[DIMENSIONALITY];
+    size_t m_strides[DIMENSIONALITY];
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -478,9 +151,10 @@ struct LaunchTask<3>
 /**
  * @brief
  *  A construct that maps a parallel-wavefront behavior to a MicroScheduler.
- *
- * @todo Implement 3D version.
- * @todo Cleanup and Optimize
+ * @details
+ *  The range is cut into blocks of its minimum sizes. A block runs once its
+ *  predecessor in each dimension, the block before it along that axis, has
+ *  run. Supports 2D and 3D ranges.
  */
 class ParallelWavefront
 {
@@ -500,218 +174,172 @@ public:
      * @brief
      *  Applies the given function 'wavefrontFunc' to the specified iteration 'range'.
      * @param range
-     *  An iteration range.
+     *  A 2D or 3D iteration range, e.g. KdRange2d, QuadRange, KdRange3d or
+     *  OctRange. Each dimension is cut into blocks of its minSize().
      * @param wavefrontFunc
      *  The wavefront function to apply to each range block. Signature:
      * @code
      *  void(*)(TRange& range, void* pUserData, TaskContext const&);
      * @endcode
      * @param partitioner
-     *  The partitioning algorithmic that will subdivided range.
+     *  Unused. The dependencies already limit the parallelism to the blocks
+     *  on the wavefront, so the blocks are not split further.
      * @param pUserData
      *  Optional user data that will be passed into func.
      */
-    template<
-        typename TFunc,
-        typename TPartitioner,
-        template<typename...> class TRange,
-        class... TArgs
-    >
+    template<typename TFunc, typename TPartitioner, typename TRange>
     GTS_INLINE void operator()(
-        TRange<TArgs...> const& range,
+        TRange const& range,
         TFunc wavefrontFunc,
         TPartitioner partitioner,
         void* pUserData)
     {
         GTS_ASSERT(m_microScheduler.isRunning());
+        GTS_UNREFERENCED_PARAM(partitioner);
+
+        enum { DIMENSIONALITY = TRange::DIMENSIONALITY };
+
+        if (range.empty())
+        {
+            return;
+        }
+
+        size_t blockCounts[DIMENSIONALITY];
+        for (uint32_t iDim = 0; iDim < DIMENSIONALITY; ++iDim)
+        {
+            auto const& subRange = range.subRange(SubRangeIndex::Type(iDim));
+            blockCounts[iDim] = (subRange.size() + subRange.minSize() - 1) / subRange.minSize();
+        }
 
-        partitioner.template initialize<TRange<TArgs...>>((uint16_t)m_microScheduler.workerCount());
+        using task_type = ParallelWavefrontTask<TFunc, TRange>;
+        typename task_type::State state(range, wavefrontFunc, pUserData, blockCounts, m_priority);
 
-        using dep_arrary_type = DependencyArray<TRange<TArgs...>, TRange<size_t>, TRange<TArgs...>::DIMENSIONALITY>;
+        state.pRoot = m_microScheduler.allocateTask<EmptyTask>();
+        state.pRoot->addRef(1, memory_order::relaxed);
 
-        LaunchTask<TRange<TArgs...>::DIMENSIONALITY>::template launch<ParallelWavefrontTask<TFunc, TRange<TArgs...>, TPartitioner, dep_arrary_type>>(
-            m_microScheduler, m_priority, range, wavefrontFunc, partitioner, pUserData);
+        // The first block has no predecessors.
+        typename task_type::coords_type origin = {};
+        Task* pTask = m_microScheduler.allocateTask<task_type>(&state, origin);
+        state.pRoot->addChildTaskWithRef(pTask);
+        m_microScheduler.spawnTask(pTask, m_priority);
 
-        #pragma message ("ParallelWavefront is a WIP. It may break or be slow.")
+        state.pRoot->waitForAll();
+        m_microScheduler.destoryTask(state.pRoot);
     }
 
 private:
 
+    ParallelWavefront(ParallelWavefront const&) = delete;
+    ParallelWavefront* operator=(ParallelWavefront const&) = delete;
+
     MicroScheduler& m_microScheduler;
     uint32_t m_priority;
 
     ////////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////////
-    template<typename TFunc, typename TRange, typename TPartitioner, typename TDependencyArray>
+    /**
+     * Runs a ready block and then the successors it makes ready. One
+     * successor runs next in this Task, which keeps the block's shared face
+     * in cache. The rest are spawned.
+     */
+    template<typename TFunc, typename TRange>
     class ParallelWavefrontTask : public Task
     {
     public:
 
-        //----------------------------------------------------------------------
-        ParallelWavefrontTask(
-            TFunc& func,
-            void* userData,
-            TRange const& range,
-            TPartitioner partitioner,
-            uint32_t priority,
-            TDependencyArray& depArray)
-
-            : m_range(range)
-            , m_partitioner(partitioner)
-            , m_func(func)
-            , m_pUserData(userData)
-            , m_depArray(depArray)
-            , m_priority(priority)
-        {}
-
-        //----------------------------------------------------------------------
-        ParallelWavefrontTask(ParallelWavefrontTask& parent, TRange const& range)
-            : m_range(range)
-            , m_partitioner(parent.m_partitioner, 0, TRange())
-            , m_func(parent.m_func)
-            , m_pUserData(parent.m_pUserData)
-            , m_depArray(parent.m_depArray)
-            , m_priority(parent.m_priority)
-        {}
+        enum { DIMENSIONALITY = TRange::DIMENSIONALITY };
 
-        //----------------------------------------------------------------------
-        ParallelWavefrontTask(ParallelWavefrontTask& parent, TRange const& range, uint16_t depth)
-            : m_range(range)
-            , m_partitioner(parent.m_partitioner, depth, TRange())
-            , m_func(parent.m_func)
-            , m_pUserData(parent.m_pUserData)
-            , m_depArray(parent.m_depArray)
-            , m_priority(parent.m_priority)
-        {}
+        using dep_array_type = DependencyArray<DIMENSIONALITY>;
+        using coords_type    = typename dep_array_type::Coords;
 
-        //----------------------------------------------------------------------
-        ParallelWavefrontTask(ParallelWavefrontTask const&) = default;
+        //! The state shared by all the Tasks of a wavefront.
+        struct State
+        {
+            //------------------------------------------------------------------
+            State(
+                TRange const& range,
+                TFunc& func,
+                void* pUserData,
+                size_t const (&blockCounts)[DIMENSIONALITY],
+                uint32_t priority)
+                : range(range)
+                , func(func)
+                , pUserData(pUserData)
+                , depArray(blockCounts)
+                , pRoot(nullptr)
+                , priority(priority)
+            {}
+
+            TRange const& range;
+            TFunc& func;
+            void* pUserData;
+            dep_array_type depArray;
+            Task* pRoot;
+            uint32_t priority;
+        };
 
         //----------------------------------------------------------------------
-        ParallelWavefrontTask& operator=(ParallelWavefrontTask const& other) = default;
+        GTS_INLINE ParallelWavefrontTask(State* pState, coords_type const& coords)
+            : m_pState(pState)
+            , m_coords(coords)
+        {}
 
         //----------------------------------------------------------------------
-        void offerRange(TaskContext const& ctx, TRange const* pReadySplits, uint8_t numReadySplits)
+        virtual Task* execute(TaskContext const& ctx) final
         {
-            // Allocate the continuation.
-            Task* pContinuation = ctx.pMicroScheduler->allocateTask<EmptyTask>();
-            pContinuation->addRef(numReadySplits, gts::memory_order::relaxed);
-            setContinuationTask(pContinuation);
+            coords_type ready[DIMENSIONALITY];
 
-            // Add the splits as siblings.
-            for (int iChild = 0; iChild < numReadySplits; ++iChild)
+            for (;;)
             {
-                Task* pChild = ctx.pMicroScheduler->allocateTask<ParallelWavefrontTask>(
-                    *this, pReadySplits[iChild]);
-
-                pContinuation->addChildTaskWithoutRef(pChild);
-                ctx.pMicroScheduler->spawnTask(pChild);
-            }
-
-            m_partitioner.template split<TRange>();
-        }
-
-        //----------------------------------------------------------------------
-        void offerRange(TaskContext const& ctx, TRange const& range, uint16_t depth = 0)
-        {
-            GTS_ASSERT(!range.empty() && "Bug in partitioner!");
-
-            // Allocate the continuation.
-            Task* pContinuation = ctx.pMicroScheduler->allocateTask<EmptyTask>();
-            pContinuation->addRef(2, gts::memory_order::relaxed);
-            setContinuationTask(pContinuation);
-
-            // The split is the right sibling.
-            Task* pSibling = ctx.pMicroScheduler->allocateTask<ParallelWavefrontTask>(*this, range, depth);
-            pContinuation->addChildTaskWithoutRef(pSibling);
-            ctx.pMicroScheduler->spawnTask(pSibling);
-
-            // This task becomes a sibling.
-            pContinuation->addChildTaskWithoutRef(this);
-
-            m_partitioner.template split<TRange>();
-        }
+                TRange block = _block(m_coords);
+                GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "Wavefront::run", block.xRange().begin(), block.yRange().begin());
+                m_pState->func(block, m_pState->pUserData, ctx);
 
-        //----------------------------------------------------------------------
-        template<typename TSplitter>
-        void run(TaskContext const& ctx, TRange& range, TSplitter const& splitter)
-        {
-            // Run this range.
-            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WAVEFRONT, analysis::Color::AntiqueWhite, "Wavefront::run", range.xRange().size(), range.yRange().size());
-            m_func(range, m_pUserData, ctx);
+                uint32_t readyCount = m_pState->depArray.complete(m_coords, ready);
+                if (readyCount == 0)
+                {
+                    return nullptr;
+                }
 
-            // Collect ready neighbors.
-            TRange readySplits[TRange::MAX_SPLITS * 2];
-            uint8_t numReadySplits = 0;
-            m_depArray.produceSplits(splitter, range, readySplits, numReadySplits);
+                for (uint32_t ii = 1; ii < readyCount; ++ii)
+                {
+                    Task* pTask = ctx.pMicroScheduler->allocateTask<ParallelWavefrontTask>(m_pState, ready[ii]);
+                    m_pState->pRoot->addChildTaskWithRef(pTask);
+                    ctx.pMicroScheduler->spawnTask(pTask, m_pState->priority);
+                }
 
-            // Offer up the ready neighbors.
-            if(numReadySplits > 0)
-            {
-                offerRange(ctx, readySplits, numReadySplits);
+                m_coords = ready[0];
             }
         }
 
-        //----------------------------------------------------------------------
-        Task* execute(TaskContext const& ctx)
-        {
-            GTS_TRACE_SCOPED_ZONE_P0(analysis::CaptureMask::WAVEFRONT, analysis::Color::RoyalBlue, isStolen() ? "S" : "P");
-
-            return m_partitioner.execute(ctx, this, m_range);
-        }
-
-        //----------------------------------------------------------------------
-        void initialOffer(TaskContext const&, TRange& range, typename TPartitioner::splitter_type const& splitter)
-        {
-            typename TRange::split_result splits;
-            range.split(splits, splitter);
-
-            m_partitioner.template split<TRange>();
-        }
+    private:
 
         //----------------------------------------------------------------------
-        void balanceAndExecute(TaskContext const& ctx, TPartitioner& partitioner, TRange& range, typename TPartitioner::splitter_type const& splitter)
+        GTS_INLINE TRange _block(coords_type const& coords) const
         {
-            uint16_t splitDepth = 0;
+            using range_type = typename TRange::range_type;
+            using size_type  = typename range_type::size_type;
 
-            // Split to depth to balance the Task tree.
-            while (splitDepth < partitioner.maxBalancedSplitDepth() && range.isDivisible())
+            TRange block = m_pState->range;
+            for (uint32_t iDim = 0; iDim < DIMENSIONALITY; ++iDim)
             {
-                GTS_TRACE_SCOPED_ZONE_P0(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::PaleVioletRed4, "ADAPTIVE SPLIT");
-
-                typename TRange::split_result splits;
-                range.split(splits, splitter);
-                ++splitDepth;
-            }
-
-            // Run this range.
-            TRange readySplits[TRange::MAX_SPLITS * 2];
-            uint8_t numReadySplits = 0;
-            m_func(range, m_pUserData, ctx);
+                range_type& subRange = block.subRange(SubRangeIndex::Type(iDim));
 
-            // Collect ready neighbors.
-            m_depArray.produceSplits(splitter, range, readySplits, numReadySplits);
+                size_type minSize    = subRange.minSize();
+                size_type blockBegin = size_type(coords.c[iDim]) * minSize;
+                size_type blockEnd   = gtsMin(subRange.size(), blockBegin + minSize);
 
-            if (numReadySplits > 0)
-            {
-                // Spawn ready neighbors.
-                for (size_t ii = 0; ii < numReadySplits; ++ii)
-                {
-                    offerRange(ctx, readySplits[ii], partitioner.maxBalancedSplitDepth() - 1);
-                }
+                subRange = range_type(
+                    subRange.begin() + blockBegin,
+                    subRange.begin() + blockEnd,
+                    minSize,
+                    subRange.splitOnMultiplesOf());
             }
+            return block;
         }
 
-    private:
-
-        using split_result = typename TRange::split_result;
-
-        TRange            m_range;
-        TPartitioner      m_partitioner;
-        TFunc&            m_func;
-        void*             m_pUserData;
-        TDependencyArray  m_depArray;
-        uint32_t          m_priority;
+        State* m_pState;
+        coords_type m_coords;
     };
 };
 
@@ -21,6 +21,7 @@
  ******************************************************************************/
 #pragma once
 
+#include "gts/platform/Memory.h"
 #include "gts/micro_scheduler/Task.h"
 #include "gts/micro_scheduler/patterns/RangeSplitters.h"
 
@@ -199,6 +200,7 @@ private:
 
 
 #include "AdaptivePartitioner.h"
+#include "AffinityPartitioner.h"
 
 
 /** @} */ // end of ParallelPatterns
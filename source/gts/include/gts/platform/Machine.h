@@ -349,6 +349,34 @@ GTS_INLINE uint64_t msbScan64(uint64_t bitSet)
 }
 #define GTS_MSB_SCAN64(bitSet) gts::msbScan64(bitSet)
 
+//------------------------------------------------------------------------------
+GTS_INLINE uint64_t lsbScan64(uint64_t bitSet)
+{
+#ifdef GTS_MSVC
+    #ifdef GTS_ARCH_X64
+        unsigned long result = 0;
+        _BitScanForward64(&result, (unsigned __int64)bitSet);
+        return (uint64_t)result;
+    #else
+        unsigned long result = 0;
+
+        // Check low word.
+        if (_BitScanForward(&result, (unsigned long)(bitSet & UINT32_MAX)) == 0)
+        {
+            // If no low word, check high word.
+            _BitScanForward(&result, (unsigned long)(bitSet >> 32));
+            result += 32;
+        }
+        return (uint64_t)result;
+    #endif // GTS_ARCH_X64
+#elif (GTS_CLANG || GTS_GCC)
+    return __builtin_ctzll(bitSet);
+#else
+    return (uint64_t)::floor(::log2((double)(bitSet & (~bitSet + 1))));
+#endif
+}
+#define GTS_LSB_SCAN64(bitSet) gts::lsbScan64(bitSet)
+
 
 } // namespace gts
 #endif // GTS_HAS_CUSTOM_CPU_INTRINSICS_WRAPPERS
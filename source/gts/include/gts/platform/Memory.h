@@ -240,6 +240,7 @@ struct Memory
     static void* osVirtualCommit(void* ptr, size_t size);
     static bool osVirtualDecommit(void* ptr, size_t size);
     static bool osVirtualFree(void* ptr, size_t size = 0);
+    static bool osBindToNumaNode(void* ptr, size_t size, uint32_t nodeId);
 
 };
 } // namespace internal
@@ -254,6 +255,7 @@ struct Memory
 #define GTS_OS_VIRTUAL_COMMIT(ptr, size) gts::internal::Memory::osVirtualCommit(ptr, size)
 #define GTS_OS_VIRTUAL_DECOMMIT(ptr, size) gts::internal::Memory::osVirtualDecommit(ptr, size)
 #define GTS_OS_VIRTUAL_FREE(ptr, size) gts::internal::Memory::osVirtualFree(ptr, size)
+#define GTS_OS_BIND_TO_NUMA_NODE(ptr, size, nodeId) gts::internal::Memory::osBindToNumaNode(ptr, size, nodeId)
 
 #endif // GTS_HAS_CUSTOM_OS_MEMORY_WRAPPERS
 
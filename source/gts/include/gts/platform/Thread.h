@@ -72,6 +72,10 @@ using ThreadFunction = void(*)(void* pArg);
             GTS_ASSERT(cpuId < 64);
             m_bitset |= uintptr_t(1) << cpuId;
         }
+        GTS_INLINE bool isSet(uint32_t cpuId) const
+        {
+            return cpuId < 64 && (m_bitset & (uintptr_t(1) << cpuId)) != 0;
+        }
         GTS_INLINE void combine(AffinitySet const& other)
         {
             m_bitset |= other.m_bitset;
@@ -115,6 +119,11 @@ using ThreadFunction = void(*)(void* pArg);
             GTS_ASSERT(cpuId < sizeof(unsigned long) * MAX_SETS * 8);
             m_bitset[cpuId / MAX_SETS] |= 1 << (cpuId % MAX_SETS);
         }
+        GTS_INLINE bool isSet(uint32_t cpuId) const
+        {
+            return cpuId / MAX_SETS < MAX_SETS &&
+                (m_bitset[cpuId / MAX_SETS] & (size_t(1) << (cpuId % MAX_SETS))) != 0;
+        }
         GTS_INLINE void combine(AffinitySet const& other)
         {
             for(uint32_t ii = 0; ii < MAX_SETS; ++ii)
@@ -321,15 +330,8 @@ struct Thread
     #define GTS_WAIT_FOREVER uint32_t(-1)
     struct EventHandle
     {
-    #ifdef GTS_64BIT
-        struct MutexHandle { GTS_ALIGN(uintptr_t) uint8_t v[40] = { 0 }; } mutex;
-        struct CondVar { GTS_ALIGN(uintptr_t) uint8_t v[48] = { 0 }; } condVar;
-    #else
-        struct MutexHandle { GTS_ALIGN(uintptr_t) uint8_t v[24] = { 0 }; } mutex;
-        struct CondVar { GTS_ALIGN(uintptr_t) uint8_t v[48] = { 0 }; } condVar;
-    #endif
-        Atomic<bool> signaled = { false };
-        bool waiting = false;
+        // A futex word.
+        Atomic<uint32_t> state = { 0 };
     };
 #elif GTS_MAC
     #error "Missing mac thread implementation."
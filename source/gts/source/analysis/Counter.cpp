@@ -19,8 +19,6 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 * THE SOFTWARE.
 ******************************************************************************/
-#if GTS_ENABLE_COUNTER == 1
-
 #include "gts/analysis/Counter.h"
 
 namespace gts {
@@ -30,69 +28,76 @@ namespace analysis {
 ////////////////////////////////////////////////////////////////////////////////
 // WorkerPoolCounters
 
-WorkerPoolCounters::WorkerPoolCounters()
+//------------------------------------------------------------------------------
+const char* WorkerPoolCounters::name(size_t counter)
 {
-    WorkerPoolCounters::m_counterStringByCounter[NUM_ALLOCATIONS]           = "Task Allocations           :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_SLOW_PATH_ALLOCATIONS] = "Task Slow Allocations      :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_MEMORY_RECLAIMS]       = "Task Reclaims              :";
-
-    WorkerPoolCounters::m_counterStringByCounter[NUM_FREES]                 = "Task Frees                 :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_DEFERRED_FREES]        = "Task Deferred Frees        :";
-
-    WorkerPoolCounters::m_counterStringByCounter[NUM_WAKE_CALLS]            = "Wake Workers Calls         :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_WAKE_CHECKS]           = "Wake Workers Checks        :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_WAKE_SUCCESSES]        = "Wake Workers               :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_SLEEP_SUCCESSES]       = "Worker Sleeps              :";
-
-    WorkerPoolCounters::m_counterStringByCounter[NUM_RESUMES]               = "Worker Resumes             :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_HALTS_SIGNALED]        = "Worker Halts Signaled      :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_HALT_SUCCESSES]        = "Worker Halts               :";
-
-    WorkerPoolCounters::m_counterStringByCounter[NUM_SCHEDULER_REGISTERS]   = "MicroScheduler Registers   :";
-    WorkerPoolCounters::m_counterStringByCounter[NUM_SCHEDULER_UNREGISTERS] = "MicorScheduler Unregisters :";
+    switch (counter)
+    {
+    case NUM_ALLOCATIONS: return "Task Allocations";
+    case NUM_SLOW_PATH_ALLOCATIONS: return "Task Slow Allocations";
+    case NUM_MEMORY_RECLAIMS: return "Task Reclaims";
+    case NUM_FREES: return "Task Frees";
+    case NUM_DEFERRED_FREES: return "Task Deferred Frees";
+    case NUM_WAKE_CALLS: return "Wake Workers Calls";
+    case NUM_WAKE_CHECKS: return "Wake Workers Checks";
+    case NUM_WAKE_SUCCESSES: return "Wake Workers";
+    case NUM_SLEEP_SUCCESSES: return "Worker Sleeps";
+    case NUM_RESUMES: return "Worker Resumes";
+    case NUM_HALTS_SIGNALED: return "Worker Halts Signaled";
+    case NUM_HALT_SUCCESSES: return "Worker Halts";
+    case NUM_SCHEDULER_REGISTERS: return "MicroScheduler Registers";
+    case NUM_SCHEDULER_UNREGISTERS: return "MicroScheduler Unregisters";
+    default:
+        GTS_ASSERT(0 && "Unknown counter.");
+        return "";
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 // MicroSchedulerCounters
 
-MicroSchedulerCounters::MicroSchedulerCounters()
+//------------------------------------------------------------------------------
+const char* MicroSchedulerCounters::name(size_t counter)
 {
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_SPAWNS]                      = "Task Spawns                    :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_QUEUES]                      = "Task Queues                    :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_DEQUE_POP_ATTEMPTS]          = "Deque Pop Attempts             :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_DEQUE_POP_SUCCESSES]         = "Deque Pops                     :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_BOOSTED_DEQUE_POP_ATTEMPTS]  = "Boosted Deque Pop Attempts     :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_BOOSTED_DEQUE_POP_SUCCESSES] = "Boosted Deque Pops             :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_DEQUE_STEAL_ATTEMPTS]        = "Deque Steal Attempts           :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_DEQUE_STEAL_SUCCESSES]       = "Deque Steals                   :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_FAILED_CAS_IN_DEQUE_STEAL]   = "Deque Steals CAS Fails         :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_EXTERNAL_STEAL_ATTEMPTS]     = "External Steal Attempts        :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_EXTERNAL_STEAL_SUCCESSES]    = "External Steals                :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_QUEUE_POP_ATTEMPTS]          = "Queue Pop Attempts             :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_QUEUE_POP_SUCCESSES]         = "Queue Pops                     :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_AFFINITY_POP_ATTEMPTS]       = "Affinity Pop Attempts          :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_AFFINITY_POP_SUCCESSES]      = "Affinity Pops                  :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_WAITS]                       = "Waits                          :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_CONTINUATIONS]               = "Continuations                  :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_EXECUTED_TASKS]              = "Executed Tasks                 :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_SCHEDULER_BYPASSES]          = "Scheduler Bypasses             :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_EXIT_ATTEMPTS]               = "Scheduler Exit Attempts        :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_EXITS]                       = "Scheduler Exits                :";
-
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_SCHEDULER_REGISTERS]         = "External Scheduler Registers   :";
-    MicroSchedulerCounters::m_counterStringByCounter[NUM_SCHEDULER_UNREGISTERS]       = "External Scheduler Unregisters :";
+    switch (counter)
+    {
+    case NUM_SPAWNS: return "Task Spawns";
+    case NUM_QUEUES: return "Task Queues";
+    case NUM_DEQUE_POP_ATTEMPTS: return "Deque Pop Attempts";
+    case NUM_DEQUE_POP_SUCCESSES: return "Deque Pops";
+    case NUM_BOOSTED_DEQUE_POP_ATTEMPTS: return "Boosted Deque Pop Attempts";
+    case NUM_BOOSTED_DEQUE_POP_SUCCESSES: return "Boosted Deque Pops";
+    case NUM_DEQUE_STEAL_ATTEMPTS: return "Deque Steal Attempts";
+    case NUM_DEQUE_STEAL_SUCCESSES: return "Deque Steals";
+    case NUM_FAILED_CAS_IN_DEQUE_STEAL: return "Deque Steals CAS Fails";
+    case NUM_DEQUE_STEAL_BATCHED_TASKS: return "Deque Batch Stolen Tasks";
+    case NUM_SMT_SIBLING_STEAL_ATTEMPTS: return "SMT Sibling Steal Attempts";
+    case NUM_SMT_SIBLING_STEAL_SUCCESSES: return "SMT Sibling Steals";
+    case NUM_SAME_NODE_STEAL_ATTEMPTS: return "Same Node Steal Attempts";
+    case NUM_SAME_NODE_STEAL_SUCCESSES: return "Same Node Steals";
+    case NUM_REMOTE_STEAL_ATTEMPTS: return "Remote Steal Attempts";
+    case NUM_REMOTE_STEAL_SUCCESSES: return "Remote Steals";
+    case NUM_CROSS_NODE_STEALS: return "Cross Node Steals";
+    case NUM_EXTERNAL_STEAL_ATTEMPTS: return "External Steal Attempts";
+    case NUM_EXTERNAL_STEAL_SUCCESSES: return "External Steals";
+    case NUM_QUEUE_POP_ATTEMPTS: return "Queue Pop Attempts";
+    case NUM_QUEUE_POP_SUCCESSES: return "Queue Pops";
+    case NUM_AFFINITY_POP_ATTEMPTS: return "Affinity Pop Attempts";
+    case NUM_AFFINITY_POP_SUCCESSES: return "Affinity Pops";
+    case NUM_WAITS: return "Waits";
+    case NUM_CONTINUATIONS: return "Continuations";
+    case NUM_EXECUTED_TASKS: return "Executed Tasks";
+    case NUM_SCHEDULER_BYPASSES: return "Scheduler Bypasses";
+    case NUM_EXIT_ATTEMPTS: return "Scheduler Exit Attempts";
+    case NUM_EXITS: return "Scheduler Exits";
+    case NUM_SCHEDULER_REGISTERS: return "External Scheduler Registers";
+    case NUM_SCHEDULER_UNREGISTERS: return "External Scheduler Unregisters";
+    default:
+        GTS_ASSERT(0 && "Unknown counter.");
+        return "";
+    }
 }
 
 } // namespace analysis
 } // namespace gts
-
-#endif
@@ -367,9 +367,9 @@ bool DagUtils::isATopologicalOrdering(
             }
 
             visited.insert(pCurr);
-            for (uint32_t ii = 0; ii < pCurr->successors().size(); ++ii)
+            for (Node* pSucc : pCurr->flatSuccessors())
             {
-                pCurr->successors()[ii]->_removePredecessorRefAndReturnReady();
+                pSucc->_removePredecessorRefAndReturnReady();
             }
         }
     }
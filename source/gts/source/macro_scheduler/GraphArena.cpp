@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include "gts/macro_scheduler/GraphArena.h"
+
+#include "gts/platform/Utils.h"
+#include "gts/synchronization/Lock.h"
+
+namespace gts {
+
+// STRUCTORS:
+
+//------------------------------------------------------------------------------
+GraphArena::GraphArena(size_t granularity, size_t blockSize)
+    : m_pCursor(nullptr)
+    , m_pBlockEnd(nullptr)
+    , m_blockIdx(0)
+    , m_liveCount(0)
+    , m_granularity(granularity)
+    , m_blockSize(alignUpTo(blockSize, granularity))
+    , m_maxChunkSize(alignDownTo(m_blockSize / 4, granularity))
+{
+    GTS_ASSERT(isPow2(granularity) && granularity >= sizeof(FreeChunk));
+    GTS_ASSERT(m_maxChunkSize >= granularity);
+    m_freeListsBySize.resize(m_maxChunkSize / m_granularity + 1, nullptr);
+}
+
+//------------------------------------------------------------------------------
+GraphArena::~GraphArena()
+{
+    GTS_ASSERT(m_liveCount == 0 && "Graph objects outlived their MacroScheduler.");
+    for (uint8_t* pBlock : m_blocks)
+    {
+        GTS_ALIGNED_FREE(pBlock);
+    }
+}
+
+// ACCESSORS:
+
+//------------------------------------------------------------------------------
+size_t GraphArena::liveCount() const
+{
+    Lock<UnfairSpinMutex<>> lock(m_mutex);
+    return m_liveCount;
+}
+
+//------------------------------------------------------------------------------
+size_t GraphArena::blockCount() const
+{
+    Lock<UnfairSpinMutex<>> lock(m_mutex);
+    return m_blocks.size();
+}
+
+// MUTATORS:
+
+//------------------------------------------------------------------------------
+void* GraphArena::allocate(size_t size)
+{
+    size = alignUpTo(gtsMax(size, size_t(1)), m_granularity);
+    if (size > m_maxChunkSize)
+    {
+        return GTS_ALIGNED_MALLOC(size, m_granularity);
+    }
+
+    Lock<UnfairSpinMutex<>> lock(m_mutex);
+    ++m_liveCount;
+
+    FreeChunk*& pFreeList = m_freeListsBySize[size / m_granularity];
+    if (pFreeList)
+    {
+        FreeChunk* pChunk = pFreeList;
+        pFreeList = pChunk->pNext;
+        return pChunk;
+    }
+
+    return _carve(size);
+}
+
+//------------------------------------------------------------------------------
+void GraphArena::deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    size = alignUpTo(gtsMax(size, size_t(1)), m_granularity);
+    if (size > m_maxChunkSize)
+    {
+        GTS_ALIGNED_FREE(ptr);
+        return;
+    }
+
+    Lock<UnfairSpinMutex<>> lock(m_mutex);
+    GTS_ASSERT(m_liveCount > 0);
+
+    if (--m_liveCount == 0)
+    {
+        // Everything is free, so start over at the first block. The next
+        // graph is then carved sequentially instead of from scattered chunks.
+        _rewind();
+        return;
+    }
+
+    FreeChunk* pChunk = (FreeChunk*)ptr;
+    FreeChunk*& pFreeList = m_freeListsBySize[size / m_granularity];
+    pChunk->pNext = pFreeList;
+    pFreeList = pChunk;
+}
+
+//------------------------------------------------------------------------------
+void* GraphArena::_carve(size_t size)
+{
+    if (m_pCursor + size > m_pBlockEnd)
+    {
+        // Move to the next retained block or grow. The tail of the current
+        // block is abandoned until the arena rewinds.
+        if (m_pCursor != nullptr)
+        {
+            ++m_blockIdx;
+        }
+
+        if (m_blockIdx == m_blocks.size())
+        {
+            uint8_t* pBlock = (uint8_t*)GTS_ALIGNED_MALLOC(m_blockSize, m_granularity);
+            if (!pBlock)
+            {
+                GTS_ASSERT(0 && "Failed Allocation.");
+                --m_liveCount;
+                return nullptr;
+            }
+            m_blocks.push_back(pBlock);
+        }
+
+        m_pCursor   = m_blocks[m_blockIdx];
+        m_pBlockEnd = m_pCursor + m_blockSize;
+    }
+
+    void* ptr = m_pCursor;
+    m_pCursor += size;
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void GraphArena::_rewind()
+{
+    for (auto& pFreeList : m_freeListsBySize)
+    {
+        pFreeList = nullptr;
+    }
+
+    m_blockIdx = 0;
+    if (m_blocks.empty())
+    {
+        m_pCursor   = nullptr;
+        m_pBlockEnd = nullptr;
+    }
+    else
+    {
+        m_pCursor   = m_blocks[0];
+        m_pBlockEnd = m_pCursor + m_blockSize;
+    }
+}
+
+} // namespace gts
@@ -20,33 +20,50 @@
  * THE SOFTWARE.
  ******************************************************************************/
 #include "gts/macro_scheduler/MacroScheduler.h"
+#include "gts/synchronization/Lock.h"
 #include "gts/macro_scheduler/Node.h"
 #include "gts/macro_scheduler/Schedule.h"
 #include "gts/macro_scheduler/ComputeResource.h"
+#include "gts/macro_scheduler/compute_resources/MicroScheduler_ComputeResource.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
 
 namespace gts {
 
 //--------------------------------------------------------------------------
 MacroScheduler::MacroScheduler()
+    : m_minComputeResourceId(0)
+    , m_minMicroSchedulerId(0)
+    , m_graphArena(GTS_NO_SHARING_CACHE_LINE_SIZE)
+    , m_edgeArena(sizeof(Node*) * 2)
 {}
 
 //--------------------------------------------------------------------------
 MacroScheduler::~MacroScheduler()
-{}
+{
+    for (Schedule* pSchedule : m_retiredSchedules)
+    {
+        _destroySchedule(pSchedule);
+    }
+    for (Schedule* pSchedule : m_freeSchedules)
+    {
+        _destroySchedule(pSchedule);
+    }
+}
 
 // ACCESSORS:
 
 //------------------------------------------------------------------------------
 ComputeResource* MacroScheduler::findComputeResource(ComputeResourceId id)
 {
-    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
-    {
-        if (m_computeResources[ii]->id() == id)
-        {
-            return m_computeResources[ii];
-        }
-    }
-    return nullptr;
+    uint32_t idx = computeResourceIndex(id);
+    return idx != UINT32_MAX ? m_computeResources[idx] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+ComputeResource* MacroScheduler::findMicroSchedulerComputeResource(SubIdType microSchedulerId)
+{
+    uint32_t offset = uint32_t(microSchedulerId) - m_minMicroSchedulerId;
+    return offset < m_computeResourcesByMicroSchedulerId.size() ? m_computeResourcesByMicroSchedulerId[offset] : nullptr;
 }
 
 //--------------------------------------------------------------------------
@@ -66,29 +83,188 @@ Vector<ComputeResource*>& MacroScheduler::computeResources()
 //--------------------------------------------------------------------------
 Node* MacroScheduler::allocateNode()
 {
-    // TODO: parallel allocator if needed.
-    return alignedNew<Node, GTS_NO_SHARING_CACHE_LINE_SIZE>(this);
+    void* ptr = m_graphArena.allocate(sizeof(Node));
+    if (!ptr)
+    {
+        return nullptr;
+    }
+    return new (ptr) Node(this);
 }
 
 //--------------------------------------------------------------------------
 void MacroScheduler::destroyNode(Node* pNode)
 {
-    // TODO: parallel allocator if needed.
-    alignedDelete(pNode);
+    if (!pNode)
+    {
+        return;
+    }
+
+    GTS_ASSERT(pNode->myScheduler() == this);
+    pNode->~Node();
+    m_graphArena.deallocate(pNode, sizeof(Node));
+}
+
+//--------------------------------------------------------------------------
+void MacroScheduler::destroyGraph(Node* pSource)
+{
+    if (!pSource)
+    {
+        return;
+    }
+
+    Vector<Node*> nodes;
+    Node::_collectGraph(pSource, nodes);
+
+    for (Node* pNode : nodes)
+    {
+        destroyNode(pNode);
+    }
+}
+
+//--------------------------------------------------------------------------
+void MacroScheduler::freeSchedule(Schedule* pSchedule)
+{
+    if (!pSchedule)
+    {
+        return;
+    }
+
+    GTS_ASSERT(pSchedule->getScheduler() == this);
+
+    Lock<UnfairSpinMutex<>> lock(m_schedulePoolMutex);
+    if (pSchedule->refCount() == 0)
+    {
+        if (pSchedule->isDone())
+        {
+            pSchedule->_detachAppendedNodes();
+        }
+        m_freeSchedules.push_back(pSchedule);
+    }
+    else
+    {
+        m_retiredSchedules.push_back(pSchedule);
+    }
+}
+
+//--------------------------------------------------------------------------
+Schedule* MacroScheduler::_acquirePooledSchedule()
+{
+    Lock<UnfairSpinMutex<>> lock(m_schedulePoolMutex);
+
+    if (m_freeSchedules.empty())
+    {
+        // Reclaim the retired Schedules that are no longer referenced.
+        for (size_t ii = 0; ii < m_retiredSchedules.size();)
+        {
+            if (m_retiredSchedules[ii]->refCount() == 0)
+            {
+                m_freeSchedules.push_back(m_retiredSchedules[ii]);
+                m_retiredSchedules[ii] = m_retiredSchedules.back();
+                m_retiredSchedules.pop_back();
+            }
+            else
+            {
+                ++ii;
+            }
+        }
+
+        if (m_freeSchedules.empty())
+        {
+            return nullptr;
+        }
+    }
+
+    Schedule* pSchedule = m_freeSchedules.back();
+    m_freeSchedules.pop_back();
+    return pSchedule;
+}
+
+//--------------------------------------------------------------------------
+void MacroScheduler::_registerSchedule(Schedule* pSchedule)
+{
+    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
+    {
+        m_computeResources[ii]->registerSchedule(pSchedule);
+    }
+}
+
+//--------------------------------------------------------------------------
+void MacroScheduler::_destroySchedule(Schedule* pSchedule)
+{
+    while (pSchedule->refCount() > 0)
+    {
+        GTS_PAUSE();
+    }
+
+    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
+    {
+        m_computeResources[ii]->unregisterSchedule(pSchedule);
+    }
+
+    unalignedDelete(pSchedule);
+}
+
+//--------------------------------------------------------------------------
+void MacroScheduler::_buildComputeResourceLookups()
+{
+    m_computeResourceIdxById.clear();
+    m_computeResourcesByMicroSchedulerId.clear();
+
+    if (m_computeResources.empty())
+    {
+        return;
+    }
+
+    // Ids are handed out sequentially, so the tables are small and dense.
+
+    ComputeResourceId minId = UINT32_MAX, maxId = 0;
+    uint32_t minMsId = UINT32_MAX, maxMsId = 0;
+    for (ComputeResource* pCompResource : m_computeResources)
+    {
+        minId = gtsMin(minId, pCompResource->id());
+        maxId = gtsMax(maxId, pCompResource->id());
+
+        if (pCompResource->type() == ComputeResourceType::CpuMicroScheduler)
+        {
+            uint32_t msId = ((MicroScheduler_ComputeResource*)pCompResource)->microScheduler()->id();
+            minMsId = gtsMin(minMsId, msId);
+            maxMsId = gtsMax(maxMsId, msId);
+        }
+    }
+
+    m_minComputeResourceId = minId;
+    m_computeResourceIdxById.resize(maxId - minId + 1, UINT32_MAX);
+
+    if (minMsId <= maxMsId)
+    {
+        m_minMicroSchedulerId = (SubIdType)minMsId;
+        m_computeResourcesByMicroSchedulerId.resize(maxMsId - minMsId + 1, nullptr);
+    }
+
+    // Iterate in reverse so the first matching ComputeResource wins.
+    for (size_t ii = m_computeResources.size(); ii-- > 0;)
+    {
+        ComputeResource* pCompResource = m_computeResources[ii];
+        m_computeResourceIdxById[pCompResource->id() - minId] = (uint32_t)ii;
+
+        if (pCompResource->type() == ComputeResourceType::CpuMicroScheduler)
+        {
+            uint32_t msId = ((MicroScheduler_ComputeResource*)pCompResource)->microScheduler()->id();
+            m_computeResourcesByMicroSchedulerId[msId - minMsId] = pCompResource;
+        }
+    }
 }
 
 //--------------------------------------------------------------------------
 void* MacroScheduler::_allocateWorkload(size_t size)
 {
-    // TODO: parallel allocator if needed.
-    return GTS_ALIGNED_MALLOC(size, GTS_NO_SHARING_CACHE_LINE_SIZE);
+    return m_graphArena.allocate(size);
 }
 
 //--------------------------------------------------------------------------
-void MacroScheduler::_freeWorkload(void* ptr)
+void MacroScheduler::_freeWorkload(void* ptr, size_t size)
 {
-    // TODO: parallel allocator if needed.
-    GTS_ALIGNED_FREE(ptr);
+    m_graphArena.deallocate(ptr, size);
 }
 
 } // namespace gts
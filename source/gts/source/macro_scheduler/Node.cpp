@@ -22,14 +22,17 @@
 #include "gts/macro_scheduler/Node.h"
 
 #include <stdarg.h>
-#include <queue>
-#include <unordered_set>
 
 #include "gts/macro_scheduler/Workload.h"
+#include "gts/macro_scheduler/Schedule.h"
 #include "gts/macro_scheduler/ComputeResource.h"
 
 namespace gts {
 
+//! Scratch space for graph traversals, so that resetting a graph for each
+//! execution does not allocate.
+static GTS_THREAD_LOCAL Vector<Node*> tl_graphNodes;
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 // Node
@@ -40,6 +43,11 @@ namespace gts {
 Node::Node(MacroScheduler* pMyScheduler)
     : m_pMyScheduler(pMyScheduler)
     , m_pSchedule(nullptr)
+    , m_predecessors(pMyScheduler->_edgeAllocator())
+    , m_successors(pMyScheduler->_edgeAllocator())
+    , m_subGraphSource(pMyScheduler->_edgeAllocator())
+    , m_pSubGraphSink(nullptr)
+    , m_pSubGraphOwner(nullptr)
     , m_upRank(0)
     , m_downRank(0)
     , m_executionCost(1)
@@ -47,6 +55,8 @@ Node::Node(MacroScheduler* pMyScheduler)
     , m_currPredecessorCount(0)
     , m_initPredecessorCount(0)
     , m_affinity(ANY_COMP_RESOURCE)
+    , m_scheduleIndex(UINT32_MAX)
+    , m_isVisited(false)
     , m_name{0}
     //, m_isIsolated(false)
 {
@@ -54,6 +64,9 @@ Node::Node(MacroScheduler* pMyScheduler)
     {
         m_workloadsByType[ii] = nullptr;
     }
+
+    m_predecessors.reserve(RESERVED_EDGE_COUNT);
+    m_successors.reserve(RESERVED_EDGE_COUNT);
 }
 
 //------------------------------------------------------------------------------
@@ -61,7 +74,7 @@ Node::~Node()
 {
     for (size_t ii = 0; ii < WorkloadType::COUNT; ++ii)
     {
-        m_pMyScheduler->_freeWorkload(m_workloadsByType[ii]);
+        _destroyWorkload((WorkloadType::Enum)ii);
     }
 }
 
@@ -101,34 +114,35 @@ bool Node::isChild(Node* pChild) const
 // MUTATORS:
 
 //------------------------------------------------------------------------------
-void Node::resetGraph(Node* pSource)
+size_t Node::resetGraph(Node* pSource, uint32_t* pOutExitCount)
 {
-    std::unordered_set<Node*> visited;
-
-    std::queue<Node*> q;
-    q.push(pSource);
+    Vector<Node*>& nodes = tl_graphNodes;
+    _collectGraph(pSource, nodes);
 
-    while(!q.empty())
+    uint32_t exitCount = 0;
+    for (Node* pNode : nodes)
     {
-        Node* pCurr = q.front(); q.pop();
-        visited.insert(pCurr);
-        pCurr->reset();
+        pNode->reset();
 
-        for(Node* pSucc : pCurr->successors())
+        if (pNode->flatSuccessors().empty())
         {
-            if(visited.find(pSucc) == visited.end())
-            {
-                q.push(pSucc);
-            }
+            ++exitCount;
         }
     }
+
+    if (pOutExitCount)
+    {
+        *pOutExitCount = exitCount;
+    }
+
+    return nodes.size();
 }
 
 //------------------------------------------------------------------------------
 void Node::removeWorkload(WorkloadType::Enum type)
 {
-    m_pMyScheduler->_freeWorkload(m_workloadsByType[type]);
-    m_workloadsByType[type] = nullptr;
+    _destroyWorkload(type);
+    _onTopologyChanged();
 }
 
 //------------------------------------------------------------------------------
@@ -143,6 +157,117 @@ void Node::reset()
 //------------------------------------------------------------------------------
 void Node::addSuccessor(Node* pNode)
 {
+    _linkSuccessor(pNode);
+
+    // Either end may be the only one compiled into a Schedule.
+    _onTopologyChanged();
+    pNode->_onTopologyChanged();
+}
+
+//------------------------------------------------------------------------------
+void Node::removeSuccessor(Node* pNode)
+{
+    bool removed = false;
+    while (_unlinkSuccessor(pNode))
+    {
+        removed = true;
+    }
+
+    if (removed)
+    {
+        _onTopologyChanged();
+        pNode->_onTopologyChanged();
+    }
+}
+
+//------------------------------------------------------------------------------
+void Node::setSubGraph(Node* pSource, Node* pSink)
+{
+    GTS_ASSERT(pSource && pSink);
+    GTS_ASSERT(pSource->m_pMyScheduler == m_pMyScheduler && pSink->m_pMyScheduler == m_pMyScheduler);
+    GTS_ASSERT(pSource->m_predecessors.empty() && "A sub-graph source cannot have predecessors.");
+    GTS_ASSERT(pSink->m_successors.empty() && "A sub-graph sink cannot have successors.");
+    GTS_ASSERT(pSink->m_pSubGraphOwner == nullptr && "The sub-graph is already nested.");
+
+    clearSubGraph();
+
+    // This Node releases the source like a predecessor.
+    m_subGraphSource.push_back(pSource);
+    ++pSource->m_initPredecessorCount;
+    pSource->m_currPredecessorCount.fetch_add(1, memory_order::acq_rel);
+
+    m_pSubGraphSink = pSink;
+    pSink->m_pSubGraphOwner = this;
+
+    _onTopologyChanged();
+    pSource->_onTopologyChanged();
+}
+
+//------------------------------------------------------------------------------
+void Node::clearSubGraph()
+{
+    if (m_subGraphSource.empty())
+    {
+        return;
+    }
+
+    Node* pSource = m_subGraphSource[0];
+    --pSource->m_initPredecessorCount;
+    pSource->m_currPredecessorCount.fetch_sub(1, memory_order::release);
+    m_subGraphSource.clear();
+
+    m_pSubGraphSink->m_pSubGraphOwner = nullptr;
+    m_pSubGraphSink = nullptr;
+
+    _onTopologyChanged();
+    pSource->_onTopologyChanged();
+}
+
+//------------------------------------------------------------------------------
+void Node::_collectGraph(Node* pSource, Vector<Node*>& out)
+{
+    out.clear();
+    out.push_back(pSource);
+    pSource->m_isVisited = true;
+
+    // 'out' doubles as the BFS queue.
+    for (size_t ii = 0; ii < out.size(); ++ii)
+    {
+        for (Node* pSucc : out[ii]->flatSuccessors())
+        {
+            if (!pSucc->m_isVisited)
+            {
+                pSucc->m_isVisited = true;
+                out.push_back(pSucc);
+            }
+        }
+    }
+
+    for (Node* pNode : out)
+    {
+        pNode->m_isVisited = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void Node::_destroyWorkload(WorkloadType::Enum type)
+{
+    Workload* pWorkload = m_workloadsByType[type];
+    if (!pWorkload)
+    {
+        return;
+    }
+
+    size_t size = pWorkload->m_allocSize;
+    pWorkload->~Workload();
+    m_pMyScheduler->_freeWorkload(pWorkload, size);
+    m_workloadsByType[type] = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void Node::_linkSuccessor(Node* pNode)
+{
+    GTS_ASSERT(m_pSubGraphOwner == nullptr && "A sub-graph sink cannot have successors.");
     m_successors.push_back(pNode);
     pNode->m_predecessors.push_back(this);
     ++pNode->m_initPredecessorCount;
@@ -150,7 +275,7 @@ void Node::addSuccessor(Node* pNode)
 }
 
 //------------------------------------------------------------------------------
-void Node::removeSuccessor(Node* pNode)
+bool Node::_unlinkSuccessor(Node* pNode)
 {
     for (size_t ii = 0; ii < m_successors.size(); ++ii)
     {
@@ -167,14 +292,25 @@ void Node::removeSuccessor(Node* pNode)
                 {
                     std::swap(pNode->m_predecessors[jj], pNode->m_predecessors.back());
                     pNode->m_predecessors.pop_back();
+                    break;
                 }
             }
 
-            // Remove pNode from this Node's children.
             --pNode->m_initPredecessorCount;
             pNode->m_currPredecessorCount.fetch_sub(1, memory_order::release);
+            return true;
         }
     }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void Node::_onTopologyChanged()
+{
+    if (m_pSchedule)
+    {
+        m_pSchedule->_onTopologyChanged();
+    }
 }
 
 //------------------------------------------------------------------------------
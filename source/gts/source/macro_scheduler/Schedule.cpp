@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include "gts/macro_scheduler/Schedule.h"
+
+#include "gts/synchronization/Lock.h"
+#include "gts/macro_scheduler/Node.h"
+
+namespace gts {
+
+// MUTATORS:
+
+//------------------------------------------------------------------------------
+void Schedule::appendNode(Node* pPredecessor, Node* pNode)
+{
+    GTS_ASSERT(pPredecessor && pNode);
+    GTS_ASSERT(pNode->predecessors().empty() && pNode->successors().empty() && "An appended Node must be new.");
+    GTS_ASSERT(pNode->subGraphSource() == nullptr && pNode->subGraphOwner() == nullptr);
+
+    Lock<UnfairSpinMutex<>> lock(m_appendMutex);
+
+    // If the predecessor was an exit, pNode replaces it. Otherwise pNode is
+    // a new exit.
+    bool wasExit = pPredecessor->flatSuccessors().empty();
+    if (!wasExit)
+    {
+        m_openExitCount.fetch_add(1, memory_order::acq_rel);
+    }
+
+    pNode->reset();
+    pPredecessor->_linkSuccessor(pNode);
+    m_appendedEdges.push_back({ pPredecessor, pNode });
+
+    _onEdgeAppended(pPredecessor, pNode);
+}
+
+//------------------------------------------------------------------------------
+void Schedule::appendEdge(Node* pPredecessor, Node* pSuccessor)
+{
+    GTS_ASSERT(pPredecessor && pSuccessor);
+
+    Lock<UnfairSpinMutex<>> lock(m_appendMutex);
+
+    bool wasExit = pPredecessor->flatSuccessors().empty();
+
+    pPredecessor->_linkSuccessor(pSuccessor);
+    m_appendedEdges.push_back({ pPredecessor, pSuccessor });
+
+    _onEdgeAppended(pPredecessor, pSuccessor);
+
+    // pSuccessor is not ready, so an exit after it is still open.
+    if (wasExit)
+    {
+        bool wasLast = _closeExit();
+        GTS_ASSERT(!wasLast);
+        GTS_UNREFERENCED_PARAM(wasLast);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Schedule::removePredecessorRef(Node* pNode)
+{
+    return pNode->_removePredecessorRefAndReturnReady();
+}
+
+//------------------------------------------------------------------------------
+void Schedule::_detachAppendedNodes()
+{
+    GTS_ASSERT(isDone());
+
+    if (m_appendedEdges.empty())
+    {
+        return;
+    }
+
+    // Tasks still unwinding from the last execution may read the edges.
+    while (refCount() > 0)
+    {
+        GTS_PAUSE();
+    }
+
+    // Undo the appends newest first, which leaves the Nodes as they were
+    // compiled.
+    for (size_t ii = m_appendedEdges.size(); ii-- > 0;)
+    {
+        AppendedEdge const& edge = m_appendedEdges[ii];
+        bool unlinked = edge.pPredecessor->_unlinkSuccessor(edge.pSuccessor);
+        GTS_ASSERT(unlinked);
+        GTS_UNREFERENCED_PARAM(unlinked);
+
+        // The execution already consumed the live count.
+        Node* pSucc = edge.pSuccessor;
+        pSucc->m_currPredecessorCount.store(pSucc->m_initPredecessorCount, memory_order::relaxed);
+    }
+    m_appendedEdges.clear();
+}
+
+} // namespace gts
@@ -135,6 +135,21 @@ uint32_t MicroScheduler_ComputeResource::processorCount() const
     return m_physicalProcessorCount;
 }
 
+//------------------------------------------------------------------------------
+uint32_t MicroScheduler_ComputeResource::workerCount() const
+{
+    return m_pMicroScheduler->workerCount();
+}
+
+//------------------------------------------------------------------------------
+uint32_t MicroScheduler_ComputeResource::thisWorkerIndex() const
+{
+    // Threads outside the WorkerPool have an unknown ID, which is past the
+    // last Worker.
+    uint32_t localId = m_pMicroScheduler->thisWorkerId().localId();
+    return localId < m_pMicroScheduler->workerCount() ? localId : UINT32_MAX;
+}
+
 //------------------------------------------------------------------------------
 void MicroScheduler_ComputeResource::notify(Schedule*)
 {
@@ -146,7 +161,17 @@ void MicroScheduler_ComputeResource::notify(Schedule*)
 Task* MicroScheduler_ComputeResource::_tryGetNextTask(CheckForTasksData* pData, bool myQueuesOnly, bool& executedTask)
 {
     GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Cyan2, "_tryGetNextTask");
-    Node* pNode = pData->pSchedule->popNextNode(pData->pSelf, myQueuesOnly);
+
+    // Hold a reference so a freed Schedule is not recycled while it is
+    // polled. Freed and pooled Schedules are done, so they are skipped.
+    pData->pSchedule->addRef(1);
+    Node* pNode = nullptr;
+    if (!pData->pSchedule->isDone())
+    {
+        pNode = pData->pSchedule->popNextNode(pData->pSelf, myQueuesOnly);
+    }
+    pData->pSchedule->removeRef(1);
+
     if (pNode)
     {
         GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Cyan2, "Build Task");
@@ -207,29 +232,50 @@ void MicroScheduler_ComputeResource::unregisterSchedule(Schedule* pSchedule)
 }
 
 //------------------------------------------------------------------------------
-void MicroScheduler_ComputeResource::spawnReadyChildren(WorkloadContext const& workloadContext, Task*)
+Task* MicroScheduler_ComputeResource::spawnReadyChildren(WorkloadContext const& workloadContext, Task*)
 {
     GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::YellowGreen, "Spawn Ready Successors");
 
     //workloadContext.pNode->_waitUntilComplete();
 
     Node* pMyNode = workloadContext.pNode;
+    Schedule* pSchedule = workloadContext.pSchedule;
 
-    Vector<Node*> const& children = pMyNode->successors();
+    // Flattened so that a sub-graph's Nodes are queued like any other.
+    Node::EdgeVector const& children = pMyNode->flatSuccessors();
 
     if(children.size() == 0)
     {
-        workloadContext.pSchedule->tryMarkDone(pMyNode);
+        // A sub-graph sink completes its enclosing Nodes.
+        pSchedule->tryMarkDone(pMyNode->flatExit());
     }
 
+    Node* pBypassNode = nullptr;
+    uint64_t bypassPriority = 0;
+
     for (size_t ii = 0; ii < children.size(); ++ii)
     {
         Node* pChildNode = children[ii];
 
         // If the Node is ready, add it to the list.
-        if (pChildNode->_removePredecessorRefAndReturnReady())
+        if (pSchedule->removePredecessorRef(pChildNode))
         {
-            workloadContext.pSchedule->insertReadyNode(pChildNode);
+            // Keep the most urgent ready Node this ComputeResource can run and
+            // queue the rest.
+            uint64_t priority = 0;
+            if (_canBypass(pSchedule, pChildNode, priority) && (!pBypassNode || priority > bypassPriority))
+            {
+                if (pBypassNode)
+                {
+                    pSchedule->insertReadyNode(pBypassNode);
+                }
+                pBypassNode    = pChildNode;
+                bypassPriority = priority;
+            }
+            else
+            {
+                pSchedule->insertReadyNode(pChildNode);
+            }
         }
     }
 
@@ -238,25 +284,39 @@ void MicroScheduler_ComputeResource::spawnReadyChildren(WorkloadContext const& w
     //    Node* pChildNode = children[ii];
     //    pChildNode->_markPredecessorComplete();
     //}
+
+    if (!pBypassNode)
+    {
+        return nullptr;
+    }
+
+    // Run the kept Node next on this worker without a queue round trip.
+    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::YellowGreen, "Bypass Ready Successor");
+    pBypassNode->_setCurrentSchedule(pSchedule);
+    return _buildTask(pSchedule, pBypassNode);
 }
 
 //------------------------------------------------------------------------------
-bool MicroScheduler_ComputeResource::_buildTaskAndRun(Schedule* pSchedule, Node* pNode)
+bool MicroScheduler_ComputeResource::_canBypass(Schedule* pSchedule, Node* pNode, uint64_t& outPriority)
 {
-    // Find a CPP or ISPC workload.
+    // Nodes with a Worker affinity must be spawned so they reach their Worker.
     MicroScheduler_Workload* pWorkload = _findWorkload(pNode);
-    GTS_ASSERT(pWorkload != nullptr && "Invalid WorkloadType");
-    if (!pWorkload)
+    if (!pWorkload || pWorkload->workerAffinityId() != ANY_WORKER)
     {
         return false;
     }
 
-    // Build the root task.
-    Task* pTask = m_pMicroScheduler->allocateTask<MicroScheduler_Task>(
-        pWorkload,
-        WorkloadContext{ pNode, pSchedule, this });
+    return pSchedule->canBypass(this, pNode, outPriority);
+}
 
-    pTask->setAffinity(pWorkload->workerAffinityId());
+//------------------------------------------------------------------------------
+bool MicroScheduler_ComputeResource::_buildTaskAndRun(Schedule* pSchedule, Node* pNode)
+{
+    Task* pTask = _buildTask(pSchedule, pNode);
+    if (!pTask)
+    {
+        return false;
+    }
 
     // Run it.
     m_pMicroScheduler->spawnTaskAndWait(pTask);
@@ -282,6 +342,9 @@ Task* MicroScheduler_ComputeResource::_buildTask(Schedule* pSchedule, Node* pNod
 
     pTask->setAffinity(pWorkload->workerAffinityId());
 
+    // Released when the Task finishes.
+    pSchedule->addRef(1);
+
     return pTask;
 }
 
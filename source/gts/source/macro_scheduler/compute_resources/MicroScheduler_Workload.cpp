@@ -75,24 +75,27 @@ Task* MicroScheduler_Task::execute(TaskContext const& ctx)
     m_workloadContext.pSchedule->observeExecutionCost(m_workloadContext.pComputeResource->id(), cost);
 #endif
 
-    static_cast<MicroScheduler_ComputeResource*>(m_workloadContext.pComputeResource)->spawnReadyChildren(m_workloadContext, this);
+    // Run a ready successor next, if one was kept for this worker. Its Task
+    // holds its own reference to the Schedule.
+    Task* pBypassTask = static_cast<MicroScheduler_ComputeResource*>(m_workloadContext.pComputeResource)->spawnReadyChildren(m_workloadContext, this);
 
-    return nullptr;
+    m_workloadContext.pSchedule->removeRef(1);
+
+    return pBypassTask;
 }
 
 //------------------------------------------------------------------------------
 ComputeResource* MicroScheduler_Task::findThisComputeResource(SubIdType microSchedulerId)
 {
-    auto& compResources = m_workloadContext.pSchedule->getScheduler()->computeResources();
-    for (uint32_t ii = 0; ii < compResources.size(); ++ii)
+    // Usually the Task runs on the ComputeResource that built it.
+    MicroScheduler_ComputeResource* pBuilder = (MicroScheduler_ComputeResource*)m_workloadContext.pComputeResource;
+    if (pBuilder->microScheduler()->id() == microSchedulerId)
     {
-        if (compResources[ii]->type() == ComputeResourceType::CpuMicroScheduler
-            && ((MicroScheduler_ComputeResource*)compResources[ii])->microScheduler()->id() == microSchedulerId)
-        {
-            return compResources[ii];
-        }
+        return pBuilder;
     }
-    return nullptr;
+
+    // Otherwise it was stolen by another MicroScheduler.
+    return m_workloadContext.pSchedule->getScheduler()->findMicroSchedulerComputeResource(microSchedulerId);
 }
 
 } // namespace gts
@@ -66,37 +66,56 @@ bool CriticalNode_MacroScheduler::init(MacroSchedulerDesc const& desc)
         nextRank += m_computeResources[ii]->processorCount();
     }
 
+    _buildComputeResourceLookups();
+
     return true;
 }
 
 // MUTATORS:
 
 //------------------------------------------------------------------------------
-Schedule* CriticalNode_MacroScheduler::buildSchedule(Node* pStart, Node* pEnd)
+void CriticalNode_MacroScheduler::setCostSmoothingFactor(double factor)
 {
-    CriticalNode_Schedule* pSchedule = unalignedNew<CriticalNode_Schedule>(this, pStart, pEnd);
-    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
-    {
-        m_computeResources[ii]->registerSchedule(pSchedule);
-    }
-    return pSchedule;
+    GTS_ASSERT(factor > 0.0 && factor <= 1.0);
+    m_costSmoothingFactor = factor;
+}
+
+//------------------------------------------------------------------------------
+void CriticalNode_MacroScheduler::setRerankThreshold(double threshold)
+{
+    GTS_ASSERT(threshold >= 0.0);
+    m_rerankThreshold = threshold;
 }
 
-//--------------------------------------------------------------------------
-void CriticalNode_MacroScheduler::freeSchedule(Schedule* pSchedule)
+//------------------------------------------------------------------------------
+void CriticalNode_MacroScheduler::setIncrementalRanking(bool enable)
+{
+    m_isRankingIncremental = enable;
+}
+
+//------------------------------------------------------------------------------
+Schedule* CriticalNode_MacroScheduler::buildSchedule(Node* pStart, Node* pEnd)
 {
-    while (pSchedule->refCount() > 0)
+    // Recycle a freed Schedule's queues and registrations if possible.
+    CriticalNode_Schedule* pSchedule = (CriticalNode_Schedule*)_acquirePooledSchedule();
+    if (pSchedule)
+    {
+        pSchedule->_rebind(pStart, pEnd);
+    }
+    else
     {
-        GTS_PAUSE();
+        pSchedule = unalignedNew<CriticalNode_Schedule>(this, pStart, pEnd);
+        _registerSchedule(pSchedule);
     }
 
-    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
+    if (!pSchedule->_compile())
     {
-        m_computeResources[ii]->unregisterSchedule(pSchedule);
+        freeSchedule(pSchedule);
+        return nullptr;
     }
+    pSchedule->_rankNodes(m_computeResources);
 
-    unalignedDelete(pSchedule);
-    pSchedule = nullptr;
+    return pSchedule;
 }
 
 //------------------------------------------------------------------------------
@@ -110,22 +129,37 @@ void CriticalNode_MacroScheduler::executeSchedule(Schedule* pSchedule, ComputeRe
     // Reset the schedule.
 
     CriticalNode_Schedule* pCritSchedule = (CriticalNode_Schedule*)pSchedule;
-    pCritSchedule->m_isDone.exchange(false, memory_order::acq_rel);
-
-    Node::resetGraph(pCritSchedule->m_pSource);
 
-    //DagUtils::printToDot("costedNodes.gv", pCritSchedule->m_pSource, DagUtils::NodePropertyFlags(DagUtils::NAME | DagUtils::COST));
-
-    //{
-    //    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Cyan, "Preprocess Nodes");
-    //    pCritSchedule->_preProcessNodes(pCritSchedule->m_pSink);
-    //}
+    // Drop the Nodes appended by the last execution if it did not block.
+    pCritSchedule->_detachAppendedNodes();
 
+    // Recompile only if an edge changed, and re-rank only if the costs moved.
+    if (pCritSchedule->_isStale())
+    {
+        if (!pCritSchedule->_compile())
+        {
+            return;
+        }
+        pCritSchedule->_rankNodes(m_computeResources);
+    }
+    else if (pCritSchedule->_smoothCosts(m_costSmoothingFactor, m_rerankThreshold))
     {
-        GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Cyan, "Rank Nodes");
-        pCritSchedule->_rankNodes(m_computeResources, pCritSchedule->m_pSource, pCritSchedule->m_pSink);
+        if (m_isRankingIncremental)
+        {
+            pCritSchedule->_rerankDriftedNodes(m_computeResources);
+        }
+        else
+        {
+            pCritSchedule->_rankNodes(m_computeResources);
+        }
     }
 
+    pCritSchedule->_resetPredecessorCounts();
+    pCritSchedule->_resetOpenExits(pCritSchedule->m_exitCount);
+    pCritSchedule->m_isDone.exchange(false, memory_order::acq_rel);
+
+    //DagUtils::printToDot("costedNodes.gv", pCritSchedule->m_pSource, DagUtils::NodePropertyFlags(DagUtils::NAME | DagUtils::COST));
+
     //DagUtils::printToDot("downRankedNodes.gv", pCritSchedule->m_pSource, DagUtils::NodePropertyFlags(DagUtils::NAME | DagUtils::DOWNRANK));
 
     //
@@ -152,6 +186,9 @@ void CriticalNode_MacroScheduler::executeSchedule(Schedule* pSchedule, ComputeRe
     if (pBlockingCompResource)
     {
         pBlockingCompResource->process(pSchedule, true);
+
+        // Done, so the appended Nodes can be released to the caller.
+        pCritSchedule->_detachAppendedNodes();
     }
 
     //while (!pCritSchedule->m_crticalPath.empty())
@@ -22,8 +22,7 @@
 #include "gts/macro_scheduler/schedulers/heterogeneous/critical_node_task_scheduling/CriticalNode_Schedule.h"
 
 #include <chrono>
-#include <stack>
-#include <queue>
+#include <cstring>
 #include <algorithm>
 
 #include "gts/platform/Assert.h"
@@ -51,6 +50,11 @@ struct alignas(GTS_NO_SHARING_CACHE_LINE_SIZE) UpRank
     gts::Atomic<uint64_t> v = { 0 };
 };
 
+constexpr uint32_t UNRANKED = UINT32_MAX;
+
+// The most ComputeResources an executable mask can hold.
+constexpr size_t MAX_MASKED_RESOURCES = 64;
+
 }
 
 namespace gts {
@@ -58,6 +62,10 @@ namespace gts {
 //------------------------------------------------------------------------------
 CriticalNode_Schedule::CriticalNode_Schedule(MacroScheduler* pMyScheduler, Node* pSource, Node* pSink)
     : Schedule(pMyScheduler)
+    , m_pPredecessorCounts(nullptr)
+    , m_exitCount(0)
+    , m_passCount(0)
+    , m_compiledTopologyVersion(0)
     , m_pSource(pSource)
     , m_pSink(pSink)
     , m_rankTransform(1)
@@ -77,30 +85,37 @@ CriticalNode_Schedule::CriticalNode_Schedule(MacroScheduler* pMyScheduler, Node*
         auto* pCompResource = computeResources[ii];
         for (uint32_t jj = 0; jj < pCompResource->processorCount(); ++jj)
         {
-            m_queuesByRank.push_back({ pCompResource, QueueMPMC<Node*>() });
+            m_queuesByRank.push_back({ pCompResource, ReadyNodeQueue() });
         }
     }
 
     // The last ComputeResource's queue.
-    m_queuesByRank.push_back({ computeResources.back(), QueueMPMC<Node*>() });
+    m_queuesByRank.push_back({ computeResources.back(), ReadyNodeQueue() });
 
-    // Initialize Nodes.
-    std::queue<Node*> q;
-    q.push(pSource);
-    while (!q.empty())
+    // Map between queues and their ComputeResources' indices.
+    m_resourceIdxByQueue.resize(m_queuesByRank.size());
+    m_queueOffsetsByResource.resize(computeResources.size() + 1, 0);
+    for (uint32_t iQueue = 0; iQueue < (uint32_t)m_queuesByRank.size(); ++iQueue)
     {
-        Node* pCurr = q.front(); q.pop();
+        uint32_t iRes = pMyScheduler->computeResourceIndex(m_queuesByRank[iQueue].pComputeResource->id());
+        m_resourceIdxByQueue[iQueue] = iRes;
+        ++m_queueOffsetsByResource[iRes + 1];
+    }
+    for (size_t iRes = 1; iRes < m_queueOffsetsByResource.size(); ++iRes)
+    {
+        m_queueOffsetsByResource[iRes] += m_queueOffsetsByResource[iRes - 1];
+    }
 
-        // If pCurr has not been executed, set its cost to 1.
-        if (pCurr->executionCost() == 0)
-        {
-            pCurr->_setExecutionCost(1);
-        }
+    // Rank for all but the last ComputeResource, which is always 0.
+    m_passCount = (uint32_t)computeResources.size() - 1;
+}
 
-        for (Node* pSucc : pCurr->successors())
-        {
-            q.push(pSucc);
-        }
+//------------------------------------------------------------------------------
+CriticalNode_Schedule::~CriticalNode_Schedule()
+{
+    if (m_pPredecessorCounts)
+    {
+        alignedVectorDelete(m_pPredecessorCounts, m_initPredecessorCounts.size());
     }
 }
 
@@ -143,50 +158,131 @@ void CriticalNode_Schedule::insertReadyNode(Node* pNode)
     // Node has affinity so ship it to that queue.
     if (pNode->affinity() != ANY_COMP_RESOURCE)
     {
-        for (size_t iQueue = 0; iQueue < m_queuesByRank.size(); ++iQueue)
+        uint32_t iRes = getScheduler()->computeResourceIndex(pNode->affinity());
+        if (iRes != UINT32_MAX && m_queueOffsetsByResource[iRes] < m_queueOffsetsByResource[iRes + 1])
         {
-            ComputeResource* pCompResource = m_queuesByRank[iQueue].pComputeResource;
-            if (pNode->affinity() == pCompResource->id())
-            {
-                GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Affinity Node At Queue", iQueue);
-                _insertReadyNode(pNode, m_queuesByRank[iQueue]);
-                pCompResource->notify(this);
-                return;
-            }
+            uint32_t iQueue = m_queueOffsetsByResource[iRes];
+            GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Affinity Node At Queue", iQueue);
+            _insertReadyNode(pNode, m_queuesByRank[iQueue]);
+            m_queuesByRank[iQueue].pComputeResource->notify(this);
+            return;
+        }
+    }
+
+    size_t iQueue = _findReadyQueueIdx(pNode);
+    GTS_ASSERT(iQueue != SIZE_MAX);
+    if (iQueue != SIZE_MAX)
+    {
+        GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Node At Queue", iQueue);
+        _insertReadyNode(pNode, m_queuesByRank[iQueue]);
+        _notifyQueuesOfReadyNode(iQueue);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool CriticalNode_Schedule::canBypass(ComputeResource* pComputeResource, Node* pNode, uint64_t& outPriority) const
+{
+    if (pNode->affinity() != ANY_COMP_RESOURCE)
+    {
+        if (pNode->affinity() != pComputeResource->id())
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // Only bypass Nodes that would have been queued for this
+        // ComputeResource, otherwise the ranking is ignored.
+        size_t iQueue = _findReadyQueueIdx(pNode);
+        if (iQueue == SIZE_MAX || m_queuesByRank[iQueue].pComputeResource != pComputeResource)
+        {
+            return false;
         }
     }
 
+    outPriority = _downRank(pNode);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t CriticalNode_Schedule::_findReadyQueueIdx(Node* pNode) const
+{
+    size_t downRank = m_queuesByRank.size() - (size_t)_downRank(pNode) - 1;
+
+    uint32_t idx = pNode->_scheduleIndex();
+    if (idx < m_executableMasks.size() && m_nodes[idx] == pNode && downRank < m_queuesByRank.size())
+    {
+        // The queues are grouped by ComputeResource, so the first executable
+        // queue at or after the ranked queue is either the ranked queue or
+        // the first queue of a later executable ComputeResource.
+        uint64_t mask = m_executableMasks[idx];
+        uint32_t iRes = m_resourceIdxByQueue[downRank];
+        if (mask & (uint64_t(1) << iRes))
+        {
+            return downRank;
+        }
+
+        uint64_t laterMask = iRes + 1 < MAX_MASKED_RESOURCES ? mask >> (iRes + 1) : 0;
+        if (laterMask)
+        {
+            return m_queueOffsetsByResource[iRes + 1 + gts::lsbScan64(laterMask)];
+        }
+
+        // No ideal queue, so fall back to the last executable queue.
+        uint64_t earlierMask = mask & ((uint64_t(1) << iRes) - 1);
+        if (earlierMask)
+        {
+            return m_queueOffsetsByResource[gts::msbScan64(earlierMask) + 1] - 1;
+        }
+        return SIZE_MAX;
+    }
+
+    // The Node was added after the DAG was compiled, so scan.
     size_t bestMatchIdx = SIZE_MAX;
-    size_t downRank = m_queuesByRank.size() - (size_t)pNode->downRank().load(memory_order::relaxed) - 1;
 
     // Look through all queues for best match because the rank the Node received
     // my not be associated with an executable queue. 
     for (size_t iQueue = 0; iQueue < m_queuesByRank.size(); ++iQueue)
     {
-        ReadyQueue& readyQueue = m_queuesByRank[iQueue];
-
-        if (readyQueue.pComputeResource->canExecute(pNode))
+        if (m_queuesByRank[iQueue].pComputeResource->canExecute(pNode))
         {
             bestMatchIdx = iQueue;
 
             if (downRank <= iQueue)
             {
-                GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Node At Queue", iQueue);
-                _insertReadyNode(pNode, readyQueue);
-                _notifyQueuesOfReadyNode(iQueue);
-                return;
+                return iQueue;
             }
         }
     }
 
     // No ideal queue found so fall back to best match.
-    GTS_ASSERT(bestMatchIdx != SIZE_MAX);
-    if (bestMatchIdx != SIZE_MAX)
+    return bestMatchIdx;
+}
+
+//------------------------------------------------------------------------------
+uint64_t CriticalNode_Schedule::_downRank(Node* pNode) const
+{
+    uint32_t idx = pNode->_scheduleIndex();
+    if (idx < m_nodes.size() && m_nodes[idx] == pNode)
+    {
+        return m_downRanks[idx];
+    }
+    return pNode->downRank().load(memory_order::relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool CriticalNode_Schedule::removePredecessorRef(Node* pNode)
+{
+    uint32_t idx = pNode->_scheduleIndex();
+    if (idx < m_nodes.size() && m_nodes[idx] == pNode)
     {
-        GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Orange, "Inserting Best Matched Node At Queue", bestMatchIdx);
-        _insertReadyNode(pNode, m_queuesByRank[bestMatchIdx]);
-        _notifyQueuesOfReadyNode(bestMatchIdx);
+        uint32_t prevCount = m_pPredecessorCounts[idx].fetch_sub(1, memory_order::acq_rel);
+        GTS_ASSERT(prevCount != 0);
+        return prevCount - 1 == 0;
     }
+
+    // The Node was added after the DAG was compiled.
+    return pNode->_removePredecessorRefAndReturnReady();
 }
 
 //------------------------------------------------------------------------------
@@ -202,176 +298,533 @@ void CriticalNode_Schedule::_notifyQueuesOfReadyNode(size_t lastQueueIdx)
     }
 }
 
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_onEdgeAppended(Node* pPredecessor, Node* pSuccessor)
+{
+    // A compiled successor waits on its compiled count.
+    uint32_t idx = pSuccessor->_scheduleIndex();
+    if (idx < m_nodes.size() && m_nodes[idx] == pSuccessor)
+    {
+        m_pPredecessorCounts[idx].fetch_add(1, memory_order::acq_rel);
+        return;
+    }
+
+    // Rank lazily: an appended Node is as urgent as its most urgent
+    // predecessor. It is detached before the next compile, so it is never
+    // ranked with the DAG.
+    uint64_t downRank = _downRank(pPredecessor);
+    if (downRank > pSuccessor->downRank().load(memory_order::relaxed))
+    {
+        pSuccessor->downRank().store(downRank, memory_order::relaxed);
+    }
+}
+
 //------------------------------------------------------------------------------
 void CriticalNode_Schedule::_insertReadyNode(Node* pNode, ReadyQueue& readyQueue)
 {
     GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Insert Node");
-    readyQueue.queue.tryPush(pNode);
+    bool pushed = readyQueue.queue.tryPush(pNode);
+    GTS_ASSERT(pushed && "Failed to queue a ready Node.");
+    GTS_UNREFERENCED_PARAM(pushed);
 }
 
 //------------------------------------------------------------------------------
-void CriticalNode_Schedule::_rankNodes(
-    Vector<ComputeResource*> const& computeResources,
-    Node* pSource,
-    Node* pSink)
+bool CriticalNode_Schedule::_compile()
 {
-    bool wasRanked = true;
-    uint32_t currRank = (uint32_t)m_queuesByRank.size() - 1;
+    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Compile DAG");
 
-    // Rank for all but the last ComputeResource, which is always 0.
-    for (size_t ii = 0; ii < computeResources.size() - 1 && wasRanked; ++ii)
+    m_compiledTopologyVersion = topologyVersion();
+
+    if (m_pPredecessorCounts)
     {
-        // NOTE: Ideally we'd do a ranking pass per processor, however this is
-        // a big upfront cost which doesn't seem to add any value in practice
-        uint32_t numToRank = computeResources[ii]->processorCount();
-
-        //{
-        //    auto start = std::chrono::high_resolution_clock::now();
-        _upRankNodes(pSink);
-        //    auto end = std::chrono::high_resolution_clock::now();
-
-        //    std::chrono::duration<double> diff = end - start;
-        //    printf("UpRank: %f\n", diff.count());
-        //}
-        //DagUtils::printToDot("upRankedNodes.gv", pSource, DagUtils::NodePropertyFlags(DagUtils::NAME | DagUtils::UPRANK));
-        //{
-        //    auto start = std::chrono::high_resolution_clock::now();
-        wasRanked = _downRankNodes(pSource, currRank, numToRank);
-        //    auto end = std::chrono::high_resolution_clock::now();
-
-        //    std::chrono::duration<double> diff = end - start;
-        //    printf("DownRank: %f\n", diff.count());
-        //}
+        alignedVectorDelete(m_pPredecessorCounts, m_initPredecessorCounts.size());
+        m_pPredecessorCounts = nullptr;
+    }
 
-        currRank -= numToRank;
+    //
+    // Gather the reachable Nodes in BFS order. A Node has been visited if its
+    // index refers back to it. Sub-graphs are flattened into the DAG, so
+    // their Nodes are ranked with the rest.
+
+    Vector<uint32_t> depths;
+
+    m_nodes.clear();
+    m_nodes.push_back(m_pSource);
+    m_pSource->_setScheduleIndex(0);
+    depths.push_back(0);
+
+    for (size_t iNode = 0; iNode < m_nodes.size(); ++iNode)
+    {
+        for (Node* pSucc : m_nodes[iNode]->flatSuccessors())
+        {
+            uint32_t idx = pSucc->_scheduleIndex();
+            if (idx >= m_nodes.size() || m_nodes[idx] != pSucc)
+            {
+                pSucc->_setScheduleIndex((uint32_t)m_nodes.size());
+                m_nodes.push_back(pSucc);
+                depths.push_back(depths[iNode] + 1);
+            }
+        }
     }
-}
 
-//------------------------------------------------------------------------------
-void CriticalNode_Schedule::_upRankNodes(Node* pSink)
-{    
-    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Up-rank nodes");
+    const uint32_t nodeCount = (uint32_t)m_nodes.size();
+
+    //
+    // Order the Nodes topologically.
+
+    Vector<uint32_t> inDegrees(nodeCount, 0);
+    for (Node* pNode : m_nodes)
+    {
+        for (Node* pSucc : pNode->flatSuccessors())
+        {
+            ++inDegrees[pSucc->_scheduleIndex()];
+        }
+    }
+
+    Vector<uint32_t> topoOrder;
+    topoOrder.reserve(nodeCount);
+    topoOrder.push_back(0);
+
+    for (size_t head = 0; head < topoOrder.size(); ++head)
+    {
+        for (Node* pSucc : m_nodes[topoOrder[head]]->flatSuccessors())
+        {
+            uint32_t idx = pSucc->_scheduleIndex();
+            if (--inDegrees[idx] == 0)
+            {
+                topoOrder.push_back(idx);
+            }
+        }
+    }
 
-    // Up-downRank this Node's predecessors with its previously calculated execution
-    // cost. This heuristic relies on a large amount of temporal coherence
-    // between each execution of the Node.
+    if (topoOrder.size() != nodeCount)
+    {
+        GTS_ASSERT(0 && "The DAG has a cycle.");
+        m_nodes.clear();
+        return false;
+    }
 
-    // Init the sink's downRank.
-    if (pSink->downRank().load(memory_order::relaxed) == 0)
+    Vector<Node*> bfsNodes(m_nodes);
+    Vector<uint32_t> bfsDepths(depths);
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
     {
-        pSink->upRank().store(pSink->executionCost(), memory_order::relaxed);
+        m_nodes[ii] = bfsNodes[topoOrder[ii]];
+        m_nodes[ii]->_setScheduleIndex(ii);
+        depths[ii] = bfsDepths[topoOrder[ii]];
+
+        // Edits to the Node now mark this Schedule stale.
+        m_nodes[ii]->_setCurrentSchedule(this);
     }
 
-    std::stack<Node*> q;
-    q.push(pSink);
+    //
+    // Flatten the successors and predecessor counts.
+
+    m_successorOffsets.resize(nodeCount + 1);
+    m_successorIdxs.clear();
+    m_initPredecessorCounts.resize(nodeCount);
+    m_exitCount = 0;
 
-    while (!q.empty())
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
     {
-        Node* pCurr = q.top();
-        q.pop();
+        Node* pNode = m_nodes[ii];
 
-        Vector<Node*>& predecessors = pCurr->predecessors();
-        for (size_t iNode = 0; iNode < predecessors.size(); ++iNode)
+        m_successorOffsets[ii] = (uint32_t)m_successorIdxs.size();
+        for (Node* pSucc : pNode->flatSuccessors())
+        {
+            m_successorIdxs.push_back(pSucc->_scheduleIndex());
+        }
+        if (m_successorOffsets[ii] == (uint32_t)m_successorIdxs.size())
         {
-            Node* pPred = predecessors[iNode];
+            ++m_exitCount;
+        }
 
-            while (true)
-            {
-                uint64_t pPredOldRank = pPred->upRank().load(memory_order::relaxed);
-                uint64_t pCurrRank = pCurr->upRank().load(memory_order::relaxed);
-                uint64_t pPredNewRank = 0;
+        m_initPredecessorCounts[ii] = pNode->initPredecessorCount();
 
-                // If not up-ranked this pass and not previously ranked, add exe cost.
-                if (pPredOldRank == 0 && pPred->downRank().load(memory_order::relaxed) == 0)
-                {
-                    pPredNewRank = pPred->executionCost();
-                }
+        // If the Node has not been executed, set its cost to 1.
+        if (pNode->executionCost() == 0)
+        {
+            pNode->_setExecutionCost(1);
+        }
+    }
+    m_successorOffsets[nodeCount] = (uint32_t)m_successorIdxs.size();
 
-                pPredNewRank += pCurrRank;
+    m_predecessorOffsets.clear();
+    m_predecessorOffsets.resize(nodeCount + 1, 0);
+    for (uint32_t succIdx : m_successorIdxs)
+    {
+        ++m_predecessorOffsets[succIdx + 1];
+    }
+    for (uint32_t ii = 1; ii <= nodeCount; ++ii)
+    {
+        m_predecessorOffsets[ii] += m_predecessorOffsets[ii - 1];
+    }
 
-                // Does this Node increase its predecessor's downRank?
-                if (pPredNewRank > pPredOldRank)
-                {
-                    if (pPred->upRank().compare_exchange_weak(pPredOldRank, pPredNewRank, memory_order::acq_rel, memory_order::relaxed))
-                    {
-                        q.push(pPred);
-                        break;
-                    }
-                }
-                else
+    Vector<uint32_t> nextPred(m_predecessorOffsets);
+    m_predecessorIdxs.resize(m_successorIdxs.size());
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
+    {
+        for (uint32_t iEdge = m_successorOffsets[ii]; iEdge < m_successorOffsets[ii + 1]; ++iEdge)
+        {
+            m_predecessorIdxs[nextPred[m_successorIdxs[iEdge]]++] = ii;
+        }
+    }
+
+    m_pPredecessorCounts = alignedVectorNew<Atomic<uint32_t>, GTS_NO_SHARING_CACHE_LINE_SIZE>(nodeCount);
+
+    //
+    // Group the Nodes by depth for down-ranking.
+
+    uint32_t maxDepth = 0;
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
+    {
+        maxDepth = gtsMax(maxDepth, depths[ii]);
+    }
+
+    m_depthOffsets.clear();
+    m_depthOffsets.resize(maxDepth + 2, 0);
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
+    {
+        ++m_depthOffsets[depths[ii] + 1];
+    }
+    for (uint32_t ii = 1; ii < m_depthOffsets.size(); ++ii)
+    {
+        m_depthOffsets[ii] += m_depthOffsets[ii - 1];
+    }
+
+    Vector<uint32_t> nextSlot(m_depthOffsets);
+    m_nodeIdxsByDepth.resize(nodeCount);
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
+    {
+        m_nodeIdxsByDepth[nextSlot[depths[ii]]++] = ii;
+    }
+
+    m_depths = depths;
+
+    // Every Node can be ready at once, so the queues never need to grow while
+    // the Schedule executes.
+    for (auto& readyQueue : m_queuesByRank)
+    {
+        readyQueue.queue.reserve(nodeCount);
+    }
+
+    //
+    // Cache which ComputeResources can execute each Node.
+
+    m_executableMasks.clear();
+    if (m_queueOffsetsByResource.size() - 1 <= MAX_MASKED_RESOURCES)
+    {
+        auto& computeResources = getScheduler()->computeResources();
+        m_executableMasks.resize(nodeCount, 0);
+        for (uint32_t ii = 0; ii < nodeCount; ++ii)
+        {
+            for (size_t iRes = 0; iRes < computeResources.size(); ++iRes)
+            {
+                bool hasQueues = m_queueOffsetsByResource[iRes] < m_queueOffsetsByResource[iRes + 1];
+                if (hasQueues && computeResources[iRes]->canExecute(m_nodes[ii]))
                 {
-                    break;
+                    m_executableMasks[ii] |= uint64_t(1) << iRes;
                 }
             }
         }
     }
+
+    //
+    // Reset the ranking state.
+
+    m_smoothedCosts.resize(nodeCount);
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
+    {
+        m_smoothedCosts[ii] = double(m_nodes[ii]->executionCost());
+    }
+
+    m_rankedCosts.resize(nodeCount);
+    m_upRanks.resize(size_t(m_passCount) * nodeCount);
+    m_rankPasses.resize(nodeCount);
+    m_downRanks.resize(nodeCount);
+
+    m_seeds.clear();
+    m_seeds.reserve(nodeCount);
+    m_isSeed.clear();
+    m_isSeed.resize(nodeCount, 0);
+
+    m_pending.clear();
+    m_pending.reserve(nodeCount);
+    m_isPending.clear();
+    m_isPending.resize(nodeCount, 0);
+
+    m_dirtyDepths.clear();
+    m_dirtyDepths.reserve(m_depthOffsets.size());
+    m_isDepthDirty.clear();
+    m_isDepthDirty.resize(m_depthOffsets.size(), 0);
+
+    m_rankCandidates.clear();
+    m_rankCandidates.reserve(nodeCount);
+
+    return true;
 }
 
 //------------------------------------------------------------------------------
-bool CriticalNode_Schedule::_downRankNodes(Node* pSource, uint32_t downRank, uint32_t numToRank)
+bool CriticalNode_Schedule::_isStale()
 {
-    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Down-rank nodes");
+    // Another Schedule that compiled or executed the DAG since receives its
+    // edits instead.
+    return m_nodes.empty() ||
+        m_pSource->currentSchedule() != this ||
+        m_compiledTopologyVersion != topologyVersion();
+}
 
-    static auto nodesGreater = [](Node* a, Node* b) {
-        return a->upRank().load(memory_order::relaxed) > b->upRank().load(memory_order::relaxed);
-    };
-    std::priority_queue<Node*, std::vector<Node*>, decltype(nodesGreater)> nodesAtDepth(nodesGreater);
+//------------------------------------------------------------------------------
+bool CriticalNode_Schedule::_smoothCosts(double smoothingFactor, double rerankThreshold)
+{
+    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Smooth costs");
+
+    // Fold the last observed costs into their moving averages. A Node whose
+    // average drifted too far from its ranked cost seeds a re-rank.
+    for (uint32_t ii = 0; ii < (uint32_t)m_nodes.size(); ++ii)
+    {
+        double smoothed = m_smoothedCosts[ii];
+        smoothed += smoothingFactor * (double(m_nodes[ii]->executionCost()) - smoothed);
+        m_smoothedCosts[ii] = smoothed;
+
+        double ranked = double(m_rankedCosts[ii]);
+        double drift  = smoothed > ranked ? smoothed - ranked : ranked - smoothed;
+        if (drift > rerankThreshold * ranked)
+        {
+            m_rankedCosts[ii] = gtsMax(uint64_t(smoothed + 0.5), uint64_t(1));
+            _addSeed(ii);
+        }
+    }
 
-    int currDepth = 0;
-    bool wasNodeRanked = false;
+    return !m_seeds.empty();
+}
 
-    RingDeque<std::pair<Node*, int>> q;
-    q.push_back({ pSource, currDepth });
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_resetPredecessorCounts()
+{
+    static_assert(sizeof(Atomic<uint32_t>) == sizeof(uint32_t), "Atomic<uint32_t> cannot be reset with memcpy.");
 
-    while (!q.empty())
+    // Not executing, so a plain copy is fine. Inserting the source Node
+    // publishes the counts to the ComputeResources.
+    memcpy((void*)m_pPredecessorCounts, m_initPredecessorCounts.data(), m_initPredecessorCounts.size() * sizeof(uint32_t));
+}
+
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_rankNodes(Vector<ComputeResource*> const& computeResources)
+{
+    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Rank nodes");
+
+    const uint32_t nodeCount = (uint32_t)m_nodes.size();
+
+    for (uint32_t ii = 0; ii < nodeCount; ++ii)
     {
-        auto curr = q.front();
-        q.pop_front();
+        m_rankedCosts[ii] = gtsMax(uint64_t(m_smoothedCosts[ii] + 0.5), uint64_t(1));
+        m_rankPasses[ii]  = UNRANKED;
+        m_downRanks[ii]   = 0;
+        m_isSeed[ii]      = 0;
+    }
+    m_seeds.clear();
+
+    uint32_t currRank = (uint32_t)m_queuesByRank.size() - 1;
 
-        if (curr.second > currDepth)
+    for (uint32_t pass = 0; pass < m_passCount; ++pass)
+    {
+        // NOTE: Ideally we'd do a ranking pass per processor, however this is
+        // a big upfront cost which doesn't seem to add any value in practice
+        uint32_t numToRank = computeResources[pass]->processorCount();
+
+        uint64_t* pUpRanks = m_upRanks.data() + size_t(pass) * nodeCount;
+        for (uint32_t ii = nodeCount; ii-- > 0;)
         {
-            uint32_t currRank = downRank;
-            while (!nodesAtDepth.empty())
-            {
-                Node* pNode = nodesAtDepth.top(); nodesAtDepth.pop();
-                pNode->upRank().store(0, memory_order::relaxed);
-                pNode->downRank().store(currRank, memory_order::relaxed);
-                wasNodeRanked = true;
-                --currRank;
-            }
-            ++currDepth;
+            pUpRanks[ii] = _upRank(pass, ii);
         }
 
-        if (curr.first->downRank().load(memory_order::relaxed) == 0)
+        for (uint32_t iDepth = 0; iDepth + 1 < (uint32_t)m_depthOffsets.size(); ++iDepth)
         {
-            nodesAtDepth.push(curr.first);
+            _downRankDepth(pass, iDepth, currRank, numToRank);
+        }
+
+        currRank -= numToRank;
+    }
+
+    // Ranked from scratch, so nothing is left to propagate.
+    for (uint32_t idx : m_seeds)
+    {
+        m_isSeed[idx] = 0;
+    }
+    m_seeds.clear();
+}
+
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_rerankDriftedNodes(Vector<ComputeResource*> const& computeResources)
+{
+    GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Re-rank drifted nodes", m_seeds.size());
+
+    uint32_t currRank = (uint32_t)m_queuesByRank.size() - 1;
 
-            // Only save the number of Nodes to rank.
-            if (nodesAtDepth.size() > numToRank)
+    for (uint32_t pass = 0; pass < m_passCount; ++pass)
+    {
+        uint32_t numToRank = computeResources[pass]->processorCount();
+
+        // Update the up-ranks that depend on the seeds. Depths with a changed
+        // up-rank are marked dirty.
+        _propagateUpRanks(pass);
+
+        // Re-rank the dirty depths. Nodes that change rank here add seeds for
+        // the next pass. Dirty depths stay dirty for the remaining passes,
+        // since a Node's eligibility in later passes may have changed.
+        for (size_t ii = 0; ii < m_dirtyDepths.size(); ++ii)
+        {
+            _downRankDepth(pass, m_dirtyDepths[ii], currRank, numToRank);
+        }
+
+        currRank -= numToRank;
+    }
+
+    for (uint32_t depth : m_dirtyDepths)
+    {
+        m_isDepthDirty[depth] = 0;
+    }
+    m_dirtyDepths.clear();
+
+    for (uint32_t idx : m_seeds)
+    {
+        m_isSeed[idx] = 0;
+    }
+    m_seeds.clear();
+}
+
+//------------------------------------------------------------------------------
+uint64_t CriticalNode_Schedule::_upRank(uint32_t pass, uint32_t idx) const
+{
+    // A Node's up-rank is the costliest path from it to the sink, where Nodes
+    // down-ranked by a previous pass cost nothing. This heuristic relies on a
+    // large amount of temporal coherence between each execution of the Node.
+    const uint64_t* pUpRanks = m_upRanks.data() + size_t(pass) * m_nodes.size();
+
+    uint64_t maxSuccUpRank = 0;
+    for (uint32_t iEdge = m_successorOffsets[idx]; iEdge < m_successorOffsets[idx + 1]; ++iEdge)
+    {
+        maxSuccUpRank = gtsMax(maxSuccUpRank, pUpRanks[m_successorIdxs[iEdge]]);
+    }
+
+    uint64_t cost = m_rankPasses[idx] < pass ? 0 : m_rankedCosts[idx];
+    return cost + maxSuccUpRank;
+}
+
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_propagateUpRanks(uint32_t pass)
+{
+    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Up-rank nodes");
+
+    uint64_t* pUpRanks = m_upRanks.data() + size_t(pass) * m_nodes.size();
+
+    for (uint32_t idx : m_seeds)
+    {
+        if (!m_isPending[idx])
+        {
+            m_isPending[idx] = 1;
+            m_pending.push_back(idx);
+            std::push_heap(m_pending.begin(), m_pending.end());
+        }
+    }
+
+    // Successors have larger indices, so popping the largest index first
+    // finalizes a Node's successors before the Node itself.
+    while (!m_pending.empty())
+    {
+        std::pop_heap(m_pending.begin(), m_pending.end());
+        uint32_t idx = m_pending.back();
+        m_pending.pop_back();
+        m_isPending[idx] = 0;
+
+        uint64_t upRank = _upRank(pass, idx);
+        if (upRank == pUpRanks[idx])
+        {
+            // Stable, so the predecessors are unaffected.
+            continue;
+        }
+
+        pUpRanks[idx] = upRank;
+        _markDepthDirty(m_depths[idx]);
+
+        for (uint32_t iEdge = m_predecessorOffsets[idx]; iEdge < m_predecessorOffsets[idx + 1]; ++iEdge)
+        {
+            uint32_t predIdx = m_predecessorIdxs[iEdge];
+            if (!m_isPending[predIdx])
             {
-                // Done with Node so clear up-rank for next pass.
-                nodesAtDepth.top()->upRank().store(0, memory_order::relaxed);
-                nodesAtDepth.pop();
+                m_isPending[predIdx] = 1;
+                m_pending.push_back(predIdx);
+                std::push_heap(m_pending.begin(), m_pending.end());
             }
         }
+    }
+}
+
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_downRankDepth(uint32_t pass, uint32_t depth, uint32_t downRank, uint32_t numToRank)
+{
+    const uint64_t* pUpRanks = m_upRanks.data() + size_t(pass) * m_nodes.size();
+
+    auto upRankGreater = [pUpRanks](uint32_t a, uint32_t b) {
+        return pUpRanks[a] > pUpRanks[b];
+    };
 
-        for (auto pSucc : curr.first->successors())
+    // Gather the Nodes at this depth not ranked by an earlier pass.
+    m_rankCandidates.clear();
+    for (uint32_t ii = m_depthOffsets[depth]; ii < m_depthOffsets[depth + 1]; ++ii)
+    {
+        uint32_t idx = m_nodeIdxsByDepth[ii];
+        uint32_t rankPass = m_rankPasses[idx];
+        if (rankPass == UNRANKED || rankPass >= pass)
         {
-            q.push_back({ pSucc, curr.second + 1 });
+            m_rankCandidates.push_back(idx);
         }
     }
 
+    // Only rank the most critical Nodes.
+    size_t rankCount = gtsMin(m_rankCandidates.size(), size_t(numToRank));
+    std::partial_sort(m_rankCandidates.begin(), m_rankCandidates.begin() + rankCount, m_rankCandidates.end(), upRankGreater);
+
+    // The least critical of them receives the highest rank.
     uint32_t currRank = downRank;
-    while (!nodesAtDepth.empty())
+    for (size_t ii = 0; ii < m_rankCandidates.size(); ++ii)
+    {
+        size_t iCandidate  = m_rankCandidates.size() - ii - 1;
+        uint32_t idx       = m_rankCandidates[iCandidate];
+        bool isRanked      = iCandidate < rankCount;
+        uint32_t rankPass  = isRanked ? pass : UNRANKED;
+        uint32_t rank      = isRanked ? currRank-- : 0;
+
+        if (m_rankPasses[idx] != rankPass)
+        {
+            // The Node's cost in later passes changed.
+            m_rankPasses[idx] = rankPass;
+            _addSeed(idx);
+        }
+
+        m_downRanks[idx] = rank;
+        m_nodes[idx]->downRank().store(rank, memory_order::relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_markDepthDirty(uint32_t depth)
+{
+    if (!m_isDepthDirty[depth])
     {
-        Node* pNode = nodesAtDepth.top(); nodesAtDepth.pop();
-        pNode->downRank().store(currRank, memory_order::relaxed);
-        wasNodeRanked = true;
-        --currRank;
+        m_isDepthDirty[depth] = 1;
+        m_dirtyDepths.push_back(depth);
     }
-    ++currDepth;
+}
 
-    return wasNodeRanked;
+//------------------------------------------------------------------------------
+void CriticalNode_Schedule::_addSeed(uint32_t idx)
+{
+    if (!m_isSeed[idx])
+    {
+        m_isSeed[idx] = 1;
+        m_seeds.push_back(idx);
+    }
 }
 
 } // namespace gts
@@ -45,6 +45,8 @@ bool CentralQueue_MacroScheduler::init(MacroSchedulerDesc const& desc)
         m_computeResources[ii] = desc.computeResources[ii];
     }
 
+    _buildComputeResourceLookups();
+
     return true;
 }
 
@@ -53,29 +55,17 @@ bool CentralQueue_MacroScheduler::init(MacroSchedulerDesc const& desc)
 //------------------------------------------------------------------------------
 Schedule* CentralQueue_MacroScheduler::buildSchedule(Node* pStart, Node* pEnd)
 {
-    CentralQueue_Schedule* pSchedule = unalignedNew<CentralQueue_Schedule>(this, pStart, pEnd);
-    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
-    {
-        m_computeResources[ii]->registerSchedule(pSchedule);
-    }
-    return pSchedule;
-}
-
-//--------------------------------------------------------------------------
-void CentralQueue_MacroScheduler::freeSchedule(Schedule* pSchedule)
-{
-    while (pSchedule->refCount() > 0)
-    {
-        GTS_PAUSE();
-    }
-
-    for (size_t ii = 0; ii < m_computeResources.size(); ++ii)
+    // Recycle a freed Schedule's queues and registrations if possible.
+    CentralQueue_Schedule* pSchedule = (CentralQueue_Schedule*)_acquirePooledSchedule();
+    if (pSchedule)
     {
-        m_computeResources[ii]->unregisterSchedule(pSchedule);
+        pSchedule->_rebind(pStart, pEnd);
+        return pSchedule;
     }
 
-    unalignedDelete(pSchedule);
-    pSchedule = nullptr;
+    pSchedule = unalignedNew<CentralQueue_Schedule>(this, pStart, pEnd);
+    _registerSchedule(pSchedule);
+    return pSchedule;
 }
 
 //------------------------------------------------------------------------------
@@ -89,9 +79,18 @@ void CentralQueue_MacroScheduler::executeSchedule(Schedule* pSchedule, ComputeRe
     // Reset the schedule.
 
     CentralQueue_Schedule* pCentralQueueSchedule = (CentralQueue_Schedule*)pSchedule;
-    pCentralQueueSchedule->m_isDone.exchange(false, memory_order::acq_rel);
 
-    Node::resetGraph(pCentralQueueSchedule->m_pSource);
+    // Drop the Nodes appended by the last execution if it did not block.
+    pCentralQueueSchedule->_detachAppendedNodes();
+
+    uint32_t exitCount = 0;
+    size_t nodeCount = Node::resetGraph(pCentralQueueSchedule->m_pSource, &exitCount);
+    pCentralQueueSchedule->_reserveReadyQueues(nodeCount);
+    pCentralQueueSchedule->_resetOpenExits(exitCount);
+
+    // ComputeResources skip done Schedules, so the queues can only be polled
+    // after this.
+    pCentralQueueSchedule->m_isDone.exchange(false, memory_order::acq_rel);
 
     //
     // Run the schedule.
@@ -115,6 +114,9 @@ void CentralQueue_MacroScheduler::executeSchedule(Schedule* pSchedule, ComputeRe
     if (pBlockingCompResource)
     {
         pBlockingCompResource->process(pSchedule, true);
+
+        // Done, so the appended Nodes can be released to the caller.
+        pCentralQueueSchedule->_detachAppendedNodes();
     }
 }
 
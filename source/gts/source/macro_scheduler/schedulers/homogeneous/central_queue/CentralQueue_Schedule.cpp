@@ -43,7 +43,7 @@ CentralQueue_Schedule::CentralQueue_Schedule(MacroScheduler* pMyScheduler, Node*
     auto computeResources = pMyScheduler->computeResources();
     for (auto* pCompResource : computeResources)
     {
-        m_affinityQueues.push_back({ pCompResource, QueueMPMC<Node*>() });
+        m_affinityQueues.push_back({ pCompResource, ReadyNodeQueue() });
     }
 }
 
@@ -53,17 +53,14 @@ Node* CentralQueue_Schedule::popNextNode(ComputeResource* pComputeResource, bool
     GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold1, "Pop Next Node");
     Node* pNode = nullptr;
 
-    for (auto& affinityQueue : m_affinityQueues)
+    // The affinity queues are in the MacroScheduler's ComputeResource order.
+    uint32_t iRes = getScheduler()->computeResourceIndex(pComputeResource->id());
+    if (iRes != UINT32_MAX)
     {
-        ComputeResource* pCompResource = affinityQueue.pComputeResource;
-        if (pComputeResource->id() == pCompResource->id())
+        if (m_affinityQueues[iRes].readyQueue.tryPop(pNode))
         {
-            if (affinityQueue.readyQueue.tryPop(pNode))
-            {
-                GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Popped Affinity Node at", pCompResource->id());
-                return pNode;
-            }
-            break;
+            GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Popped Affinity Node at", pComputeResource->id());
+            return pNode;
         }
     }
 
@@ -76,6 +73,25 @@ Node* CentralQueue_Schedule::popNextNode(ComputeResource* pComputeResource, bool
     return pNode;
 }
 
+//------------------------------------------------------------------------------
+bool CentralQueue_Schedule::canBypass(ComputeResource* pComputeResource, Node* pNode, uint64_t& outPriority) const
+{
+    if (pNode->affinity() != ANY_COMP_RESOURCE && pNode->affinity() != pComputeResource->id())
+    {
+        return false;
+    }
+
+    // The central queue is FIFO, so all Nodes are equally urgent.
+    outPriority = 0;
+    return pComputeResource->canExecute(pNode);
+}
+
+//------------------------------------------------------------------------------
+bool CentralQueue_Schedule::removePredecessorRef(Node* pNode)
+{
+    return pNode->_removePredecessorRefAndReturnReady();
+}
+
 //------------------------------------------------------------------------------
 void CentralQueue_Schedule::insertReadyNode(Node* pNode)
 {
@@ -86,20 +102,34 @@ void CentralQueue_Schedule::insertReadyNode(Node* pNode)
     // Node has affinity so ship it to that queue.
     if (pNode->affinity() != ANY_COMP_RESOURCE)
     {
-        for (auto& affinityQueue : m_affinityQueues)
+        uint32_t iRes = getScheduler()->computeResourceIndex(pNode->affinity());
+        if (iRes != UINT32_MAX)
         {
-            ComputeResource* pCompResource = affinityQueue.pComputeResource;
-            if (pNode->affinity() == pCompResource->id())
-            {
-                GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Affinity Node at", pCompResource->id());
-                affinityQueue.readyQueue.tryPush(pNode);
-                pCompResource->notify(this);
-                return;
-            }
+            AffinityQueue& affinityQueue = m_affinityQueues[iRes];
+            GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Affinity Node at", pNode->affinity());
+            bool pushed = affinityQueue.readyQueue.tryPush(pNode);
+            GTS_ASSERT(pushed && "Failed to queue a ready Node.");
+            GTS_UNREFERENCED_PARAM(pushed);
+            affinityQueue.pComputeResource->notify(this);
+            return;
         }
     }
 
-    m_readyQueue.tryPush(pNode);
+    bool pushed = m_readyQueue.tryPush(pNode);
+    GTS_ASSERT(pushed && "Failed to queue a ready Node.");
+    GTS_UNREFERENCED_PARAM(pushed);
+}
+
+//------------------------------------------------------------------------------
+void CentralQueue_Schedule::_reserveReadyQueues(size_t nodeCount)
+{
+    // Every Node can be ready at once, so the queues never need to grow while
+    // the Schedule executes.
+    m_readyQueue.reserve(nodeCount);
+    for (auto& affinityQueue : m_affinityQueues)
+    {
+        affinityQueue.readyQueue.reserve(nodeCount);
+    }
 }
 
 } // namespace gts
@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include "gts/macro_scheduler/schedulers/homogeneous/work_stealing/WorkStealing_Schedule.h"
+
+#include "gts/platform/Assert.h"
+#include "gts/macro_scheduler/Node.h"
+#include "gts/macro_scheduler/MacroScheduler.h"
+#include "gts/macro_scheduler/ComputeResource.h"
+
+namespace gts {
+
+//------------------------------------------------------------------------------
+WorkStealing_Schedule::WorkStealing_Schedule(MacroScheduler* pMyScheduler, Node* pSource, Node* pSink)
+    : Schedule(pMyScheduler)
+    , m_pSource(pSource)
+    , m_pSink(pSink)
+    , m_isDone(true)
+{
+    GTS_ASSERT(pMyScheduler != nullptr);
+    GTS_ASSERT(pSource != nullptr);
+    GTS_ASSERT(pSink != nullptr);
+    GTS_ASSERT(pMyScheduler->computeResources().size() > 0);
+
+    // Populate a queue per Worker and the affinity queues.
+    auto const& computeResources = pMyScheduler->computeResources();
+    for (auto* pCompResource : computeResources)
+    {
+        m_workerQueueOffsets.push_back((uint32_t)m_workerQueues.size());
+        for (uint32_t ii = 0; ii < pCompResource->workerCount(); ++ii)
+        {
+            m_workerQueues.push_back(ReadyNodeQueue());
+        }
+
+        m_affinityQueues.push_back({ pCompResource, ReadyNodeQueue() });
+    }
+    m_workerQueueOffsets.push_back((uint32_t)m_workerQueues.size());
+}
+
+//------------------------------------------------------------------------------
+Node* WorkStealing_Schedule::popNextNode(ComputeResource* pComputeResource, bool myQueuesOnly)
+{
+    GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold1, "Pop Next Node", myQueuesOnly);
+    Node* pNode = nullptr;
+
+    // Affinitized Nodes can only run here, so they go first.
+    uint32_t iRes = getScheduler()->computeResourceIndex(pComputeResource->id());
+    if (iRes != UINT32_MAX)
+    {
+        if (m_affinityQueues[iRes].readyQueue.tryPop(pNode))
+        {
+            GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Popped Affinity Node at", pComputeResource->id());
+            return pNode;
+        }
+    }
+
+    uint32_t iMyQueue = _thisWorkerQueueIdx(pComputeResource);
+    if (iMyQueue != UINT32_MAX && m_workerQueues[iMyQueue].tryPop(pNode))
+    {
+        GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold2, "Popped Node");
+        return pNode;
+    }
+
+    if (m_injectionQueue.tryPop(pNode))
+    {
+        GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold2, "Popped Injected Node");
+        return pNode;
+    }
+
+    if (myQueuesOnly)
+    {
+        return nullptr;
+    }
+
+    //
+    // Steal, starting at the next Worker so that thieves spread out.
+
+    uint32_t queueCount = (uint32_t)m_workerQueues.size();
+    uint32_t startIdx   = iMyQueue != UINT32_MAX ? iMyQueue + 1 : 0;
+    for (uint32_t ii = 0; ii < queueCount; ++ii)
+    {
+        uint32_t iVictim = (startIdx + ii) % queueCount;
+        if (iVictim == iMyQueue || m_workerQueues[iVictim].empty())
+        {
+            continue;
+        }
+
+        if (m_workerQueues[iVictim].tryPop(pNode))
+        {
+            GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold3, "Stole Node from", iVictim);
+            return pNode;
+        }
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool WorkStealing_Schedule::canBypass(ComputeResource* pComputeResource, Node* pNode, uint64_t& outPriority) const
+{
+    if (pNode->affinity() != ANY_COMP_RESOURCE && pNode->affinity() != pComputeResource->id())
+    {
+        return false;
+    }
+
+    // Ready Nodes are not ranked, so all Nodes are equally urgent.
+    outPriority = 0;
+    return pComputeResource->canExecute(pNode);
+}
+
+//------------------------------------------------------------------------------
+bool WorkStealing_Schedule::removePredecessorRef(Node* pNode)
+{
+    return pNode->_removePredecessorRefAndReturnReady();
+}
+
+//------------------------------------------------------------------------------
+void WorkStealing_Schedule::insertReadyNode(Node* pNode)
+{
+    GTS_TRACE_SCOPED_ZONE_P0(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Insert Ready Node");
+
+    pNode->_setCurrentSchedule(this);
+
+    // Node has affinity so ship it to that queue.
+    if (pNode->affinity() != ANY_COMP_RESOURCE)
+    {
+        uint32_t iRes = getScheduler()->computeResourceIndex(pNode->affinity());
+        if (iRes != UINT32_MAX)
+        {
+            AffinityQueue& affinityQueue = m_affinityQueues[iRes];
+            GTS_TRACE_SCOPED_ZONE_P1(gts::analysis::CaptureMask::MACRO_SCHEDULER_PROFILE, gts::analysis::Color::Gold, "Inserting Affinity Node at", pNode->affinity());
+            bool pushed = affinityQueue.readyQueue.tryPush(pNode);
+            GTS_ASSERT(pushed && "Failed to queue a ready Node.");
+            GTS_UNREFERENCED_PARAM(pushed);
+            affinityQueue.pComputeResource->notify(this);
+            return;
+        }
+    }
+
+    // Keep the Node on the Worker that readied it. The Node's predecessor
+    // likely left its inputs in this Worker's cache.
+    uint32_t iMyQueue = _thisWorkerQueueIdx();
+    ReadyNodeQueue& readyQueue = iMyQueue != UINT32_MAX ? m_workerQueues[iMyQueue] : m_injectionQueue;
+
+    bool pushed = readyQueue.tryPush(pNode);
+    GTS_ASSERT(pushed && "Failed to queue a ready Node.");
+    GTS_UNREFERENCED_PARAM(pushed);
+}
+
+//------------------------------------------------------------------------------
+uint32_t WorkStealing_Schedule::_thisWorkerQueueIdx(ComputeResource* pComputeResource)
+{
+    uint32_t iRes = getScheduler()->computeResourceIndex(pComputeResource->id());
+    if (iRes == UINT32_MAX)
+    {
+        return UINT32_MAX;
+    }
+
+    uint32_t iWorker = pComputeResource->thisWorkerIndex();
+    if (iWorker >= m_workerQueueOffsets[iRes + 1] - m_workerQueueOffsets[iRes])
+    {
+        return UINT32_MAX;
+    }
+
+    return m_workerQueueOffsets[iRes] + iWorker;
+}
+
+//------------------------------------------------------------------------------
+uint32_t WorkStealing_Schedule::_thisWorkerQueueIdx()
+{
+    // Homogeneous schedulers rarely have more than a few ComputeResources, so
+    // a scan is cheap.
+    auto const& computeResources = getScheduler()->computeResources();
+    for (auto* pCompResource : computeResources)
+    {
+        uint32_t iQueue = _thisWorkerQueueIdx(pCompResource);
+        if (iQueue != UINT32_MAX)
+        {
+            return iQueue;
+        }
+    }
+    return UINT32_MAX;
+}
+
+//------------------------------------------------------------------------------
+void WorkStealing_Schedule::_reserveReadyQueues(size_t nodeCount)
+{
+    // Every Node can be ready on one Worker at once, so the queues never need
+    // to grow while the Schedule executes.
+    for (auto& workerQueue : m_workerQueues)
+    {
+        workerQueue.reserve(nodeCount);
+    }
+    m_injectionQueue.reserve(nodeCount);
+    for (auto& affinityQueue : m_affinityQueues)
+    {
+        affinityQueue.readyQueue.reserve(nodeCount);
+    }
+}
+
+} // namespace gts
@@ -29,9 +29,11 @@
 #include "gts/synchronization/Lock.h"
 
 #include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/MicroSchedulerAlgorithm.h"
 #include "gts/micro_scheduler/WorkerPool.h"
 
 #include "Worker.h"
+#include "StealHierarchy.h"
 
 namespace gts {
 
@@ -61,9 +63,11 @@ void Task::spawnAndWaitForAll(Task* pChild)
 LocalScheduler::LocalScheduler()
     : m_pPriorityTaskQueue(nullptr)
     , m_pMyScheduler(nullptr)
+    , m_pCounters(nullptr)
     , m_hasDemand{false}
     , m_pWaiterTask(nullptr)
     , m_randState(0)
+    , m_failedNearSteals(0)
     , m_proirityBoostAgeStart(INT16_MAX)
     , m_proirityBoostAge(INT16_MAX)
     , m_currentProirityToBoost(1)
@@ -113,12 +117,15 @@ void LocalScheduler::initialize(
     MicroScheduler* pScheduler,
     uint32_t priorityCount,
     int16_t proirityBoostAge,
-    bool canStealBack)
+    bool canStealBack,
+    uint32_t maxStealBatchSize)
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::AntiqueWhite, "LocalScheduler Init", scheduleId.localId(), 0);
 
     m_pPriorityTaskQueue = pScheduler->m_pPriorityTaskQueue;
     m_pMyScheduler       = pScheduler;
+    m_pAlgorithm         = pScheduler->m_pAlgorithm;
+    m_pStealHierarchy    = pScheduler->m_pWorkerPool->m_pStealHierarchy;
 
     m_id        = scheduleId;
     m_randState = scheduleId.localId() + 1; // can't be zero.
@@ -134,13 +141,59 @@ void LocalScheduler::initialize(
     m_pWaiterTask->header().executionState = internal::TaskHeader::ALLOCATED;
     m_pWaiterTask->header().flags |= internal::TaskHeader::TASK_IS_WAITER;
 
+    m_pCounters = pScheduler->m_counters.workerSlot(scheduleId.localId());
+
     m_stealBack.enabled = canStealBack;
+    m_maxStealBatchSize = gtsMin(maxStealBatchSize, MAX_STEAL_BATCH_SIZE);
 }
 
 //------------------------------------------------------------------------------
 bool LocalScheduler::spawnTask(Task* pTask, uint32_t priority)
 {
-    return m_priorityTaskDeque[priority].tryPush(pTask);
+    if (m_pAlgorithm)
+    {
+        return m_pAlgorithm->push(pTask, priority, m_id.localId());
+    }
+
+    if (!m_priorityTaskDeque[priority].tryPush(pTask))
+    {
+        return false;
+    }
+
+    MicroScheduler::GlobalPriorities* pGlobalPriorities = m_pMyScheduler->m_pGlobalPriorities;
+    if (pGlobalPriorities)
+    {
+        pGlobalPriorities->markOccupied(priority, m_id.localId());
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t LocalScheduler::spawnTasks(Task* const* ppTasks, size_t count, uint32_t priority)
+{
+    if (m_pAlgorithm)
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            if (!m_pAlgorithm->push(ppTasks[ii], priority, m_id.localId()))
+            {
+                return ii;
+            }
+        }
+        return count;
+    }
+
+    if (!m_priorityTaskDeque[priority].tryPushBatch(ppTasks, count))
+    {
+        return 0;
+    }
+
+    MicroScheduler::GlobalPriorities* pGlobalPriorities = m_pMyScheduler->m_pGlobalPriorities;
+    if (pGlobalPriorities)
+    {
+        pGlobalPriorities->markOccupied(priority, m_id.localId());
+    }
+    return count;
 }
 
 //------------------------------------------------------------------------------
@@ -173,14 +226,20 @@ void LocalScheduler::_handleContinuation(Task* pParent, Task*& pBypassTask, SubI
     else
     {
         GTS_SPECULATION_FENCE();
-        if(pParent->removeRef(1) > 1)
+        int32_t refCount = pParent->removeRef(1);
+        if(refCount > 1)
         {
+            if (refCount == internal::TaskHeader::BLOCKED_WAIT_REF + 2)
+            {
+                // Wake the non-worker thread blocked on pParent.
+                MicroScheduler::_signalWaiter(pParent);
+            }
             return;
         }
     }
 
     GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::AntiqueWhite, "L_SCHD PARENT IS CONTINUATION", this, pParent);
-    GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_CONTINUATIONS);
+    GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_CONTINUATIONS);
 
 
     if (pBypassTask == nullptr)
@@ -202,11 +261,17 @@ void LocalScheduler::_handleContinuation(Task* pParent, Task*& pBypassTask, SubI
 //------------------------------------------------------------------------------
 Task* LocalScheduler::_getNonLocalTask(Worker* pThisWorker, bool getAffinity, bool callerIsExternal, bool isLastChance, SubIdType localId, bool& executedWork)
 {
-    Task* pTask = _getQueuedTask(localId);
+    // This LocalScheduler may not be the caller's, so count against the caller.
+    // Steal counts from concurrent external callers are best-effort.
+    analysis::MicroSchedulerCounterSlot* pCounters = callerIsExternal
+        ? m_pMyScheduler->m_counters.externalSlot()
+        : m_pMyScheduler->m_ppLocalSchedulersByIdx[localId]->m_pCounters;
+
+    Task* pTask = _getQueuedTask(localId, pCounters);
 
     if(!pTask && getAffinity)
     {
-        pTask = _getAffinityTask(localId);
+        pTask = _getAffinityTask(localId, pCounters);
         if (pTask)
         {
             // Reset because the submission of an affinitized task
@@ -217,7 +282,7 @@ Task* LocalScheduler::_getNonLocalTask(Worker* pThisWorker, bool getAffinity, bo
 
     if (!pTask)
     {
-        pTask = _stealTask(localId, callerIsExternal);
+        pTask = _stealTask(localId, callerIsExternal, pCounters);
     }
 
     if (!pTask)
@@ -280,7 +345,7 @@ Task* LocalScheduler::_getNonLocalTaskLoop(Task* pWaitingTask, Worker* pThisWork
         else // No work found, try to exit
         {
             GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Red, "L_SCHD TRY EXIT", this, 0);
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_EXIT_ATTEMPTS);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_EXIT_ATTEMPTS);
 
             // If this is a top level worker, try to quit.
             if (isTopLevelWorker)
@@ -321,7 +386,7 @@ Task* LocalScheduler::_getNonLocalTaskLoop(Task* pWaitingTask, Worker* pThisWork
                 {
                     // No tasks. Quit.
                     GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::AntiqueWhite, "L_SCHD LOCAL SCHEDULER EXIT", this, 0);
-                    GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_EXITS);
+                    GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_EXITS);
                     break;
                 }
             }
@@ -352,6 +417,10 @@ Task* LocalScheduler::_getNonLocalTaskLoop(Task* pWaitingTask, Worker* pThisWork
 //------------------------------------------------------------------------------
 void LocalScheduler::_executeTaskLoop(Task* pTask, SubIdType localId, Worker* pThisWorker, bool& executedTask)
 {
+    // Every Task after the first is a bypass. Count them once on the way out
+    // to keep the counters off the execute path.
+    uint64_t executedCount = 0;
+
     while (pTask)
     {
         // ----------------------------------------------------
@@ -361,7 +430,7 @@ void LocalScheduler::_executeTaskLoop(Task* pTask, SubIdType localId, Worker* pT
         {
             // Execute!
             GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Cyan, "L_SCHD EXECUTE TASK", this, pTask);
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_EXECUTED_TASKS);
+            ++executedCount;
             pTask->header().pMyLocalScheduler = this;
             pTask->header().executionState = internal::TaskHeader::EXECUTING;
             pByPassTask = pTask->execute(TaskContext{ m_pMyScheduler, m_id, pTask, pThisWorker->m_pUserData });
@@ -409,6 +478,12 @@ void LocalScheduler::_executeTaskLoop(Task* pTask, SubIdType localId, Worker* pT
 
         --m_proirityBoostAge;
     }
+
+    if (executedCount > 0)
+    {
+        GTS_MS_COUNTER_ADD(m_pCounters, analysis::MicroSchedulerCounters::NUM_EXECUTED_TASKS, executedCount);
+        GTS_MS_COUNTER_ADD(m_pCounters, analysis::MicroSchedulerCounters::NUM_SCHEDULER_BYPASSES, executedCount - 1);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -427,6 +502,11 @@ bool LocalScheduler::runUntilDone(Task* pWaitingTask, Task* pChild)
 
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::AntiqueWhite, "L_SCHD WORKER-LOOP", this, 0);
 
+    if (pWaitingTask && pWaitingTask != m_pWaiterTask)
+    {
+        GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_WAITS);
+    }
+
     // WORKER-LOOP
     while (m_pMyScheduler->m_isAttached.load(memory_order::relaxed))
     {
@@ -495,6 +575,11 @@ Task* LocalScheduler::_getLocalTask(SubIdType localId)
 
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Orange2, "L_SCHD TRY GET LOCAL TASK", this, 0);
 
+    if (m_pAlgorithm)
+    {
+        return m_pAlgorithm->pop(localId);
+    }
+
     Task* pTask = nullptr;
     size_t numPriorities = m_priorityTaskDeque.size();
 
@@ -503,17 +588,22 @@ Task* LocalScheduler::_getLocalTask(SubIdType localId)
         // It's time to boost a priority so that we don't starve a lower priority Task.
         return _getLocalBoostedTask(localId);
     }
+    else if (m_pMyScheduler->m_pGlobalPriorities)
+    {
+        // Get the next task in priority order across all the LocalSchedulers.
+        return _getGlobalPriorityTask(localId);
+    }
     else
     {
         // Get the next task in normal priority order.
         for (size_t priority = 0; priority < numPriorities; ++priority)
         {
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_DEQUE_POP_ATTEMPTS);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_POP_ATTEMPTS);
             TaskDeque& deque = m_priorityTaskDeque[priority];
             if (deque.tryPop(pTask))
             {
                 GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD GOT LOCAL TASK", this, pTask);
-                GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_DEQUE_POP_SUCCESSES);
+                GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_POP_SUCCESSES);
                 return pTask;
             }
         }
@@ -544,22 +634,118 @@ Task* LocalScheduler::_getLocalBoostedTask(SubIdType localId)
     size_t priority = startPriority;
     for (size_t ii = 0; ii < numPriorities - 1; ++ii)
     {
-        GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_BOOSTED_DEQUE_POP_ATTEMPTS);
+        GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_BOOSTED_DEQUE_POP_ATTEMPTS);
         priority = (size_t)((int32_t)priority % ((int32_t)numPriorities - 1)) + 1;
 
         TaskDeque& deque = m_priorityTaskDeque[priority];
         if (deque.tryPop(pTask))
         {
             GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD GOT LOCAL BOOSTED TASK", this, pTask);
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_BOOSTED_DEQUE_POP_SUCCESSES);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_BOOSTED_DEQUE_POP_SUCCESSES);
+            return pTask;
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+Task* LocalScheduler::_getGlobalPriorityTask(SubIdType localId)
+{
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Orange2, "L_SCHD TRY GET GLOBAL PRIORITY TASK", this, 0);
+
+    MicroScheduler::GlobalPriorities* pGlobalPriorities = m_pMyScheduler->m_pGlobalPriorities;
+    const SubIdType myId = m_id.localId();
+
+    Task* pTask = nullptr;
+    size_t numPriorities = m_priorityTaskDeque.size();
+
+    // Drain each priority level across the MicroScheduler before moving on
+    // to the next one.
+    for (size_t priority = 0; priority < numPriorities; ++priority)
+    {
+        GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_POP_ATTEMPTS);
+        TaskDeque& deque = m_priorityTaskDeque[priority];
+        if (deque.tryPop(pTask))
+        {
+            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD GOT LOCAL TASK", this, pTask);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_POP_SUCCESSES);
+            return pTask;
+        }
+
+        // Only this thread pushes to the deque, so it stays empty until we
+        // spawn into it again.
+        pGlobalPriorities->markEmpty((uint32_t)priority, myId);
+
+        TaskQueue& queue = (*m_pPriorityTaskQueue)[priority];
+        if (!queue.empty() && queue.tryPop(pTask))
+        {
+            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD GOT QUEUED TASK", this, pTask);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_QUEUE_POP_SUCCESSES);
+            return pTask;
+        }
+
+        pTask = _stealGlobalPriorityTask(localId, (uint32_t)priority);
+        if (pTask)
+        {
+            return pTask;
+        }
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+Task* LocalScheduler::_stealGlobalPriorityTask(SubIdType localId, uint32_t priority)
+{
+    GTS_UNREFERENCED_PARAM(localId);
+
+    MicroScheduler::GlobalPriorities* pGlobalPriorities = m_pMyScheduler->m_pGlobalPriorities;
+    LocalScheduler** GTS_NOT_ALIASED ppVictims = m_pMyScheduler->m_ppLocalSchedulersByIdx;
+    const uint32_t localSchedulerCount = m_pMyScheduler->m_localSchedulerCount;
+
+    Task* pTask = nullptr;
+
+    // Bounded so that stale bits cannot keep us here. The random steal is
+    // the fallback.
+    for (uint32_t ii = 0; ii < localSchedulerCount; ++ii)
+    {
+        SubIdType victimId = pGlobalPriorities->findVictim(
+            priority, m_id.localId(), (SubIdType)(fastRand(m_randState) % localSchedulerCount));
+
+        if (victimId == UNKNOWN_SUBID)
+        {
+            return nullptr;
+        }
+
+        GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_ATTEMPTS);
+
+        TaskDeque& deque = ppVictims[victimId]->m_priorityTaskDeque[priority];
+        if (deque.trySteal(pTask, m_pCounters))
+        {
+            GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD STOLE GLOBAL PRIORITY TASK", this, pTask);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_SUCCESSES);
+            pTask->header().flags |= internal::TaskHeader::TASK_IS_STOLEN;
+            if (m_stealBack.enabled)
+            {
+                ppVictims[victimId]->m_stealBack.lastThief.store(m_id, memory_order::release);
+            }
+            ppVictims[victimId]->m_hasDemand.store(false, memory_order::release);
             return pTask;
         }
+
+        // Stale or contended. Clear the bit unless the owner refilled it.
+        pGlobalPriorities->markEmpty(priority, victimId);
+        if (!deque.empty())
+        {
+            pGlobalPriorities->markOccupied(priority, victimId);
+        }
     }
+
     return nullptr;
 }
 
 //------------------------------------------------------------------------------
-Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
+Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal, analysis::MicroSchedulerCounterSlot* pCounters)
 {
     GTS_SIM_TRACE_MARKER(sim_trace::MARKER_STEAL_TASK_BEGIN);
 
@@ -567,6 +753,15 @@ Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
 
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Orange2, "L_SCHD TRY STEAL TASK", this, 0);
 
+    if (m_pAlgorithm)
+    {
+        // The algorithm owns all the Tasks, so there is nothing to steal.
+        // Just ask it for the next Task.
+        Task* pTask = m_pAlgorithm->pop(callerIsExternal ? UNKNOWN_SUBID : localId);
+        GTS_SIM_TRACE_MARKER(sim_trace::MARKER_STEAL_TASK_END);
+        return pTask;
+    }
+
     const uint32_t localSchedulerCount = m_pMyScheduler->m_localSchedulerCount;
 
     if (!callerIsExternal && localSchedulerCount == 1)
@@ -577,6 +772,11 @@ Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
 
     LocalScheduler** GTS_NOT_ALIASED ppVictims = m_pMyScheduler->m_ppLocalSchedulersByIdx;
 
+    // Batched Tasks go to the caller's own deque, which only exists if the
+    // caller is one of our Workers. (This LocalScheduler may not be the
+    // caller's.)
+    LocalScheduler* pThief = (m_maxStealBatchSize > 1 && !callerIsExternal) ? ppVictims[localId] : nullptr;
+
     Task* pTask = nullptr;
 
 
@@ -588,11 +788,11 @@ Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
         {
             if (stealBackId.ownerId() == m_id.ownerId())
             {
-                pTask = _stealTaskFrom(localId, stealBackId.localId(), ppVictims, false);
+                pTask = _stealTaskFrom(localId, stealBackId.localId(), ppVictims, pThief, pCounters, false);
             }
             else
             {
-                pTask = _stealBackExternalTask(localId, stealBackId);
+                pTask = _stealBackExternalTask(localId, stealBackId, pCounters);
             }
         }
     }
@@ -611,13 +811,13 @@ Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
 
     for (size_t priority = 0; priority < numPriorities; ++priority)
     {
-        GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_ATTEMPTS);
+        GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_ATTEMPTS);
 
         TaskDeque& deque = victimDeque[priority];
         if (deque.trySteal(pTask))
         {
             GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD STOLE TASK", this, pTask);
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_SUCCESSES);
+            GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_SUCCESSES);
             pTask->header().flags |= internal::TaskHeader::TASK_IS_STOLEN;
             break;
         }
@@ -625,16 +825,20 @@ Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
 
 #else
 
-    uint32_t r = fastRand(m_randState) % (localSchedulerCount);
-
-    if (!pTask)
+    if (!pTask && m_pStealHierarchy && !callerIsExternal)
     {
-        pTask = _stealTaskLoop(localId, ppVictims, r, localSchedulerCount);
+        pTask = _stealTaskByLocality(localId, ppVictims, pThief, pCounters);
     }
-
-    if(!pTask)
+    else if (!pTask)
     {
-        pTask = _stealTaskLoop(localId, ppVictims, 0, r);
+        uint32_t r = fastRand(m_randState) % (localSchedulerCount);
+
+        pTask = _stealTaskLoop(localId, ppVictims, pThief, pCounters, r, localSchedulerCount);
+
+        if(!pTask)
+        {
+            pTask = _stealTaskLoop(localId, ppVictims, pThief, pCounters, 0, r);
+        }
     }
 
 #endif
@@ -644,21 +848,87 @@ Task* LocalScheduler::_stealTask(SubIdType localId, bool callerIsExternal)
 }
 
 //------------------------------------------------------------------------------
-Task* LocalScheduler::_stealTaskLoop(SubIdType localId, LocalScheduler** GTS_NOT_ALIASED ppVictims, uint32_t begin, uint32_t end)
+Task* LocalScheduler::_stealTaskLoop(SubIdType localId, LocalScheduler** GTS_NOT_ALIASED ppVictims, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters, uint32_t begin, uint32_t end)
 {
     GTS_UNREFERENCED_PARAM(localId);
 
     Task* pTask = nullptr;
     for(uint32_t ii = begin; ii < end && !pTask; ++ii)
     {
-        pTask = _stealTaskFrom(localId, (SubIdType)ii, ppVictims, true);
+        pTask = _stealTaskFrom(localId, (SubIdType)ii, ppVictims, pThief, pCounters, true);
     }
 
     return pTask;
 }
 
 //------------------------------------------------------------------------------
-Task* LocalScheduler::_stealTaskFrom(SubIdType localId, SubIdType victimId, LocalScheduler** ppVictims, bool notifyStealBack)
+Task* LocalScheduler::_stealTaskByLocality(SubIdType localId, LocalScheduler** GTS_NOT_ALIASED ppVictims, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters)
+{
+    GTS_ASSERT(m_pStealHierarchy->workerCount() == m_pMyScheduler->m_localSchedulerCount);
+
+    static constexpr size_t attemptCounterByLevel[StealHierarchy::LEVEL_COUNT] = {
+        analysis::MicroSchedulerCounters::NUM_SMT_SIBLING_STEAL_ATTEMPTS,
+        analysis::MicroSchedulerCounters::NUM_SAME_NODE_STEAL_ATTEMPTS,
+        analysis::MicroSchedulerCounters::NUM_REMOTE_STEAL_ATTEMPTS
+    };
+    static constexpr size_t successCounterByLevel[StealHierarchy::LEVEL_COUNT] = {
+        analysis::MicroSchedulerCounters::NUM_SMT_SIBLING_STEAL_SUCCESSES,
+        analysis::MicroSchedulerCounters::NUM_SAME_NODE_STEAL_SUCCESSES,
+        analysis::MicroSchedulerCounters::NUM_REMOTE_STEAL_SUCCESSES
+    };
+
+    SubIdType const* pVictimIds = m_pStealHierarchy->victims(localId);
+
+    // The failure count belongs to the thief, which may not be this scheduler.
+    LocalScheduler* pCaller = ppVictims[localId];
+    const uint32_t remoteStealPeriod = m_pStealHierarchy->remoteStealPeriod();
+
+    // Exhaust each level, nearest first, from a random start within the level.
+    for (uint32_t level = 0; level < StealHierarchy::LEVEL_COUNT; ++level)
+    {
+        const uint32_t begin = m_pStealHierarchy->levelBegin(localId, level);
+        const uint32_t count = m_pStealHierarchy->levelEnd(localId, level) - begin;
+        if (count == 0)
+        {
+            continue;
+        }
+
+        // Only go off node after enough consecutive misses close by.
+        if (level == StealHierarchy::REMOTE && remoteStealPeriod > 1)
+        {
+            if (++pCaller->m_failedNearSteals < remoteStealPeriod)
+            {
+                return nullptr;
+            }
+            pCaller->m_failedNearSteals = 0;
+        }
+
+        const uint32_t r = fastRand(m_randState) % count;
+        for (uint32_t ii = 0; ii < count; ++ii)
+        {
+            const SubIdType victimId = pVictimIds[begin + (r + ii) % count];
+
+            GTS_MS_COUNTER_INC(pCounters, attemptCounterByLevel[level]);
+
+            Task* pTask = _stealTaskFrom(localId, victimId, ppVictims, pThief, pCounters, true);
+            if (pTask)
+            {
+                pCaller->m_failedNearSteals = 0;
+                GTS_MS_COUNTER_INC(pCounters, successCounterByLevel[level]);
+                if (m_pStealHierarchy->isCrossNode(localId, victimId))
+                {
+                    GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_CROSS_NODE_STEALS);
+                }
+                return pTask;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+Task* LocalScheduler::_stealTaskFrom(SubIdType localId, SubIdType victimId, LocalScheduler** ppVictims, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters, bool notifyStealBack)
 {
     GTS_UNREFERENCED_PARAM(localId);
 
@@ -669,13 +939,15 @@ Task* LocalScheduler::_stealTaskFrom(SubIdType localId, SubIdType victimId, Loca
 
     for (size_t priority = 0; priority < numPriorities; ++priority)
     {
-        GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_ATTEMPTS);
+        GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_ATTEMPTS);
 
         TaskDeque& deque = victimDeque[priority];
-        if (deque.trySteal(pTask))
+        if (pThief && pThief != ppVictims[victimId]
+            ? _stealBatch(deque, pTask, pThief, pCounters, (uint32_t)priority)
+            : deque.trySteal(pTask, pCounters))
         {
             GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD STOLE TASK", this, pTask);
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_SUCCESSES);
+            GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_SUCCESSES);
             pTask->header().flags |= internal::TaskHeader::TASK_IS_STOLEN;
             if (m_stealBack.enabled)
             {
@@ -695,12 +967,52 @@ Task* LocalScheduler::_stealTaskFrom(SubIdType localId, SubIdType victimId, Loca
 }
 
 //------------------------------------------------------------------------------
-Task* LocalScheduler::_getQueuedTask(SubIdType localId)
+bool LocalScheduler::_stealBatch(TaskDeque& victimDeque, Task*& pTask, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters, uint32_t priority)
+{
+    Task* stolenTasks[MAX_STEAL_BATCH_SIZE];
+
+    size_t count = victimDeque.tryStealHalf(stolenTasks, m_maxStealBatchSize);
+    if (count == 0)
+    {
+        return false;
+    }
+
+    // Execute the oldest Task and keep the rest for later.
+    pTask = stolenTasks[0];
+
+    if (count > 1)
+    {
+        GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD STOLE BATCH", this, count);
+
+        TaskDeque& thiefDeque = pThief->m_priorityTaskDeque[priority];
+        for (size_t ii = 1; ii < count; ++ii)
+        {
+            GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_DEQUE_STEAL_BATCHED_TASKS);
+
+            // Flag before the push. Once pushed, another thief may take it.
+            stolenTasks[ii]->header().flags |= internal::TaskHeader::TASK_IS_STOLEN;
+
+            bool result = thiefDeque.tryPush(stolenTasks[ii]);
+            GTS_ASSERT(result && "Task queue overflow");
+            GTS_UNREFERENCED_PARAM(result);
+        }
+
+        MicroScheduler::GlobalPriorities* pGlobalPriorities = m_pMyScheduler->m_pGlobalPriorities;
+        if (pGlobalPriorities)
+        {
+            pGlobalPriorities->markOccupied(priority, pThief->m_id.localId());
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+Task* LocalScheduler::_getQueuedTask(SubIdType localId, analysis::MicroSchedulerCounterSlot* pCounters)
 {
     GTS_UNREFERENCED_PARAM(localId);
 
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Orange2, "L_SCHD TRY GET QUEUED TASK", this, 0);
-    GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_QUEUE_POP_ATTEMPTS);
+    GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_QUEUE_POP_ATTEMPTS);
 
     Task* pTask = nullptr;
 
@@ -712,7 +1024,7 @@ Task* LocalScheduler::_getQueuedTask(SubIdType localId)
             if(queue.tryPop(pTask))
             {
                 GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD GOT QUEUED TASK", this, pTask);
-                GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_QUEUE_POP_SUCCESSES);
+                GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_QUEUE_POP_SUCCESSES);
                 return pTask;
             }
         }
@@ -721,7 +1033,7 @@ Task* LocalScheduler::_getQueuedTask(SubIdType localId)
 }
 
 //------------------------------------------------------------------------------
-Task* LocalScheduler::_getAffinityTask(SubIdType localId)
+Task* LocalScheduler::_getAffinityTask(SubIdType localId, analysis::MicroSchedulerCounterSlot* pCounters)
 {
     GTS_UNREFERENCED_PARAM(localId);
 
@@ -731,12 +1043,12 @@ Task* LocalScheduler::_getAffinityTask(SubIdType localId)
 
     for (size_t priority = 0; priority < m_affinityTaskQueue.size(); ++priority)
     {
-        GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_AFFINITY_POP_ATTEMPTS);
+        GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_AFFINITY_POP_ATTEMPTS);
         AffinityTaskQueue& queue = m_affinityTaskQueue[priority];
         if (!queue.empty() && queue.tryPop(pTask))
         {
             GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Blue, "L_SCHD GOT AFFINITY TASK", this, pTask);
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_AFFINITY_POP_SUCCESSES);
+            GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_AFFINITY_POP_SUCCESSES);
             return pTask;
         }
     }
@@ -749,7 +1061,7 @@ Task* LocalScheduler::_stealExternalTask(SubIdType localId)
     GTS_UNREFERENCED_PARAM(localId);
 
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_PROFILE, analysis::Color::Orange2, "L_SCHD TRY STEAL EXTERN TASK", this, 0);
-    GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_EXTERNAL_STEAL_ATTEMPTS);
+    GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_EXTERNAL_STEAL_ATTEMPTS);
 
     Task* pTask                = nullptr;
     MicroScheduler* pScheduler = nullptr;
@@ -773,17 +1085,17 @@ Task* LocalScheduler::_stealExternalTask(SubIdType localId)
         uint32_t localSchedulerCount = pScheduler->m_localSchedulerCount;
         uint32_t r = fastRand(m_randState) % (localSchedulerCount);
 
-        pTask = _stealTaskLoop(localId, ppVictims, r, localSchedulerCount);
+        pTask = _stealTaskLoop(localId, ppVictims, nullptr, m_pCounters, r, localSchedulerCount);
         if(!pTask)
         {
-            pTask = _stealTaskLoop(localId, ppVictims, 0, r);
+            pTask = _stealTaskLoop(localId, ppVictims, nullptr, m_pCounters, 0, r);
         }
 
         pScheduler->m_pExternalSchedulers->m_thiefAccessCount.fetch_sub(1, memory_order::release);
 
         if (pTask)
         {
-            GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_EXTERNAL_STEAL_SUCCESSES);
+            GTS_MS_COUNTER_INC(m_pCounters, analysis::MicroSchedulerCounters::NUM_EXTERNAL_STEAL_SUCCESSES);
             return pTask;
         }
 
@@ -794,7 +1106,7 @@ Task* LocalScheduler::_stealExternalTask(SubIdType localId)
 }
 
 //------------------------------------------------------------------------------
-Task* LocalScheduler::_stealBackExternalTask(SubIdType localId, OwnedId const& stealBackId)
+Task* LocalScheduler::_stealBackExternalTask(SubIdType localId, OwnedId const& stealBackId, analysis::MicroSchedulerCounterSlot* pCounters)
 {
     Task* pTask = nullptr;
     MicroScheduler* pScheduler = nullptr;
@@ -818,13 +1130,13 @@ Task* LocalScheduler::_stealBackExternalTask(SubIdType localId, OwnedId const& s
     }
 
     LocalScheduler** GTS_NOT_ALIASED ppVictims = pScheduler->m_ppLocalSchedulersByIdx;
-    pTask = _stealTaskFrom(localId, stealBackId.localId(), ppVictims, false);
+    pTask = _stealTaskFrom(localId, stealBackId.localId(), ppVictims, nullptr, pCounters, false);
 
     pScheduler->m_pExternalSchedulers->m_thiefAccessCount.fetch_sub(1, memory_order::release);
 
     if (pTask)
     {
-        GTS_MS_COUNTER_INC(m_id, analysis::MicroSchedulerCounters::NUM_EXTERNAL_STEAL_SUCCESSES);
+        GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_EXTERNAL_STEAL_SUCCESSES);
         return pTask;
     }
 
@@ -21,6 +21,7 @@
  ******************************************************************************/
 #pragma once
 
+#include "gts/analysis/Counter.h"
 #include "gts/containers/Vector.h"
 #include "gts/micro_scheduler/MicroSchedulerTypes.h"
 #include "Containers.h"
@@ -28,6 +29,8 @@
 namespace gts {
 
 class MicroScheduler;
+class MicroSchedulerAlgorithm;
+class StealHierarchy;
 class Task;
 class Worker;
 
@@ -71,11 +74,13 @@ public: // MUTATORS:
         MicroScheduler* pScheduler,
         uint32_t priorityCount,
         int16_t proirityToBoostAge,
-        bool canStealBack);
+        bool canStealBack,
+        uint32_t maxStealBatchSize);
 
     bool run(Task* pInitialTask);
 
     bool spawnTask(Task* pTask, uint32_t priority);
+    size_t spawnTasks(Task* const* ppTasks, size_t count, uint32_t priority);
     bool queueAffinityTask(Task* pTask, uint32_t priority);
     bool runUntilDone(Task* pWaitingTask, Task* pChild);
 
@@ -85,15 +90,19 @@ private: // PRIVATE METHODS:
     GTS_NO_INLINE void _handleContinuation(Task* pParent, Task*& pBypassTask, SubIdType localId);
     Task* _getLocalTask(SubIdType localId);
     GTS_NO_INLINE Task* _getLocalBoostedTask(SubIdType localId);
+    GTS_NO_INLINE Task* _getGlobalPriorityTask(SubIdType localId);
+    Task* _stealGlobalPriorityTask(SubIdType localId, uint32_t priority);
     Task* _getNonLocalTaskLoop(Task* pWaitingTask, Worker* pThisWorker, SubIdType localId, bool canStealExternal, bool& executedTask);
-    Task* _getQueuedTask(SubIdType localId);
-    Task* _getAffinityTask(SubIdType localId);
-    Task* _stealTask(SubIdType localId, bool callerIsExternal);
-    Task* _stealTaskLoop(SubIdType localId, LocalScheduler** ppVictims, uint32_t begin, uint32_t end);
-    Task* _stealTaskFrom(SubIdType localId, SubIdType victimId, LocalScheduler** ppVictims, bool notifyStealBack);
+    Task* _getQueuedTask(SubIdType localId, analysis::MicroSchedulerCounterSlot* pCounters);
+    Task* _getAffinityTask(SubIdType localId, analysis::MicroSchedulerCounterSlot* pCounters);
+    Task* _stealTask(SubIdType localId, bool callerIsExternal, analysis::MicroSchedulerCounterSlot* pCounters);
+    Task* _stealTaskLoop(SubIdType localId, LocalScheduler** ppVictims, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters, uint32_t begin, uint32_t end);
+    Task* _stealTaskByLocality(SubIdType localId, LocalScheduler** ppVictims, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters);
+    Task* _stealTaskFrom(SubIdType localId, SubIdType victimId, LocalScheduler** ppVictims, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters, bool notifyStealBack);
+    bool _stealBatch(TaskDeque& victimDeque, Task*& pTask, LocalScheduler* pThief, analysis::MicroSchedulerCounterSlot* pCounters, uint32_t priority);
     Task* _getNonLocalTask(Worker* pThisWorker, bool getAffinity, bool callerIsExternal, bool isLastChance, SubIdType localId, bool& executedTask);
     GTS_NO_INLINE Task* _stealExternalTask(SubIdType localId);
-    Task* LocalScheduler::_stealBackExternalTask(SubIdType localId, OwnedId const& stealbackId);
+    Task* LocalScheduler::_stealBackExternalTask(SubIdType localId, OwnedId const& stealbackId, analysis::MicroSchedulerCounterSlot* pCounters);
 
 private: // DATA:
 
@@ -106,12 +115,17 @@ private: // DATA:
     static constexpr uint16_t TASKS_STATE_FULL  = 1;
     static constexpr uint16_t TASKS_STATE_BUSY  = 2;
 
+    static constexpr uint32_t MAX_STEAL_BATCH_SIZE = 64;
+
     using MutexType = UnfairSpinMutex<>;
 
     PriorityTaskDeque m_priorityTaskDeque;
     PriorityAffinityTaskQueue m_affinityTaskQueue;
     PriorityTaskQueue* m_pPriorityTaskQueue;
     MicroScheduler* m_pMyScheduler;
+    MicroSchedulerAlgorithm* m_pAlgorithm;
+    StealHierarchy const* m_pStealHierarchy;
+    analysis::MicroSchedulerCounterSlot* m_pCounters;
     OwnedId m_id;
 
     struct GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) 
@@ -125,6 +139,8 @@ private: // DATA:
     GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Task* m_pWaiterTask;
 
     uint32_t m_randState;
+    uint32_t m_failedNearSteals;
+    uint32_t m_maxStealBatchSize;
     int16_t m_proirityBoostAgeStart;
     int16_t m_proirityBoostAge;
     int16_t m_currentProirityToBoost;
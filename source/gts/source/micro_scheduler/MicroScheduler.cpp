@@ -28,6 +28,7 @@
 #include "gts/analysis/Trace.h"
 #include "gts/analysis/Counter.h"
 #include "gts/synchronization/Lock.h"
+#include "gts/micro_scheduler/MicroSchedulerAlgorithm.h"
 #include "gts/micro_scheduler/WorkerPool.h"
 
 #include "Worker.h"
@@ -52,6 +53,9 @@ MicroScheduler::MicroScheduler()
     , m_ppLocalSchedulersByIdx(nullptr)
     , m_pExternalSchedulers(nullptr)
     , m_pCallbacks(nullptr)
+    , m_pWaitEvents(nullptr)
+    , m_pGlobalPriorities(nullptr)
+    , m_pAlgorithm(nullptr)
     , m_creationThreadId(0)
     , m_localSchedulerCount(0)
     , m_schedulerId(UINT16_MAX)
@@ -109,10 +113,20 @@ bool MicroScheduler::initialize(MicroSchedulerDesc const& desc)
         return false;
     }
 
+    m_counters.initialize(m_localSchedulerCount);
+
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::AntiqueWhite, "MIRCOSCHED INIT", this, 0);
 
+    if (desc.pAlgorithm && !desc.pAlgorithm->initialize(m_localSchedulerCount, priorityCount))
+    {
+        GTS_ASSERT(0 && "MicroSchedulerAlgorithm failed to initialize.");
+        return false;
+    }
+    m_pAlgorithm = desc.pAlgorithm;
+
     m_pExternalSchedulers = alignedNew<ExternalSchedulers, GTS_NO_SHARING_CACHE_LINE_SIZE>();
     m_pCallbacks          = alignedVectorNew<Callbacks, GTS_NO_SHARING_CACHE_LINE_SIZE>((size_t)MicroSchedulerCallbackType::COUNT);
+    m_pWaitEvents         = alignedNew<WaitEvents, GTS_NO_SHARING_CACHE_LINE_SIZE>();
 
     // Make sure this Worker is registered and is referenced as our Master.
     uintptr_t workerState = m_pWorkerPool->m_pGetThreadLocalStateFcn();
@@ -129,8 +143,9 @@ bool MicroScheduler::initialize(MicroSchedulerDesc const& desc)
             m_pWorkerPool->m_pGetThreadLocalStateFcn,
             m_pWorkerPool->m_pSetThreadLocalStateFcn,
             nullptr,
-            m_pWorkerPool->m_pWorkersByIdx[0].m_cachableTaskSize,
+            m_pWorkerPool->m_pWorkersByIdx[0].m_pTaskPool->cachableTaskSize(),
             0,
+            nullptr,
             true);
 
         m_pWorkerPool->m_pSetThreadLocalStateFcn((uintptr_t)m_pMyMaster);
@@ -146,6 +161,13 @@ bool MicroScheduler::initialize(MicroSchedulerDesc const& desc)
     m_pPriorityTaskQueue = alignedNew<PriorityTaskQueue, GTS_NO_SHARING_CACHE_LINE_SIZE>();
     m_pPriorityTaskQueue->resize(priorityCount);
 
+    // Global priorities are only meaningful when there is something to order.
+    if (desc.useGlobalPriorities && !m_pAlgorithm && priorityCount > 1 && m_localSchedulerCount > 1)
+    {
+        m_pGlobalPriorities = alignedNew<GlobalPriorities, GTS_NO_SHARING_CACHE_LINE_SIZE>(
+            priorityCount, m_localSchedulerCount);
+    }
+
     // Create and init all the Schedulers.
     m_ppLocalSchedulersByIdx = alignedVectorNew<LocalScheduler*, GTS_NO_SHARING_CACHE_LINE_SIZE>(m_localSchedulerCount);
     for (uint16_t ii = 0; ii < m_localSchedulerCount; ++ii)
@@ -156,7 +178,8 @@ bool MicroScheduler::initialize(MicroSchedulerDesc const& desc)
             this,
             desc.priorityCount,
             desc.priorityBoostAge,
-            desc.canStealBackTasks);
+            desc.canStealBackTasks,
+            gtsMax(1u, desc.maxStealBatchSize));
     }
 
     // Attach the Schedulers to Workers.
@@ -194,6 +217,12 @@ void MicroScheduler::shutdown()
     alignedVectorDelete(m_ppLocalSchedulersByIdx, m_localSchedulerCount);
     m_ppLocalSchedulersByIdx = nullptr;
 
+    if (m_pAlgorithm)
+    {
+        m_pAlgorithm->shutdown();
+        m_pAlgorithm = nullptr;
+    }
+
     // A MicroScheduler must be shutdown on the thread that created it, or 
     // it may clear the wrong TL storage.
     GTS_ASSERT(m_pMyMaster->m_threadId == ThisThread::getId() && "A MicroScheduler must be shutdown on the thread that created it.");
@@ -216,16 +245,14 @@ void MicroScheduler::shutdown()
     alignedDelete(m_pExternalSchedulers);
     m_pExternalSchedulers = nullptr;
 
+    alignedDelete(m_pWaitEvents);
+    m_pWaitEvents = nullptr;
+
     alignedDelete(m_pPriorityTaskQueue);
     m_pPriorityTaskQueue = nullptr;
 
-    char filename[128];
-#ifdef GTS_MSVC
-    sprintf_s(filename, "MicroScheduler_Analysis_%d.txt", m_schedulerId);
-#else
-    snprintf(filename, 128, "MicroScheduler_Analysis_%d.txt", m_schedulerId);
-#endif
-    GTS_MS_COUNTER_DUMP_TO(m_schedulerId, filename);
+    alignedDelete(m_pGlobalPriorities);
+    m_pGlobalPriorities = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -254,6 +281,13 @@ void* MicroScheduler::_allocateRawTask(uint32_t size)
 
         pTask->header().pMyLocalScheduler = m_ppLocalSchedulersByIdx[pWorker->id().localId()];
     }
+    else if(TaskPool* pExternalTaskPool = TaskPool::getExternalLocal(m_pWorkerPool))
+    {
+        GTS_TRACE_SCOPED_ZONE_P1(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::Magenta, "MIRCOSCHED ALLOC REGISTERED EXTERNAL THREAD", this);
+
+        pTask = pExternalTaskPool->allocateTask(size);
+        GTS_ASSERT(pTask != nullptr);
+    }
     else
     {
         GTS_TRACE_SCOPED_ZONE_P1(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::DarkMagenta, "MIRCOSCHED ALLOC UNKNOWN WORKER", this);
@@ -269,6 +303,44 @@ void* MicroScheduler::_allocateRawTask(uint32_t size)
     return pTask;
 }
 
+//------------------------------------------------------------------------------
+void MicroScheduler::_allocateRawTasks(uint32_t size, void** ppOut, size_t count)
+{
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::Magenta, "MIRCOSCHED ALLOC TASKS", this, count);
+
+    // Resolve the calling thread's pool once for the whole batch.
+    uintptr_t state = Worker::getLocalState();
+
+    if(state)
+    {
+        Worker* pWorker = (Worker*)state;
+        LocalScheduler* pLocalScheduler = m_ppLocalSchedulersByIdx[pWorker->id().localId()];
+
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            Task* pTask = pWorker->allocateTask(size);
+            GTS_ASSERT(pTask != nullptr);
+            pTask->header().pMyLocalScheduler = pLocalScheduler;
+            ppOut[ii] = pTask;
+        }
+    }
+    else if(TaskPool* pExternalTaskPool = TaskPool::getExternalLocal(m_pWorkerPool))
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            ppOut[ii] = pExternalTaskPool->allocateTask(size);
+            GTS_ASSERT(ppOut[ii] != nullptr);
+        }
+    }
+    else
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            ppOut[ii] = _allocateRawTask(size);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void MicroScheduler::_wakeWorkers(Worker* pThisWorker, uint32_t count, bool reset, bool wakeExternalVictims)
 {
@@ -282,6 +354,17 @@ void MicroScheduler::_wakeWorkers(Worker* pThisWorker, uint32_t count, bool rese
     }
 }
 
+//------------------------------------------------------------------------------
+analysis::MicroSchedulerCounterSlot* MicroScheduler::_counters(Worker* pWorker)
+{
+    // Threads that do not work on this scheduler share one slot.
+    if (pWorker != nullptr && pWorker->id().ownerId() == m_pWorkerPool->poolId())
+    {
+        return m_counters.workerSlot(pWorker->id().localId());
+    }
+    return m_counters.externalSlot();
+}
+
 //------------------------------------------------------------------------------
 void MicroScheduler::_addTask(Worker* pWorker, Task* pTask, uint32_t priority)
 {
@@ -297,8 +380,6 @@ void MicroScheduler::_addTask(Worker* pWorker, Task* pTask, uint32_t priority)
 
     uint32_t mandatoryAffinity = pTask->header().affinity;
 
-    GTS_MS_COUNTER_INC(pWorker ? pWorker->id() : OwnedId(), analysis::MicroSchedulerCounters::NUM_SPAWNS);
-
     bool result = false;
     GTS_UNREFERENCED_PARAM(result);
 
@@ -308,6 +389,7 @@ void MicroScheduler::_addTask(Worker* pWorker, Task* pTask, uint32_t priority)
         GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::SeaGreen, "MIRCOSCHED SPAWN AFFINITY TASK", this, pTask);
 
         GTS_ASSERT(mandatoryAffinity < m_localSchedulerCount && "Worker index out of range.");
+        GTS_MS_COUNTER_INC_SHARED(_counters(pWorker), analysis::MicroSchedulerCounters::NUM_SPAWNS);
 
         result = m_ppLocalSchedulersByIdx[mandatoryAffinity]->queueAffinityTask(pTask, priority);
         GTS_ASSERT(result && "Affinity queue overflow");
@@ -325,6 +407,7 @@ void MicroScheduler::_addTask(Worker* pWorker, Task* pTask, uint32_t priority)
 
         // we are good to queue into this Worker's deque.
         LocalScheduler* pLocalScheduler = m_ppLocalSchedulersByIdx[localId];
+        GTS_MS_COUNTER_INC(pLocalScheduler->m_pCounters, analysis::MicroSchedulerCounters::NUM_SPAWNS);
         result = pLocalScheduler->spawnTask(pTask, priority);
         GTS_ASSERT(result && "Task queue overflow");
 
@@ -336,8 +419,17 @@ void MicroScheduler::_addTask(Worker* pWorker, Task* pTask, uint32_t priority)
     else
     {
         GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::SeaGreen, "MIRCOSCHED QUEUE OFF-SCHED TASK", this, pTask);
+        GTS_MS_COUNTER_INC_SHARED(_counters(pWorker), analysis::MicroSchedulerCounters::NUM_SPAWNS);
+        GTS_MS_COUNTER_INC_SHARED(_counters(pWorker), analysis::MicroSchedulerCounters::NUM_QUEUES);
 
-        result = (*m_pPriorityTaskQueue)[priority].tryPush(pTask);
+        if (m_pAlgorithm)
+        {
+            result = m_pAlgorithm->push(pTask, priority, UNKNOWN_SUBID);
+        }
+        else
+        {
+            result = (*m_pPriorityTaskQueue)[priority].tryPush(pTask);
+        }
         GTS_ASSERT(result && "Task queue overflow");
 
         // Wake any worker.
@@ -347,6 +439,104 @@ void MicroScheduler::_addTask(Worker* pWorker, Task* pTask, uint32_t priority)
     GTS_SIM_TRACE_MARKER(sim_trace::MARKER_PUSH_TASK_END);
 }
 
+//------------------------------------------------------------------------------
+size_t MicroScheduler::_addTasks(Worker* pWorker, Task** ppTasks, size_t count, uint32_t priority)
+{
+    GTS_SIM_TRACE_MARKER(sim_trace::MARKER_PUSH_TASK_BEGIN);
+
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::SeaGreen, "MIRCOSCHED ADD TASKS", this, count);
+
+    // Workers of this scheduler push into their own deque, everyone else into
+    // the MPMC Task queue.
+    LocalScheduler* pLocalScheduler = nullptr;
+    if (pWorker != nullptr && pWorker->id().ownerId() == m_pWorkerPool->poolId())
+    {
+        pLocalScheduler = m_ppLocalSchedulersByIdx[pWorker->id().localId()];
+    }
+    analysis::MicroSchedulerCounterSlot* pCounters = _counters(pWorker);
+
+    size_t queuedCount  = 0;
+    size_t spawnedCount = count;
+    size_t runBegin     = 0;
+
+    // Queue runs of Tasks without a mandatory affinity. Tasks with one are
+    // added individually, since they go to their own Worker.
+    for (size_t ii = 0; ii <= count; ++ii)
+    {
+        if (ii < count)
+        {
+            Task* pTask = ppTasks[ii];
+            GTS_ASSERT(pTask != nullptr);
+            GTS_ASSERT(!(pTask->header().flags & internal::TaskHeader::TASK_IS_CONTINUATION) &&
+                "Cannot queue a continuation.");
+
+            if (pTask->header().affinity == ANY_WORKER)
+            {
+                pTask->header().executionState = internal::TaskHeader::READY;
+                continue;
+            }
+        }
+
+        const size_t runCount = ii - runBegin;
+        if (runCount > 0)
+        {
+            size_t pushedCount = 0;
+
+            if (pLocalScheduler)
+            {
+                pushedCount = pLocalScheduler->spawnTasks(ppTasks + runBegin, runCount, priority);
+                GTS_MS_COUNTER_ADD(pCounters, analysis::MicroSchedulerCounters::NUM_SPAWNS, pushedCount);
+            }
+            else
+            {
+                for (; pushedCount < runCount; ++pushedCount)
+                {
+                    Task* pTask = ppTasks[runBegin + pushedCount];
+                    bool result = m_pAlgorithm
+                        ? m_pAlgorithm->push(pTask, priority, UNKNOWN_SUBID)
+                        : (*m_pPriorityTaskQueue)[priority].tryPush(pTask);
+                    if (!result)
+                    {
+                        break;
+                    }
+                    GTS_MS_COUNTER_INC_SHARED(pCounters, analysis::MicroSchedulerCounters::NUM_SPAWNS);
+                    GTS_MS_COUNTER_INC_SHARED(pCounters, analysis::MicroSchedulerCounters::NUM_QUEUES);
+                }
+            }
+
+            queuedCount += pushedCount;
+
+            // A queue could not grow. Stop, and hand the rest back to the
+            // caller untouched.
+            if (pushedCount < runCount)
+            {
+                spawnedCount = runBegin + pushedCount;
+                for (size_t jj = spawnedCount; jj < ii; ++jj)
+                {
+                    ppTasks[jj]->header().executionState = internal::TaskHeader::ALLOCATED;
+                }
+                break;
+            }
+        }
+
+        if (ii < count)
+        {
+            _addTask(pWorker, ppTasks[ii], priority);
+        }
+        runBegin = ii + 1;
+    }
+
+    if (queuedCount > 0)
+    {
+        // Woken Workers wake the next one until the count is spent or no
+        // one is left sleeping.
+        _wakeWorkers(pWorker, (uint32_t)gtsMin(queuedCount, (size_t)m_localSchedulerCount), true, true);
+    }
+
+    GTS_SIM_TRACE_MARKER(sim_trace::MARKER_PUSH_TASK_END);
+    return spawnedCount;
+}
+
 //------------------------------------------------------------------------------
 void MicroScheduler::spawnTask(Task* pTask, uint32_t priority)
 {
@@ -355,6 +545,14 @@ void MicroScheduler::spawnTask(Task* pTask, uint32_t priority)
     _addTask(pWorker, pTask, priority);
 }
 
+//------------------------------------------------------------------------------
+size_t MicroScheduler::spawnTasks(Task** ppTasks, size_t count, uint32_t priority)
+{
+    uintptr_t state = Worker::getLocalState();
+    Worker* pWorker = (Worker*)state;
+    return _addTasks(pWorker, ppTasks, count, priority);
+}
+
 //------------------------------------------------------------------------------
 void MicroScheduler::spawnTaskAndWait(Task* pTask, uint32_t priority)
 {
@@ -411,18 +609,42 @@ void MicroScheduler::_wait(Worker* pWorker, Task* pWaiterTask, Task* pChild)
     {
         _wakeWorkers(pWorker, 1, true, true);
 
-        // TODO: use Event
-
-        // Block until done.
-        BackoffType backoff;
-        while (pWaiterTask->refCount() > 2)
+        if (pWaiterTask->refCount() > 2)
         {
-            backoff.tick();
-            _wakeWorkers(pWorker, 1, true, true);
+            // Block until the last child signals the event. The waiter publishes
+            // the event and then biases the ref count. Only the child whose
+            // removeRef observes the biased count of 2 touches pWaiterTask
+            // afterwards, and the waiter cannot return until that child has
+            // signaled, so pWaiterTask outlives every access to it.
+            BinarySemaphore* pEvent = m_pWaitEvents->acquire();
+            Atomic<BinarySemaphore*>& waitEvent = pWaiterTask->header().pWaitEvent;
+            Atomic<int32_t>& refCount = pWaiterTask->header().refCount;
+            waitEvent.store(pEvent, memory_order::relaxed);
+
+            if (refCount.fetch_add(internal::TaskHeader::BLOCKED_WAIT_REF, memory_order::acq_rel) > 2)
+            {
+                pEvent->wait();
+            }
+
+            refCount.fetch_sub(internal::TaskHeader::BLOCKED_WAIT_REF, memory_order::acq_rel);
+            GTS_ASSERT(pWaiterTask->refCount() == 2);
+            waitEvent.store(nullptr, memory_order::relaxed);
+
+            m_pWaitEvents->release(pEvent);
         }
     }
 }
 
+//------------------------------------------------------------------------------
+void MicroScheduler::_signalWaiter(Task* pWaiterTask)
+{
+    // Called by the last child of a blocked waiter. Signaling must be the last
+    // access, since the waiter may destroy pWaiterTask as soon as it wakes.
+    BinarySemaphore* pEvent = pWaiterTask->header().pWaitEvent.load(memory_order::acquire);
+    GTS_ASSERT(pEvent != nullptr);
+    pEvent->signal();
+}
+
 //------------------------------------------------------------------------------
 void MicroScheduler::destoryTask(Task* pTask)
 {
@@ -441,8 +663,14 @@ void MicroScheduler::destoryTask(Task* pTask)
         else
         {
             GTS_SPECULATION_FENCE();
-            if(pParent->removeRef(1) > 1)
+            int32_t refCount = pParent->removeRef(1);
+            if(refCount > 1)
             {
+                if (refCount == internal::TaskHeader::BLOCKED_WAIT_REF + 2)
+                {
+                    // Wake the non-worker thread blocked on pParent.
+                    _signalWaiter(pParent);
+                }
                 return;
             }
         }
@@ -459,7 +687,7 @@ void MicroScheduler::addExternalVictim(MicroScheduler* pScheduler)
         return;
     }
 
-    GTS_MS_COUNTER_INC(OwnedId(m_schedulerId, 0), gts::analysis::MicroSchedulerCounters::NUM_SCHEDULER_REGISTERS);
+    GTS_MS_COUNTER_INC_SHARED(m_counters.externalSlot(), gts::analysis::MicroSchedulerCounters::NUM_SCHEDULER_REGISTERS);
 
     m_pExternalSchedulers->registerVictim(pScheduler, this);
 }
@@ -467,7 +695,7 @@ void MicroScheduler::addExternalVictim(MicroScheduler* pScheduler)
 //--------------------------------------------------------------------------
 void MicroScheduler::removeExternalVictim(MicroScheduler* pScheduler)
 {
-    GTS_MS_COUNTER_INC(OwnedId(m_schedulerId, 0), gts::analysis::MicroSchedulerCounters::NUM_SCHEDULER_UNREGISTERS);
+    GTS_MS_COUNTER_INC_SHARED(m_counters.externalSlot(), gts::analysis::MicroSchedulerCounters::NUM_SCHEDULER_UNREGISTERS);
 
     m_pExternalSchedulers->unregisterVictim(pScheduler, this);
 }
@@ -485,10 +713,25 @@ void MicroScheduler::_freeTask(Task* pTask)
         GTS_TRACE_SCOPED_ZONE_P1(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::Magenta, "MIRCOSCHED FREE KNOWN TASK", this);
         ((Worker*)state)->freeTask(pTask);
     }
+    else if(TaskPool* pExternalTaskPool = TaskPool::getExternalLocal(m_pWorkerPool))
+    {
+        GTS_TRACE_SCOPED_ZONE_P1(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::Magenta, "MIRCOSCHED FREE REGISTERED EXTERNAL TASK", this);
+        pExternalTaskPool->freeTask(pTask);
+    }
     else
     {
         GTS_TRACE_SCOPED_ZONE_P1(analysis::CaptureMask::MICRO_SCHEDULER_DEBUG, analysis::Color::DarkMagenta, "MIRCOSCHED FREE UNKNOWN TASK", this);
-        GTS_ALIGNED_FREE(&pTask->header());
+
+        internal::TaskHeader& header = pTask->header();
+        if ((header.flags & internal::TaskHeader::TASK_IS_SMALL) && header.pMyTaskPool != nullptr)
+        {
+            // Pooled memory, possibly from a TaskArena. Give it back to its owner.
+            header.pMyTaskPool->freeTaskDeferred(pTask);
+        }
+        else
+        {
+            GTS_ALIGNED_FREE(&header);
+        }
     }
 }
 
@@ -500,6 +743,12 @@ void MicroScheduler::wakeWorker()
     _wakeWorkers(pWorker, 1, true, false);
 }
 
+//------------------------------------------------------------------------------
+void MicroScheduler::getCounters(analysis::MicroSchedulerCounterSnapshot& out) const
+{
+    m_counters.snapshot(out);
+}
+
 //------------------------------------------------------------------------------
 bool MicroScheduler::stealAndExecuteTask()
 {
@@ -573,6 +822,11 @@ uint32_t MicroScheduler::workerCount() const
 //------------------------------------------------------------------------------
 bool MicroScheduler::_hasDequeTasks() const
 {
+    if (m_pAlgorithm)
+    {
+        return m_pAlgorithm->hasTasks();
+    }
+
     for (size_t ii = 0, len = m_localSchedulerCount; ii < len; ++ii)
     {
         if(m_ppLocalSchedulersByIdx[ii]->hasDequeTasks())
@@ -980,5 +1234,107 @@ int32_t MicroScheduler::Callbacks::_locateCallback(uintptr_t func, void* pData)
     return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// class WaitEvents
+
+//------------------------------------------------------------------------------
+MicroScheduler::WaitEvents::~WaitEvents()
+{
+    for (uint32_t ii = 0; ii < m_freeEvents.size(); ++ii)
+    {
+        alignedDelete(m_freeEvents[ii]);
+    }
+}
+
+//------------------------------------------------------------------------------
+BinarySemaphore* MicroScheduler::WaitEvents::acquire()
+{
+    {
+        Lock<mutex_type> lock(m_mutex);
+        if (!m_freeEvents.empty())
+        {
+            BinarySemaphore* pEvent = m_freeEvents.back();
+            m_freeEvents.pop_back();
+            return pEvent;
+        }
+    }
+    return alignedNew<BinarySemaphore, GTS_NO_SHARING_CACHE_LINE_SIZE>();
+}
+
+//------------------------------------------------------------------------------
+void MicroScheduler::WaitEvents::release(BinarySemaphore* pEvent)
+{
+    pEvent->reset();
+
+    Lock<mutex_type> lock(m_mutex);
+    m_freeEvents.push_back(pEvent);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// class GlobalPriorities
+
+//------------------------------------------------------------------------------
+MicroScheduler::GlobalPriorities::GlobalPriorities(uint32_t priorityCount, uint32_t localSchedulerCount)
+    : m_priorityCount(priorityCount)
+    , m_wordCount((localSchedulerCount + 63) / 64)
+{
+    // Give each priority its own cache line(s) so that spawning at one
+    // priority does not invalidate the masks of another.
+    constexpr uint32_t wordsPerLine = GTS_NO_SHARING_CACHE_LINE_SIZE / sizeof(uint64_t);
+    m_wordStride = ((m_wordCount + wordsPerLine - 1) / wordsPerLine) * wordsPerLine;
+
+    const size_t totalWords = size_t(m_priorityCount) * m_wordStride;
+    m_pOccupancyMasks = alignedVectorNew<Atomic<uint64_t>, GTS_NO_SHARING_CACHE_LINE_SIZE>(totalWords);
+    for (size_t ii = 0; ii < totalWords; ++ii)
+    {
+        m_pOccupancyMasks[ii].store(0, memory_order::relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+MicroScheduler::GlobalPriorities::~GlobalPriorities()
+{
+    alignedVectorDelete(m_pOccupancyMasks, size_t(m_priorityCount) * m_wordStride);
+}
+
+//------------------------------------------------------------------------------
+SubIdType MicroScheduler::GlobalPriorities::findVictim(uint32_t priority, SubIdType thiefId, SubIdType startId) const
+{
+    Atomic<uint64_t> const* pMasks = m_pOccupancyMasks + priority * m_wordStride;
+
+    const uint32_t startWord = startId >> 6;
+    const uint64_t startBit  = _bit(startId);
+
+    // Wrap around the words starting at 'startWord'. The start word is visited
+    // twice: first for the bits below 'startId' and last for the rest.
+    for (uint32_t ii = 0; ii <= m_wordCount; ++ii)
+    {
+        const uint32_t word = (startWord + ii) % m_wordCount;
+
+        uint64_t mask = pMasks[word].load(memory_order::acquire);
+        if (word == (thiefId >> 6))
+        {
+            mask &= ~_bit(thiefId);
+        }
+
+        if (ii == 0)
+        {
+            mask &= startBit - 1;
+        }
+        else if (ii == m_wordCount)
+        {
+            mask &= ~(startBit - 1);
+        }
+
+        if (mask != 0)
+        {
+            return (SubIdType)((word << 6) + GTS_MSB_SCAN64(mask));
+        }
+    }
+
+    return UNKNOWN_SUBID;
+}
 
 } // namespace gts
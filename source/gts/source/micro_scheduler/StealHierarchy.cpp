@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include "StealHierarchy.h"
+
+#include "gts/platform/Assert.h"
+
+namespace gts {
+
+namespace {
+
+//------------------------------------------------------------------------------
+bool coreHasHwThread(CpuCoreInfo const& core, uint32_t hwTid)
+{
+    for (size_t ii = 0; ii < core.hardwareThreadIdCount; ++ii)
+    {
+        if (core.pHardwareThreadIds[ii] == hwTid)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+template<typename TInfo>
+bool infoHasHwThread(TInfo const& info, uint32_t hwTid)
+{
+    for (size_t ii = 0; ii < info.coreInfoElementCount; ++ii)
+    {
+        if (coreHasHwThread(info.pCoreInfoArray[ii], hwTid))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Socket IDs are offset so they cannot collide with NUMA node IDs.
+constexpr uint32_t SOCKET_NODE_OFFSET = 1 << 16;
+
+//------------------------------------------------------------------------------
+uint32_t findNode(ProcessorGroupInfo const& group, uint32_t hwTid, uint32_t socketOffset)
+{
+    for (size_t ii = 0; ii < group.numaNodeInfoElementCount; ++ii)
+    {
+        NumaNodeInfo const& node = group.pNumaInfoArray[ii];
+        if (infoHasHwThread(node, hwTid))
+        {
+            return node.nodeId != SIZE_MAX ? (uint32_t)node.nodeId : (uint32_t)ii;
+        }
+    }
+
+    // No NUMA information. Treat each socket as a node.
+    for (size_t ii = 0; ii < group.socketInfoElementCount; ++ii)
+    {
+        if (infoHasHwThread(group.pSocketInfoArray[ii], hwTid))
+        {
+            return SOCKET_NODE_OFFSET + socketOffset + (uint32_t)ii;
+        }
+    }
+
+    return StealHierarchy::UNKNOWN_LOCATION;
+}
+
+//------------------------------------------------------------------------------
+void locateWorker(
+    SystemTopology const& topology,
+    WorkerThreadDesc::GroupAndAffinity const& affinity,
+    uint32_t& outCore,
+    uint32_t& outNode)
+{
+    outCore = StealHierarchy::UNKNOWN_LOCATION;
+    outNode = StealHierarchy::UNKNOWN_LOCATION;
+
+    if (affinity.affinitySet.empty())
+    {
+        return;
+    }
+
+    uint32_t coreOffset   = 0;
+    uint32_t socketOffset = 0;
+
+    for (size_t iGroup = 0; iGroup < topology.groupInfoElementCount; ++iGroup)
+    {
+        ProcessorGroupInfo const& group = topology.pGroupInfoArray[iGroup];
+
+        if (group.groupId == affinity.group)
+        {
+            for (size_t iCore = 0; iCore < group.coreInfoElementCount; ++iCore)
+            {
+                CpuCoreInfo const& core = group.pCoreInfoArray[iCore];
+                for (size_t iThread = 0; iThread < core.hardwareThreadIdCount; ++iThread)
+                {
+                    const uint32_t hwTid = core.pHardwareThreadIds[iThread];
+                    if (affinity.affinitySet.isSet(hwTid))
+                    {
+                        outCore = coreOffset + (uint32_t)iCore;
+                        outNode = findNode(group, hwTid, socketOffset);
+                        return;
+                    }
+                }
+            }
+        }
+
+        coreOffset   += (uint32_t)group.coreInfoElementCount;
+        socketOffset += (uint32_t)group.socketInfoElementCount;
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+bool StealHierarchy::build(
+    SystemTopology const& topology,
+    WorkerThreadDesc::GroupAndAffinity const* pAffinities,
+    uint32_t workerCount)
+{
+    GTS_ASSERT(workerCount > 0);
+
+    Vector<uint32_t> coreByWorker(workerCount);
+    m_nodeByWorker.resize(workerCount);
+
+    for (uint32_t ii = 0; ii < workerCount; ++ii)
+    {
+        locateWorker(topology, pAffinities[ii], coreByWorker[ii], m_nodeByWorker[ii]);
+    }
+
+    m_victims.resize(workerCount * (workerCount - 1));
+    m_levelEnds.resize(workerCount * LEVEL_COUNT);
+
+    bool hasPreferredVictims = false;
+
+    for (uint32_t thief = 0; thief < workerCount; ++thief)
+    {
+        const uint32_t thiefCore = coreByWorker[thief];
+        const uint32_t thiefNode = m_nodeByWorker[thief];
+
+        SubIdType* pVictims = m_victims.data() + thief * (workerCount - 1);
+        uint32_t count = 0;
+
+        for (uint32_t level = 0; level < LEVEL_COUNT; ++level)
+        {
+            for (uint32_t victim = 0; victim < workerCount; ++victim)
+            {
+                if (victim == thief)
+                {
+                    continue;
+                }
+
+                uint32_t victimLevel = REMOTE;
+                if (thiefCore != UNKNOWN_LOCATION && coreByWorker[victim] == thiefCore)
+                {
+                    victimLevel = SMT_SIBLING;
+                }
+                else if (thiefNode != UNKNOWN_LOCATION && m_nodeByWorker[victim] == thiefNode)
+                {
+                    victimLevel = SAME_NODE;
+                }
+
+                if (victimLevel == level)
+                {
+                    pVictims[count++] = (SubIdType)victim;
+                }
+            }
+
+            m_levelEnds[thief * LEVEL_COUNT + level] = count;
+        }
+
+        GTS_ASSERT(count == workerCount - 1);
+
+        // Only useful if some victims are nearer than others.
+        uint32_t usedLevelCount = 0;
+        for (uint32_t level = 0; level < LEVEL_COUNT; ++level)
+        {
+            if (levelBegin((SubIdType)thief, level) != levelEnd((SubIdType)thief, level))
+            {
+                ++usedLevelCount;
+            }
+        }
+        hasPreferredVictims |= usedLevelCount > 1;
+    }
+
+    return hasPreferredVictims;
+}
+
+} // namespace gts
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#pragma once
+
+#include "gts/platform/Thread.h"
+#include "gts/containers/Vector.h"
+#include "gts/micro_scheduler/MicroSchedulerTypes.h"
+
+namespace gts {
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  The order in which each Worker of a WorkerPool visits its steal victims,
+ *  nearest first: Workers on the same core (SMT siblings), then Workers on the
+ *  same NUMA node, then everyone else.
+ * @remark
+ *  A Worker's location is the first hardware thread in its affinity set. A
+ *  Worker without an affinity can migrate anywhere, so it has no location and
+ *  is treated as remote to every other Worker.
+ */
+class StealHierarchy
+{
+public:
+
+    enum Level : uint32_t
+    {
+        SMT_SIBLING,
+        SAME_NODE,
+        REMOTE,
+        LEVEL_COUNT
+    };
+
+    static constexpr uint32_t UNKNOWN_LOCATION = UINT32_MAX;
+
+public: // MUTATORS:
+
+    /**
+     * @brief
+     *  Builds the victim order for 'workerCount' Workers.
+     * @param pAffinities
+     *  The affinity of each Worker, indexed by local Worker ID.
+     * @returns
+     *  False if the topology gives no Worker a preferred victim, in which
+     *  case the hierarchy is no better than random victim selection.
+     */
+    bool build(
+        SystemTopology const& topology,
+        WorkerThreadDesc::GroupAndAffinity const* pAffinities,
+        uint32_t workerCount);
+
+    /**
+     * @brief
+     *  Sets how many consecutive failed near steals a Worker makes before it
+     *  tries a remote victim. 1 tries remote victims on every steal.
+     */
+    GTS_INLINE void setRemoteStealPeriod(uint32_t period)
+    {
+        GTS_ASSERT(period > 0);
+        m_remoteStealPeriod = period;
+    }
+
+public: // ACCESSORS:
+
+    GTS_INLINE uint32_t remoteStealPeriod() const
+    {
+        return m_remoteStealPeriod;
+    }
+
+    GTS_INLINE uint32_t workerCount() const
+    {
+        return (uint32_t)m_nodeByWorker.size();
+    }
+
+    /**
+     * @returns The victims of 'workerId' ordered nearest first. Excludes
+     *  'workerId' itself.
+     */
+    GTS_INLINE SubIdType const* victims(SubIdType workerId) const
+    {
+        return m_victims.data() + workerId * (workerCount() - 1);
+    }
+
+    /**
+     * @returns The end index into victims(workerId) of 'level'. The level
+     *  begins where the previous one ends.
+     */
+    GTS_INLINE uint32_t levelEnd(SubIdType workerId, uint32_t level) const
+    {
+        return m_levelEnds[workerId * LEVEL_COUNT + level];
+    }
+
+    GTS_INLINE uint32_t levelBegin(SubIdType workerId, uint32_t level) const
+    {
+        return level == 0 ? 0 : levelEnd(workerId, level - 1);
+    }
+
+    /**
+     * @returns True if both Workers have a known NUMA node and they differ.
+     */
+    GTS_INLINE bool isCrossNode(SubIdType workerA, SubIdType workerB) const
+    {
+        const uint32_t nodeA = m_nodeByWorker[workerA];
+        const uint32_t nodeB = m_nodeByWorker[workerB];
+        return nodeA != UNKNOWN_LOCATION && nodeB != UNKNOWN_LOCATION && nodeA != nodeB;
+    }
+
+private:
+
+    Vector<SubIdType> m_victims;
+    Vector<uint32_t> m_levelEnds;
+    Vector<uint32_t> m_nodeByWorker;
+    uint32_t m_remoteStealPeriod = 1;
+};
+
+} // namespace gts
@@ -217,6 +217,55 @@ public: // MUTATORS
         return true;
     }
 
+    //--------------------------------------------------------------------------
+    /**
+     * A single-producer-safe push operation. Pushes 'count' Tasks to the back
+     * in order and publishes them to consumers at once.
+     * @param ppTasks
+     *  The Tasks to push.
+     * @param count
+     *  The number of Tasks in ppTasks.
+     * @return
+     *  True if all the Tasks were pushed, false if none were.
+     * @remark
+     *  Thread-safe.
+     */
+    GTS_INLINE bool tryPushBatch(Task* const* ppTasks, size_t count)
+    {
+        size_t b                = m_back.load(memory_order::relaxed);
+        size_t f                = m_front.load(memory_order::acquire);
+        RingBuffer* pRingBuffer = m_ringBuffer.load(memory_order::relaxed);
+
+        // If the buffer is at capacity, grow it once to fit the whole batch.
+        size_t cap = capacity();
+        size_t size = (b + count) - f;
+        if (size > cap)
+        {
+            size_t newCap = gtsMax(size_t(1), cap);
+            while (newCap < size)
+            {
+                newCap *= 2;
+            }
+
+            if (!_grow(newCap, f, b))
+            {
+                return false;
+            }
+            pRingBuffer = m_ringBuffer.load(memory_order::relaxed);
+        }
+
+        // Store the new values in the buffer.
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            (*pRingBuffer)[b + ii] = ppTasks[ii];
+        }
+
+        // Notify the consumers that the new values exist.
+        m_back.store(b + count, memory_order::release);
+
+        return true;
+    }
+
     //--------------------------------------------------------------------------
     /**
      * A single-producer-safe pop operation. Pops pTask from the back.
@@ -269,15 +318,13 @@ public: // MUTATORS
      * A multi-consumer-safe pop operation. Pops pTask from the front.
      * @param pTask
      *  The stolen task.
+     * @param pCounters
+     *  The thief's counters. Optional.
      * @return True if the steal succeeded, false otherwise.
      * @remark
      *  Thread-safe.
      */
-#if GTS_ENABLE_COUNTER
-    GTS_INLINE bool trySteal(Task*& out, OwnedId const& ownedID)
-#else
-    GTS_INLINE bool trySteal(Task*& out)
-#endif
+    GTS_INLINE bool trySteal(Task*& out, analysis::MicroSchedulerCounterSlot* pCounters = nullptr)
     {
         while (true)
         {
@@ -312,9 +359,10 @@ public: // MUTATORS
             // (2) Race against tryPop with other consumers
             if (!m_front.compare_exchange_strong(f, f + 1, memory_order::seq_cst, memory_order::relaxed))
             {
-#if GTS_ENABLE_COUNTER
-                GTS_MS_COUNTER_INC(ownedID, analysis::MicroSchedulerCounters::NUM_FAILED_CAS_IN_DEQUE_STEAL);
-#endif
+                if (pCounters)
+                {
+                    GTS_MS_COUNTER_INC(pCounters, analysis::MicroSchedulerCounters::NUM_FAILED_CAS_IN_DEQUE_STEAL);
+                }
                 GTS_SPECULATION_FENCE();
 
                 // race lost, try again
@@ -326,6 +374,79 @@ public: // MUTATORS
         }
     }
 
+    //--------------------------------------------------------------------------
+    /**
+     * A multi-consumer-safe batch pop. Steals up to half of the elements, and
+     * no more than 'maxCount', from the front.
+     * @param pOut
+     *  Receives the stolen tasks in front to back order. Must have room for
+     *  'maxCount' tasks.
+     * @param maxCount
+     *  The maximum number of tasks to steal.
+     * @return The number of tasks stolen.
+     * @remark
+     *  Thread-safe. Each element is claimed with its own CAS on front. A
+     *  single CAS over a range would race with tryPop, which only
+     *  synchronizes with thieves on the last element. The batch still
+     *  amortizes victim selection and keeps front's cache line local to the
+     *  thief while it drains.
+     */
+    GTS_INLINE size_t tryStealHalf(Task** pOut, size_t maxCount)
+    {
+        size_t f = m_front.load(memory_order::acquire);
+
+        // Early out. Check if the queue is empty before synchronizing.
+        size_t b = m_back.load(memory_order::acquire);
+        if (b <= f || (b == SIZE_MAX && f == 0))
+        {
+            return 0;
+        }
+
+        const size_t batchSize = gtsMax(size_t(1), gtsMin(maxCount, (b - f + 1) / 2));
+        size_t count = 0;
+
+        while (count < batchSize)
+        {
+#if GTS_USE_MFENCE
+            GTS_MFENCE(); // sync with take.
+            b = m_back.load(memory_order::relaxed);
+#else
+            b = m_back.load(memory_order::seq_cst);
+#endif
+
+            // If the queue is empty, quit.
+            if (b <= f || (b == SIZE_MAX && f == 0))
+            {
+                break;
+            }
+
+            // Get element before releasing change to front.
+            RingBuffer* pRingBuffer = m_ringBuffer.load(memory_order::consume);
+            pOut[count] = (*pRingBuffer)[f];
+
+            // Race against tryPop with other consumers. On failure, 'f' is
+            // updated to the current front.
+            if (!m_front.compare_exchange_strong(f, f + 1, memory_order::seq_cst, memory_order::relaxed))
+            {
+                GTS_SPECULATION_FENCE();
+
+                if (count == 0)
+                {
+                    // Nothing stolen yet, try again.
+                    continue;
+                }
+
+                // Contended. Keep what we have.
+                break;
+            }
+
+            ++count;
+            ++f;
+        }
+
+        return count;
+    }
+
 private:
 
     //--------------------------------------------------------------------------
@@ -32,6 +32,8 @@
 #include "LocalScheduler.h"
 
 static GTS_THREAD_LOCAL uintptr_t tl_threadState;
+static GTS_THREAD_LOCAL gts::TaskPool* tl_pExternalTaskPool;
+static GTS_THREAD_LOCAL gts::WorkerPool* tl_pExternalTaskPoolOwner;
 static constexpr uint64_t LOWER_BOUND_SLEEP_CYCLES = 1024 * 10;
 
 //------------------------------------------------------------------------------
@@ -48,6 +50,264 @@ static void gtsSetThreadState(uintptr_t state)
 
 namespace gts {
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// TaskArena:
+
+// STRUCTORS:
+
+//------------------------------------------------------------------------------
+TaskArena::TaskArena(uint32_t nodeId, bool bindMemory)
+    : m_nodeId(nodeId)
+    , m_bindMemory(bindMemory)
+{}
+
+//------------------------------------------------------------------------------
+TaskArena::~TaskArena()
+{
+    for (size_t ii = 0; ii < m_slabs.size(); ++ii)
+    {
+        GTS_OS_VIRTUAL_FREE(m_slabs[ii], SLAB_SIZE);
+    }
+}
+
+// MUTATORS:
+
+//------------------------------------------------------------------------------
+void* TaskArena::allocateSlab()
+{
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::Magenta, "TASKARENA ALLOCATE SLAB", this, m_nodeId);
+
+    void* pSlab = GTS_OS_VIRTUAL_ALLOCATE(nullptr, SLAB_SIZE, true, false);
+    if (pSlab == nullptr || pSlab == (void*)UINTPTR_MAX)
+    {
+        return nullptr;
+    }
+
+    // Bind before the first touch, otherwise the touching thread's node wins.
+    if (m_bindMemory)
+    {
+        GTS_OS_BIND_TO_NUMA_NODE(pSlab, SLAB_SIZE, m_nodeId);
+    }
+
+    Lock<UnfairSpinMutex<>> lock(m_mutex);
+    m_slabs.push_back(pSlab);
+    return pSlab;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// TaskPool:
+
+// STRUCTORS:
+
+//------------------------------------------------------------------------------
+TaskPool::TaskPool(uint32_t cachableTaskSize, TaskArena* pArena)
+    : m_pArena(pArena)
+    , m_cachableTaskSize(cachableTaskSize)
+{
+    GTS_ASSERT(!pArena || cachableTaskSize <= TaskArena::SLAB_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TaskPool::~TaskPool()
+{
+    freeCachedTasks();
+}
+
+// MUTATORS:
+
+//------------------------------------------------------------------------------
+Task* TaskPool::allocateTask(uint32_t size)
+{
+    uint32_t totalSize = gtsMax(m_cachableTaskSize, (uint32_t)sizeof(internal::TaskHeader) + size);
+    Task* pTask = nullptr;
+    uint32_t arenaFlag = 0;
+
+    if (totalSize == m_cachableTaskSize)
+    {
+        if((pTask = m_pFreeList) != nullptr)
+        {
+            m_pFreeList = pTask->header().pListNext.load(memory_order::relaxed);
+        }
+        else if(m_pDeferredFreeList.load(memory_order::relaxed) != nullptr)
+        {
+            GTS_SPECULATION_FENCE();
+
+            pTask = m_pDeferredFreeList.exchange(nullptr, memory_order::acq_rel);
+            m_pFreeList = pTask->header().pListNext.load(memory_order::relaxed);
+        }
+        else if(m_pArena)
+        {
+            pTask = _allocateFromArena();
+        }
+
+        if (pTask)
+        {
+            // Recycled Tasks keep track of where their memory came from.
+            arenaFlag = pTask->header().flags & internal::TaskHeader::TASK_IS_ARENA_MEMORY;
+        }
+    }
+    
+    if(!pTask)
+    {
+        GTS_SPECULATION_FENCE();
+        pTask = ((internal::TaskHeader*)GTS_ALIGNED_MALLOC(totalSize, GTS_NO_SHARING_CACHE_LINE_SIZE))->_task();
+    }
+
+    internal::TaskHeader& header = pTask->header();
+    header.pParent               = nullptr;
+    header.pMyLocalScheduler     = nullptr;
+    header.pMyTaskPool           = this;
+    header.pListNext.store(nullptr, memory_order::relaxed);
+    header.pWaitEvent.store(nullptr, memory_order::relaxed);
+    header.affinity              = ANY_WORKER;
+    header.refCount.store(1, memory_order::relaxed);
+    header.executionState        = internal::TaskHeader::ALLOCATED;
+    header.flags                 = (totalSize <= m_cachableTaskSize ? internal::TaskHeader::TASK_IS_SMALL : 0) | arenaFlag;
+
+    return pTask;
+}
+
+//------------------------------------------------------------------------------
+Task* TaskPool::_allocateFromArena()
+{
+    const size_t stride = alignUpTo(m_cachableTaskSize, GTS_NO_SHARING_CACHE_LINE_SIZE);
+
+    if (m_pSlabCursor + stride > m_pSlabEnd)
+    {
+        uint8_t* pSlab = (uint8_t*)m_pArena->allocateSlab();
+        if (!pSlab)
+        {
+            return nullptr;
+        }
+        m_pSlabCursor = pSlab;
+        m_pSlabEnd    = pSlab + TaskArena::SLAB_SIZE;
+    }
+
+    // The calling thread is the first to touch the memory.
+    internal::TaskHeader* pHeader = new (m_pSlabCursor) internal::TaskHeader();
+    pHeader->flags = internal::TaskHeader::TASK_IS_ARENA_MEMORY;
+    m_pSlabCursor += stride;
+
+    return pHeader->_task();
+}
+
+//------------------------------------------------------------------------------
+void TaskPool::freeTask(Task* pTask)
+{
+    GTS_SIM_TRACE_MARKER(sim_trace::MARKER_FREE_TASK_BEGIN);
+
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::Magenta, "TASKPOOL FREE TASK", this, pTask);
+
+    internal::TaskHeader& taskHeader = pTask->header();
+
+    if(taskHeader.flags & internal::TaskHeader::TASK_IS_SMALL && taskHeader.pMyTaskPool != nullptr)
+    {
+        GTS_ASSERT(taskHeader.executionState != internal::TaskHeader::FREED && "double free!");
+        taskHeader.executionState = internal::TaskHeader::FREED;
+
+        if(taskHeader.pMyTaskPool == this)
+        {
+            taskHeader.pListNext.store(m_pFreeList, memory_order::relaxed);
+            m_pFreeList = pTask;
+        }
+        else
+        {
+            taskHeader.pMyTaskPool->freeTaskDeferred(pTask);
+        }
+    }
+    else
+    {
+        GTS_ALIGNED_FREE(&pTask->header());
+    }
+
+    GTS_SIM_TRACE_MARKER(sim_trace::MARKER_FREE_TASK_END);
+}
+
+//------------------------------------------------------------------------------
+void TaskPool::freeTaskDeferred(Task* pTask)
+{
+    internal::TaskHeader& taskHeader = pTask->header();
+    GTS_ASSERT(taskHeader.pMyTaskPool == this);
+
+    taskHeader.executionState = internal::TaskHeader::FREED;
+
+    Task* pHead = m_pDeferredFreeList.load(memory_order::acquire);
+    taskHeader.pListNext.store(pHead, memory_order::relaxed);
+
+    while (!m_pDeferredFreeList.compare_exchange_strong(pHead, pTask, memory_order::acq_rel, memory_order::relaxed))
+    {
+        taskHeader.pListNext.store(pHead, memory_order::relaxed);
+        GTS_SPECULATION_FENCE();
+    }
+}
+
+//------------------------------------------------------------------------------
+void TaskPool::precacheTasks(uint32_t count)
+{
+    if(count > 0)
+    {
+        Vector<Task*, AlignedAllocator<alignof(Task*)>> tasks(count);
+        for(uint32_t ii = 0; ii < count; ++ii)
+        {
+            tasks[ii] = allocateTask(m_cachableTaskSize - sizeof(internal::TaskHeader));
+        }
+
+        for(uint32_t ii = 0; ii < count; ++ii)
+        {
+            freeTask(tasks[count - ii - 1]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void TaskPool::freeCachedTasks()
+{
+    // Arena memory is owned by the TaskArena.
+    while (m_pFreeList != nullptr)
+    {
+        Task* pTask = m_pFreeList;
+        m_pFreeList = m_pFreeList->header().pListNext.load(memory_order::relaxed);
+        if ((pTask->header().flags & internal::TaskHeader::TASK_IS_ARENA_MEMORY) == 0)
+        {
+            GTS_ALIGNED_FREE(&pTask->header());
+        }
+    }
+
+    while (m_pDeferredFreeList.load(memory_order::relaxed) != nullptr)
+    {
+        Task* pTask = m_pDeferredFreeList.load(memory_order::relaxed);
+        m_pDeferredFreeList.store(pTask->header().pListNext.load(memory_order::relaxed), memory_order::relaxed);
+        if ((pTask->header().flags & internal::TaskHeader::TASK_IS_ARENA_MEMORY) == 0)
+        {
+            GTS_ALIGNED_FREE(&pTask->header());
+        }
+    }
+}
+
+// ACCESSORS:
+
+//------------------------------------------------------------------------------
+TaskPool* TaskPool::getExternalLocal(WorkerPool const* pOwner)
+{
+    return tl_pExternalTaskPoolOwner == pOwner ? tl_pExternalTaskPool : nullptr;
+}
+
+//------------------------------------------------------------------------------
+WorkerPool* TaskPool::getExternalLocalOwner()
+{
+    return tl_pExternalTaskPoolOwner;
+}
+
+//------------------------------------------------------------------------------
+void TaskPool::setExternalLocal(TaskPool* pTaskPool, WorkerPool* pOwner)
+{
+    GTS_ASSERT((pTaskPool == nullptr) == (pOwner == nullptr));
+    tl_pExternalTaskPool      = pTaskPool;
+    tl_pExternalTaskPoolOwner = pOwner;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 // Worker:
@@ -74,8 +334,6 @@ Worker::Worker()
     , m_currentScheduleIdx(0)
     , m_resumeCount(0)
     , m_refCount(1)
-    , m_cachableTaskSize(0)
-
 {}
 
 //------------------------------------------------------------------------------
@@ -95,6 +353,7 @@ bool Worker::initialize(
     WorkerPoolVisitor* pVisitor,
     uint32_t cachableTaskSize,
     uint32_t initialTaskCountPerWorker,
+    TaskArena* pTaskArena,
     bool isMaster)
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKER INIT", this, workerId.localId());
@@ -115,7 +374,6 @@ bool Worker::initialize(
     GTS_ASSERT(pMyPool != nullptr);
     m_pMyPool = pMyPool;
 
-    m_pTaskPool = alignedNew<TaskPool, GTS_NO_SHARING_CACHE_LINE_SIZE>();
     m_pSleepBlocker = alignedNew<ThreadBlocker, GTS_NO_SHARING_CACHE_LINE_SIZE>();
     m_pHaltSemaphore = alignedNew<BinarySemaphore, GTS_NO_SHARING_CACHE_LINE_SIZE>();
     m_pRegisteredSchedulersMutex = alignedNew<MutexType, GTS_NO_SHARING_CACHE_LINE_SIZE>();
@@ -125,23 +383,11 @@ bool Worker::initialize(
         GTS_ASSERT(cachableTaskSize >= GTS_CACHE_LINE_SIZE);
         cachableTaskSize = GTS_CACHE_LINE_SIZE;
     }
-    m_cachableTaskSize = cachableTaskSize;
+    m_pTaskPool = alignedNew<TaskPool, GTS_NO_SHARING_CACHE_LINE_SIZE>(cachableTaskSize, pTaskArena);
 
     if (isMaster)
     {
-        if(initialTaskCountPerWorker > 0)
-        {
-            Vector<Task*, AlignedAllocator<GTS_NO_SHARING_CACHE_LINE_SIZE>> tasks(initialTaskCountPerWorker);
-            for(uint32_t ii = 0; ii < initialTaskCountPerWorker; ++ii)
-            {
-                tasks[ii] = allocateTask(m_cachableTaskSize - sizeof(internal::TaskHeader));
-            }
-
-            for(uint32_t ii = 0; ii < initialTaskCountPerWorker; ++ii)
-            {
-                freeTask(tasks[initialTaskCountPerWorker - ii - 1]);
-            }
-        }
+        m_pTaskPool->precacheTasks(initialTaskCountPerWorker);
 
         m_threadId = ThisThread::getId();
 
@@ -173,6 +419,7 @@ bool Worker::initialize(
     workerArgs.workerId                  = workerId;
     workerArgs.fenv                      = fenv;
     workerArgs.pVisitor                  = pVisitor;
+    workerArgs.affinity                  = affinity;
     workerArgs.name                      = threadName;
     workerArgs.initialTaskCountPerWorker = initialTaskCountPerWorker;
 
@@ -193,11 +440,6 @@ bool Worker::initialize(
         GTS_PAUSE();
     }
 
-    if(!affinity.affinitySet.empty())
-    {
-        m_thread.setAffinity(affinity.group, affinity.affinitySet);
-    }
-
     m_thread.setPriority(threadPrioity);
 
     m_registeredSchedulers.reserve(1024);
@@ -210,7 +452,7 @@ void Worker::shutdown()
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKER SHUTDOWN", this, id().localId());
 
-    _freeTasks();
+    m_pTaskPool->freeCachedTasks();
 
     if (id().localId() != 0) // Skip master. It has no thread.
     {
@@ -224,86 +466,6 @@ void Worker::shutdown()
     alignedDelete(m_pTaskPool);
 }
 
-//------------------------------------------------------------------------------
-Task* Worker::allocateTask(uint32_t size)
-{
-    uint32_t totalSize = gtsMax(m_cachableTaskSize, (uint32_t)sizeof(internal::TaskHeader) + size);
-    Task* pTask = nullptr;
-
-    if (totalSize == m_cachableTaskSize)
-    {
-        if((pTask = m_pTaskPool->pFreeList) != nullptr)
-        {
-            m_pTaskPool->pFreeList = pTask->header().pListNext.load(memory_order::relaxed);
-        }
-        else if(m_pTaskPool->pDeferredFreeList.load(memory_order::relaxed) != nullptr)
-        {
-            GTS_SPECULATION_FENCE();
-
-            pTask = m_pTaskPool->pDeferredFreeList.exchange(nullptr, memory_order::acq_rel);
-            m_pTaskPool->pFreeList = pTask->header().pListNext.load(memory_order::relaxed);
-        }
-    }
-    
-    if(!pTask)
-    {
-        GTS_SPECULATION_FENCE();
-        pTask = ((internal::TaskHeader*)GTS_ALIGNED_MALLOC(totalSize, GTS_NO_SHARING_CACHE_LINE_SIZE))->_task();
-    }
-
-    internal::TaskHeader& header = pTask->header();
-    header.pParent               = nullptr;
-    header.pMyLocalScheduler     = nullptr;
-    header.pMyWorker             = this;
-    header.pListNext.store(nullptr, memory_order::relaxed);
-    header.affinity              = ANY_WORKER;
-    header.refCount.store(1, memory_order::relaxed);
-    header.executionState        = internal::TaskHeader::ALLOCATED;
-    header.flags                 = totalSize <= m_cachableTaskSize ? internal::TaskHeader::TASK_IS_SMALL : 0;
-
-    return pTask;
-}
-
-//------------------------------------------------------------------------------
-void Worker::freeTask(Task* pTask)
-{
-    GTS_SIM_TRACE_MARKER(sim_trace::MARKER_FREE_TASK_BEGIN);
-
-    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::MICRO_SCHEDULER_ALL, analysis::Color::Magenta, "WORKER FREE TASK", this, pTask);
-    //GTS_COUNTER_INC(m_pMyPool->m_pAnalyzer, localId(), analysis::AnalysisType::NUM_FREES);
-
-    internal::TaskHeader& taskHeader = pTask->header();
-
-    if(taskHeader.flags & internal::TaskHeader::TASK_IS_SMALL && taskHeader.pMyWorker != nullptr)
-    {
-        GTS_ASSERT(taskHeader.executionState != internal::TaskHeader::FREED && "double free!");
-        taskHeader.executionState = internal::TaskHeader::FREED;
-
-        if(taskHeader.pMyWorker == this)
-        {
-            taskHeader.pListNext.store(m_pTaskPool->pFreeList, memory_order::relaxed);
-            m_pTaskPool->pFreeList = pTask;
-        }
-        else
-        {
-            Task* pHead = taskHeader.pMyWorker->m_pTaskPool->pDeferredFreeList.load(memory_order::acquire);
-            taskHeader.pListNext.store(pHead, memory_order::relaxed);
-            
-            while (!taskHeader.pMyWorker->m_pTaskPool->pDeferredFreeList.compare_exchange_strong(pHead, pTask, memory_order::acq_rel, memory_order::relaxed))
-            {
-                taskHeader.pListNext.store(pHead, memory_order::relaxed);
-                GTS_SPECULATION_FENCE();
-            }
-        }
-    }
-    else
-    {
-        GTS_ALIGNED_FREE(&pTask->header());
-    }
-
-    GTS_SIM_TRACE_MARKER(sim_trace::MARKER_FREE_TASK_END);
-}
-
 //------------------------------------------------------------------------------
 MicroScheduler* Worker::currentMicroScheduler() const
 {
@@ -327,6 +489,12 @@ void Worker::_workerThreadRoutine(void* pArg)
 
     pSelf->m_threadId = ThisThread::getId();
 
+    // Pin before touching any memory so first-touch pages land on our node.
+    if (!args.affinity.affinitySet.empty())
+    {
+        ThisThread::setAffinity(args.affinity.group, args.affinity.affinitySet);
+    }
+
     if (args.name)
     {
         ThisThread::setName(args.name);
@@ -373,19 +541,7 @@ void Worker::_workerThreadRoutine(void* pArg)
     // -v-v-v-v-v-v-v-v-v-v- 'pArgs' is now invalid -v-v-v-v-v-v-v-v-v-v-
 
     // Precache Tasks.
-    if(initialTaskCountPerWorker > 0)
-    {
-        Vector<Task*, AlignedAllocator<alignof(Task*)>> tasks(initialTaskCountPerWorker);
-        for(uint32_t ii = 0; ii < initialTaskCountPerWorker; ++ii)
-        {
-            tasks[ii] = pSelf->allocateTask(pSelf->m_cachableTaskSize - sizeof(internal::TaskHeader));
-        }
-
-        for(uint32_t ii = 0; ii < initialTaskCountPerWorker; ++ii)
-        {
-            pSelf->freeTask(tasks[initialTaskCountPerWorker - ii - 1]);
-        }
-    }
+    pSelf->m_pTaskPool->precacheTasks(initialTaskCountPerWorker);
 
     // Execute tasks until done.
     pSelf->_schedulerExecutionLoop(workerId.localId());
@@ -403,34 +559,16 @@ void Worker::_workerThreadRoutine(void* pArg)
     }
 }
 
-//------------------------------------------------------------------------------
-void Worker::_freeTasks()
-{
-    while (m_pTaskPool->pFreeList != nullptr)
-    {
-        Task* pTask = m_pTaskPool->pFreeList;
-        m_pTaskPool->pFreeList = m_pTaskPool->pFreeList->header().pListNext.load(memory_order::relaxed);
-        GTS_ALIGNED_FREE(&pTask->header());
-    }
-
-    while (m_pTaskPool->pDeferredFreeList.load(memory_order::relaxed) != nullptr)
-    {
-        Task* pTask = m_pTaskPool->pDeferredFreeList.load(memory_order::relaxed);
-        m_pTaskPool->pDeferredFreeList.store(pTask->header().pListNext.load(memory_order::relaxed), memory_order::relaxed);
-        GTS_ALIGNED_FREE(&pTask->header());
-    }
-}
-
 //------------------------------------------------------------------------------
 void Worker::sleep(bool force)
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_ALL, analysis::Color::DarkRed, "WORKER SLEEP", this, id().localId());
-    GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_SLEEP_SUCCESSES);
+    GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_SLEEP_SUCCESSES);
 
     uint64_t startSleepTime = GTS_RDTSC();
 
     // Notify the WorkPool of the suspension.
-    m_pMyPool->m_sleepingWorkerCount.fetch_add(1, memory_order::acquire);
+    m_pMyPool->_markSleeping(id().localId(), true);
 
     if (force)
     {
@@ -476,7 +614,7 @@ void Worker::sleep(bool force)
     m_resumeCount = 0;
 
     // Notify the WorkPool of the resume.
-    m_pMyPool->m_sleepingWorkerCount.fetch_sub(1, memory_order::release);
+    m_pMyPool->_markSleeping(id().localId(), false);
 
     // Wait for wakers to exit.
     while (m_pSleepBlocker->numWakers.load(memory_order::acquire) > 0)
@@ -516,7 +654,7 @@ bool Worker::wake(uint32_t count, bool reset, bool force)
     }
 
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_ALL, analysis::Color::Green1, "ATTEMPTY WAKE WORKER", this, id().localId());
-    GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_WAKE_CHECKS);
+    GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_WAKE_CHECKS);
 
     if (force || m_pSleepBlocker->state.load(memory_order::acquire) == ThreadBlocker::IS_BLOCKED)
     {
@@ -561,7 +699,7 @@ bool Worker::wake(uint32_t count, bool reset, bool force)
         GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::Yellow, "WORKER DONE WAKING", this, id().localId());
 
         m_resumeCount = count - 1;
-        GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_WAKE_SUCCESSES);
+        GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_WAKE_SUCCESSES);
         return true;
     }
 
@@ -573,7 +711,7 @@ void Worker::halt()
 {
     // enter halt.
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_ALL, analysis::Color::DarkRed, "WORKER HALT", this, id().localId());
-    GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_HALT_SUCCESSES);
+    GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_HALT_SUCCESSES);
 
     m_pMyPool->m_haltedWorkerCount.fetch_add(1, memory_order::acquire);
     m_pHaltSemaphore->reset();
@@ -589,7 +727,7 @@ void Worker::halt()
 //------------------------------------------------------------------------------
 void Worker::resume()
 {
-    GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_RESUMES);
+    GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_RESUMES);
     m_pHaltSemaphore->signal();
 }
 
@@ -597,7 +735,7 @@ void Worker::resume()
 void Worker::registerLocalScheduler(LocalScheduler* pLocalScheduler)
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKER REG LOCAL SCHED", this, id().localId());
-    GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_SCHEDULER_REGISTERS);
+    GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_SCHEDULER_REGISTERS);
 
     Lock<MutexType> lock(*m_pRegisteredSchedulersMutex);
 
@@ -610,7 +748,7 @@ void Worker::registerLocalScheduler(LocalScheduler* pLocalScheduler)
 void Worker::unregisterLocalScheduler(LocalScheduler* pLocalScheduler)
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKER UNREG LOCAL SCHED", this, id().localId());
-    GTS_WP_COUNTER_INC(id(), gts::analysis::WorkerPoolCounters::NUM_SCHEDULER_UNREGISTERS);
+    GTS_WP_COUNTER_INC_SHARED(m_pMyPool->_counters(id()), gts::analysis::WorkerPoolCounters::NUM_SCHEDULER_UNREGISTERS);
 
     Lock<MutexType> lock(*m_pRegisteredSchedulersMutex);
 
@@ -24,6 +24,7 @@
 #include <fenv.h>
 
 #include "gts/platform/Thread.h"
+#include "gts/synchronization/SpinMutex.h"
 #include "gts/containers/parallel/BinnedAllocator.h"
 #include "gts/micro_scheduler/MicroSchedulerTypes.h"
 #include "gts/micro_scheduler/Task.h"
@@ -43,6 +44,119 @@ namespace internal {
 
 } // namespace internal
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  The Task memory of one NUMA node. TaskPools on the node carve the arena's
+ *  slabs into Tasks. The pages are placed on the node by first touch, or by
+ *  binding them when requested. Slabs are only released when the arena is
+ *  destroyed.
+ */
+class GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) TaskArena
+{
+public: // STRUCTORS:
+
+    TaskArena(uint32_t nodeId, bool bindMemory);
+    ~TaskArena();
+
+public: // MUTATORS:
+
+    /**
+     * @return A SLAB_SIZE block of memory or nullptr if out of memory.
+     * @remark
+     *  Thread-safe.
+     */
+    void* allocateSlab();
+
+public: // ACCESSORS:
+
+    GTS_INLINE uint32_t nodeId() const
+    {
+        return m_nodeId;
+    }
+
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+private:
+
+    // no copy
+    TaskArena(TaskArena const&) = delete;
+    TaskArena& operator=(TaskArena const&) = delete;
+
+    UnfairSpinMutex<> m_mutex;
+    Vector<void*> m_slabs;
+    uint32_t m_nodeId;
+    bool m_bindMemory;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ *  A thread's cache of small Tasks. Only the owning thread allocates from the
+ *  pool. Other threads return the pool's Tasks through a deferred free list.
+ */
+class GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) TaskPool
+{
+public: // STRUCTORS:
+
+    explicit TaskPool(uint32_t cachableTaskSize, TaskArena* pArena = nullptr);
+    ~TaskPool();
+
+public: // MUTATORS:
+
+    Task* allocateTask(uint32_t size);
+    void freeTask(Task* pTask);
+
+    /**
+     * @brief
+     *  Returns one of this pool's Tasks from a thread that has no TaskPool.
+     * @remark
+     *  Thread-safe.
+     */
+    void freeTaskDeferred(Task* pTask);
+
+    void precacheTasks(uint32_t count);
+    void freeCachedTasks();
+
+public: // ACCESSORS:
+
+    GTS_INLINE uint32_t cachableTaskSize() const
+    {
+        return m_cachableTaskSize;
+    }
+
+    /**
+     * @return The TaskPool the calling non-Worker thread registered with
+     *  'pOwner', or nullptr if it is not registered with 'pOwner'.
+     */
+    static TaskPool* getExternalLocal(WorkerPool const* pOwner);
+
+    /**
+     * @return The WorkerPool the calling non-Worker thread is registered
+     *  with, or nullptr if there is none.
+     */
+    static WorkerPool* getExternalLocalOwner();
+
+    static void setExternalLocal(TaskPool* pTaskPool, WorkerPool* pOwner);
+
+private:
+
+    // no copy
+    TaskPool(TaskPool const&) = delete;
+    TaskPool& operator=(TaskPool const&) = delete;
+
+    Task* _allocateFromArena();
+
+    GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Atomic<Task*> m_pDeferredFreeList = { nullptr };
+    GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Task* m_pFreeList = nullptr;
+    TaskArena* m_pArena;
+    uint8_t* m_pSlabCursor = nullptr;
+    uint8_t* m_pSlabEnd = nullptr;
+    uint32_t m_cachableTaskSize;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 /**
@@ -70,6 +184,7 @@ public: // MUTATORS:
         WorkerPoolVisitor* pVisitor,
         uint32_t cachableTaskSize,
         uint32_t initialTaskCountPerWorker,
+        TaskArena* pTaskArena,
         bool isMaster = false);
 
     void shutdown();
@@ -84,8 +199,15 @@ public: // MUTATORS:
     void registerLocalScheduler(LocalScheduler* pLocalScheduler);
     void unregisterLocalScheduler(LocalScheduler* pLocalScheduler);
 
-    Task* allocateTask(uint32_t size);
-    void freeTask(Task* pTask);
+    GTS_INLINE Task* allocateTask(uint32_t size)
+    {
+        return m_pTaskPool->allocateTask(size);
+    }
+
+    GTS_INLINE void freeTask(Task* pTask)
+    {
+        m_pTaskPool->freeTask(pTask);
+    }
 
 public: // ACCESSORS:
 
@@ -129,6 +251,7 @@ private: // PRIVATE METHODS:
         OwnedId workerId;
         fenv_t fenv;
         WorkerPoolVisitor* pVisitor = nullptr;
+        WorkerThreadDesc::GroupAndAffinity affinity;
         uint32_t initialTaskCountPerWorker = 0;
         Atomic<bool> isReady = { false };
     };
@@ -148,20 +271,12 @@ private: // PRIVATE METHODS:
     // Check if there is work to do.
     bool _hasWork();
 
-    void _freeTasks();
-
 private: // DATA:
 
     friend class MicroScheduler;
     friend class WorkerPool;
     friend class LocalScheduler;
 
-    struct TaskPool
-    {
-        GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Atomic<Task*> pDeferredFreeList = { nullptr };
-        GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) Task* pFreeList = nullptr;
-    };
-
     struct ThreadBlocker
     {
         static constexpr uint32_t IS_UNBLOCKED          = 0;
@@ -196,7 +311,6 @@ private: // DATA:
     uint32_t m_resumeCount;
     Atomic<uint32_t> m_refCount;
     OwnedId m_id;
-    uint32_t m_cachableTaskSize;
 
     char pad[GTS_CACHE_LINE_SIZE * 2];
 
@@ -32,6 +32,7 @@
 
 #include "Worker.h"
 #include "LocalScheduler.h"
+#include "StealHierarchy.h"
 
 #include <iostream>
 
@@ -43,11 +44,14 @@ Atomic<uint16_t> WorkerPool::s_nextWorkerPoolId = { 0 };
 WorkerPool::WorkerPool()
     : m_pWorkersByIdx(nullptr)
     , m_pRegisteredSchedulers(nullptr)
+    , m_pExternalTaskPools(nullptr)
+    , m_pStealHierarchy(nullptr)
+    , m_pSleepingWorkerMasks(nullptr)
     , m_pGetThreadLocalStateFcn(nullptr)
     , m_pSetThreadLocalStateFcn(nullptr)
+    , m_cachableTaskSize(0)
     , m_poolId(UINT16_MAX)
     , m_workerCount(0)
-    , m_sleepingWorkerCount(0)
     , m_haltedWorkerCount(0)
     , m_isRunning(false)
     , m_ishalting(false)
@@ -93,24 +97,58 @@ bool WorkerPool::initialize(WorkerPoolDesc& desc)
         GTS_ASSERT(0 && "m_workerCount <= 0");
     }
     m_workerCount = workerCount;
+
+    m_counters.initialize(m_workerCount);
+
+    // Resolve where each Worker runs.
+    Vector<WorkerThreadDesc::GroupAndAffinity> affinities(m_workerCount);
+    bool hasAffinity = false;
+    for (uint32_t ii = 0; ii < m_workerCount; ++ii)
+    {
+        affinities[ii] = desc.workerDescs[ii].affinity;
+        hasAffinity |= !affinities[ii].affinitySet.empty();
+    }
+
+    // Without pinned Workers there is no locality to exploit, so don't pay
+    // for reading the topology.
+    SystemTopology topology;
+    if (desc.numaAware || (hasAffinity && m_workerCount > 1))
+    {
+        Thread::getSystemTopology(topology);
+    }
+
+    Vector<TaskArena*> arenaByWorker(m_workerCount, nullptr);
+    if (desc.numaAware)
+    {
+        _initNuma(desc, topology, affinities, arenaByWorker);
+    }
     
-    if (!_initWorkers(desc))
+    if (!_initWorkers(desc, affinities.data(), arenaByWorker.data()))
     {
         return false;
     }
 
+    _initStealHierarchy(desc, topology, affinities);
+
+    m_cachableTaskSize = m_pWorkersByIdx[0].m_pTaskPool->cachableTaskSize();
+
     m_pRegisteredSchedulers = alignedNew<RegisteredSchedulers, GTS_CACHE_LINE_SIZE>();
+    m_pExternalTaskPools    = alignedNew<ExternalTaskPools, GTS_CACHE_LINE_SIZE>();
 
     return true;
 }
 
 //------------------------------------------------------------------------------
-bool WorkerPool::_initWorkers(WorkerPoolDesc& desc)
+bool WorkerPool::_initWorkers(
+    WorkerPoolDesc& desc,
+    WorkerThreadDesc::GroupAndAffinity const* pAffinities,
+    TaskArena* const* ppArenaByWorker)
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKERPOOL INIT WORKERS", this, m_poolId);
 
     // Create the Workers.
     m_pWorkersByIdx = gts::alignedVectorNew<Worker, GTS_CACHE_LINE_SIZE>(m_workerCount);
+    m_pSleepingWorkerMasks = gts::alignedVectorNew<Atomic<uint64_t>, GTS_NO_SHARING_CACHE_LINE_SIZE>(_sleepingWorkerMaskCount());
 
     // Mark the scheduler as running.
     m_isRunning.store(true, gts::memory_order::release);
@@ -150,6 +188,7 @@ bool WorkerPool::_initWorkers(WorkerPoolDesc& desc)
         desc.pVisitor,
         desc.cachableTaskSize,
         desc.initialTaskCountPerWorker,
+        ppArenaByWorker[masterWorkerId],
         true))
     {
         return false;
@@ -163,7 +202,7 @@ bool WorkerPool::_initWorkers(WorkerPoolDesc& desc)
         if (!m_pWorkersByIdx[workerId].initialize(
             this,
             OwnedId(m_poolId, workerId),
-            desc.workerDescs[workerId].affinity,
+            pAffinities[workerId],
             desc.workerDescs[workerId].priority,
             desc.workerDescs[workerId].name,
             desc.workerDescs[workerId].pUserData,
@@ -171,7 +210,8 @@ bool WorkerPool::_initWorkers(WorkerPoolDesc& desc)
             desc.pSetThreadLocalStateFcn,
             desc.pVisitor,
             desc.cachableTaskSize,
-            desc.initialTaskCountPerWorker))
+            desc.initialTaskCountPerWorker,
+            ppArenaByWorker[workerId]))
         {
             return false;
         }
@@ -180,6 +220,115 @@ bool WorkerPool::_initWorkers(WorkerPoolDesc& desc)
     return true;
 }
 
+//------------------------------------------------------------------------------
+void WorkerPool::_initNuma(
+    WorkerPoolDesc const& desc,
+    SystemTopology const& topology,
+    Vector<WorkerThreadDesc::GroupAndAffinity>& affinities,
+    Vector<TaskArena*>& arenaByWorker)
+{
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKERPOOL INIT NUMA", this, m_poolId);
+
+    struct HwThreadSlot
+    {
+        size_t group;
+        uint32_t hwTid;
+        uint32_t nodeIdx;
+    };
+
+    // Order the hardware threads node by node, so consecutive Workers fill a
+    // node before spilling into the next one.
+    Vector<HwThreadSlot> slots;
+    for (size_t iGroup = 0; iGroup < topology.groupInfoElementCount; ++iGroup)
+    {
+        ProcessorGroupInfo const& group = topology.pGroupInfoArray[iGroup];
+        for (size_t iNode = 0; iNode < group.numaNodeInfoElementCount; ++iNode)
+        {
+            NumaNodeInfo const& node = group.pNumaInfoArray[iNode];
+            if (node.coreInfoElementCount == 0)
+            {
+                continue;
+            }
+
+            const uint32_t nodeIdx = (uint32_t)m_taskArenas.size();
+            const uint32_t nodeId  = node.nodeId != SIZE_MAX ? (uint32_t)node.nodeId : (uint32_t)iNode;
+            m_taskArenas.push_back(alignedNew<TaskArena, GTS_NO_SHARING_CACHE_LINE_SIZE>(nodeId, desc.numaBindMemory));
+
+            for (size_t iCore = 0; iCore < node.coreInfoElementCount; ++iCore)
+            {
+                CpuCoreInfo const& core = node.pCoreInfoArray[iCore];
+                for (size_t iThread = 0; iThread < core.hardwareThreadIdCount; ++iThread)
+                {
+                    slots.push_back({ group.groupId, core.pHardwareThreadIds[iThread], nodeIdx });
+                }
+            }
+        }
+    }
+
+    if (slots.empty())
+    {
+        GTS_ASSERT(0 && "The system reports no NUMA nodes.");
+        return;
+    }
+
+    for (uint32_t ii = 0; ii < m_workerCount; ++ii)
+    {
+        WorkerThreadDesc::GroupAndAffinity& affinity = affinities[ii];
+
+        if (affinity.affinitySet.empty())
+        {
+            HwThreadSlot const& slot = slots[ii % slots.size()];
+            affinity.group = slot.group;
+            affinity.affinitySet.set(slot.hwTid);
+            arenaByWorker[ii] = m_taskArenas[slot.nodeIdx];
+            continue;
+        }
+
+        // Keep the user's affinity. Use the arena of its first hardware thread.
+        for (size_t iSlot = 0; iSlot < slots.size(); ++iSlot)
+        {
+            if (slots[iSlot].group == affinity.group && affinity.affinitySet.isSet(slots[iSlot].hwTid))
+            {
+                arenaByWorker[ii] = m_taskArenas[slots[iSlot].nodeIdx];
+                break;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void WorkerPool::_initStealHierarchy(
+    WorkerPoolDesc const& desc,
+    SystemTopology const& topology,
+    Vector<WorkerThreadDesc::GroupAndAffinity> const& affinities)
+{
+    bool hasAffinity = false;
+    for (uint32_t ii = 0; ii < m_workerCount; ++ii)
+    {
+        hasAffinity |= !affinities[ii].affinitySet.empty();
+    }
+
+    if (!hasAffinity || m_workerCount < 2)
+    {
+        return;
+    }
+
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKERPOOL INIT STEAL HIERARCHY", this, m_poolId);
+
+    m_pStealHierarchy = alignedNew<StealHierarchy, GTS_CACHE_LINE_SIZE>();
+    if (!m_pStealHierarchy->build(topology, affinities.data(), m_workerCount))
+    {
+        alignedDelete(m_pStealHierarchy);
+        m_pStealHierarchy = nullptr;
+        return;
+    }
+
+    if (desc.numaAware)
+    {
+        m_pStealHierarchy->setRemoteStealPeriod(gtsMax(1u, desc.numaRemoteStealPeriod));
+    }
+}
+
 //------------------------------------------------------------------------------
 bool WorkerPool::shutdown()
 {
@@ -203,16 +352,6 @@ bool WorkerPool::shutdown()
             m_pSetThreadLocalStateFcn(0);
         }
         
-        // Analysis dump. Must happen before the workers are destroyed.
-        char filename[128];
-        #ifdef GTS_MSVC
-            sprintf_s(filename, "WorkerPool_Analysis_%d.txt", m_poolId);
-        #else
-            snprintf(filename, 128, "WorkerPool_Analysis_%d.txt", m_poolId);
-        #endif
-
-        GTS_WP_COUNTER_DUMP_TO(m_poolId, filename);
-
         // Destroy all the Workers.
         _destroyWorkers();
 
@@ -227,7 +366,27 @@ bool WorkerPool::shutdown()
         gts::alignedVectorDelete(m_pWorkersByIdx, m_workerCount);
         m_pWorkersByIdx = nullptr;
 
-        m_sleepingWorkerCount.store(0, memory_order::release);
+        gts::alignedVectorDelete(m_pSleepingWorkerMasks, _sleepingWorkerMaskCount());
+        m_pSleepingWorkerMasks = nullptr;
+
+        alignedDelete(m_pStealHierarchy);
+        m_pStealHierarchy = nullptr;
+
+        // After the Workers, since their TaskPools carve the arenas.
+        for (size_t ii = 0; ii < m_taskArenas.size(); ++ii)
+        {
+            alignedDelete(m_taskArenas[ii]);
+        }
+        m_taskArenas.clear();
+
+        GTS_ASSERT(m_pExternalTaskPools->pools.size() == m_pExternalTaskPools->unboundPools.size() &&
+            "An external thread is still registered.");
+        for (uint32_t ii = 0; ii < m_pExternalTaskPools->pools.size(); ++ii)
+        {
+            alignedDelete(m_pExternalTaskPools->pools[ii]);
+        }
+        alignedDelete(m_pExternalTaskPools);
+        m_pExternalTaskPools = nullptr;
 
         GTS_TRACE_ZONE_MARKER_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKERPOOL DESTROYED", this, m_poolId);
     }
@@ -280,6 +439,22 @@ MicroScheduler* WorkerPool::currentMicroScheduler() const
     return ((Worker*)state)->currentMicroScheduler();
 }
 
+//------------------------------------------------------------------------------
+void WorkerPool::getCounters(analysis::WorkerPoolCounterSnapshot& out) const
+{
+    m_counters.snapshot(out);
+}
+
+//------------------------------------------------------------------------------
+analysis::WorkerPoolCounterSlot* WorkerPool::_counters(OwnedId workerId)
+{
+    if (workerId.ownerId() == m_poolId && workerId.localId() < m_workerCount)
+    {
+        return m_counters.workerSlot(workerId.localId());
+    }
+    return m_counters.externalSlot();
+}
+
 //------------------------------------------------------------------------------
 void WorkerPool::enumerateWorkerIds(Vector<OwnedId>& out) const
 {
@@ -308,58 +483,155 @@ void WorkerPool::resetIdGenerator()
     s_nextWorkerPoolId.store(0, memory_order::release);
 }
 
+//------------------------------------------------------------------------------
+bool WorkerPool::registerExternalThread()
+{
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKERPOOL REGISTER EXTERNAL THREAD", this, m_poolId);
+
+    if (m_pGetThreadLocalStateFcn() != 0)
+    {
+        GTS_ASSERT(0 && "Worker threads cannot be registered as external threads.");
+        return false;
+    }
+
+    if (WorkerPool* pOwner = TaskPool::getExternalLocalOwner())
+    {
+        // A thread has a single cache, so it can only register with one pool.
+        GTS_ASSERT(0 && (pOwner == this
+            ? "This thread is already registered."
+            : "This thread is registered with another WorkerPool."));
+        return false;
+    }
+
+    TaskPool* pTaskPool = nullptr;
+    {
+        Lock<MutexType> lock(m_pExternalTaskPools->mutex);
+
+        // Reuse the cache of a thread that has unregistered.
+        if (!m_pExternalTaskPools->unboundPools.empty())
+        {
+            pTaskPool = m_pExternalTaskPools->unboundPools.back();
+            m_pExternalTaskPools->unboundPools.pop_back();
+        }
+        else
+        {
+            pTaskPool = alignedNew<TaskPool, GTS_NO_SHARING_CACHE_LINE_SIZE>(m_cachableTaskSize);
+            m_pExternalTaskPools->pools.push_back(pTaskPool);
+        }
+    }
+
+    TaskPool::setExternalLocal(pTaskPool, this);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void WorkerPool::unregisterExternalThread()
+{
+    GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_DEBUG, analysis::Color::AntiqueWhite, "WORKERPOOL UNREGISTER EXTERNAL THREAD", this, m_poolId);
+
+    TaskPool* pTaskPool = TaskPool::getExternalLocal(this);
+    if (pTaskPool == nullptr)
+    {
+        GTS_ASSERT(0 && (TaskPool::getExternalLocalOwner() != nullptr
+            ? "This thread is registered with another WorkerPool."
+            : "This thread is not registered."));
+        return;
+    }
+
+    // Tasks from this thread may still be in flight, so the cache stays alive
+    // until shutdown. Workers keep returning Tasks to its deferred free list.
+    TaskPool::setExternalLocal(nullptr, nullptr);
+
+    Lock<MutexType> lock(m_pExternalTaskPools->mutex);
+    m_pExternalTaskPools->unboundPools.push_back(pTaskPool);
+}
+
 //------------------------------------------------------------------------------
 void WorkerPool::_wakeWorker(Worker* pThisWorker, uint32_t count, bool reset)
 {
     GTS_TRACE_SCOPED_ZONE_P3(analysis::CaptureMask::WORKERPOOL_ALL, analysis::Color::Orange2, "WORKERPOOL WAKE WORKER", this, m_poolId, pThisWorker->id().uid());
-    GTS_WP_COUNTER_INC(pThisWorker->id(), gts::analysis::WorkerPoolCounters::NUM_WAKE_CALLS);
+
+    // Called on every spawn, so our own Workers skip the atomic add.
+    if (pThisWorker && pThisWorker->id().ownerId() == m_poolId)
+    {
+        GTS_WP_COUNTER_INC(m_counters.workerSlot(pThisWorker->id().localId()), gts::analysis::WorkerPoolCounters::NUM_WAKE_CALLS);
+    }
+    else
+    {
+        GTS_WP_COUNTER_INC_SHARED(m_counters.externalSlot(), gts::analysis::WorkerPoolCounters::NUM_WAKE_CALLS);
+    }
 
     GTS_ASSERT(count > 0);
 
-    // Make sure we have suspended threads before entering the more expensive
-    // suspend process.
-    if (m_sleepingWorkerCount.load(gts::memory_order::acquire) > 0)
+    uint32_t startIdx = 1; // <- start at 1 because the master thread #0 does not suspend and will not resume.
+    OwnedId thisWorkerId;
+    if(pThisWorker)
     {
-        uint32_t startIdx = 1; // <- start at 1 because the master thread #0 does not suspend and will not resume.
-        OwnedId thisWorkerId;
-        if(pThisWorker)
+        startIdx = fastRand(pThisWorker->m_randState) % m_workerCount;
+        if(startIdx == 0)
         {
-            startIdx = fastRand(pThisWorker->m_randState) % m_workerCount;
-            if(startIdx == 0)
-            {
-                ++startIdx;
-            }
-            thisWorkerId = pThisWorker->id();
+            ++startIdx;
         }
+        thisWorkerId = pThisWorker->id();
+    }
 
-        // Search through all the Workers for a sleeping Worker.
-        if (!_wakeWorkerLoop(startIdx, m_workerCount, thisWorkerId.localId(), count, reset))
-        {
-            _wakeWorkerLoop(1, startIdx, thisWorkerId.localId(), count, reset);
-        }
+    // Search through the sleeping Workers. With no sleepers this is just a
+    // load per 64 Workers.
+    if (!_wakeWorkerLoop(startIdx, m_workerCount, thisWorkerId.localId(), count, reset))
+    {
+        _wakeWorkerLoop(1, startIdx, thisWorkerId.localId(), count, reset);
     }
 }
 
 //------------------------------------------------------------------------------
 bool WorkerPool::_wakeWorkerLoop(uint32_t startIdx, uint32_t endIdx, SubIdType thisWorkerId, uint32_t count, bool reset)
 {
-    for (uint32_t ii = startIdx; ii < endIdx; ++ii) 
+    for (uint32_t maskIdx = startIdx / SLEEP_MASK_BITS; maskIdx * SLEEP_MASK_BITS < endIdx; ++maskIdx)
     {
-        if (ii == thisWorkerId)
-        {
-            continue; // already awake!
-        }
+        const uint32_t maskBegin = maskIdx * SLEEP_MASK_BITS;
+        const uint32_t lo        = gtsMax(startIdx, maskBegin) - maskBegin;
+        const uint32_t hi        = gtsMin(endIdx, maskBegin + SLEEP_MASK_BITS) - maskBegin;
 
-        Worker& worker = m_pWorkersByIdx[ii];
-        if (worker.wake(count, reset, false))
+        uint64_t sleepers = m_pSleepingWorkerMasks[maskIdx].load(memory_order::acquire);
+        sleepers &= (hi == SLEEP_MASK_BITS ? UINT64_MAX : (uint64_t(1) << hi) - 1) & ~((uint64_t(1) << lo) - 1);
+
+        while (sleepers != 0)
         {
-            return true;
+            const uint32_t ii = maskBegin + (uint32_t)GTS_LSB_SCAN64(sleepers);
+            sleepers &= sleepers - 1;
+
+            if (ii == thisWorkerId)
+            {
+                continue; // already awake!
+            }
+
+            Worker& worker = m_pWorkersByIdx[ii];
+            if (worker.wake(count, reset, false))
+            {
+                return true;
+            }
+            GTS_SPECULATION_FENCE();
         }
-        GTS_SPECULATION_FENCE();
     }
     return false;
 }
 
+//------------------------------------------------------------------------------
+void WorkerPool::_markSleeping(SubIdType workerId, bool isSleeping)
+{
+    const uint64_t bit = uint64_t(1) << (workerId % SLEEP_MASK_BITS);
+    Atomic<uint64_t>& mask = m_pSleepingWorkerMasks[workerId / SLEEP_MASK_BITS];
+
+    if (isSleeping)
+    {
+        mask.fetch_or(bit, memory_order::acq_rel);
+    }
+    else
+    {
+        mask.fetch_and(~bit, memory_order::acq_rel);
+    }
+}
+
 //------------------------------------------------------------------------------
 uint32_t WorkerPool::_haltedWorkerCount() const
 {
@@ -380,7 +652,7 @@ uint32_t WorkerPool::_haltedWorkerCount() const
 void WorkerPool::_haltAllWorkers()
 {
     GTS_TRACE_SCOPED_ZONE_P2(analysis::CaptureMask::WORKERPOOL_ALL, analysis::Color::AntiqueWhite, "WORKERPOOL HALT WORKERS", this, m_poolId);
-    GTS_WP_COUNTER_INC(thisWorkerId(), gts::analysis::WorkerPoolCounters::NUM_HALTS_SIGNALED);
+    GTS_WP_COUNTER_INC_SHARED(_counters(thisWorkerId()), gts::analysis::WorkerPoolCounters::NUM_HALTS_SIGNALED);
 
     uintptr_t state = Worker::getLocalState();
     Worker* pWorker = (Worker*)state;
@@ -425,7 +697,7 @@ void WorkerPool::_resumeAllWorkers()
         // Get all workers our of their suspend state.
         for (volatile size_t ii = 1; ii < m_workerCount; ++ii)  // ii = 1. ignore master
         {
-            GTS_WP_COUNTER_INC(thisWorkerId(), gts::analysis::WorkerPoolCounters::NUM_RESUMES);
+            GTS_WP_COUNTER_INC_SHARED(_counters(thisWorkerId()), gts::analysis::WorkerPoolCounters::NUM_RESUMES);
             Worker& worker = m_pWorkersByIdx[ii];
             worker.resume();
         }
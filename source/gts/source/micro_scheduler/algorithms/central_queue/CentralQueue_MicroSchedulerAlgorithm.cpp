@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include "gts/micro_scheduler/algorithms/central_queue/CentralQueue_MicroSchedulerAlgorithm.h"
+
+#include "gts/platform/Assert.h"
+
+namespace gts {
+
+// LIFETIME:
+
+//------------------------------------------------------------------------------
+bool CentralQueue_MicroSchedulerAlgorithm::initialize(uint32_t workerCount, uint32_t priorityCount)
+{
+    GTS_UNREFERENCED_PARAM(workerCount);
+
+    if (priorityCount == 0)
+    {
+        GTS_ASSERT(0 && "Must have at least one priority.");
+        return false;
+    }
+
+    m_queuesByPriority.resize(priorityCount);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void CentralQueue_MicroSchedulerAlgorithm::shutdown()
+{
+    GTS_ASSERT(!hasTasks() && "Shutting down with unexecuted Tasks.");
+    m_queuesByPriority.clear();
+}
+
+// MUTATORS:
+
+//------------------------------------------------------------------------------
+bool CentralQueue_MicroSchedulerAlgorithm::push(Task* pTask, uint32_t priority, SubIdType workerIdx)
+{
+    GTS_UNREFERENCED_PARAM(workerIdx);
+    GTS_ASSERT(priority < m_queuesByPriority.size());
+
+    return m_queuesByPriority[priority].tryPush(pTask);
+}
+
+//------------------------------------------------------------------------------
+Task* CentralQueue_MicroSchedulerAlgorithm::pop(SubIdType workerIdx)
+{
+    GTS_UNREFERENCED_PARAM(workerIdx);
+
+    Task* pTask = nullptr;
+    for (size_t priority = 0; priority < m_queuesByPriority.size(); ++priority)
+    {
+        TaskQueue& queue = m_queuesByPriority[priority];
+        if (!queue.empty() && queue.tryPop(pTask))
+        {
+            return pTask;
+        }
+    }
+    return nullptr;
+}
+
+// ACCESSORS:
+
+//------------------------------------------------------------------------------
+bool CentralQueue_MicroSchedulerAlgorithm::hasTasks() const
+{
+    for (size_t priority = 0; priority < m_queuesByPriority.size(); ++priority)
+    {
+        if (!m_queuesByPriority[priority].empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+const char* CentralQueue_MicroSchedulerAlgorithm::name() const
+{
+    return "CentralQueue";
+}
+
+} // namespace gts
@@ -36,6 +36,10 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#ifdef GTS_LINUX
+#include <sys/syscall.h>
+#endif
+
 #if !defined(MAP_ANONYMOUS)
   #define MAP_ANONYMOUS  MAP_ANON
 #endif
@@ -229,6 +233,35 @@ bool Memory::osVirtualFree(void* ptr, size_t size)
     return result == 0;
 }
 
+//------------------------------------------------------------------------------
+bool Memory::osBindToNumaNode(void* ptr, size_t size, uint32_t nodeId)
+{
+#if defined(GTS_LINUX) && defined(SYS_mbind)
+    // Call mbind directly so that GTS does not depend on libnuma.
+    constexpr int MPOL_PREFERRED_MODE = 1;
+    constexpr size_t BITS_PER_WORD    = sizeof(unsigned long) * 8;
+    constexpr size_t MASK_WORDS       = 16;
+
+    if (nodeId >= BITS_PER_WORD * MASK_WORDS)
+    {
+        return false;
+    }
+
+    unsigned long nodeMask[MASK_WORDS] = { 0 };
+    nodeMask[nodeId / BITS_PER_WORD] = 1ul << (nodeId % BITS_PER_WORD);
+
+    // Preferred rather than strict binding, so a full node spills over
+    // instead of failing the allocation.
+    long result = syscall(SYS_mbind, ptr, size, MPOL_PREFERRED_MODE, nodeMask, BITS_PER_WORD * MASK_WORDS + 1, 0);
+    return result == 0;
+#else
+    GTS_UNREFERENCED_PARAM(ptr);
+    GTS_UNREFERENCED_PARAM(size);
+    GTS_UNREFERENCED_PARAM(nodeId);
+    return false;
+#endif
+}
+
 } // namespace internal
 } // namespace gts
 
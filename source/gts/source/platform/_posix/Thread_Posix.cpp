@@ -26,9 +26,12 @@
 #include <map>
 #include <vector>
 
+#include <climits>
+
 #include <pthread.h>
 #include <unistd.h>
 #include <sched.h>
+#include <linux/futex.h>
 #include <linux/limits.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
@@ -115,7 +118,7 @@ void setBaseFrequencyId(Core& out, uint32_t coreId)
     FILE* file = fopen(filenameBuffer, "r");
     if(file == nullptr)
     {
-        GTS_ASSERT(0 && "No package ID found.");
+        // cpufreq is optional, e.g. most VMs don't expose it.
         return;
     }
     int result = fscanf(file, "%u", &out.baseFrequency);
@@ -348,10 +351,12 @@ void Thread::getSytemTopology(SystemTopology& out)
     // Build socket info.
     groupInfo.pSocketInfoArray = new SocketInfo[coresByPackageId.size()];
     groupInfo.socketInfoElementCount = coresByPackageId.size();
-    for(uint32_t iSocket = 0; iSocket < groupInfo.socketInfoElementCount; ++iSocket)
+    uint32_t iSocket = 0;
+    for(auto iter = coresByPackageId.begin(); iter != coresByPackageId.end(); ++iter, ++iSocket)
     {
+        // Keyed by package ID, which is not necessarily 0..n-1.
         auto& socket = groupInfo.pSocketInfoArray[iSocket];
-        auto& cores = coresByPackageId[iSocket];
+        auto& cores = iter->second;
 
         socket.pCoreInfoArray = new CpuCoreInfo[cores.size()];
         socket.coreInfoElementCount = cores.size();
@@ -371,10 +376,13 @@ void Thread::getSytemTopology(SystemTopology& out)
     // Build NUMA info.
     groupInfo.pNumaInfoArray = new NumaNodeInfo[coresByNumaNode.size()];
     groupInfo.numaNodeInfoElementCount = coresByNumaNode.size();
-    for(uint32_t iNode = 0; iNode < groupInfo.numaNodeInfoElementCount; ++iNode)
+    uint32_t iNode = 0;
+    for(auto iter = coresByNumaNode.begin(); iter != coresByNumaNode.end(); ++iter, ++iNode)
     {
+        // Keyed by NUMA node ID, which is not necessarily 0..n-1.
         auto& node = groupInfo.pNumaInfoArray[iNode];
-        auto& cores = coresByNumaNode[iNode];
+        auto& cores = iter->second;
+        node.nodeId = iter->first;
 
         node.pCoreInfoArray = new CpuCoreInfo[cores.size()];
         node.coreInfoElementCount = cores.size();
@@ -394,15 +402,18 @@ void Thread::getSytemTopology(SystemTopology& out)
     // Build core info.
     groupInfo.pCoreInfoArray = new CpuCoreInfo[coresByFirstHwThread.size()];
     groupInfo.coreInfoElementCount = coresByFirstHwThread.size();
-    for(uint32_t iCore = 0; iCore < groupInfo.coreInfoElementCount; ++iCore)
+    uint32_t iCore = 0;
+    for(auto iter = coresByFirstHwThread.begin(); iter != coresByFirstHwThread.end(); ++iter, ++iCore)
     {
+        // Keyed by first hardware thread, which is not necessarily 0..n-1.
+        Core const& core = iter->second;
         auto& coreInfo = groupInfo.pCoreInfoArray[iCore];
-        coreInfo.efficiencyClass = efficiencyByFrequency[coresByFirstHwThread[iCore].baseFrequency];
-        coreInfo.pHardwareThreadIds = new uint32_t[cores[iCore].hwThreadsIds.size()];
-        coreInfo.hardwareThreadIdCount = coresByFirstHwThread[iCore].hwThreadsIds.size();
+        coreInfo.efficiencyClass = efficiencyByFrequency[core.baseFrequency];
+        coreInfo.pHardwareThreadIds = new uint32_t[core.hwThreadsIds.size()];
+        coreInfo.hardwareThreadIdCount = core.hwThreadsIds.size();
         for(uint32_t iThread = 0; iThread < coreInfo.hardwareThreadIdCount; ++iThread)
         {
-            coreInfo.pHardwareThreadIds[iThread] = coresByFirstHwThread[iCore].hwThreadsIds[iThread];
+            coreInfo.pHardwareThreadIds[iThread] = core.hwThreadsIds[iThread];
         }
     }
 }
@@ -469,110 +480,90 @@ bool Thread::setThisPriority(int32_t priority)
 
 #ifndef GTS_HAS_CUSTOM_EVENT_WRAPPERS
 
-static_assert(sizeof(EventHandle::MutexHandle)  == sizeof(pthread_mutex_t), "EventHandle::Mutex size mismatch.");
-static_assert(sizeof(EventHandle::CondVar)      == sizeof(pthread_cond_t), "EventHandle::ConditionVar size mismatch.");
-static_assert(alignof(EventHandle::MutexHandle) == alignof(pthread_mutex_t), "EventHandle::Mutex alignment mismatch.");
-static_assert(alignof(EventHandle::CondVar)     == alignof(pthread_cond_t), "EventHandle::ConditionVar alignment mismatch.");
-static_assert(GTS_WAIT_FOREVER                  == uint32_t(-1), "Value of GTS_WAIT_FOREVER does not match the OS.");
+static_assert(sizeof(Atomic<uint32_t>) == sizeof(uint32_t), "A futex word must be 32-bits.");
+static_assert(GTS_WAIT_FOREVER         == uint32_t(-1), "Value of GTS_WAIT_FOREVER does not match the OS.");
+
+// The Event is a single futex word, so signaling an Event nobody waits on
+// never enters the kernel.
+static constexpr uint32_t EVENT_UNSIGNALED = 0;
+static constexpr uint32_t EVENT_SIGNALED   = 1;
+static constexpr uint32_t EVENT_WAITING    = 2; // Unsignaled with waiters.
 
 //------------------------------------------------------------------------------
-bool Event::createEvent(EventHandle& handle)
+static GTS_INLINE void futexWait(Atomic<uint32_t>& word, uint32_t expected)
 {
-    int result = pthread_cond_init((pthread_cond_t*)&handle.condVar, 0);
-    if(result != 0)
-    {
-        GTS_ASSERT(0);
-        return false;
-    }
+    // Returns immediately if 'word' != 'expected'. Callers recheck the word,
+    // so EINTR and spurious wakes are harmless.
+    syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
 
-    result = pthread_mutex_init((pthread_mutex_t*)&handle.mutex, 0);
-    GTS_ASSERT(result == 0);
-    return result == 0;
+//------------------------------------------------------------------------------
+static GTS_INLINE void futexWakeAll(Atomic<uint32_t>& word)
+{
+    syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
 }
 
 //------------------------------------------------------------------------------
-bool Event::destroyEvent(EventHandle& handle)
+bool Event::createEvent(EventHandle& handle)
 {
-    int result = pthread_mutex_destroy((pthread_mutex_t*)&handle.mutex);
-    if(result != 0)
-    {
-        GTS_ASSERT(0);
-        return false;
-    }
+    handle.state.store(EVENT_UNSIGNALED, memory_order::release);
+    return true;
+}
 
-    result = pthread_cond_destroy((pthread_cond_t*)&handle.condVar);
-    GTS_ASSERT(result == 0);
-    return result == 0;
+//------------------------------------------------------------------------------
+bool Event::destroyEvent(EventHandle& handle)
+{
+    GTS_ASSERT(handle.state.load(memory_order::acquire) != EVENT_WAITING && "Destroying an Event with waiters.");
+    GTS_UNREFERENCED_PARAM(handle);
+    return true;
 }
 
 //------------------------------------------------------------------------------
 bool Event::waitForEvent(EventHandle& handle, bool waitForever)
 {
-    if (handle.signaled.load(memory_order::acquire))
+    uint32_t state = handle.state.load(memory_order::acquire);
+    if (state == EVENT_SIGNALED)
     {
         return false;
     }
 
-    int result = pthread_mutex_lock((pthread_mutex_t*)&handle.mutex);
-    if (result != 0)
-    {
-        GTS_ASSERT(0);
-        return false;
-    }
-
     if (!waitForever)
     {
-        result = pthread_mutex_unlock((pthread_mutex_t*)&handle.mutex);
-        if (result != 0)
-        {
-            GTS_ASSERT(0);
-            return false;
-        }
-        return handle.waiting;
+        return state == EVENT_WAITING;
     }
 
-    handle.waiting = true;
-
-    while (!handle.signaled.load(memory_order::acquire)) // guard against spurious wakes.
+    while (state != EVENT_SIGNALED) // guard against spurious wakes.
     {
-        result = pthread_cond_wait((pthread_cond_t*)&handle.condVar, (pthread_mutex_t*)&handle.mutex);
-        if (result != 0)
+        // Announce the waiter so signalEvent knows to enter the kernel.
+        if (state == EVENT_UNSIGNALED &&
+            !handle.state.compare_exchange_weak(state, EVENT_WAITING, memory_order::acq_rel, memory_order::acquire))
         {
-            GTS_ASSERT(0);
+            continue;
         }
 
-        if (result != 0)
-        {
-            GTS_ASSERT(0);
-            result = pthread_mutex_unlock((pthread_mutex_t*)&handle.mutex);
-            if (result != 0)
-            {
-                GTS_ASSERT(0);
-            }
-            return false;
-        }
+        futexWait(handle.state, EVENT_WAITING);
+        state = handle.state.load(memory_order::acquire);
     }
 
-    handle.waiting = false;
-
-    result = pthread_mutex_unlock((pthread_mutex_t*)&handle.mutex);
-    GTS_ASSERT(result == 0);
-    return result == 0;
+    return true;
 }
 
 //------------------------------------------------------------------------------
 bool Event::signalEvent(EventHandle& handle)
 {
-    handle.signaled.exchange(true, memory_order::acq_rel);
-    int result = pthread_cond_signal((pthread_cond_t*)&handle.condVar);
-    GTS_ASSERT(result == 0);
-    return result == 0;
+    if (handle.state.exchange(EVENT_SIGNALED, memory_order::acq_rel) == EVENT_WAITING)
+    {
+        futexWakeAll(handle.state);
+    }
+    return true;
 }
 
 //------------------------------------------------------------------------------
 bool Event::resetEvent(EventHandle& handle)
 {
-    handle.signaled.exchange(false, memory_order::acq_rel);
+    // Leave EVENT_WAITING alone so its waiters are still woken.
+    uint32_t expected = EVENT_SIGNALED;
+    handle.state.compare_exchange_strong(expected, EVENT_UNSIGNALED, memory_order::acq_rel, memory_order::relaxed);
     return true;
 }
 
@@ -179,6 +179,14 @@ bool Memory::osVirtualFree(void* ptr, size_t)
     return result == TRUE;
 }
 
+//------------------------------------------------------------------------------
+bool Memory::osBindToNumaNode(void*, size_t, uint32_t)
+{
+    // Windows can only choose a node at allocation (VirtualAllocExNuma). Rely
+    // on first-touch placement instead.
+    return false;
+}
+
 } // namespace internal
 } // namespace gts
 
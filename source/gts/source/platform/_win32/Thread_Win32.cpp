@@ -706,8 +706,12 @@ bool Event::waitForEvent(EventHandle& handle, bool waitForever)
 bool Event::signalEvent(EventHandle& handle)
 {
     GTS_TRACE_SCOPED_ZONE_P0(analysis::CaptureMask::THREAD_PROFILE, analysis::Color::Purple, "Event signaled");
+    // Signal under the lock so a waiter cannot miss the wake between
+    // checking 'signaled' and sleeping on the condition variable.
+    EnterCriticalSection((CRITICAL_SECTION*)&handle.mutex);
     handle.signaled.exchange(true, memory_order::acq_rel);
     WakeConditionVariable((CONDITION_VARIABLE*)&handle.condVar);
+    LeaveCriticalSection((CRITICAL_SECTION*)&handle.mutex);
     return true;
 }
 
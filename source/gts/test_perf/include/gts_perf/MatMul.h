@@ -24,6 +24,8 @@
 
 #include <gts/containers/Vector.h>
 #include <gts/micro_scheduler/MicroScheduler.h>
+#include <gts/micro_scheduler/patterns/ParallelFor.h>
+#include <gts/micro_scheduler/patterns/KdRange2d.h>
 
 namespace matmul {
 
@@ -694,4 +696,33 @@ inline void sgemmParallelBlockDivideAndConquerKd(
     taskScheduler.spawnTaskAndWait(pRoot);
 }
 
+//------------------------------------------------------------------------------
+// Computes each blockSizeM x blockSizeK block of C with a ParallelFor, so the
+// partitioner decides which Worker computes which block.
+template<typename TPartitioner>
+inline void sgemmParallelFor(
+    gts::MicroScheduler& taskScheduler,
+    float const* __restrict matrixA, float const* __restrict matrixB, float* __restrict matrixC,
+    size_t const M, size_t const N, size_t const K,
+    size_t const blockSizeM, size_t const blockSizeK,
+    TPartitioner partitioner)
+{
+    gts::ParallelFor parallelFor(taskScheduler);
+
+    parallelFor(
+        gts::KdRange2d<size_t>(0, M, blockSizeM, 0, K, blockSizeK, blockSizeM, blockSizeK),
+        [=](gts::KdRange2d<size_t>& range, void*, gts::TaskContext const&)
+        {
+            for (size_t m = range.xRange().begin(); m < range.xRange().end(); m += blockSizeM)
+            {
+                for (size_t k = range.yRange().begin(); k < range.yRange().end(); k += blockSizeK)
+                {
+                    sgemmKernelSimd512(matrixA + m * N, matrixB + k, matrixC + m * K + k, N, K, blockSizeM, N, blockSizeK);
+                }
+            }
+        },
+        partitioner,
+        nullptr);
+}
+
 } // namespace matmul
@@ -29,13 +29,22 @@
 Stats spawnTaskOverheadWithoutAllocPerf(gts::MicroScheduler& taskScheduler, uint32_t iterations);
 Stats spawnTaskOverheadWithAllocCachingPerf(gts::MicroScheduler& taskScheduler, uint32_t iterations);
 Stats spawnTaskOverheadWithAllocPerf(gts::MicroScheduler& taskScheduler, uint32_t iterations);
+Stats spawnTaskOverheadFromExternalThreadPerf(gts::WorkerPool& workerPool, gts::MicroScheduler& taskScheduler, uint32_t iterations, bool registerThread);
+Stats spawnToExecuteLatencyPerf(gts::MicroScheduler& taskScheduler, uint32_t idleTimeUs, uint32_t iterations);
+
+Stats nonWorkerWaitLatencyPerf(gts::MicroScheduler& taskScheduler, uint32_t workTimeUs, uint32_t iterations);
+Stats nonWorkerWaitCpuTimePerf(gts::MicroScheduler& taskScheduler, uint32_t workTimeUs, uint32_t iterations);
+
+Stats highPriorityTimeToStartPerf(gts::WorkerPool& workerPool, bool useGlobalPriorities, uint32_t taskCount, uint32_t iterations);
 
 Stats schedulerOverheadParForPerf(gts::MicroScheduler& taskScheduler, uint32_t size, uint32_t iterations);
 Stats schedulerOverheadFibPerf(gts::MicroScheduler& taskScheduler, uint32_t fibN, uint32_t iterations);
 Stats poorDistributionPerf(gts::MicroScheduler& taskScheduler, uint32_t taskCount, uint32_t iterations);
+Stats poorDistributionBatchStealPerf(gts::WorkerPool& workerPool, uint32_t maxStealBatchSize, uint32_t taskCount, uint32_t iterations);
 Stats poorSystemDistributionPerf(gts::WorkerPool& workerPool, uint32_t iterations);
 
 Stats sparseWorkPerf(gts::MicroScheduler& taskScheduler, uint32_t items, uint32_t iterations);
+Stats sparseWorkBatchStealPerf(gts::WorkerPool& workerPool, uint32_t maxStealBatchSize, uint32_t items, uint32_t iterations);
 
 Stats irregularRandParallelFor(gts::MicroScheduler& taskScheduler, uint32_t items, uint32_t iterations);
 Stats irregularUpfrontParallelFor(gts::MicroScheduler& taskScheduler, uint32_t items, uint32_t iterations);
@@ -48,10 +57,32 @@ Stats aoBenchPerfParallel(gts::MicroScheduler& taskScheduler, uint32_t w, uint32
 
 Stats matMulPefSerial(const size_t M, const size_t N, const size_t K, size_t iterations);
 Stats matMulPefParallel(gts::MicroScheduler& taskScheduler, const size_t M, const size_t N, const size_t K, size_t iterations);
+Stats matMulPefParallelFor(gts::MicroScheduler& taskScheduler, const size_t M, const size_t N, const size_t K, size_t iterations, bool useAffinity);
 
 Stats mpmcQueuePerfSerial(const uint32_t itemCount, uint32_t iterations);
 Stats mpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount, uint32_t iterations);
+Stats boundedMpmcQueuePerfSerial(const uint32_t itemCount, uint32_t iterations);
+Stats boundedMpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount, uint32_t iterations);
+
+Stats parallelScanPerfSerial(uint32_t elementCount, uint32_t iterations);
+Stats parallelScanPerfParallel(gts::MicroScheduler& taskScheduler, uint32_t elementCount, uint32_t iterations);
+
+Stats parallelSortPerfSerial(uint32_t elementCount, uint32_t iterations);
+Stats parallelSortPerfMerge(gts::MicroScheduler& taskScheduler, uint32_t elementCount, uint32_t iterations);
+Stats parallelSortPerfRadix(gts::MicroScheduler& taskScheduler, uint32_t elementCount, uint32_t iterations);
+
+Stats parallelPipelinePerfSerial(uint32_t itemCount, uint32_t iterations);
+Stats parallelPipelinePerfParallel(gts::MicroScheduler& taskScheduler, uint32_t tokenCount, uint32_t itemCount, uint32_t iterations);
+
+Stats parallelWavefrontPerf2dSerial(uint32_t dimSize, uint32_t iterations);
+Stats parallelWavefrontPerf2dParallel(gts::MicroScheduler& taskScheduler, uint32_t dimSize, uint32_t iterations);
+Stats parallelWavefrontPerf3dSerial(uint32_t dimSize, uint32_t iterations);
+Stats parallelWavefrontPerf3dParallel(gts::MicroScheduler& taskScheduler, uint32_t dimSize, uint32_t iterations);
+
+Stats stencilPerfSerial(uint32_t dimSize, uint32_t iterations);
+Stats stencilPerfParallel(gts::MicroScheduler& taskScheduler, uint32_t dimSize, uint32_t iterations, bool useAffinity);
 
-Stats homoRandomDagWorkStealing(uint32_t iterations);
+Stats homoRandomDagWorkStealing(uint32_t iterations, bool workStealingScheduler, bool wideDag);
 Stats heteroRandomDagWorkStealing(uint32_t iterations, bool bidirectionalStealing);
 Stats heteroRandomDagCriticallyAware(uint32_t iterations);
+Stats heteroRandomDagCriticalNodeRanking(uint32_t iterations, bool incrementalRanking);
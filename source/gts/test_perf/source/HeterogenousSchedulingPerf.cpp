@@ -39,10 +39,15 @@
 #include "gts/macro_scheduler/schedulers/homogeneous/central_queue/CentralQueue_MacroScheduler.h"
 #include "gts/macro_scheduler/schedulers/homogeneous/central_queue/CentralQueue_Schedule.h"
 
+#include "gts/macro_scheduler/schedulers/homogeneous/work_stealing/WorkStealing_MacroScheduler.h"
+
 // critically_aware_task_scheduling
 #include "gts/macro_scheduler/schedulers/heterogeneous/critically_aware_task_scheduling/CriticallyAware_MacroScheduler.h"
 #include "gts/macro_scheduler/schedulers/heterogeneous/critically_aware_task_scheduling/CriticallyAware_Schedule.h"
 
+// critical_node_task_scheduling
+#include "gts/macro_scheduler/schedulers/heterogeneous/critical_node_task_scheduling/CriticalNode_MacroScheduler.h"
+
 #include <Windows.h>
 
 using namespace gts;
@@ -389,6 +394,9 @@ Stats heteroRandomDagTest(Vector<ComputeResource*>const& computeResources, uint3
             pMacroScheduler->destroyNode(nodes[ii]);
         }
 
+        // Destroys the pooled Schedule.
+        delete pMacroScheduler;
+
         time[iStep] = stats.mean();
         printf("time: %f\n", stats.mean());
         printf("stddev: %f\n", stats.standardDeviation());
@@ -548,20 +556,76 @@ Stats heteroRandomDagTest(Vector<ComputeResource*>const& computeResources, uint3
     return stats;
 }
 
+//------------------------------------------------------------------------------
+template<typename TMacroScheduler>
+Stats homoRandomDagTest(ComputeResource* pComputeResource, uint32_t iterations, bool wideDag)
+{
+    // Small workloads, so the cost of moving ready Nodes between Workers
+    // dominates over the work itself.
+    const uint32_t NUM_RANKS              = wideDag ? 20 : 500;
+    const uint32_t MIN_NODES_PER_RANK     = wideDag ? 50 : 1;
+    const uint32_t MAX_NODES_PER_RANK     = wideDag ? 100 : 4;
+    const uint32_t CHANCE_OF_INCOMING_END = 0;
+    const uint32_t MAX_SPIN               = 1024;
+
+    Stats stats(iterations);
+
+    MacroSchedulerDesc macroSchedulerDesc;
+    macroSchedulerDesc.computeResources.push_back(pComputeResource);
+
+    TMacroScheduler* pMacroScheduler = new TMacroScheduler;
+    pMacroScheduler->init(macroSchedulerDesc);
+
+    // The fixed seed gives each scheduler the same DAG and workloads.
+    Vector<Node*> nodes;
+    DagUtils::generateRandomDag(pMacroScheduler, 1, NUM_RANKS, MIN_NODES_PER_RANK, MAX_NODES_PER_RANK, CHANCE_OF_INCOMING_END, nodes);
+
+    for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+    {
+        nodes[ii]->addWorkload<SinSpinWorkload>(1 + rand() % MAX_SPIN);
+    }
+
+    Schedule* pSchedule = pMacroScheduler->buildSchedule(nodes.front(), nodes.back());
+
+    for (uint32_t iter = 0; iter < iterations; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        pMacroScheduler->executeSchedule(pSchedule, pComputeResource->id());
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    pMacroScheduler->freeSchedule(pSchedule);
+
+    for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+    {
+        pMacroScheduler->destroyNode(nodes[ii]);
+    }
+
+    delete pMacroScheduler;
+
+    return stats;
+}
+
 } // namespace
 
 //------------------------------------------------------------------------------
-Stats homoRandomDagWorkStealing(uint32_t iterations)
+Stats homoRandomDagWorkStealing(uint32_t iterations, bool workStealingScheduler, bool wideDag)
 {
     ComputeResourceData data(1);
     createHomogeneousComputeResources(data);
 
-    Vector<ComputeResource*> computeResources;
-    computeResources.push_back(data.pComputeResource[0]);
-
-    Stats stats = heteroRandomDagTest<CentralQueue_MacroScheduler>(computeResources, iterations);
-
-    return stats;
+    if (workStealingScheduler)
+    {
+        return homoRandomDagTest<WorkStealing_MacroScheduler>(data.pComputeResource[0], iterations, wideDag);
+    }
+    return homoRandomDagTest<CentralQueue_MacroScheduler>(data.pComputeResource[0], iterations, wideDag);
 }
 
 //------------------------------------------------------------------------------
@@ -667,3 +731,63 @@ Stats heteroRandomDagCriticallyAware(uint32_t iterations)
 
     return stats;
 }
+
+//------------------------------------------------------------------------------
+Stats heteroRandomDagCriticalNodeRanking(uint32_t iterations, bool incrementalRanking)
+{
+    // A wide DAG of tiny workloads executed for many frames, so the per-frame
+    // cost of re-ranking dominates over the work itself.
+    const uint32_t NUM_RANKS              = 100;
+    const uint32_t MIN_NODES_PER_RANK     = 10;
+    const uint32_t MAX_NODES_PER_RANK     = 30;
+    const uint32_t CHANCE_OF_INCOMING_END = 0;
+    const uint32_t MAX_SPIN               = 64;
+
+    Stats stats(iterations);
+
+    ComputeResourceData data(2);
+    createHeterogeneousComputeResources(data);
+
+    MacroSchedulerDesc macroSchedulerDesc;
+    macroSchedulerDesc.computeResources.push_back(data.pComputeResource[0]);
+    macroSchedulerDesc.computeResources.push_back(data.pComputeResource[1]);
+
+    CriticalNode_MacroScheduler* pMacroScheduler = new CriticalNode_MacroScheduler;
+    pMacroScheduler->init(macroSchedulerDesc);
+    pMacroScheduler->setIncrementalRanking(incrementalRanking);
+
+    Vector<Node*> nodes;
+    DagUtils::generateRandomDag(pMacroScheduler, 1, NUM_RANKS, MIN_NODES_PER_RANK, MAX_NODES_PER_RANK, CHANCE_OF_INCOMING_END, nodes);
+
+    for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+    {
+        nodes[ii]->addWorkload<SinSpinWorkload>(1 + rand() % MAX_SPIN);
+    }
+
+    Schedule* pSchedule = pMacroScheduler->buildSchedule(nodes.front(), nodes.back());
+
+    for (uint32_t iter = 0; iter < iterations; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        pMacroScheduler->executeSchedule(pSchedule, data.pComputeResource[0]->id());
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    pMacroScheduler->freeSchedule(pSchedule);
+
+    for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+    {
+        pMacroScheduler->destroyNode(nodes[ii]);
+    }
+
+    delete pMacroScheduler;
+
+    return stats;
+}
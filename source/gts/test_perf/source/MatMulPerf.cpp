@@ -159,3 +159,46 @@ Stats matMulPefParallel(gts::MicroScheduler& taskScheduler, const size_t M, cons
 
     return stats;
 }
+
+//------------------------------------------------------------------------------
+// Blocked matrix multiplication with a ParallelFor. With 'useAffinity', each
+// block of C is computed by the same Worker on every iteration.
+Stats matMulPefParallelFor(gts::MicroScheduler& taskScheduler, const size_t M, const size_t N, const size_t K, size_t iterations, bool useAffinity)
+{
+    Stats stats(iterations);
+
+    gts::Vector<float, gts::AlignedAllocator<64>> A(M * N);
+    initMatrixRand(A.data(), M, N, 10.0f);
+    gts::Vector<float, gts::AlignedAllocator<64>> B(N * K);
+    initMatrixRand(B.data(), M, N, 10.0f);
+    gts::Vector<float, gts::AlignedAllocator<64>> C(M * K);
+    initMatrix(C.data(), M, K, 0.0f);
+
+    gts::AffinityPartitioner affinityPartitioner;
+
+    // Do test.
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        if (useAffinity)
+        {
+            sgemmParallelFor(taskScheduler, A.data(), B.data(), C.data(), M, N, K, BLOCK_SIZE, BLOCK_SIZE, affinityPartitioner);
+        }
+        else
+        {
+            sgemmParallelFor(taskScheduler, A.data(), B.data(), C.data(), M, N, K, BLOCK_SIZE, BLOCK_SIZE, gts::AdaptivePartitioner());
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+    return stats;
+}
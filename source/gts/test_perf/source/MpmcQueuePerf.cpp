@@ -29,18 +29,22 @@
 #include <gts/micro_scheduler/WorkerPool.h>
 #include <gts/micro_scheduler/MicroScheduler.h>
 #include <gts/containers/parallel/QueueMPMC.h>
+#include <gts/containers/parallel/BoundedQueueMPMC.h>
 
 using namespace gts;
 
+namespace {
+
 //------------------------------------------------------------------------------
-Stats mpmcQueuePerfSerial(const uint32_t itemCount, uint32_t iterations)
+template<typename TQueue>
+Stats queuePerfSerial(TQueue const& prototype, const uint32_t itemCount, uint32_t iterations)
 {
     Stats stats(iterations);
 
     // Do test.
     for (uint32_t ii = 0; ii < iterations; ++ii)
     {
-        gts::QueueMPMC<uint32_t> queue;
+        TQueue queue(prototype);
 
         auto start = std::chrono::high_resolution_clock::now();
         
@@ -65,7 +69,8 @@ Stats mpmcQueuePerfSerial(const uint32_t itemCount, uint32_t iterations)
 }
 
 //------------------------------------------------------------------------------
-Stats mpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount, uint32_t iterations)
+template<typename TQueue>
+Stats queuePerfParallel(TQueue const& prototype, const uint32_t threadCount, const uint32_t itemCount, uint32_t iterations)
 {
     Stats stats(iterations);
 
@@ -86,7 +91,7 @@ Stats mpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount
         uint32_t producedItemsPerThread = itemCount / producerThreadCount;
         uint32_t consumedItemsPerThread = producedItemsPerThread;
 
-        gts::QueueMPMC<uint32_t> queue;
+        TQueue queue(prototype);
 
         gts::Atomic<bool> startTest(false);
 
@@ -173,3 +178,29 @@ Stats mpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount
 
     return stats;
 }
+
+} // namespace
+
+//------------------------------------------------------------------------------
+Stats mpmcQueuePerfSerial(const uint32_t itemCount, uint32_t iterations)
+{
+    return queuePerfSerial(gts::QueueMPMC<uint32_t>(), itemCount, iterations);
+}
+
+//------------------------------------------------------------------------------
+Stats mpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount, uint32_t iterations)
+{
+    return queuePerfParallel(gts::QueueMPMC<uint32_t>(), threadCount, itemCount, iterations);
+}
+
+//------------------------------------------------------------------------------
+Stats boundedMpmcQueuePerfSerial(const uint32_t itemCount, uint32_t iterations)
+{
+    return queuePerfSerial(gts::BoundedQueueMPMC<uint32_t>(itemCount), itemCount, iterations);
+}
+
+//------------------------------------------------------------------------------
+Stats boundedMpmcQueuePerfParallel(const uint32_t threadCount, const uint32_t itemCount, uint32_t iterations)
+{
+    return queuePerfParallel(gts::BoundedQueueMPMC<uint32_t>(itemCount), threadCount, itemCount, iterations);
+}
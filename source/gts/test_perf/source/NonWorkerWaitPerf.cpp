@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+#include <thread>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/analysis/Trace.h>
+#include <gts/platform/Atomic.h>
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+
+#ifdef GTS_WINDOWS
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace {
+
+//------------------------------------------------------------------------------
+// The CPU time consumed by the calling thread in nanoseconds.
+uint64_t threadCpuTimeNs()
+{
+#ifdef GTS_WINDOWS
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime);
+    uint64_t kernel = (uint64_t(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+    uint64_t user   = (uint64_t(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+    return (kernel + user) * 100;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ull + uint64_t(ts.tv_nsec);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Busy works for 'workTime' and then time stamps its completion.
+struct TimedWorkTask : public gts::Task
+{
+    TimedWorkTask(std::chrono::microseconds workTime, gts::Atomic<uint64_t>* pDoneTime)
+        : workTime(workTime)
+        , pDoneTime(pDoneTime)
+    {}
+
+    virtual gts::Task* execute(gts::TaskContext const&) final
+    {
+        auto end = std::chrono::high_resolution_clock::now() + workTime;
+        while (std::chrono::high_resolution_clock::now() < end)
+        {
+            GTS_PAUSE();
+        }
+        pDoneTime->store(GTS_RDTSC(), gts::memory_order::release);
+        return nullptr;
+    }
+
+    std::chrono::microseconds workTime;
+    gts::Atomic<uint64_t>* pDoneTime;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+ * Test how long it takes a non-worker thread to resume after the Task it is
+ * waiting on completes.
+ */
+Stats nonWorkerWaitLatencyPerf(gts::MicroScheduler& taskScheduler, uint32_t workTimeUs, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    // Do test.
+    GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+    std::thread nonWorker([&]()
+    {
+        gts::Atomic<uint64_t> doneTime = { 0 };
+
+        for (uint32_t ii = 0; ii < iterations; ++ii)
+        {
+            gts::Task* pTask = taskScheduler.allocateTask<TimedWorkTask>(
+                std::chrono::microseconds(workTimeUs), &doneTime);
+            taskScheduler.spawnTaskAndWait(pTask);
+
+            auto end = GTS_RDTSC();
+            stats.addDataPoint(double(end - doneTime.load(gts::memory_order::acquire)));
+        }
+    });
+
+    nonWorker.join();
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Test the percentage of a core that a non-worker thread consumes while it
+ * waits on a Task.
+ */
+Stats nonWorkerWaitCpuTimePerf(gts::MicroScheduler& taskScheduler, uint32_t workTimeUs, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    // Do test.
+    GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+    std::thread nonWorker([&]()
+    {
+        gts::Atomic<uint64_t> doneTime = { 0 };
+
+        for (uint32_t ii = 0; ii < iterations; ++ii)
+        {
+            gts::Task* pTask = taskScheduler.allocateTask<TimedWorkTask>(
+                std::chrono::microseconds(workTimeUs), &doneTime);
+
+            auto wallStart = std::chrono::high_resolution_clock::now();
+            uint64_t cpuStart = threadCpuTimeNs();
+
+            taskScheduler.spawnTaskAndWait(pTask);
+
+            uint64_t cpuEnd = threadCpuTimeNs();
+            auto wallEnd = std::chrono::high_resolution_clock::now();
+
+            double wallNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(wallEnd - wallStart).count();
+            stats.addDataPoint(100.0 * double(cpuEnd - cpuStart) / wallNs);
+        }
+    });
+
+    nonWorker.join();
+
+    return stats;
+}
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+#include <vector>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+#include <gts/micro_scheduler/patterns/ParallelPipeline.h>
+
+namespace {
+
+constexpr uint32_t ITEM_SIZE = 4096;
+
+//------------------------------------------------------------------------------
+// Per-item buffers, allocated once per token.
+struct StreamToken
+{
+    StreamToken() : data(ITEM_SIZE) {}
+
+    std::vector<uint32_t> data;
+    uint32_t item;
+    uint32_t checksum;
+};
+
+//------------------------------------------------------------------------------
+// Stage 1, serial: fill the item, standing in for reading and decoding.
+void decode(StreamToken& token, uint32_t item)
+{
+    token.item = item;
+    uint32_t state = item * 2654435761u + 1;
+    for (uint32_t ii = 0; ii < ITEM_SIZE; ++ii)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        token.data[ii] = state;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Stage 2, parallel: the expensive per-item work.
+void transform(StreamToken& token)
+{
+    uint32_t hash = 2166136261u;
+    for (uint32_t round = 0; round < 8; ++round)
+    {
+        for (uint32_t ii = 0; ii < ITEM_SIZE; ++ii)
+        {
+            hash = (hash ^ token.data[ii]) * 16777619u;
+            token.data[ii] = hash;
+        }
+    }
+    token.checksum = hash;
+}
+
+//------------------------------------------------------------------------------
+// Stage 3, serial in order: standing in for an upload that must stay ordered.
+void upload(StreamToken const& token, uint64_t& stream)
+{
+    stream = stream * 31 + token.checksum;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+Stats parallelPipelinePerfSerial(uint32_t itemCount, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    StreamToken token;
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        uint64_t stream = 0;
+        for (uint32_t item = 0; item < itemCount; ++item)
+        {
+            decode(token, item);
+            transform(token);
+            upload(token, stream);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+Stats parallelPipelinePerfParallel(gts::MicroScheduler& taskScheduler, uint32_t tokenCount, uint32_t itemCount, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<StreamToken> tokens(tokenCount);
+    gts::ParallelPipeline pipeline(taskScheduler);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        uint32_t nextItem = 0;
+        uint64_t stream   = 0;
+
+        pipeline(tokens.data(), tokenCount,
+            [&](StreamToken& token, gts::TaskContext const&)
+            {
+                if (nextItem == itemCount)
+                {
+                    return false;
+                }
+                decode(token, nextItem++);
+                return true;
+            },
+            gts::ParallelPipeline::stage(gts::PipelineStageMode::PARALLEL, [](StreamToken& token, gts::TaskContext const&)
+            {
+                transform(token);
+            }),
+            gts::ParallelPipeline::stage(gts::PipelineStageMode::SERIAL_IN_ORDER, [&](StreamToken& token, gts::TaskContext const&)
+            {
+                upload(token, stream);
+            }));
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
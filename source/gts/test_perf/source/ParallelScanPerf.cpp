@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+#include <vector>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+#include <gts/micro_scheduler/patterns/ParallelScan.h>
+
+#define VALIDATE_SCAN 0
+
+namespace {
+
+//------------------------------------------------------------------------------
+void initInput(std::vector<uint64_t>& in)
+{
+    for (size_t ii = 0; ii < in.size(); ++ii)
+    {
+        in[ii] = ii % 13;
+    }
+}
+
+//------------------------------------------------------------------------------
+void validate(std::vector<uint64_t> const& in, std::vector<uint64_t> const& out)
+{
+#if VALIDATE_SCAN
+    uint64_t sum = 0;
+    for (size_t ii = 0; ii < in.size(); ++ii)
+    {
+        sum += in[ii];
+        GTS_ASSERT(out[ii] == sum);
+    }
+#else
+    GTS_UNREFERENCED_PARAM(in);
+    GTS_UNREFERENCED_PARAM(out);
+#endif
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+Stats parallelScanPerfSerial(uint32_t elementCount, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<uint64_t> in(elementCount);
+    std::vector<uint64_t> out(elementCount);
+    initInput(in);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        uint64_t sum = 0;
+        for (uint32_t jj = 0; jj < elementCount; ++jj)
+        {
+            sum += in[jj];
+            out[jj] = sum;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+
+        validate(in, out);
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+Stats parallelScanPerfParallel(gts::MicroScheduler& taskScheduler, uint32_t elementCount, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<uint64_t> in(elementCount);
+    std::vector<uint64_t> out(elementCount);
+    initInput(in);
+
+    gts::ParallelScan scan(taskScheduler);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        scan.inclusive(in.data(), in.data() + elementCount, out.data(), uint64_t(0),
+            [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; });
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+
+        validate(in, out);
+    }
+
+    return stats;
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+#include <gts/micro_scheduler/patterns/ParallelSort.h>
+
+namespace {
+
+//------------------------------------------------------------------------------
+std::vector<uint32_t> makeKeys(uint32_t elementCount)
+{
+    std::mt19937 rng(elementCount);
+
+    std::vector<uint32_t> keys(elementCount);
+    for (uint32_t ii = 0; ii < elementCount; ++ii)
+    {
+        keys[ii] = rng();
+    }
+    return keys;
+}
+
+//------------------------------------------------------------------------------
+template<typename TSortFunc>
+Stats sortPerf(uint32_t elementCount, uint32_t iterations, TSortFunc sortFunc)
+{
+    Stats stats(iterations);
+
+    std::vector<uint32_t> const input = makeKeys(elementCount);
+    std::vector<uint32_t> keys(elementCount);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        keys = input;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        sortFunc(keys);
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+
+        GTS_ASSERT(std::is_sorted(keys.begin(), keys.end()));
+    }
+
+    return stats;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+Stats parallelSortPerfSerial(uint32_t elementCount, uint32_t iterations)
+{
+    return sortPerf(elementCount, iterations, [](std::vector<uint32_t>& keys)
+    {
+        std::sort(keys.begin(), keys.end());
+    });
+}
+
+//------------------------------------------------------------------------------
+Stats parallelSortPerfMerge(gts::MicroScheduler& taskScheduler, uint32_t elementCount, uint32_t iterations)
+{
+    gts::ParallelSort parallelSort(taskScheduler);
+    return sortPerf(elementCount, iterations, [&](std::vector<uint32_t>& keys)
+    {
+        parallelSort(keys.begin(), keys.end());
+    });
+}
+
+//------------------------------------------------------------------------------
+Stats parallelSortPerfRadix(gts::MicroScheduler& taskScheduler, uint32_t elementCount, uint32_t iterations)
+{
+    gts::ParallelSort parallelSort(taskScheduler);
+    return sortPerf(elementCount, iterations, [&](std::vector<uint32_t>& keys)
+    {
+        parallelSort.radix(keys.begin(), keys.end());
+    });
+}
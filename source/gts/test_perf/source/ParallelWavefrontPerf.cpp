@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+#include <vector>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+#include <gts/micro_scheduler/patterns/ParallelWavefront.h>
+#include <gts/micro_scheduler/patterns/KdRange2d.h>
+#include <gts/micro_scheduler/patterns/KdRange3d.h>
+
+namespace {
+
+constexpr uint32_t TILE_SIZE_2D = 64;
+constexpr uint32_t TILE_SIZE_3D = 16;
+
+//------------------------------------------------------------------------------
+// A propagation step that depends on the previous cell in each dimension.
+GTS_INLINE void relax2d(std::vector<float>& grid, std::vector<float> const& src, uint32_t dimSize, uint32_t x, uint32_t y)
+{
+    size_t idx = size_t(x) * dimSize + y;
+    float left = x > 0 ? grid[idx - dimSize] : 0.f;
+    float up   = y > 0 ? grid[idx - 1] : 0.f;
+    grid[idx]  = 0.45f * (left + up) + src[idx];
+}
+
+//------------------------------------------------------------------------------
+GTS_INLINE void relax3d(std::vector<float>& grid, std::vector<float> const& src, uint32_t dimSize, uint32_t x, uint32_t y, uint32_t z)
+{
+    size_t idx  = (size_t(x) * dimSize + y) * dimSize + z;
+    float left  = x > 0 ? grid[idx - size_t(dimSize) * dimSize] : 0.f;
+    float up    = y > 0 ? grid[idx - dimSize] : 0.f;
+    float back  = z > 0 ? grid[idx - 1] : 0.f;
+    grid[idx]   = 0.3f * (left + up + back) + src[idx];
+}
+
+//------------------------------------------------------------------------------
+void initSource(std::vector<float>& src)
+{
+    for (size_t ii = 0; ii < src.size(); ++ii)
+    {
+        src[ii] = float(ii % 7) * 0.125f;
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+Stats parallelWavefrontPerf2dSerial(uint32_t dimSize, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<float> src(size_t(dimSize) * dimSize);
+    std::vector<float> grid(src.size());
+    initSource(src);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t x = 0; x < dimSize; ++x)
+        {
+            for (uint32_t y = 0; y < dimSize; ++y)
+            {
+                relax2d(grid, src, dimSize, x, y);
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+Stats parallelWavefrontPerf2dParallel(gts::MicroScheduler& taskScheduler, uint32_t dimSize, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<float> src(size_t(dimSize) * dimSize);
+    std::vector<float> grid(src.size());
+    initSource(src);
+
+    gts::ParallelWavefront wavefront(taskScheduler);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        wavefront(
+            gts::KdRange2d<uint32_t>(0, dimSize, TILE_SIZE_2D, 0, dimSize, TILE_SIZE_2D),
+            [&](gts::KdRange2d<uint32_t>& range, void*, gts::TaskContext const&)
+            {
+                for (uint32_t x = range.xRange().begin(); x != range.xRange().end(); ++x)
+                {
+                    for (uint32_t y = range.yRange().begin(); y != range.yRange().end(); ++y)
+                    {
+                        relax2d(grid, src, dimSize, x, y);
+                    }
+                }
+            },
+            gts::SimplePartitioner(),
+            nullptr);
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+Stats parallelWavefrontPerf3dSerial(uint32_t dimSize, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<float> src(size_t(dimSize) * dimSize * dimSize);
+    std::vector<float> grid(src.size());
+    initSource(src);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t x = 0; x < dimSize; ++x)
+        {
+            for (uint32_t y = 0; y < dimSize; ++y)
+            {
+                for (uint32_t z = 0; z < dimSize; ++z)
+                {
+                    relax3d(grid, src, dimSize, x, y, z);
+                }
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+Stats parallelWavefrontPerf3dParallel(gts::MicroScheduler& taskScheduler, uint32_t dimSize, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<float> src(size_t(dimSize) * dimSize * dimSize);
+    std::vector<float> grid(src.size());
+    initSource(src);
+
+    gts::ParallelWavefront wavefront(taskScheduler);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        wavefront(
+            gts::KdRange3d<uint32_t>(0, dimSize, TILE_SIZE_3D, 0, dimSize, TILE_SIZE_3D, 0, dimSize, TILE_SIZE_3D),
+            [&](gts::KdRange3d<uint32_t>& range, void*, gts::TaskContext const&)
+            {
+                for (uint32_t x = range.xRange().begin(); x != range.xRange().end(); ++x)
+                {
+                    for (uint32_t y = range.yRange().begin(); y != range.yRange().end(); ++y)
+                    {
+                        for (uint32_t z = range.zRange().begin(); z != range.zRange().end(); ++z)
+                        {
+                            relax3d(grid, src, dimSize, x, y, z);
+                        }
+                    }
+                }
+            },
+            gts::SimplePartitioner(),
+            nullptr);
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
@@ -77,3 +77,23 @@ Stats poorDistributionPerf(gts::MicroScheduler& taskScheduler, uint32_t taskCoun
 
     return stats;
 }
+
+//------------------------------------------------------------------------------
+/**
+ * poorDistributionPerf where thieves steal up to 'maxStealBatchSize' Tasks at
+ * once. Compare against poorDistributionPerf to measure batch stealing.
+ */
+Stats poorDistributionBatchStealPerf(gts::WorkerPool& workerPool, uint32_t maxStealBatchSize, uint32_t taskCount, uint32_t iterations)
+{
+    gts::MicroSchedulerDesc desc;
+    desc.pWorkerPool       = &workerPool;
+    desc.maxStealBatchSize = maxStealBatchSize;
+
+    gts::MicroScheduler taskScheduler;
+    taskScheduler.initialize(desc);
+
+    Stats stats = poorDistributionPerf(taskScheduler, taskCount, iterations);
+
+    taskScheduler.shutdown();
+    return stats;
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/analysis/Trace.h>
+#include <gts/platform/Atomic.h>
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+
+namespace {
+
+constexpr uint32_t HIGH_PRIORITY = 0;
+constexpr uint32_t LOW_PRIORITY  = 1;
+
+// Every Nth low priority Task spawns a high priority Task.
+constexpr uint32_t HIGH_PRIORITY_STRIDE = 16;
+
+// How long each low priority leaf Task runs.
+constexpr uint32_t LOW_PRIORITY_WORK_US = 50;
+
+struct Latencies
+{
+    gts::Atomic<uint64_t> totalCycles = { 0 };
+    gts::Atomic<uint64_t> count = { 0 };
+};
+
+//------------------------------------------------------------------------------
+// Records the time between its spawn and the start of its execution.
+struct HighPriorityTask : public gts::Task
+{
+    HighPriorityTask(uint64_t spawnTime, Latencies* pLatencies)
+        : spawnTime(spawnTime)
+        , pLatencies(pLatencies)
+    {}
+
+    virtual gts::Task* execute(gts::TaskContext const&) final
+    {
+        uint64_t startTime = GTS_RDTSC();
+        pLatencies->totalCycles.fetch_add(startTime - spawnTime, gts::memory_order::relaxed);
+        pLatencies->count.fetch_add(1, gts::memory_order::relaxed);
+        return nullptr;
+    }
+
+    uint64_t spawnTime;
+    Latencies* pLatencies;
+};
+
+//------------------------------------------------------------------------------
+// Recursively splits [begin, end) so that every Worker's deque fills up with
+// low priority Tasks. Each leaf busy works, spawning a high priority Task from
+// the middle of the work every HIGH_PRIORITY_STRIDE leaves.
+struct LowPriorityTask : public gts::Task
+{
+    LowPriorityTask(uint32_t begin, uint32_t end, gts::Task* pRoot, Latencies* pLatencies)
+        : begin(begin)
+        , end(end)
+        , pRoot(pRoot)
+        , pLatencies(pLatencies)
+    {}
+
+    virtual gts::Task* execute(gts::TaskContext const& ctx) final
+    {
+        while (end - begin > 1)
+        {
+            uint32_t mid = begin + (end - begin) / 2;
+            gts::Task* pRight = ctx.pMicroScheduler->allocateTask<LowPriorityTask>(mid, end, pRoot, pLatencies);
+            pRoot->addChildTaskWithRef(pRight);
+            ctx.pMicroScheduler->spawnTask(pRight, LOW_PRIORITY);
+            end = mid;
+        }
+
+        _work(std::chrono::microseconds(LOW_PRIORITY_WORK_US / 2));
+
+        if (begin % HIGH_PRIORITY_STRIDE == 0)
+        {
+            gts::Task* pHigh = ctx.pMicroScheduler->allocateTask<HighPriorityTask>(GTS_RDTSC(), pLatencies);
+            pRoot->addChildTaskWithRef(pHigh);
+            ctx.pMicroScheduler->spawnTask(pHigh, HIGH_PRIORITY);
+        }
+
+        _work(std::chrono::microseconds(LOW_PRIORITY_WORK_US / 2));
+
+        return nullptr;
+    }
+
+    static void _work(std::chrono::microseconds workTime)
+    {
+        auto end = std::chrono::high_resolution_clock::now() + workTime;
+        while (std::chrono::high_resolution_clock::now() < end)
+        {
+            GTS_PAUSE();
+        }
+    }
+
+    uint32_t begin;
+    uint32_t end;
+    gts::Task* pRoot;
+    Latencies* pLatencies;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+ * Test how long a high priority Task waits to start while every Worker is
+ * saturated with low priority Tasks. With local priorities only the spawning
+ * Worker favors the Task; with global priorities any Worker may take it.
+ */
+Stats highPriorityTimeToStartPerf(gts::WorkerPool& workerPool, bool useGlobalPriorities, uint32_t taskCount, uint32_t iterations)
+{
+    gts::MicroSchedulerDesc desc;
+    desc.pWorkerPool         = &workerPool;
+    desc.priorityCount       = 2;
+    desc.useGlobalPriorities = useGlobalPriorities;
+
+    gts::MicroScheduler taskScheduler;
+    taskScheduler.initialize(desc);
+
+    Stats stats(iterations);
+
+    // Do test.
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        Latencies latencies;
+
+        gts::Task* pRootTask = taskScheduler.allocateTask<gts::EmptyTask>();
+        pRootTask->addRef(2);
+
+        gts::Task* pChildTask = taskScheduler.allocateTask<LowPriorityTask>(0, taskCount, pRootTask, &latencies);
+        pRootTask->addChildTaskWithoutRef(pChildTask);
+        taskScheduler.spawnTask(pChildTask, LOW_PRIORITY);
+
+        pRootTask->waitForAll();
+        taskScheduler.destoryTask(pRootTask);
+
+        uint64_t count = latencies.count.load(gts::memory_order::acquire);
+        if (count > 0)
+        {
+            stats.addDataPoint(double(latencies.totalCycles.load(gts::memory_order::acquire)) / double(count));
+        }
+    }
+
+    taskScheduler.shutdown();
+
+    return stats;
+}
@@ -71,3 +71,23 @@ Stats sparseWorkPerf(gts::MicroScheduler& taskScheduler, uint32_t items, uint32_
 
     return stats;
 }
+
+//------------------------------------------------------------------------------
+/**
+ * sparseWorkPerf where thieves steal up to 'maxStealBatchSize' Tasks at
+ * once. Compare against sparseWorkPerf to measure batch stealing.
+ */
+Stats sparseWorkBatchStealPerf(gts::WorkerPool& workerPool, uint32_t maxStealBatchSize, uint32_t items, uint32_t iterations)
+{
+    gts::MicroSchedulerDesc desc;
+    desc.pWorkerPool       = &workerPool;
+    desc.maxStealBatchSize = maxStealBatchSize;
+
+    gts::MicroScheduler taskScheduler;
+    taskScheduler.initialize(desc);
+
+    Stats stats = sparseWorkPerf(taskScheduler, items, iterations);
+
+    taskScheduler.shutdown();
+    return stats;
+}
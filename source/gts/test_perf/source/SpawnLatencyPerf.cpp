@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+#include <thread>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/analysis/Trace.h>
+#include <gts/platform/Atomic.h>
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Time stamps the start of its execution.
+struct TimeStampTask : public gts::Task
+{
+    explicit TimeStampTask(gts::Atomic<uint64_t>* pStartTime)
+        : pStartTime(pStartTime)
+    {}
+
+    virtual gts::Task* execute(gts::TaskContext const&) final
+    {
+        pStartTime->store(GTS_RDTSC(), gts::memory_order::release);
+        return nullptr;
+    }
+
+    gts::Atomic<uint64_t>* pStartTime;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/**
+ * Test the time from spawning a Task on an otherwise idle scheduler to a
+ * Worker starting it. The spawning thread does not execute Tasks, and it
+ * idles for 'idleTimeUs' between spawns so that the Workers fall asleep.
+ * Requires at least two Workers.
+ */
+Stats spawnToExecuteLatencyPerf(gts::MicroScheduler& taskScheduler, uint32_t idleTimeUs, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    gts::Atomic<uint64_t> startTime = { 0 };
+
+    // Do test.
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::this_thread::sleep_for(std::chrono::microseconds(idleTimeUs));
+
+        startTime.store(0, gts::memory_order::relaxed);
+
+        gts::Task* pTask = taskScheduler.allocateTask<TimeStampTask>(&startTime);
+        uint64_t spawnTime = GTS_RDTSC();
+        taskScheduler.spawnTask(pTask);
+
+        // Wait without executing so that another Worker has to be woken.
+        uint64_t start = 0;
+        while ((start = startTime.load(gts::memory_order::acquire)) == 0)
+        {
+            GTS_PAUSE();
+        }
+
+        stats.addDataPoint(double(start - spawnTime));
+    }
+
+    return stats;
+}
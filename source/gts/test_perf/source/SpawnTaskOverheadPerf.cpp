@@ -21,6 +21,7 @@
  ******************************************************************************/
 #include <atomic>
 #include <chrono>
+#include <thread>
 
 #include "gts_perf/Stats.h"
 
@@ -119,3 +120,56 @@ Stats spawnTaskOverheadWithAllocPerf(gts::MicroScheduler& taskScheduler, uint32_
 
     return stats;
 }
+
+//------------------------------------------------------------------------------
+/**
+ * Test how long it takes a non-worker thread to allocate and spawn K tasks. If
+ * registerThread is true, the thread is given its own Task cache.
+ */
+Stats spawnTaskOverheadFromExternalThreadPerf(gts::WorkerPool& workerPool, gts::MicroScheduler& taskScheduler, uint32_t iterations, bool registerThread)
+{
+    Stats stats(iterations);
+
+    std::thread externalThread([&]()
+    {
+        if (registerThread)
+        {
+            workerPool.registerExternalThread();
+        }
+
+        // Do test.
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // Build the task cache.
+        gts::Vector<gts::Task*> tasks(iterations);
+        for (uint32_t iTask = 0; iTask < iterations; ++iTask)
+        {
+            tasks[iTask] = taskScheduler.allocateTask<gts::EmptyTask>();
+        }
+        for (uint32_t iTask = 0; iTask < iterations; ++iTask)
+        {
+            taskScheduler.destoryTask(tasks[iTask]);
+        }
+
+        auto start = GTS_RDTSC();
+
+        for (uint32_t iTask = 0; iTask < iterations; ++iTask)
+        {
+            gts::Task* pTask = taskScheduler.allocateTask<gts::EmptyTask>();
+            taskScheduler.spawnTask(pTask);
+        }
+
+        auto end = GTS_RDTSC();
+
+        stats.addDataPoint(double(end - start) / iterations);
+
+        if (registerThread)
+        {
+            workerPool.unregisterExternalThread();
+        }
+    });
+
+    externalThread.join();
+
+    return stats;
+}
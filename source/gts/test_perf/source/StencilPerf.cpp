@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <chrono>
+#include <vector>
+
+#include "gts_perf/Stats.h"
+
+#include <gts/micro_scheduler/WorkerPool.h>
+#include <gts/micro_scheduler/MicroScheduler.h>
+#include <gts/micro_scheduler/patterns/ParallelFor.h>
+#include <gts/micro_scheduler/patterns/Range1d.h>
+
+namespace {
+
+//! The Jacobi sweeps per timed iteration.
+constexpr uint32_t SWEEPS_PER_ITERATION = 16;
+
+//! The rows in the smallest ParallelFor range.
+constexpr uint32_t MIN_ROWS = 4;
+
+//------------------------------------------------------------------------------
+// One 5-point Jacobi sweep over rows [rowBegin, rowEnd) of the interior.
+GTS_INLINE void sweepRows(float const* pIn, float* pOut, uint32_t dimSize, uint32_t rowBegin, uint32_t rowEnd)
+{
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        float const* pRow   = pIn + size_t(y) * dimSize;
+        float const* pAbove = pRow - dimSize;
+        float const* pBelow = pRow + dimSize;
+        float* pOutRow      = pOut + size_t(y) * dimSize;
+
+        for (uint32_t x = 1; x < dimSize - 1; ++x)
+        {
+            pOutRow[x] = 0.2f * (pRow[x] + pRow[x - 1] + pRow[x + 1] + pAbove[x] + pBelow[x]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void initGrid(std::vector<float>& grid, uint32_t dimSize)
+{
+    for (uint32_t y = 0; y < dimSize; ++y)
+    {
+        for (uint32_t x = 0; x < dimSize; ++x)
+        {
+            // Hot borders, cold interior.
+            bool isBorder = x == 0 || y == 0 || x == dimSize - 1 || y == dimSize - 1;
+            grid[size_t(y) * dimSize + x] = isBorder ? 1.f : 0.f;
+        }
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+Stats stencilPerfSerial(uint32_t dimSize, uint32_t iterations)
+{
+    Stats stats(iterations);
+
+    std::vector<float> gridA(size_t(dimSize) * dimSize);
+    std::vector<float> gridB(gridA.size());
+    initGrid(gridA, dimSize);
+    initGrid(gridB, dimSize);
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t iSweep = 0; iSweep < SWEEPS_PER_ITERATION; ++iSweep)
+        {
+            sweepRows(gridA.data(), gridB.data(), dimSize, 1, dimSize - 1);
+            gridA.swap(gridB);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+// Repeated sweeps over the same grid. With 'useAffinity', each Worker sweeps
+// the same rows on every call and finds them in its cache.
+Stats stencilPerfParallel(gts::MicroScheduler& taskScheduler, uint32_t dimSize, uint32_t iterations, bool useAffinity)
+{
+    Stats stats(iterations);
+
+    std::vector<float> gridA(size_t(dimSize) * dimSize);
+    std::vector<float> gridB(gridA.size());
+    initGrid(gridA, dimSize);
+    initGrid(gridB, dimSize);
+
+    gts::ParallelFor parallelFor(taskScheduler);
+    gts::AffinityPartitioner affinityPartitioner;
+
+    for (uint32_t ii = 0; ii < iterations; ++ii)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t iSweep = 0; iSweep < SWEEPS_PER_ITERATION; ++iSweep)
+        {
+            float const* pIn = gridA.data();
+            float* pOut      = gridB.data();
+
+            auto sweep = [=](gts::Range1d<uint32_t>& range, void*, gts::TaskContext const&)
+            {
+                sweepRows(pIn, pOut, dimSize, range.begin(), range.end());
+            };
+
+            gts::Range1d<uint32_t> rows(1, dimSize - 1, MIN_ROWS);
+            if (useAffinity)
+            {
+                parallelFor(rows, sweep, affinityPartitioner, nullptr);
+            }
+            else
+            {
+                parallelFor(rows, sweep, gts::AdaptivePartitioner(), nullptr);
+            }
+
+            gridA.swap(gridB);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> diff = end - start;
+        stats.addDataPoint(diff.count());
+    }
+
+    return stats;
+}
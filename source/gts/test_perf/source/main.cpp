@@ -19,7 +19,10 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  ******************************************************************************/
+#include <cmath>
+
 #include <gts/platform/Thread.h>
+#include <gts/micro_scheduler/algorithms/central_queue/CentralQueue_MicroSchedulerAlgorithm.h>
 
 #include "gts_perf/Stats.h"
 #include "gts_perf/Output.h"
@@ -129,6 +132,129 @@ void spawnTaskOverhead(Output& output,
 
         output << std::endl;
     }
+
+    output << "=== Spawn Task Overhead From External Thread (cycles) ===" << std::endl;
+    output << "iterations: " << iterations << std::endl;
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, 1, false);
+
+        gts::MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        Stats stats = spawnTaskOverheadFromExternalThreadPerf(workerPool, taskScheduler, iterations, false);
+        output << stats.mean() << ", ";
+
+        output << std::endl;
+    }
+
+    output << "=== Spawn Task Overhead From Registered External Thread (cycles) ===" << std::endl;
+    output << "iterations: " << iterations << std::endl;
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, 1, false);
+
+        gts::MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        Stats stats = spawnTaskOverheadFromExternalThreadPerf(workerPool, taskScheduler, iterations, true);
+        output << stats.mean() << ", ";
+
+        output << std::endl;
+    }
+}
+
+//------------------------------------------------------------------------------
+void nonWorkerWait(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t workTimeUs = 1000,
+    uint32_t iterations = 1000)
+{
+    output << "=== Non-Worker Wait Wake Latency (cycles) ===" << std::endl;
+    output << "work time (us): " << workTimeUs << std::endl;
+    output << "iterations: " << iterations << std::endl;
+
+    for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, iThread, false);
+
+        gts::MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        Stats stats = nonWorkerWaitLatencyPerf(taskScheduler, workTimeUs, iterations);
+        output << stats.mean() << ", ";
+    }
+
+    output << std::endl;
+
+    output << "=== Non-Worker Wait CPU Usage (% of a core) ===" << std::endl;
+    output << "work time (us): " << workTimeUs << std::endl;
+    output << "iterations: " << iterations << std::endl;
+
+    for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, iThread, false);
+
+        gts::MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        Stats stats = nonWorkerWaitCpuTimePerf(taskScheduler, workTimeUs, iterations);
+        output << stats.mean() << ", ";
+    }
+
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void spawnLatency(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t idleTimeUs = 1000,
+    uint32_t iterations = 1000)
+{
+    output << "=== Spawn-To-Execute Latency, Idle Workers (cycles) ===" << std::endl;
+    output << "idle time (us): " << idleTimeUs << std::endl;
+    output << "iterations: " << iterations << std::endl;
+
+    // The spawning thread doesn't execute, so another Worker is required.
+    for (uint32_t iThread = gts::gtsMax(2u, startThreadCount); iThread <= endThreadCount; ++iThread)
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, iThread, false);
+
+        gts::MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        Stats stats = spawnToExecuteLatencyPerf(taskScheduler, idleTimeUs, iterations);
+        output << stats.mean() << ", ";
+    }
+
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void highPriorityTimeToStart(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t taskCount = 4096,
+    uint32_t iterations = 100)
+{
+    const char* modeNames[] = { "Local", "Global" };
+
+    for (uint32_t mode = 0; mode < 2; ++mode)
+    {
+        output << "=== High Priority Time-To-Start, " << modeNames[mode] << " Priorities (cycles) ===" << std::endl;
+        output << "task count: " << taskCount << std::endl;
+        output << "iterations: " << iterations << std::endl;
+
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            Stats stats = highPriorityTimeToStartPerf(workerPool, mode == 1, taskCount, iterations);
+            output << stats.mean() << ", ";
+        }
+
+        output << std::endl;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -158,7 +284,8 @@ void schedulerOverheadParFor(Output& output, uint32_t startThreadCount, uint32_t
 //------------------------------------------------------------------------------
 void sparseWork(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
     uint32_t size = 10000,
-    uint32_t iterations = 100000)
+    uint32_t iterations = 100000,
+    uint32_t maxStealBatchSize = 32)
 {
     output << "=== Sparse Work (s) ===" << std::endl;
     output << "size: " << size << std::endl;
@@ -177,6 +304,22 @@ void sparseWork(Output& output, uint32_t startThreadCount, uint32_t endThreadCou
     }
 
     output << std::endl;
+
+    output << "=== Sparse Work, Steal Half (s) ===" << std::endl;
+    output << "size: " << size << std::endl;
+    output << "iterations: " << iterations << std::endl;
+    output << "max steal batch: " << maxStealBatchSize << std::endl;
+
+    for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, iThread, false);
+
+        Stats stats = sparseWorkBatchStealPerf(workerPool, maxStealBatchSize, size, iterations);
+        output << stats.mean() << ", ";
+    }
+
+    output << std::endl;
 }
 
 //------------------------------------------------------------------------------
@@ -251,10 +394,70 @@ void schedulerOverheadFib(Output& output, uint32_t startThreadCount, uint32_t en
     output << std::endl;
 }
 
+//------------------------------------------------------------------------------
+void schedulingAlgorithms(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t fibN = 25,
+    uint32_t iterations = 100)
+{
+    gts::CentralQueue_MicroSchedulerAlgorithm centralQueue;
+
+    // nullptr selects the built-in work-stealing algorithm.
+    gts::MicroSchedulerAlgorithm* algorithms[] = { nullptr, &centralQueue };
+
+    for (gts::MicroSchedulerAlgorithm* pAlgorithm : algorithms)
+    {
+        const char* name = pAlgorithm ? pAlgorithm->name() : "WorkStealing";
+
+        output << "=== " << name << " Scheduler Overhead Fib (s) ===" << std::endl;
+        output << "Fib#: " << fibN << std::endl;
+        output << "iterations: " << iterations << std::endl;
+
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroSchedulerDesc desc;
+            desc.pWorkerPool = &workerPool;
+            desc.pAlgorithm  = pAlgorithm;
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(desc);
+
+            Stats stats = schedulerOverheadFibPerf(taskScheduler, fibN, iterations);
+            output << stats.mean() << ", ";
+        }
+
+        output << std::endl;
+
+        output << "=== " << name << " Poor Distribution (s) ===" << std::endl;
+        output << "iterations: " << iterations << std::endl;
+
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroSchedulerDesc desc;
+            desc.pWorkerPool = &workerPool;
+            desc.pAlgorithm  = pAlgorithm;
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(desc);
+
+            Stats stats = poorDistributionPerf(taskScheduler, 5000, iterations);
+            output << stats.mean() << ", ";
+        }
+
+        output << std::endl;
+    }
+}
+
 //------------------------------------------------------------------------------
 void poorDistribution(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
     uint32_t tasks = 5000,
-    uint32_t iterations = 30)
+    uint32_t iterations = 30,
+    uint32_t maxStealBatchSize = 32)
 {
     output << "=== Poor Distribution ===" << std::endl;
     output << "tasks: " << tasks << std::endl;
@@ -273,6 +476,22 @@ void poorDistribution(Output& output, uint32_t startThreadCount, uint32_t endThr
     }
 
     output << std::endl;
+
+    output << "=== Poor Distribution, Steal Half ===" << std::endl;
+    output << "tasks: " << tasks << std::endl;
+    output << "iterations: " << iterations << std::endl;
+    output << "max steal batch: " << maxStealBatchSize << std::endl;
+
+    for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+    {
+        gts::WorkerPool workerPool;
+        initWorkerPool(workerPool, iThread, false);
+
+        Stats stats = poorDistributionBatchStealPerf(workerPool, maxStealBatchSize, tasks, iterations);
+        output << stats.mean() << ", ";
+    }
+
+    output << std::endl;
 }
 
 //------------------------------------------------------------------------------
@@ -401,6 +620,25 @@ void matMul(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
             Stats stats = matMulPefParallel(taskScheduler, dimensions, dimensions, dimensions, iterations);
             output << stats.mean() << ", ";
         }
+        output << std::endl;
+
+        const char* partitionerNames[] = { "adaptive parallel-for", "affinity parallel-for" };
+        for (uint32_t iPartitioner = 0; iPartitioner < 2; ++iPartitioner)
+        {
+            output << partitionerNames[iPartitioner] << ": ";
+            for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+            {
+                gts::WorkerPool workerPool;
+                initWorkerPool(workerPool, iThread, affinitize);
+
+                gts::MicroScheduler taskScheduler;
+                taskScheduler.initialize(&workerPool);
+
+                Stats stats = matMulPefParallelFor(taskScheduler, dimensions, dimensions, dimensions, iterations, iPartitioner == 1);
+                output << stats.mean() << ", ";
+            }
+            output << std::endl;
+        }
     }
     output << std::endl;
 }
@@ -422,16 +660,239 @@ void mpmcQueue(Output& output, uint32_t startThreadCount, uint32_t endThreadCoun
     {
         output << "--- serial ---" << std::endl;
         Stats stats = mpmcQueuePerfSerial(numElements, iterations);
-        output << stats.mean() << std::endl;
+        output << "unbounded: " << stats.mean() << std::endl;
+        stats = boundedMpmcQueuePerfSerial(numElements, iterations);
+        output << "bounded: " << stats.mean() << std::endl;
     }
     else
     {
         output << "--- parallel ---" << std::endl;
+        output << "unbounded: ";
         for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; iThread += 2)
         {
             Stats stats = mpmcQueuePerfParallel(iThread, numElements, iterations);
             output << stats.mean() << ", ";
         }
+        output << std::endl;
+        output << "bounded: ";
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; iThread += 2)
+        {
+            Stats stats = boundedMpmcQueuePerfParallel(iThread, numElements, iterations);
+            output << stats.mean() << ", ";
+        }
+    }
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void parallelScan(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t numElements = 1 << 24,
+    uint32_t iterations = 100,
+    bool serial = false)
+{
+    output << "=== Parallel Scan (s) ===" << std::endl;
+    output << "numElements : " << numElements << std::endl;
+    output << "iterations : " << iterations << std::endl;
+
+    if(serial)
+    {
+        output << "--- serial ---" << std::endl;
+        Stats stats = parallelScanPerfSerial(numElements, iterations);
+        output << stats.mean() << std::endl;
+    }
+    else
+    {
+        output << "--- parallel ---" << std::endl;
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(&workerPool);
+
+            Stats stats = parallelScanPerfParallel(taskScheduler, numElements, iterations);
+            output << stats.mean() << ", ";
+        }
+    }
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void parallelSort(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t numElements = 1 << 22,
+    uint32_t iterations = 100,
+    bool serial = false)
+{
+    output << "=== Parallel Sort (s) ===" << std::endl;
+    output << "numElements : " << numElements << std::endl;
+    output << "iterations : " << iterations << std::endl;
+
+    if(serial)
+    {
+        output << "--- std::sort ---" << std::endl;
+        Stats stats = parallelSortPerfSerial(numElements, iterations);
+        output << stats.mean() << std::endl;
+    }
+    else
+    {
+        output << "--- parallel ---" << std::endl;
+        output << "merge: ";
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(&workerPool);
+
+            Stats stats = parallelSortPerfMerge(taskScheduler, numElements, iterations);
+            output << stats.mean() << ", ";
+        }
+        output << std::endl;
+        output << "radix: ";
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(&workerPool);
+
+            Stats stats = parallelSortPerfRadix(taskScheduler, numElements, iterations);
+            output << stats.mean() << ", ";
+        }
+    }
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void parallelPipeline(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t numItems = 4096,
+    uint32_t iterations = 100,
+    bool serial = false)
+{
+    output << "=== Parallel Pipeline (items/s) ===" << std::endl;
+    output << "numItems : " << numItems << std::endl;
+    output << "iterations : " << iterations << std::endl;
+
+    if(serial)
+    {
+        output << "--- serial ---" << std::endl;
+        Stats stats = parallelPipelinePerfSerial(numItems, iterations);
+        output << numItems / stats.mean() << std::endl;
+    }
+    else
+    {
+        output << "--- parallel ---" << std::endl;
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(&workerPool);
+
+            // Enough tokens to keep every worker busy while the serial stages
+            // drain.
+            Stats stats = parallelPipelinePerfParallel(taskScheduler, iThread * 4, numItems, iterations);
+            output << numItems / stats.mean() << ", ";
+        }
+    }
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void parallelWavefront(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t dimSize = 2048,
+    uint32_t iterations = 100,
+    bool serial = false)
+{
+    // Keep the 3D volume about as large as the 2D grid.
+    uint32_t dimSize3d = uint32_t(std::cbrt(double(dimSize) * dimSize));
+
+    output << "=== Parallel Wavefront (s) ===" << std::endl;
+    output << "dimSize 2D : " << dimSize << std::endl;
+    output << "dimSize 3D : " << dimSize3d << std::endl;
+    output << "iterations : " << iterations << std::endl;
+
+    if(serial)
+    {
+        output << "--- serial ---" << std::endl;
+        Stats stats = parallelWavefrontPerf2dSerial(dimSize, iterations);
+        output << "2D: " << stats.mean() << std::endl;
+        stats = parallelWavefrontPerf3dSerial(dimSize3d, iterations);
+        output << "3D: " << stats.mean() << std::endl;
+    }
+    else
+    {
+        output << "--- parallel ---" << std::endl;
+        output << "2D: ";
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(&workerPool);
+
+            Stats stats = parallelWavefrontPerf2dParallel(taskScheduler, dimSize, iterations);
+            output << stats.mean() << ", ";
+        }
+        output << std::endl;
+        output << "3D: ";
+        for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+        {
+            gts::WorkerPool workerPool;
+            initWorkerPool(workerPool, iThread, false);
+
+            gts::MicroScheduler taskScheduler;
+            taskScheduler.initialize(&workerPool);
+
+            Stats stats = parallelWavefrontPerf3dParallel(taskScheduler, dimSize3d, iterations);
+            output << stats.mean() << ", ";
+        }
+    }
+    output << std::endl;
+}
+
+//------------------------------------------------------------------------------
+void stencil(Output& output, uint32_t startThreadCount, uint32_t endThreadCount,
+    uint32_t dimSize = 1024,
+    uint32_t iterations = 100,
+    bool serial = false)
+{
+    output << "=== Repeated Stencil (s) ===" << std::endl;
+    output << "dimSize : " << dimSize << std::endl;
+    output << "iterations : " << iterations << std::endl;
+
+    if(serial)
+    {
+        output << "--- serial ---" << std::endl;
+        Stats stats = stencilPerfSerial(dimSize, iterations);
+        output << stats.mean() << std::endl;
+    }
+    else
+    {
+        output << "--- parallel ---" << std::endl;
+
+        const char* partitionerNames[] = { "adaptive", "affinity" };
+        for (uint32_t iPartitioner = 0; iPartitioner < 2; ++iPartitioner)
+        {
+            output << partitionerNames[iPartitioner] << ": ";
+            for (uint32_t iThread = startThreadCount; iThread <= endThreadCount; ++iThread)
+            {
+                gts::WorkerPool workerPool;
+                initWorkerPool(workerPool, iThread, false);
+
+                gts::MicroScheduler taskScheduler;
+                taskScheduler.initialize(&workerPool);
+
+                Stats stats = stencilPerfParallel(taskScheduler, dimSize, iterations, iPartitioner == 1);
+                output << stats.mean() << ", ";
+            }
+            output << std::endl;
+        }
     }
     output << std::endl;
 }
@@ -445,9 +906,17 @@ void homoRandomDagWorkStealing(Output& output, uint32_t iterations = 100)
 
     GTS_ASSERT(gts::Thread::getHardwareThreadCount() >= 16 && "Machine must have at least 16 cores.");
 
-    Stats stats = homoRandomDagWorkStealing(iterations);
-    output << stats.mean() << ", ";
-    output << std::endl;
+    const char* dagNames[] = { "deep", "wide" };
+    for (uint32_t iDag = 0; iDag < 2; ++iDag)
+    {
+        output << "--- " << dagNames[iDag] << " ---" << std::endl;
+
+        Stats stats = homoRandomDagWorkStealing(iterations, false, iDag == 1);
+        output << "central queue: " << stats.mean() << std::endl;
+
+        stats = homoRandomDagWorkStealing(iterations, true, iDag == 1);
+        output << "work stealing: " << stats.mean() << std::endl;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -478,15 +947,42 @@ void heteroRandomDagCriticallyAware(Output& output, uint32_t iterations = 100)
     output << std::endl;
 }
 
-constexpr char* TEST_TYPE_SPAWN_TASK        = "spawn_task";
-constexpr char* TEST_TYPE_OVERHEAD          = "empty_for";
-constexpr char* TEST_TYPE_FIBONACCI         = "fibonacci";
-constexpr char* TEST_TYPE_POOR_DIST         = "poor_dist";
-constexpr char* TEST_TYPE_POOR_SYS_DIST     = "poor_sys_dist";
-constexpr char* TEST_TYPE_MANDELBROT        = "mandelbrot";
-constexpr char* TEST_TYPE_AO_BENCH          = "ao_bench";
-constexpr char* TEST_TYPE_MAT_MUL           = "mat_mul";
-constexpr char* TEST_TYPE_MPMC_QUEUE        = "mpmc_queue";
+//------------------------------------------------------------------------------
+void heteroRandomDagCriticalNodeRanking(Output& output, uint32_t iterations = 1000)
+{
+    output << "=== Heterogeneous Random DAG Critical Node Ranking (s) ===" << std::endl;
+    output << "threads : " << 16 << std::endl;
+    output << "iterations : " << iterations << std::endl;
+
+    GTS_ASSERT(gts::Thread::getHardwareThreadCount() >= 16 && "Machine must have at least 16 cores.");
+
+    output << "--- full ---" << std::endl;
+    Stats stats = heteroRandomDagCriticalNodeRanking(iterations, false);
+    output << stats.mean() << std::endl;
+
+    output << "--- incremental ---" << std::endl;
+    stats = heteroRandomDagCriticalNodeRanking(iterations, true);
+    output << stats.mean() << std::endl;
+}
+
+constexpr char* TEST_TYPE_SPAWN_TASK         = "spawn_task";
+constexpr char* TEST_TYPE_OVERHEAD           = "empty_for";
+constexpr char* TEST_TYPE_FIBONACCI          = "fibonacci";
+constexpr char* TEST_TYPE_POOR_DIST          = "poor_dist";
+constexpr char* TEST_TYPE_POOR_SYS_DIST      = "poor_sys_dist";
+constexpr char* TEST_TYPE_MANDELBROT         = "mandelbrot";
+constexpr char* TEST_TYPE_AO_BENCH           = "ao_bench";
+constexpr char* TEST_TYPE_MAT_MUL            = "mat_mul";
+constexpr char* TEST_TYPE_MPMC_QUEUE         = "mpmc_queue";
+constexpr char* TEST_TYPE_PARALLEL_SCAN      = "parallel_scan";
+constexpr char* TEST_TYPE_PARALLEL_SORT      = "parallel_sort";
+constexpr char* TEST_TYPE_PARALLEL_PIPELINE  = "parallel_pipeline";
+constexpr char* TEST_TYPE_PARALLEL_WAVEFRONT = "parallel_wavefront";
+constexpr char* TEST_TYPE_STENCIL            = "stencil";
+constexpr char* TEST_TYPE_NON_WORKER_WAIT    = "non_worker_wait";
+constexpr char* TEST_TYPE_PRIORITY_START     = "priority_start";
+constexpr char* TEST_TYPE_SPAWN_LATENCY      = "spawn_latency";
+constexpr char* TEST_TYPE_ALGORITHMS         = "algorithms";
 
 //------------------------------------------------------------------------------
 void runTests(
@@ -533,12 +1029,48 @@ void runTests(
     {
         mpmcQueue(output, startThreadCount, endThreadCount, testSize, testIterations);
     }
+    else if(TEST_TYPE_PARALLEL_SCAN == testType)
+    {
+        parallelScan(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_PARALLEL_SORT == testType)
+    {
+        parallelSort(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_PARALLEL_PIPELINE == testType)
+    {
+        parallelPipeline(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_PARALLEL_WAVEFRONT == testType)
+    {
+        parallelWavefront(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_STENCIL == testType)
+    {
+        stencil(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_NON_WORKER_WAIT == testType)
+    {
+        nonWorkerWait(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_PRIORITY_START == testType)
+    {
+        highPriorityTimeToStart(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_SPAWN_LATENCY == testType)
+    {
+        spawnLatency(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
+    else if(TEST_TYPE_ALGORITHMS == testType)
+    {
+        schedulingAlgorithms(output, startThreadCount, endThreadCount, testSize, testIterations);
+    }
 }
 
 //------------------------------------------------------------------------------
 void printArgRequirements()
 {
-    std::cout << "\nRequired Args:\n[spawn_task|empty_for|fibonacci|poor_dist|poor_sys_dist|mandelbrot|ao_bench|mat_mul] [size] [iterations] [startThreadCount] [endThreadCount]\n\n";
+    std::cout << "\nRequired Args:\n[spawn_task|empty_for|fibonacci|poor_dist|poor_sys_dist|mandelbrot|ao_bench|mat_mul|mpmc_queue|parallel_scan|parallel_sort|parallel_pipeline|parallel_wavefront|stencil|non_worker_wait|priority_start|spawn_latency|algorithms] [size] [iterations] [startThreadCount] [endThreadCount]\n\n";
 }
 
 //------------------------------------------------------------------------------
@@ -598,6 +1130,19 @@ int main(int argc, char *argv[])
         aoBench(output, startThreadCount, endThreadCount);
         matMul(output, startThreadCount, endThreadCount);
         mpmcQueue(output, startThreadCount, endThreadCount);
+        parallelScan(output, startThreadCount, endThreadCount);
+        parallelSort(output, startThreadCount, endThreadCount, 1 << 22, 100, true);
+        parallelSort(output, startThreadCount, endThreadCount);
+        parallelPipeline(output, startThreadCount, endThreadCount, 4096, 100, true);
+        parallelPipeline(output, startThreadCount, endThreadCount);
+        parallelWavefront(output, startThreadCount, endThreadCount, 2048, 100, true);
+        parallelWavefront(output, startThreadCount, endThreadCount);
+        stencil(output, startThreadCount, endThreadCount, 1024, 100, true);
+        stencil(output, startThreadCount, endThreadCount);
+        nonWorkerWait(output, startThreadCount, endThreadCount);
+        highPriorityTimeToStart(output, startThreadCount, endThreadCount);
+        spawnLatency(output, startThreadCount, endThreadCount);
+        schedulingAlgorithms(output, startThreadCount, endThreadCount);
     }
 
 #else
@@ -616,6 +1161,22 @@ int main(int argc, char *argv[])
 
     //mpmcQueue(output, gts::Thread::getHardwareThreadCount(), gts::Thread::getHardwareThreadCount(), 100000, 100);
 
+    //parallelScan(output, gts::Thread::getHardwareThreadCount(), gts::Thread::getHardwareThreadCount(), 1 << 24, 100);
+
+    //parallelSort(output, 1, gts::Thread::getHardwareThreadCount(), 1 << 22, 100);
+
+    //parallelPipeline(output, 1, gts::Thread::getHardwareThreadCount(), 4096, 100);
+
+    //parallelWavefront(output, 1, gts::Thread::getHardwareThreadCount(), 2048, 100);
+
+    //stencil(output, 1, gts::Thread::getHardwareThreadCount(), 1024, 100);
+
+    //nonWorkerWait(output, gts::Thread::getHardwareThreadCount(), gts::Thread::getHardwareThreadCount(), 1000, 1000);
+
+    //highPriorityTimeToStart(output, gts::Thread::getHardwareThreadCount(), gts::Thread::getHardwareThreadCount(), 4096, 100);
+
+    //schedulingAlgorithms(output, gts::Thread::getHardwareThreadCount(), gts::Thread::getHardwareThreadCount(), 25, 100);
+
     //sparseWork(output, gts::Thread::getHardwareThreadCount(), gts::Thread::getHardwareThreadCount(), 10000, 100);
 
     //irregularRandParFor(output, 16, 16, 10000, 500);
@@ -623,6 +1184,7 @@ int main(int argc, char *argv[])
 
     //homoRandomDagWorkStealing(output, 10);
     //heteroRandomDagCriticallyAware(output, 10);
+    //heteroRandomDagCriticalNodeRanking(output, 1000);
 
 #endif
 
@@ -27,6 +27,7 @@
 #include "gts/containers/parallel/QueueMPMC.h"
 
 #include "gts/macro_scheduler/Node.h"
+#include "gts/macro_scheduler/Schedule.h"
 #include "gts/macro_scheduler/compute_resources/MicroScheduler_Workload.h"
 #include "gts/macro_scheduler/compute_resources/MicroScheduler_ComputeResource.h"
 #include "gts/macro_scheduler/DagUtils.h"
@@ -66,6 +67,55 @@ private:
         gts::QueueMPMC<uint32_t>& executionQueue;
     };
 
+    // Appends two Nodes each time it executes: one that joins 'pJoin' and
+    // one that nothing waits on. The Nodes are allocated once and appended
+    // again after each execution detaches them.
+    struct AppendingWorkload : public MicroScheduler_Workload
+    {
+        GTS_INLINE AppendingWorkload(
+            uint32_t id,
+            gts::QueueMPMC<uint32_t>& executionQueue,
+            Node* pJoin,
+            Vector<Node*>& appendedNodes)
+            : id(id)
+            , executionQueue(executionQueue)
+            , pJoin(pJoin)
+            , appendedNodes(appendedNodes)
+        {}
+
+        GTS_INLINE virtual void execute(WorkloadContext const& ctx) final
+        {
+            if (!executionQueue.tryPush(id))
+            {
+                GTS_ASSERT(0);
+            }
+
+            if (appendedNodes.empty())
+            {
+                MacroScheduler* pMacroScheduler = ctx.pNode->myScheduler();
+
+                Node* pJoining = pMacroScheduler->allocateNode();
+                Node* pLeaf = pMacroScheduler->allocateNode();
+                pJoining->addWorkload<DagWorkload>(id + 3, executionQueue);
+                pLeaf->addWorkload<DagWorkload>(id + 4, executionQueue);
+                appendedNodes.push_back(pJoining);
+                appendedNodes.push_back(pLeaf);
+            }
+
+            Node* pJoining = appendedNodes[0];
+            Node* pLeaf = appendedNodes[1];
+
+            ctx.pSchedule->appendNode(ctx.pNode, pJoining);
+            ctx.pSchedule->appendNode(pJoining, pLeaf);
+            ctx.pSchedule->appendEdge(pJoining, pJoin);
+        }
+
+        uint32_t id;
+        gts::QueueMPMC<uint32_t>& executionQueue;
+        Node* pJoin;
+        Vector<Node*>& appendedNodes;
+    };
+
 public:
 
     //--------------------------------------------------------------------------
@@ -86,6 +136,69 @@ public:
         //DagUtils::printToDot("outDag.gv", dag[0]); // DEBUG with GraphViz
     }
 
+    //--------------------------------------------------------------------------
+    // A long chain where each link also forks a leaf that joins the last Node,
+    // so completing a link readies more than one successor.
+    GTS_INLINE static void makeChainDag(MacroScheduler* pMacroScheduler, Vector<Node*>& dag)
+    {
+        const uint32_t CHAIN_LENGTH = 64;
+
+        dag.push_back(pMacroScheduler->allocateNode());
+        Node* pSink = pMacroScheduler->allocateNode();
+
+        for (uint32_t ii = 1; ii < CHAIN_LENGTH; ++ii)
+        {
+            Node* pLink = pMacroScheduler->allocateNode();
+            Node* pLeaf = pMacroScheduler->allocateNode();
+
+            dag.back()->addSuccessor(pLink);
+            dag.back()->addSuccessor(pLeaf);
+            pLeaf->addSuccessor(pSink);
+
+            dag.push_back(pLeaf);
+            dag.push_back(pLink);
+        }
+
+        dag.back()->addSuccessor(pSink);
+        dag.push_back(pSink);
+
+        //DagUtils::printToDot("outDag.gv", dag[0]); // DEBUG with GraphViz
+    }
+
+    //--------------------------------------------------------------------------
+    // A diamond whose left Node nests a diamond, one of whose Nodes nests a
+    // pair, and whose last Node nests a pair, so that the Schedule also ends
+    // on a sub-graph.
+    GTS_INLINE static void makeSubGraphDag(MacroScheduler* pMacroScheduler, Vector<Node*>& dag)
+    {
+        Vector<Node*> outer, inner;
+        makeDiamondDag(pMacroScheduler, outer);
+        makeDiamondDag(pMacroScheduler, inner);
+
+        Node* pInnerPair[2] = { pMacroScheduler->allocateNode(), pMacroScheduler->allocateNode() };
+        pInnerPair[0]->addSuccessor(pInnerPair[1]);
+
+        Node* pSinkPair[2] = { pMacroScheduler->allocateNode(), pMacroScheduler->allocateNode() };
+        pSinkPair[0]->addSuccessor(pSinkPair[1]);
+
+        outer[1]->setSubGraph(inner.front(), inner.back());
+        inner[2]->setSubGraph(pInnerPair[0], pInnerPair[1]);
+        outer[3]->setSubGraph(pSinkPair[0], pSinkPair[1]);
+
+        dag.push_back(outer[0]);
+        dag.push_back(outer[1]);
+        dag.push_back(outer[2]);
+        for (Node* pNode : inner)
+        {
+            dag.push_back(pNode);
+        }
+        dag.push_back(pInnerPair[0]);
+        dag.push_back(pInnerPair[1]);
+        dag.push_back(pSinkPair[0]);
+        dag.push_back(pSinkPair[1]);
+        dag.push_back(outer[3]);
+    }
+
     //--------------------------------------------------------------------------
     GTS_INLINE static void makeRandomDag(MacroScheduler* pMacroScheduler, Vector<Node*>& dag)
     {
@@ -166,6 +279,289 @@ public:
 
         delete pMacroScheduler;
     }
+
+    //--------------------------------------------------------------------------
+    // Executes a diamond DAG, inserts a Node between two of its Nodes, and
+    // executes the same Schedule again.
+    GTS_INLINE static void runWithEdgeChange(Vector<ComputeResource*>const& computeResources, uint32_t iterations)
+    {
+        MacroSchedulerDesc macroSchedulerDesc;
+        macroSchedulerDesc.computeResources = computeResources;
+
+        MacroScheduler* pMacroScheduler = new TMacroScheduler;
+        pMacroScheduler->init(macroSchedulerDesc);
+
+        Vector<Node*> nodes;
+        makeDiamondDag(pMacroScheduler, nodes);
+
+        gts::QueueMPMC<uint32_t> executionQueue;
+
+        for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+        {
+            nodes[ii]->addWorkload<DagWorkload>(ii, executionQueue);
+        }
+
+        Schedule* pSchedule = pMacroScheduler->buildSchedule(nodes.front(), nodes.back());
+
+        for (uint32_t iter = 0; iter < iterations; ++iter)
+        {
+            if (iter == 1)
+            {
+                Node* pNode = pMacroScheduler->allocateNode();
+                pNode->addWorkload<DagWorkload>((uint32_t)nodes.size(), executionQueue);
+                nodes[1]->addSuccessor(pNode);
+                pNode->addSuccessor(nodes[3]);
+                nodes.push_back(pNode);
+            }
+
+            pMacroScheduler->executeSchedule(pSchedule, computeResources[0]->id());
+
+            Vector<uint32_t> executionOrder;
+            uint32_t id = 0;
+            while (executionQueue.tryPop(id))
+            {
+                executionOrder.push_back(id);
+            }
+
+            ASSERT_EQ(nodes.size(), executionOrder.size());
+            ASSERT_TRUE(DagUtils::isATopologicalOrdering(nodes, executionOrder));
+        }
+
+        pMacroScheduler->freeSchedule(pSchedule);
+
+        for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+        {
+            pMacroScheduler->destroyNode(nodes[ii]);
+        }
+
+        delete pMacroScheduler;
+    }
+
+    //--------------------------------------------------------------------------
+    // Edits one of two DAGs between executions and checks that only its own
+    // Schedule sees the topology change.
+    GTS_INLINE static void runWithUnrelatedEdit(Vector<ComputeResource*>const& computeResources, uint32_t iterations)
+    {
+        MacroSchedulerDesc macroSchedulerDesc;
+        macroSchedulerDesc.computeResources = computeResources;
+
+        MacroScheduler* pMacroScheduler = new TMacroScheduler;
+        pMacroScheduler->init(macroSchedulerDesc);
+
+        Vector<Node*> nodes[2];
+        Schedule* pSchedules[2];
+        gts::QueueMPMC<uint32_t> executionQueue;
+
+        for (uint32_t iDag = 0; iDag < 2; ++iDag)
+        {
+            makeDiamondDag(pMacroScheduler, nodes[iDag]);
+            for (uint32_t ii = 0; ii < nodes[iDag].size(); ++ii)
+            {
+                nodes[iDag][ii]->addWorkload<DagWorkload>(ii, executionQueue);
+            }
+            pSchedules[iDag] = pMacroScheduler->buildSchedule(nodes[iDag].front(), nodes[iDag].back());
+        }
+
+        for (uint32_t iter = 0; iter < iterations; ++iter)
+        {
+            uint64_t versions[2];
+            for (uint32_t iDag = 0; iDag < 2; ++iDag)
+            {
+                versions[iDag] = pSchedules[iDag]->topologyVersion();
+            }
+
+            if (iter > 0)
+            {
+                // Grow the second DAG only.
+                Node* pNode = pMacroScheduler->allocateNode();
+                pNode->addWorkload<DagWorkload>((uint32_t)nodes[1].size(), executionQueue);
+                nodes[1][1]->addSuccessor(pNode);
+                pNode->addSuccessor(nodes[1][3]);
+                nodes[1].push_back(pNode);
+
+                ASSERT_EQ(pSchedules[0]->topologyVersion(), versions[0]);
+                ASSERT_NE(pSchedules[1]->topologyVersion(), versions[1]);
+            }
+
+            for (uint32_t iDag = 0; iDag < 2; ++iDag)
+            {
+                pMacroScheduler->executeSchedule(pSchedules[iDag], computeResources[0]->id());
+
+                Vector<uint32_t> executionOrder;
+                uint32_t id = 0;
+                while (executionQueue.tryPop(id))
+                {
+                    executionOrder.push_back(id);
+                }
+
+                ASSERT_EQ(nodes[iDag].size(), executionOrder.size());
+                ASSERT_TRUE(DagUtils::isATopologicalOrdering(nodes[iDag], executionOrder));
+            }
+        }
+
+        for (uint32_t iDag = 0; iDag < 2; ++iDag)
+        {
+            pMacroScheduler->freeSchedule(pSchedules[iDag]);
+            for (uint32_t ii = 0; ii < nodes[iDag].size(); ++ii)
+            {
+                pMacroScheduler->destroyNode(nodes[iDag][ii]);
+            }
+        }
+
+        delete pMacroScheduler;
+    }
+
+    //--------------------------------------------------------------------------
+    // Executes a diamond DAG where one Node appends Nodes to the running
+    // Schedule each time, and checks that the appends neither outlive the
+    // execution nor change the Schedule's topology.
+    GTS_INLINE static void runWithAppendedNodes(Vector<ComputeResource*>const& computeResources, uint32_t iterations)
+    {
+        MacroSchedulerDesc macroSchedulerDesc;
+        macroSchedulerDesc.computeResources = computeResources;
+
+        MacroScheduler* pMacroScheduler = new TMacroScheduler;
+        pMacroScheduler->init(macroSchedulerDesc);
+
+        Vector<Node*> nodes;
+        makeDiamondDag(pMacroScheduler, nodes);
+
+        gts::QueueMPMC<uint32_t> executionQueue;
+        Vector<Node*> appendedNodes;
+
+        nodes[0]->addWorkload<DagWorkload>(0, executionQueue);
+        nodes[1]->addWorkload<AppendingWorkload>(1, executionQueue, nodes[3], appendedNodes);
+        nodes[2]->addWorkload<DagWorkload>(2, executionQueue);
+        nodes[3]->addWorkload<DagWorkload>(3, executionQueue);
+
+        Schedule* pSchedule = pMacroScheduler->buildSchedule(nodes.front(), nodes.back());
+
+        // Let the first execution settle which Schedule the Nodes report to.
+        uint64_t topologyVersion = 0;
+
+        for (uint32_t iter = 0; iter < iterations; ++iter)
+        {
+            pMacroScheduler->executeSchedule(pSchedule, computeResources[0]->id());
+
+            if (iter == 0)
+            {
+                // Appended Nodes are numbered after the diamond.
+                ASSERT_EQ(appendedNodes.size(), 2u);
+                nodes.push_back(appendedNodes[0]);
+                nodes.push_back(appendedNodes[1]);
+                topologyVersion = pSchedule->topologyVersion();
+            }
+
+            // The appends were detached from the diamond.
+            ASSERT_EQ(pSchedule->topologyVersion(), topologyVersion);
+            ASSERT_EQ(nodes[1]->successors().size(), 1u);
+            ASSERT_EQ(nodes[3]->initPredecessorCount(), 2u);
+            for (Node* pAppended : appendedNodes)
+            {
+                ASSERT_TRUE(pAppended->predecessors().empty());
+                ASSERT_TRUE(pAppended->successors().empty());
+            }
+
+            Vector<uint32_t> executionOrder;
+            uint32_t id = 0;
+            while (executionQueue.tryPop(id))
+            {
+                executionOrder.push_back(id);
+            }
+
+            // The Schedule must wait for the appended leaf.
+            ASSERT_EQ(nodes.size(), executionOrder.size());
+            ASSERT_TRUE(DagUtils::isATopologicalOrdering(nodes, executionOrder));
+
+            // The appended edges are gone, so check their order by hand.
+            Vector<uint32_t> positions(executionOrder.size());
+            for (uint32_t ii = 0; ii < executionOrder.size(); ++ii)
+            {
+                positions[executionOrder[ii]] = ii;
+            }
+            ASSERT_LT(positions[1], positions[4]);
+            ASSERT_LT(positions[4], positions[5]);
+            ASSERT_LT(positions[4], positions[3]);
+        }
+
+        pMacroScheduler->freeSchedule(pSchedule);
+
+        for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+        {
+            pMacroScheduler->destroyNode(nodes[ii]);
+        }
+
+        delete pMacroScheduler;
+    }
+
+    //--------------------------------------------------------------------------
+    // Rebuilds a Schedule for a different DAG each iteration and checks that
+    // freed Schedules are recycled.
+    GTS_INLINE static void runWithScheduleRebuild(Vector<ComputeResource*>const& computeResources, uint32_t iterations)
+    {
+        MacroSchedulerDesc macroSchedulerDesc;
+        macroSchedulerDesc.computeResources = computeResources;
+
+        MacroScheduler* pMacroScheduler = new TMacroScheduler;
+        pMacroScheduler->init(macroSchedulerDesc);
+
+        gts::QueueMPMC<uint32_t> executionQueue;
+        Schedule* pLastSchedule = nullptr;
+
+        for (uint32_t iter = 0; iter < iterations; ++iter)
+        {
+            Vector<Node*> nodes;
+            if (iter % 2 == 0)
+            {
+                makeDiamondDag(pMacroScheduler, nodes);
+            }
+            else
+            {
+                makeChainDag(pMacroScheduler, nodes);
+            }
+
+            for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+            {
+                nodes[ii]->addWorkload<DagWorkload>(ii, executionQueue);
+            }
+
+            Schedule* pSchedule = pMacroScheduler->buildSchedule(nodes.front(), nodes.back());
+            ASSERT_NE(pSchedule, nullptr);
+            if (pLastSchedule)
+            {
+                ASSERT_EQ(pSchedule, pLastSchedule);
+            }
+
+            pMacroScheduler->executeSchedule(pSchedule, computeResources[0]->id());
+
+            Vector<uint32_t> executionOrder;
+            uint32_t id = 0;
+            while (executionQueue.tryPop(id))
+            {
+                executionOrder.push_back(id);
+            }
+
+            ASSERT_EQ(nodes.size(), executionOrder.size());
+            ASSERT_TRUE(DagUtils::isATopologicalOrdering(nodes, executionOrder));
+
+            // Let the last Task release the Schedule so that it is recycled
+            // by the next build instead of being retired.
+            while (pSchedule->refCount() > 0)
+            {
+                GTS_PAUSE();
+            }
+
+            pMacroScheduler->freeSchedule(pSchedule);
+            pLastSchedule = pSchedule;
+
+            for (uint32_t ii = 0; ii < nodes.size(); ++ii)
+            {
+                pMacroScheduler->destroyNode(nodes[ii]);
+            }
+        }
+
+        delete pMacroScheduler;
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -133,6 +133,210 @@ struct WorkerStealingDequeTester
         }
     }
 
+    //--------------------------------------------------------------------------
+    void pushBatchPopCopy(TQueue& queue)
+    {
+        WorkerPool workerPool;
+        workerPool.initialize(1);
+
+        MicroScheduler scheduler;
+        scheduler.initialize(&workerPool);
+
+        uint32_t itemCount = ITEM_COUNT;
+        std::vector<Task*> tasks(itemCount);
+        scheduler.allocateTasks<EmptyTask>(tasks.data(), itemCount);
+
+        // Odd sized batches so that growth happens mid-batch.
+        const uint32_t batchSize = 7;
+
+        // Do twice to verify looping around the ring buffer is handled correctly.
+        for (size_t iter = 0; iter < 2; ++iter)
+        {
+            for (uint32_t ii = 0; ii < itemCount; ii += batchSize)
+            {
+                uint32_t count = gtsMin(batchSize, itemCount - ii);
+                while (!queue.tryPushBatch(tasks.data() + ii, count))
+                {
+                }
+            }
+
+            ASSERT_EQ(queue.size(), itemCount);
+
+            for (uint32_t ii = 0; ii < itemCount; ++ii)
+            {
+                Task* val;
+                ASSERT_EQ(queue.empty(), false);
+                while (!queue.tryPop(val))
+                {
+                }
+                ASSERT_EQ(val, tasks[itemCount - 1 - ii]);
+            }
+        }
+
+        for (uint32_t ii = 0; ii < itemCount; ++ii)
+        {
+            scheduler.destoryTask(tasks[ii]);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void pushStealHalfCopy(TQueue& queue)
+    {
+        WorkerPool workerPool;
+        workerPool.initialize(1);
+
+        MicroScheduler scheduler;
+        scheduler.initialize(&workerPool);
+
+        uint32_t itemCount = ITEM_COUNT;
+        std::vector<EmptyTask*> tasks(itemCount);
+        for (uint32_t ii = 0; ii < itemCount; ++ii)
+        {
+            tasks[ii] = scheduler.allocateTask<EmptyTask>();
+        }
+
+        std::vector<Task*> stolen(itemCount);
+
+        // Do twice to verify looping around the ring buffer is handled correctly.
+        for (size_t iter = 0; iter < 2; ++iter)
+        {
+            for (uint32_t ii = 0; ii < itemCount; ++ii)
+            {
+                while (!queue.tryPush(tasks[ii]))
+                {
+                }
+            }
+
+            // Each batch takes half of what remains, from the front.
+            uint32_t front = 0;
+            while (!queue.empty())
+            {
+                size_t remaining = queue.size();
+                size_t expected  = (remaining + 1) / 2;
+
+                size_t count = queue.tryStealHalf(stolen.data(), itemCount);
+                ASSERT_EQ(count, expected);
+
+                for (size_t ii = 0; ii < count; ++ii, ++front)
+                {
+                    ASSERT_EQ(stolen[ii], tasks[front]);
+                }
+            }
+            ASSERT_EQ(front, itemCount);
+        }
+
+        // Verify the batch size is clamped.
+        for (uint32_t ii = 0; ii < itemCount; ++ii)
+        {
+            while (!queue.tryPush(tasks[ii]))
+            {
+            }
+        }
+        ASSERT_EQ(queue.tryStealHalf(stolen.data(), 3), 3u);
+        ASSERT_EQ(queue.size(), size_t(itemCount - 3));
+
+        Task* val;
+        while (queue.tryPop(val))
+        {
+        }
+
+        for (uint32_t ii = 0; ii < itemCount; ++ii)
+        {
+            scheduler.destoryTask(tasks[ii]);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    void popStealHalfRace_ManyThreads(TQueue& queue)
+    {
+        WorkerPool workerPool;
+        workerPool.initialize(1);
+
+        MicroScheduler scheduler;
+        scheduler.initialize(&workerPool);
+
+        for (uint32_t testIter = 0; testIter < PARALLEL_ITERATIONS; ++testIter)
+        {
+            const uint32_t itemCount = ITEM_COUNT;
+            const uint32_t threadCount = gtsMax(1u, std::thread::hardware_concurrency() - 1);
+
+            std::vector<EmptyTask*> tasks(itemCount);
+            for (uint32_t ii = 0; ii < itemCount; ++ii)
+            {
+                tasks[ii] = scheduler.allocateTask<EmptyTask>();
+            }
+
+            // produce all values uncontended
+            for (uint32_t ii = 0; ii < itemCount; ++ii)
+            {
+                while (!queue.tryPush(tasks[ii]))
+                {
+                }
+            }
+
+            std::vector<std::thread*> threads(threadCount);
+            std::vector<std::vector<Task*>> takenValues(threadCount + 1);
+
+            gts::Atomic<bool> startTest(false);
+
+            for (uint32_t tt = 0; tt < threadCount; ++tt)
+            {
+                threads[tt] = new std::thread([&queue, &takenValues, &startTest, tt]()
+                {
+                    while (!startTest.load(memory_order::acquire))
+                    {
+                        GTS_PAUSE();
+                    }
+
+                    Task* batch[16];
+                    while (!queue.empty())
+                    {
+                        size_t count = queue.tryStealHalf(batch, 16);
+                        for (size_t ii = 0; ii < count; ++ii)
+                        {
+                            takenValues[tt].push_back(batch[ii]);
+                        }
+                    }
+                });
+            }
+
+            startTest.store(true, memory_order::release);
+
+            // pop on the owner thread
+            Task* val;
+            while (!queue.empty())
+            {
+                if (queue.tryPop(val))
+                {
+                    takenValues[threadCount].push_back(val);
+                }
+            }
+
+            for (uint32_t tt = 0; tt < threadCount; ++tt)
+            {
+                threads[tt]->join();
+                delete threads[tt];
+            }
+
+            // Verify that every value was taken exactly once.
+            std::unordered_set<Task*> values;
+            for (uint32_t ii = 0; ii < takenValues.size(); ++ii)
+            {
+                for (Task* taken : takenValues[ii])
+                {
+                    ASSERT_TRUE(values.insert(taken).second);
+                }
+            }
+
+            ASSERT_EQ(values.size(), size_t(itemCount));
+
+            for (uint32_t ii = 0; ii < itemCount; ++ii)
+            {
+                scheduler.destoryTask(tasks[ii]);
+            }
+        }
+    }
+
     //--------------------------------------------------------------------------
     void stealRace(TQueue& queue)
     {
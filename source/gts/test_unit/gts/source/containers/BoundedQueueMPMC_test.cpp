@@ -0,0 +1,192 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include "gts/containers/parallel/BoundedQueueMPMC.h"
+
+#include "testers/QueueTester.h"
+
+namespace testing {
+
+//------------------------------------------------------------------------------
+// Sized so that every QueueTester test fits without popping.
+struct TestBoundedQueueMPMC : public gts::BoundedQueueMPMC<uint32_t>
+{
+    TestBoundedQueueMPMC()
+        : gts::BoundedQueueMPMC<uint32_t>(ITEM_COUNT * gts::Thread::getHardwareThreadCount())
+    {}
+};
+
+static QueueTester<TestBoundedQueueMPMC> tester;
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, emptyConstructor)
+{
+    tester.emptyConstructor();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, copyConstructor)
+{
+    tester.copyConstructor();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, moveConstructor)
+{
+    tester.moveConstructor();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, copyAssign)
+{
+    tester.copyAssign();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, moveAssign)
+{
+    tester.moveAssign();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, clear)
+{
+    tester.clear();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, copyPushPop)
+{
+    tester.copyPushPop();
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, movePushPop)
+{
+    tester.movePushPop();
+}
+
+//------------------------------------------------------------------------------
+void TestPushFullPopEmpty(uint32_t capacity, uint32_t expectedCapacity)
+{
+    gts::BoundedQueueMPMC<uint32_t> queue(capacity);
+    ASSERT_EQ(queue.capacity(), expectedCapacity);
+
+    // Wrap around the ring a few times.
+    for (uint32_t iLap = 0; iLap < 3; ++iLap)
+    {
+        for (uint32_t ii = 0; ii < expectedCapacity; ++ii)
+        {
+            ASSERT_TRUE(queue.tryPush(ii));
+        }
+        ASSERT_FALSE(queue.tryPush(expectedCapacity));
+        ASSERT_EQ(queue.size(), expectedCapacity);
+
+        for (uint32_t ii = 0; ii < expectedCapacity; ++ii)
+        {
+            uint32_t val = 0;
+            ASSERT_TRUE(queue.tryPop(val));
+            ASSERT_EQ(val, ii);
+        }
+
+        uint32_t val = 0;
+        ASSERT_FALSE(queue.tryPop(val));
+        ASSERT_TRUE(queue.empty());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, pushFullPopEmpty)
+{
+    TestPushFullPopEmpty(ITEM_COUNT, ITEM_COUNT);
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, pushFullPopEmptyCapacity1)
+{
+    // A one element request is rounded up to the smallest working ring.
+    TestPushFullPopEmpty(1, 2);
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, pushFullPopEmptyCapacity2)
+{
+    TestPushFullPopEmpty(2, 2);
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, reserve)
+{
+    gts::BoundedQueueMPMC<uint32_t> queue;
+    ASSERT_EQ(queue.capacity(), 0U);
+    ASSERT_FALSE(queue.tryPush(0));
+
+    queue.reserve(3);
+    ASSERT_EQ(queue.capacity(), 4U);
+
+    for (uint32_t ii = 0; ii < 4; ++ii)
+    {
+        ASSERT_TRUE(queue.tryPush(ii));
+    }
+
+    // Growing keeps the elements in order.
+    queue.reserve(ITEM_COUNT);
+    ASSERT_EQ(queue.capacity(), ITEM_COUNT);
+    ASSERT_EQ(queue.size(), 4U);
+
+    for (uint32_t ii = 0; ii < 4; ++ii)
+    {
+        uint32_t val = 0;
+        ASSERT_TRUE(queue.tryPop(val));
+        ASSERT_EQ(val, ii);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, pushRace)
+{
+    for(uint32_t ii = 0; ii < PARALLEL_ITERATIONS; ++ii)
+    {
+        tester.pushRace(gts::Thread::getHardwareThreadCount());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, popRace)
+{
+    for(uint32_t ii = 0; ii < PARALLEL_ITERATIONS; ++ii)
+    {
+        tester.popRace(gts::Thread::getHardwareThreadCount());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(BoundedQueueMPMC, pushPopRace)
+{
+    uint32_t producerCount = std::max(1u, gts::Thread::getHardwareThreadCount() / 2);
+    uint32_t consumerCount = std::max(1u, gts::Thread::getHardwareThreadCount() / 2);
+    for(uint32_t ii = 0; ii < PARALLEL_ITERATIONS; ++ii)
+    {
+        tester.pushPopRace(producerCount, consumerCount);
+    }
+}
+
+} // namespace testing
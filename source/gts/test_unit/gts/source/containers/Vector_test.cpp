@@ -20,6 +20,7 @@
 * THE SOFTWARE.
 ******************************************************************************/
 #include <chrono>
+#include <map>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -93,6 +94,66 @@ private:
 size_t DummyObject::s_constructorCount = 0;
 size_t DummyObject::s_destructorCount = 0;
 
+// Records the size of every live allocation so that each deallocation can be
+// checked against it.
+struct TrackingAllocator
+{
+    TrackingAllocator() = default;
+
+    explicit TrackingAllocator(std::map<void*, size_t>* pLiveSizes)
+        : pLiveSizes(pLiveSizes)
+    {}
+
+    template<typename T>
+    size_t max_size() const
+    {
+        return SIZE_MAX / sizeof(T);
+    }
+
+    template<typename T, typename... TArgs>
+    void construct(T* ptr, TArgs&&... args)
+    {
+        new (ptr) T(std::forward<TArgs>(args)...);
+    }
+
+    template<typename T>
+    void destroy(T* const ptr)
+    {
+        ptr->~T();
+    }
+
+    template<typename T>
+    T* allocate(const size_t n) const
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        T* ptr = (T*)::malloc(n * sizeof(T));
+        (*pLiveSizes)[ptr] = n * sizeof(T);
+        return ptr;
+    }
+
+    template<typename T>
+    void deallocate(T* const ptr, size_t n) const
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        auto iter = pLiveSizes->find(ptr);
+        EXPECT_TRUE(iter != pLiveSizes->end());
+        if (iter != pLiveSizes->end())
+        {
+            EXPECT_EQ(iter->second, n * sizeof(T));
+            pLiveSizes->erase(iter);
+        }
+        ::free(ptr);
+    }
+
+    std::map<void*, size_t>* pLiveSizes = nullptr;
+};
+
 } // namespace
 
 namespace testing {
@@ -222,6 +283,42 @@ TEST(Vector, copyAssignment)
     ASSERT_NE(vCopy.data(), v.data());
 }
 
+//------------------------------------------------------------------------------
+TEST(Vector, copyAssignmentWithAllocator)
+{
+    std::map<void*, size_t> srcSizes;
+    std::map<void*, size_t> dstSizes;
+    {
+        Vector<size_t, TrackingAllocator> v{TrackingAllocator(&srcSizes)};
+        v.reserve(32);
+        for (size_t ii = 0; ii < 3; ++ii)
+        {
+            v.push_back(ii);
+        }
+
+        Vector<size_t, TrackingAllocator> vCopy{TrackingAllocator(&dstSizes)};
+        vCopy.push_back(7);
+        vCopy = v;
+
+        // The copy adopts v's allocator and the buffer matches its capacity.
+        ASSERT_EQ(vCopy.get_allocator().pLiveSizes, &srcSizes);
+        ASSERT_TRUE(dstSizes.empty());
+        ASSERT_EQ(vCopy.capacity(), v.capacity());
+        ASSERT_EQ(srcSizes[vCopy.data()], vCopy.capacity() * sizeof(size_t));
+        ASSERT_EQ(vCopy.size(), v.size());
+        for (size_t ii = 0; ii < v.size(); ++ii)
+        {
+            ASSERT_EQ(vCopy[ii], ii);
+        }
+
+        Vector<size_t, TrackingAllocator> vCopyConstructed(v);
+        ASSERT_EQ(srcSizes[vCopyConstructed.data()], vCopyConstructed.capacity() * sizeof(size_t));
+    }
+
+    // Every buffer was freed with the size it was allocated with.
+    ASSERT_TRUE(srcSizes.empty());
+}
+
 //------------------------------------------------------------------------------
 TEST(Vector, moveAssignment)
 {
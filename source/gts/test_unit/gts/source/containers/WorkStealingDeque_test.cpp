@@ -54,6 +54,20 @@ TEST(WorkStealingDeque, pushStealCopy)
     workStealingDequeTester.pushStealCopy(deque);
 }
 
+//------------------------------------------------------------------------------
+TEST(WorkStealingDeque, pushBatchPopCopy)
+{
+    DequeType deque;
+    workStealingDequeTester.pushBatchPopCopy(deque);
+}
+
+//------------------------------------------------------------------------------
+TEST(WorkStealingDeque, pushStealHalfCopy)
+{
+    DequeType deque;
+    workStealingDequeTester.pushStealHalfCopy(deque);
+}
+
 //------------------------------------------------------------------------------
 TEST(WorkStealingDeque, stealRace)
 {
@@ -82,4 +96,11 @@ TEST(WorkStealingDeque, pushStealPopRace_ManyThreads)
     workStealingDequeTester.pushStealPopRace_ManyThreads(deque);
 }
 
+//------------------------------------------------------------------------------
+TEST(WorkStealingDeque, popStealHalfRace_ManyThreads)
+{
+    DequeType deque;
+    workStealingDequeTester.popStealHalfRace_ManyThreads(deque);
+}
+
 } // namespace testing
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "gts/macro_scheduler/GraphArena.h"
+#include "gts/macro_scheduler/Node.h"
+#include "gts/macro_scheduler/schedulers/homogeneous/central_queue/CentralQueue_MacroScheduler.h"
+
+using namespace gts;
+
+namespace testing {
+
+//------------------------------------------------------------------------------
+TEST(GraphArena, carvesSequentially)
+{
+    GraphArena arena(32, 1024);
+
+    uint8_t* pFirst = (uint8_t*)arena.allocate(40);
+    uint8_t* pSecond = (uint8_t*)arena.allocate(64);
+    uint8_t* pThird = (uint8_t*)arena.allocate(1);
+
+    ASSERT_TRUE(isAligned(pFirst, 32));
+    ASSERT_EQ(pSecond, pFirst + 64);
+    ASSERT_EQ(pThird, pSecond + 64);
+    ASSERT_EQ(arena.liveCount(), 3u);
+    ASSERT_EQ(arena.blockCount(), 1u);
+
+    arena.deallocate(pFirst, 40);
+    arena.deallocate(pSecond, 64);
+    arena.deallocate(pThird, 1);
+}
+
+//------------------------------------------------------------------------------
+TEST(GraphArena, recyclesBySize)
+{
+    GraphArena arena(16, 1024);
+
+    // Keeps the arena from rewinding.
+    void* pKeepAlive = arena.allocate(16);
+
+    void* pA = arena.allocate(48);
+    void* pB = arena.allocate(32);
+    arena.deallocate(pA, 48);
+    arena.deallocate(pB, 32);
+
+    // Each size reuses its own chunks.
+    ASSERT_EQ(arena.allocate(32), pB);
+    ASSERT_EQ(arena.allocate(48), pA);
+    ASSERT_EQ(arena.liveCount(), 3u);
+
+    arena.deallocate(pA, 48);
+    arena.deallocate(pB, 32);
+    arena.deallocate(pKeepAlive, 16);
+}
+
+//------------------------------------------------------------------------------
+TEST(GraphArena, rewindsWhenEmpty)
+{
+    GraphArena arena(16, 256);
+
+    // Spill into a second block.
+    Vector<void*> ptrs;
+    for (uint32_t ii = 0; ii < 20; ++ii)
+    {
+        ptrs.push_back(arena.allocate(16));
+    }
+    ASSERT_EQ(arena.blockCount(), 2u);
+
+    for (void* ptr : ptrs)
+    {
+        arena.deallocate(ptr, 16);
+    }
+    ASSERT_EQ(arena.liveCount(), 0u);
+
+    // The blocks are kept and carved from the start again.
+    for (uint32_t ii = 0; ii < 20; ++ii)
+    {
+        ASSERT_EQ(arena.allocate(16), ptrs[ii]);
+    }
+    ASSERT_EQ(arena.blockCount(), 2u);
+
+    for (void* ptr : ptrs)
+    {
+        arena.deallocate(ptr, 16);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(GraphArena, largeAllocationsBypass)
+{
+    GraphArena arena(16, 256);
+
+    void* ptr = arena.allocate(128);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(arena.liveCount(), 0u);
+    ASSERT_EQ(arena.blockCount(), 0u);
+
+    arena.deallocate(ptr, 128);
+}
+
+//------------------------------------------------------------------------------
+TEST(GraphArena, nodesAreAdjacentAndRewindOnTeardown)
+{
+    constexpr uint32_t NODE_COUNT = 16;
+
+    CentralQueue_MacroScheduler macroScheduler;
+
+    Node* pNodes[NODE_COUNT];
+    for (uint32_t ii = 0; ii < NODE_COUNT; ++ii)
+    {
+        pNodes[ii] = macroScheduler.allocateNode();
+        if (ii > 0)
+        {
+            pNodes[ii - 1]->addSuccessor(pNodes[ii]);
+        }
+    }
+
+    size_t stride = alignUpTo(sizeof(Node), GTS_NO_SHARING_CACHE_LINE_SIZE);
+    for (uint32_t ii = 1; ii < NODE_COUNT; ++ii)
+    {
+        ASSERT_EQ((uintptr_t)pNodes[ii], (uintptr_t)pNodes[ii - 1] + stride);
+    }
+
+    macroScheduler.destroyGraph(pNodes[0]);
+
+    // The next graph reuses the same memory in the same order.
+    for (uint32_t ii = 0; ii < NODE_COUNT; ++ii)
+    {
+        ASSERT_EQ(macroScheduler.allocateNode(), pNodes[ii]);
+    }
+
+    for (uint32_t ii = 0; ii < NODE_COUNT; ++ii)
+    {
+        macroScheduler.destroyNode(pNodes[ii]);
+    }
+}
+
+//------------------------------------------------------------------------------
+struct GTS_ALIGN(GTS_NO_SHARING_CACHE_LINE_SIZE) AlignedWorkload : public Workload
+{
+    AlignedWorkload() : Workload(WorkloadType::CPP) {}
+
+    virtual void execute(WorkloadContext const&) final {}
+
+    uint8_t payload[8];
+};
+
+//------------------------------------------------------------------------------
+TEST(GraphArena, nodesAndWorkloadsDoNotShare)
+{
+    constexpr uint32_t NODE_COUNT = 16;
+
+    CentralQueue_MacroScheduler macroScheduler;
+
+    Node* pNodes[NODE_COUNT];
+    for (uint32_t ii = 0; ii < NODE_COUNT; ++ii)
+    {
+        pNodes[ii] = macroScheduler.allocateNode();
+        ASSERT_TRUE(isAligned(pNodes[ii], GTS_NO_SHARING_CACHE_LINE_SIZE));
+
+        AlignedWorkload* pWorkload = pNodes[ii]->addWorkload<AlignedWorkload>();
+        ASSERT_TRUE(isAligned(pWorkload, alignof(AlignedWorkload)));
+    }
+
+    for (uint32_t ii = 0; ii < NODE_COUNT; ++ii)
+    {
+        macroScheduler.destroyNode(pNodes[ii]);
+    }
+}
+
+} // namespace testing
@@ -19,6 +19,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  ******************************************************************************/
+#include "gts/macro_scheduler/Schedule.h"
+#include "gts/macro_scheduler/schedulers/homogeneous/central_queue/CentralQueue_MacroScheduler.h"
 #include "macro_scheduler/MacroSchedulerTester.h"
 
 using namespace ::testing;
@@ -30,4 +32,55 @@ INSTANTIATE_TEST_SUITE_P(MacroScheduler, ExecutionOrderTest,
         , ExecutionOrderTestParams{ createMircoSchedulerComputeResourceFactory(1, gts::Thread::getHardwareThreadCount()), ITERATIONS_CONCUR }
         , ExecutionOrderTestParams{ createMircoSchedulerComputeResourceFactory(2, gts::Thread::getHardwareThreadCount()), ITERATIONS_CONCUR }
         , ExecutionOrderTestParams{ createMircoSchedulerComputeResourceFactory(3, gts::Thread::getHardwareThreadCount()), ITERATIONS_CONCUR }
-));
\ No newline at end of file
+));
+
+namespace {
+
+//------------------------------------------------------------------------------
+// A user Schedule that only implements the required interface.
+class MinimalSchedule : public gts::Schedule
+{
+public:
+
+    MinimalSchedule(gts::MacroScheduler* pMyScheduler) : Schedule(pMyScheduler) {}
+
+    virtual gts::Node* popNextNode(gts::ComputeResource*, bool) override { return nullptr; }
+    virtual bool isDone() const override { return true; }
+    virtual void tryMarkDone(gts::Node*) override {}
+    virtual void insertReadyNode(gts::Node*) override {}
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+TEST(Schedule, defaultNeverBypasses)
+{
+    gts::CentralQueue_MacroScheduler macroScheduler;
+    MinimalSchedule schedule(&macroScheduler);
+
+    gts::Node* pNode = macroScheduler.allocateNode();
+
+    uint64_t priority = 0;
+    ASSERT_FALSE(schedule.canBypass(nullptr, pNode, priority));
+
+    macroScheduler.destroyNode(pNode);
+}
+
+//------------------------------------------------------------------------------
+TEST(Schedule, defaultRemovesPredecessorRef)
+{
+    gts::CentralQueue_MacroScheduler macroScheduler;
+    MinimalSchedule schedule(&macroScheduler);
+
+    gts::Node* pA = macroScheduler.allocateNode();
+    gts::Node* pB = macroScheduler.allocateNode();
+    gts::Node* pC = macroScheduler.allocateNode();
+    pA->addSuccessor(pC);
+    pB->addSuccessor(pC);
+
+    ASSERT_FALSE(schedule.removePredecessorRef(pC));
+    ASSERT_TRUE(schedule.removePredecessorRef(pC));
+
+    macroScheduler.destroyGraph(pA);
+    macroScheduler.destroyNode(pB);
+}
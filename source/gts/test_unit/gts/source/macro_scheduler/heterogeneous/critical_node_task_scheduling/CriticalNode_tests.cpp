@@ -35,6 +35,20 @@ TEST_P(ExecutionOrderTest, CriticalNode_DiamondDag)
         MacroSchedulerTester<CriticalNode_MacroScheduler>::makeDiamondDag, m_pkg.computeResources, m_params.iterations);
 }
 
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_ChainDag)
+{
+    MacroSchedulerTester<CriticalNode_MacroScheduler>::run(
+        MacroSchedulerTester<CriticalNode_MacroScheduler>::makeChainDag, m_pkg.computeResources, m_params.iterations);
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_SubGraphDag)
+{
+    MacroSchedulerTester<CriticalNode_MacroScheduler>::run(
+        MacroSchedulerTester<CriticalNode_MacroScheduler>::makeSubGraphDag, m_pkg.computeResources, m_params.iterations);
+}
+
 //------------------------------------------------------------------------------
 TEST_P(ExecutionOrderTest, CriticalNode_RandomDag)
 {
@@ -42,4 +56,55 @@ TEST_P(ExecutionOrderTest, CriticalNode_RandomDag)
         MacroSchedulerTester<CriticalNode_MacroScheduler>::makeRandomDag, m_pkg.computeResources, m_params.iterations);
 }
 
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_AppendNodesWhileExecuting)
+{
+    MacroSchedulerTester<CriticalNode_MacroScheduler>::runWithAppendedNodes(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 2u));
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_ScheduleRebuildRecycles)
+{
+    MacroSchedulerTester<CriticalNode_MacroScheduler>::runWithScheduleRebuild(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 4u));
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_EdgeChangeRecompiles)
+{
+    MacroSchedulerTester<CriticalNode_MacroScheduler>::runWithEdgeChange(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 2u));
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_UnrelatedEditKeepsCompile)
+{
+    MacroSchedulerTester<CriticalNode_MacroScheduler>::runWithUnrelatedEdit(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 3u));
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Re-ranks on every cost change so that each execution exercises the
+ * incremental ranking path.
+ */
+class EagerRerankMacroScheduler : public CriticalNode_MacroScheduler
+{
+public:
+
+    EagerRerankMacroScheduler()
+    {
+        setCostSmoothingFactor(1.0);
+        setRerankThreshold(0.0);
+    }
+};
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CriticalNode_RandomDagIncrementalRanking)
+{
+    MacroSchedulerTester<EagerRerankMacroScheduler>::run(
+        MacroSchedulerTester<EagerRerankMacroScheduler>::makeRandomDag, m_pkg.computeResources, gtsMax(m_params.iterations, 8u));
+}
+
 } // namespace testing
@@ -35,6 +35,20 @@ TEST_P(ExecutionOrderTest, CentralQueue_DiamondDag)
         MacroSchedulerTester<CentralQueue_MacroScheduler>::makeDiamondDag, m_pkg.computeResources, m_params.iterations);
 }
 
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CentralQueue_ChainDag)
+{
+    MacroSchedulerTester<CentralQueue_MacroScheduler>::run(
+        MacroSchedulerTester<CentralQueue_MacroScheduler>::makeChainDag, m_pkg.computeResources, m_params.iterations);
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CentralQueue_SubGraphDag)
+{
+    MacroSchedulerTester<CentralQueue_MacroScheduler>::run(
+        MacroSchedulerTester<CentralQueue_MacroScheduler>::makeSubGraphDag, m_pkg.computeResources, m_params.iterations);
+}
+
 //------------------------------------------------------------------------------
 TEST_P(ExecutionOrderTest, CentralQueue_RandomDag)
 {
@@ -42,4 +56,40 @@ TEST_P(ExecutionOrderTest, CentralQueue_RandomDag)
         MacroSchedulerTester<CentralQueue_MacroScheduler>::makeRandomDag, m_pkg.computeResources, m_params.iterations);
 }
 
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CentralQueue_AppendNodesWhileExecuting)
+{
+    MacroSchedulerTester<CentralQueue_MacroScheduler>::runWithAppendedNodes(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 2u));
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CentralQueue_ScheduleRebuildRecycles)
+{
+    MacroSchedulerTester<CentralQueue_MacroScheduler>::runWithScheduleRebuild(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 4u));
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, CentralQueue_FindComputeResource)
+{
+    MacroSchedulerDesc macroSchedulerDesc;
+    macroSchedulerDesc.computeResources = m_pkg.computeResources;
+
+    CentralQueue_MacroScheduler macroScheduler;
+    macroScheduler.init(macroSchedulerDesc);
+
+    for (uint32_t ii = 0; ii < m_pkg.computeResources.size(); ++ii)
+    {
+        MicroScheduler_ComputeResource* pCompResource = (MicroScheduler_ComputeResource*)m_pkg.computeResources[ii];
+
+        ASSERT_EQ(macroScheduler.computeResourceIndex(pCompResource->id()), ii);
+        ASSERT_EQ(macroScheduler.findComputeResource(pCompResource->id()), pCompResource);
+        ASSERT_EQ(macroScheduler.findMicroSchedulerComputeResource(pCompResource->microScheduler()->id()), pCompResource);
+    }
+
+    ASSERT_EQ(macroScheduler.findComputeResource(UNKNOWN_COMP_RESOURCE), nullptr);
+    ASSERT_EQ(macroScheduler.computeResourceIndex(UNKNOWN_COMP_RESOURCE), UINT32_MAX);
+}
+
 } // namespace testing
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "gts/macro_scheduler/schedulers/homogeneous/work_stealing/WorkStealing_MacroScheduler.h"
+#include "macro_scheduler/MacroSchedulerTester.h"
+
+namespace {
+
+using namespace ::gts;
+using namespace ::testing;
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, WorkStealing_DiamondDag)
+{
+    MacroSchedulerTester<WorkStealing_MacroScheduler>::run(
+        MacroSchedulerTester<WorkStealing_MacroScheduler>::makeDiamondDag, m_pkg.computeResources, m_params.iterations);
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, WorkStealing_ChainDag)
+{
+    MacroSchedulerTester<WorkStealing_MacroScheduler>::run(
+        MacroSchedulerTester<WorkStealing_MacroScheduler>::makeChainDag, m_pkg.computeResources, m_params.iterations);
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, WorkStealing_SubGraphDag)
+{
+    MacroSchedulerTester<WorkStealing_MacroScheduler>::run(
+        MacroSchedulerTester<WorkStealing_MacroScheduler>::makeSubGraphDag, m_pkg.computeResources, m_params.iterations);
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, WorkStealing_RandomDag)
+{
+    MacroSchedulerTester<WorkStealing_MacroScheduler>::run(
+        MacroSchedulerTester<WorkStealing_MacroScheduler>::makeRandomDag, m_pkg.computeResources, m_params.iterations);
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, WorkStealing_AppendNodesWhileExecuting)
+{
+    MacroSchedulerTester<WorkStealing_MacroScheduler>::runWithAppendedNodes(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 2u));
+}
+
+//------------------------------------------------------------------------------
+TEST_P(ExecutionOrderTest, WorkStealing_ScheduleRebuildRecycles)
+{
+    MacroSchedulerTester<WorkStealing_MacroScheduler>::runWithScheduleRebuild(
+        m_pkg.computeResources, gtsMax(m_params.iterations, 4u));
+}
+
+} // namespace testing
@@ -0,0 +1,334 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gts/platform/Atomic.h"
+#include "gts/analysis/Trace.h"
+
+#include "gts/micro_scheduler/WorkerPool.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/MicroSchedulerAlgorithm.h"
+#include "gts/micro_scheduler/algorithms/central_queue/CentralQueue_MicroSchedulerAlgorithm.h"
+
+#include "SchedulerTestsCommon.h"
+
+using namespace gts;
+
+namespace testing {
+
+////////////////////////////////////////////////////////////////////////////////
+// A LIFO algorithm that counts how it is used.
+struct CountingAlgorithm : public MicroSchedulerAlgorithm
+{
+    virtual bool initialize(uint32_t workerCount, uint32_t priorityCount) final
+    {
+        this->workerCount = workerCount;
+        this->priorityCount = priorityCount;
+        return true;
+    }
+
+    virtual void shutdown() final
+    {
+        isShutdown = true;
+    }
+
+    virtual bool push(Task* pTask, uint32_t, SubIdType workerIdx) final
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pushCount == maxPushCount)
+        {
+            return false;
+        }
+        if (workerIdx == UNKNOWN_SUBID)
+        {
+            ++externalPushCount;
+        }
+        tasks.push_back(pTask);
+        ++pushCount;
+        return true;
+    }
+
+    virtual Task* pop(SubIdType) final
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty())
+        {
+            return nullptr;
+        }
+        Task* pTask = tasks.back();
+        tasks.pop_back();
+        ++popCount;
+        return pTask;
+    }
+
+    virtual bool hasTasks() const final
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !tasks.empty();
+    }
+
+    virtual const char* name() const final
+    {
+        return "Counting";
+    }
+
+    mutable std::mutex mutex;
+    std::deque<Task*> tasks;
+    uint32_t pushCount = 0;
+    uint32_t maxPushCount = UINT32_MAX;
+    uint32_t popCount = 0;
+    uint32_t externalPushCount = 0;
+    uint32_t workerCount = 0;
+    uint32_t priorityCount = 0;
+    bool isShutdown = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+struct AlgorithmCounterTask : public Task
+{
+    AlgorithmCounterTask(gts::Atomic<uint32_t>* pCount) : pCount(pCount) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const&)
+    {
+        pCount->fetch_add(1, memory_order::relaxed);
+        return nullptr;
+    }
+
+    gts::Atomic<uint32_t>* pCount;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+struct AlgorithmGenerator : public Task
+{
+    AlgorithmGenerator(gts::Atomic<uint32_t>* pCount, uint32_t numTasks)
+        : pCount(pCount), numTasks(numTasks) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const& ctx)
+    {
+        addRef(numTasks + 1);
+
+        for (uint32_t ii = 0; ii < numTasks; ++ii)
+        {
+            Task* pTask = ctx.pMicroScheduler->allocateTask<AlgorithmCounterTask>(pCount);
+            addChildTaskWithoutRef(pTask);
+            ctx.pMicroScheduler->spawnTask(pTask);
+        }
+
+        waitForAll();
+        return nullptr;
+    }
+
+    gts::Atomic<uint32_t>* pCount;
+    uint32_t numTasks;
+};
+
+//------------------------------------------------------------------------------
+uint32_t RunGenerator(MicroSchedulerAlgorithm* pAlgorithm, uint32_t numTasks, uint32_t threadCount)
+{
+    WorkerPool workerPool;
+    workerPool.initialize(threadCount);
+
+    MicroSchedulerDesc desc;
+    desc.pWorkerPool = &workerPool;
+    desc.pAlgorithm  = pAlgorithm;
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(desc);
+
+    gts::Atomic<uint32_t> count = { 0 };
+    taskScheduler.spawnTaskAndWait(taskScheduler.allocateTask<AlgorithmGenerator>(&count, numTasks));
+
+    taskScheduler.shutdown();
+    return count.load(memory_order::acquire);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// ALGORITHM TESTS:
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, algorithmReceivesSpawnedTasks)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        CountingAlgorithm algorithm;
+        uint32_t numTasks = TEST_DEPTH * 10;
+
+        ASSERT_EQ(numTasks, RunGenerator(&algorithm, numTasks, 2));
+        ASSERT_EQ(2u, algorithm.workerCount);
+        ASSERT_EQ(1u, algorithm.priorityCount);
+        ASSERT_EQ(numTasks, algorithm.pushCount);
+        ASSERT_EQ(numTasks, algorithm.popCount);
+        ASSERT_TRUE(algorithm.isShutdown);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, algorithmReceivesNonWorkerTasks)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        CountingAlgorithm algorithm;
+
+        WorkerPool workerPool;
+        workerPool.initialize(2);
+
+        MicroSchedulerDesc desc;
+        desc.pWorkerPool = &workerPool;
+        desc.pAlgorithm  = &algorithm;
+
+        MicroScheduler taskScheduler;
+        taskScheduler.initialize(desc);
+
+        gts::Atomic<uint32_t> count = { 0 };
+
+        std::thread nonWorker([&]()
+        {
+            taskScheduler.spawnTaskAndWait(taskScheduler.allocateTask<AlgorithmCounterTask>(&count));
+        });
+        nonWorker.join();
+
+        taskScheduler.shutdown();
+
+        ASSERT_EQ(1u, count.load(memory_order::acquire));
+        ASSERT_EQ(1u, algorithm.externalPushCount);
+    }
+}
+
+//------------------------------------------------------------------------------
+void TestSpawnTasksOverflow(bool fromNonWorker)
+{
+    constexpr uint32_t NUM_TASKS = 8;
+    constexpr uint32_t NUM_FIT   = 5;
+
+    CountingAlgorithm algorithm;
+    algorithm.maxPushCount = NUM_FIT;
+
+    WorkerPool workerPool;
+    workerPool.initialize(2);
+
+    MicroSchedulerDesc desc;
+    desc.pWorkerPool = &workerPool;
+    desc.pAlgorithm  = &algorithm;
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(desc);
+
+    gts::Atomic<uint32_t> count = { 0 };
+
+    auto spawn = [&]()
+    {
+        std::vector<Task*> tasks(NUM_TASKS);
+        for (uint32_t ii = 0; ii < NUM_TASKS; ++ii)
+        {
+            tasks[ii] = taskScheduler.allocateTask<AlgorithmCounterTask>(&count);
+        }
+
+        // Only the first NUM_FIT Tasks fit.
+        ASSERT_EQ(NUM_FIT, taskScheduler.spawnTasks(tasks.data(), NUM_TASKS));
+
+        // The rest are still ours, so spawn them once there is room.
+        {
+            std::lock_guard<std::mutex> lock(algorithm.mutex);
+            algorithm.maxPushCount = UINT32_MAX;
+        }
+        ASSERT_EQ(NUM_TASKS - NUM_FIT, taskScheduler.spawnTasks(tasks.data() + NUM_FIT, NUM_TASKS - NUM_FIT));
+    };
+
+    if (fromNonWorker)
+    {
+        std::thread nonWorker(spawn);
+        nonWorker.join();
+    }
+    else
+    {
+        spawn();
+    }
+
+    while (count.load(memory_order::acquire) != NUM_TASKS)
+    {
+        std::this_thread::yield();
+    }
+
+    taskScheduler.shutdown();
+
+    ASSERT_EQ(NUM_TASKS, algorithm.pushCount);
+    ASSERT_EQ(fromNonWorker ? NUM_TASKS : 0u, algorithm.externalPushCount);
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTasksReportsOverflow)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestSpawnTasksOverflow(false);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTasksReportsOverflowFromNonWorker)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestSpawnTasksOverflow(true);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, centralQueueAlgorithmSingleThreaded)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        CentralQueue_MicroSchedulerAlgorithm algorithm;
+        ASSERT_EQ(TEST_DEPTH, RunGenerator(&algorithm, TEST_DEPTH, 1));
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, centralQueueAlgorithmMultiThreaded)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        CentralQueue_MicroSchedulerAlgorithm algorithm;
+        ASSERT_EQ(TEST_DEPTH * 100, RunGenerator(&algorithm, TEST_DEPTH * 100, gts::Thread::getHardwareThreadCount()));
+    }
+}
+
+} // namespace testing
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "gts/platform/Atomic.h"
+#include "gts/analysis/Counter.h"
+#include "gts/analysis/Trace.h"
+
+#include "gts/micro_scheduler/WorkerPool.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+
+#include "SchedulerTestsCommon.h"
+
+using namespace gts;
+
+namespace testing {
+
+////////////////////////////////////////////////////////////////////////////////
+struct CountedGenerator : public Task
+{
+    //--------------------------------------------------------------------------
+    // Spawns numTasks empty children and waits for them.
+    Task* execute(TaskContext const& ctx)
+    {
+        addRef(numTasks + 1);
+
+        for (uint32_t ii = 0; ii < numTasks; ++ii)
+        {
+            Task* pTask = ctx.pMicroScheduler->allocateTask<EmptyTask>();
+            addChildTaskWithoutRef(pTask);
+            ctx.pMicroScheduler->spawnTask(pTask);
+        }
+
+        waitForAll();
+
+        return nullptr;
+    }
+
+    uint32_t numTasks;
+};
+
+//------------------------------------------------------------------------------
+void TestCounters(const uint32_t numTasks, const uint32_t threadCount)
+{
+    using Counters = analysis::MicroSchedulerCounters;
+
+    WorkerPool workerPool;
+    workerPool.initialize(threadCount);
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    CountedGenerator* pRootTask = taskScheduler.allocateTask<CountedGenerator>();
+    pRootTask->numTasks = numTasks;
+    taskScheduler.spawnTaskAndWait(pRootTask);
+
+    taskScheduler.shutdown();
+
+    analysis::MicroSchedulerCounterSnapshot snapshot;
+    taskScheduler.getCounters(snapshot);
+
+    // A slot per Worker plus one for everyone else.
+    ASSERT_EQ(threadCount + 1, (uint32_t)snapshot.countsByWorker.size());
+
+    // The root is executed directly by spawnTaskAndWait, not spawned.
+    ASSERT_EQ(numTasks + 1, snapshot.totals.counts[Counters::NUM_EXECUTED_TASKS]);
+    ASSERT_EQ(numTasks, snapshot.totals.counts[Counters::NUM_SPAWNS]);
+    ASSERT_GE(snapshot.totals.counts[Counters::NUM_WAITS], 1u);
+
+    // Totals are the sum of the slots.
+    for (size_t iCounter = 0; iCounter < Counters::COUNT; ++iCounter)
+    {
+        uint64_t sum = 0;
+        for (size_t iSlot = 0; iSlot < snapshot.countsByWorker.size(); ++iSlot)
+        {
+            sum += snapshot.countsByWorker[iSlot].counts[iCounter];
+        }
+        ASSERT_EQ(sum, snapshot.totals.counts[iCounter]) << Counters::name(iCounter);
+    }
+
+    analysis::WorkerPoolCounterSnapshot poolSnapshot;
+    workerPool.getCounters(poolSnapshot);
+    ASSERT_EQ(threadCount + 1, (uint32_t)poolSnapshot.countsByWorker.size());
+
+    // Every Worker but the master registers the scheduler.
+    ASSERT_EQ(threadCount - 1, poolSnapshot.totals.counts[analysis::WorkerPoolCounters::NUM_SCHEDULER_REGISTERS]);
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, countersSingleThreaded)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestCounters(TEST_DEPTH * 100, 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, countersMultiThreaded)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestCounters(TEST_DEPTH * 100, gts::Thread::getHardwareThreadCount());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, countersSnapshotWhileRunning)
+{
+    using Counters = analysis::MicroSchedulerCounters;
+
+    const uint32_t numTasks = TEST_DEPTH * 1000;
+
+    WorkerPool workerPool;
+    workerPool.initialize(gts::Thread::getHardwareThreadCount());
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    gts::Atomic<bool> done = { false };
+
+    // Poll like a telemetry thread. The counts must never go backwards.
+    std::thread poller([&]()
+    {
+        analysis::MicroSchedulerCounterSnapshot snapshot;
+        uint64_t lastExecuted = 0;
+        while (!done.load(memory_order::acquire))
+        {
+            taskScheduler.getCounters(snapshot);
+            uint64_t executed = snapshot.totals.counts[Counters::NUM_EXECUTED_TASKS];
+            ASSERT_GE(executed, lastExecuted);
+            lastExecuted = executed;
+            std::this_thread::yield();
+        }
+    });
+
+    CountedGenerator* pRootTask = taskScheduler.allocateTask<CountedGenerator>();
+    pRootTask->numTasks = numTasks;
+    taskScheduler.spawnTaskAndWait(pRootTask);
+
+    done.store(true, memory_order::release);
+    poller.join();
+
+    analysis::MicroSchedulerCounterSnapshot snapshot;
+    taskScheduler.getCounters(snapshot);
+    ASSERT_EQ(numTasks + 1, snapshot.totals.counts[Counters::NUM_EXECUTED_TASKS]);
+
+    taskScheduler.shutdown();
+}
+
+} // namespace testing
@@ -41,7 +41,9 @@ namespace testing {
 struct ThreadData
 {
     MicroScheduler* pMicroScheduler;
+    WorkerPool* pWorkerPool;
     uint32_t maxCount;
+    bool registerThread;
     gts::Atomic<uint32_t> count;
 };
 
@@ -69,15 +71,25 @@ struct PerThreadCounterTask : public Task
 //------------------------------------------------------------------------------
 void NonWorkerThreadFunc(ThreadData* data)
 {
+    if (data->registerThread)
+    {
+        ASSERT_TRUE(data->pWorkerPool->registerExternalThread());
+    }
+
     for (uint32_t ii = 0; ii < data->maxCount; ++ii)
     {
         Task* pTask = data->pMicroScheduler->allocateTask<PerThreadCounterTask>(&data->count);
         data->pMicroScheduler->spawnTaskAndWait(pTask);
     }
+
+    if (data->registerThread)
+    {
+        data->pWorkerPool->unregisterExternalThread();
+    }
 }
 
 //------------------------------------------------------------------------------
-void TestNonWorkerThreads(uint32_t numTasks, uint32_t nonWorkerCount, uint32_t threadCount)
+void TestNonWorkerThreads(uint32_t numTasks, uint32_t nonWorkerCount, uint32_t threadCount, bool registerThreads = false)
 {
     WorkerPool workerPool;
     workerPool.initialize(threadCount);
@@ -91,7 +103,9 @@ void TestNonWorkerThreads(uint32_t numTasks, uint32_t nonWorkerCount, uint32_t t
     for (uint32_t nn = 0; nn < nonWorkerCount; ++nn)
     {
         threadData[nn].pMicroScheduler = &taskScheduler;
+        threadData[nn].pWorkerPool = &workerPool;
         threadData[nn].maxCount = numTasks;
+        threadData[nn].registerThread = registerThreads;
         threadData[nn].count.store(0, memory_order::release);
 
         threadPool[nn] = new std::thread(NonWorkerThreadFunc, &threadData[nn]);
@@ -130,6 +144,85 @@ TEST(MicroScheduler_nonWorkerThread, singleThreaded)
     }
 }
 
+//------------------------------------------------------------------------------
+TEST(MicroScheduler_nonWorkerThread, singleThreadedRegistered)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestNonWorkerThreads(1000, 1, 2, true); // 2 since the main thread will be blocked.
+
+        WorkerPool::resetIdGenerator();
+        MicroScheduler::resetIdGenerator();
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler_nonWorkerThread, multiThreadedRegistered)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestNonWorkerThreads(1000, 4, gts::Thread::getHardwareThreadCount() + 1, true);
+
+        WorkerPool::resetIdGenerator();
+        MicroScheduler::resetIdGenerator();
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler_nonWorkerThread, registeredWithAnotherPool)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // 2 since the main thread will be blocked.
+        WorkerPool registeredPool;
+        registeredPool.initialize(2);
+        WorkerPool otherPool;
+        otherPool.initialize(2);
+
+        MicroScheduler registeredScheduler;
+        registeredScheduler.initialize(&registeredPool);
+        MicroScheduler otherScheduler;
+        otherScheduler.initialize(&otherPool);
+
+        gts::Atomic<uint32_t> count(0);
+
+        // A thread registered with one pool may still use schedulers on
+        // another. Those Tasks must not come from the registered cache.
+        std::thread nonWorker([&]()
+        {
+            ASSERT_TRUE(registeredPool.registerExternalThread());
+
+            for (uint32_t jj = 0; jj < 1000; ++jj)
+            {
+                MicroScheduler& taskScheduler = jj % 2 ? otherScheduler : registeredScheduler;
+                Task* pTask = taskScheduler.allocateTask<PerThreadCounterTask>(&count);
+                taskScheduler.spawnTaskAndWait(pTask);
+            }
+
+            registeredPool.unregisterExternalThread();
+
+            // The freed cache is reused by the next thread to register.
+            ASSERT_TRUE(registeredPool.registerExternalThread());
+            registeredPool.unregisterExternalThread();
+        });
+        nonWorker.join();
+
+        ASSERT_EQ(count.load(memory_order::acquire), 1000u);
+
+        otherScheduler.shutdown();
+        registeredScheduler.shutdown();
+        otherPool.shutdown();
+        registeredPool.shutdown();
+
+        WorkerPool::resetIdGenerator();
+        MicroScheduler::resetIdGenerator();
+    }
+}
+
 //------------------------------------------------------------------------------
 TEST(MicroScheduler_nonWorkerThread, multiThreaded)
 {
@@ -241,4 +241,161 @@ TEST(MicroScheduler, priorityStarvationSingleThreaded)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// GLOBAL PRIORITY TESTS:
+
+struct GlobalPriorityState
+{
+    Atomic<bool> seederStarted = { false };
+    Atomic<bool> seederReady = { false };
+    Atomic<bool> go = { false };
+    Atomic<bool> highRan = { false };
+    Atomic<uint32_t> leavesStartedBeforeHigh = { 0 };
+};
+
+////////////////////////////////////////////////////////////////////////////////
+struct GlobalPriorityHigh : public Task
+{
+    GlobalPriorityHigh(GlobalPriorityState* pState) : pState(pState) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const&)
+    {
+        pState->highRan.store(true, memory_order::release);
+        return nullptr;
+    }
+
+    GlobalPriorityState* pState;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+struct GlobalPriorityLeaf : public Task
+{
+    GlobalPriorityLeaf(GlobalPriorityState* pState) : pState(pState) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const&)
+    {
+        if (!pState->highRan.load(memory_order::acquire))
+        {
+            pState->leavesStartedBeforeHigh.fetch_add(1, memory_order::relaxed);
+        }
+        return nullptr;
+    }
+
+    GlobalPriorityState* pState;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Runs on the other Worker and fills its deque with low priority leaves.
+struct GlobalPrioritySeeder : public Task
+{
+    GlobalPrioritySeeder(GlobalPriorityState* pState, Task* pRoot, uint32_t leafCount)
+        : pState(pState), pRoot(pRoot), leafCount(leafCount) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const& ctx)
+    {
+        pState->seederStarted.store(true, memory_order::release);
+
+        for (uint32_t ii = 0; ii < leafCount; ++ii)
+        {
+            Task* pLeaf = ctx.pMicroScheduler->allocateTask<GlobalPriorityLeaf>(pState);
+            pRoot->addChildTaskWithRef(pLeaf);
+            ctx.pMicroScheduler->spawnTask(pLeaf, 1);
+        }
+
+        pState->seederReady.store(true, memory_order::release);
+
+        while (!pState->go.load(memory_order::acquire))
+        {
+            GTS_PAUSE();
+        }
+        return nullptr;
+    }
+
+    GlobalPriorityState* pState;
+    Task* pRoot;
+    uint32_t leafCount;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+struct GlobalPriorityGenerator : public Task
+{
+    GlobalPriorityGenerator(GlobalPriorityState* pState, uint32_t leafCount)
+        : pState(pState), leafCount(leafCount) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const& ctx)
+    {
+        addRef(3);
+
+        // Block this Worker so that the seeder is stolen by the other one.
+        Task* pSeeder = ctx.pMicroScheduler->allocateTask<GlobalPrioritySeeder>(pState, this, leafCount);
+        addChildTaskWithoutRef(pSeeder);
+        ctx.pMicroScheduler->spawnTask(pSeeder, 1);
+
+        while (!pState->seederReady.load(memory_order::acquire))
+        {
+            GTS_PAUSE();
+        }
+
+        // The high priority Task lands in this Worker's deque while this
+        // Worker stays busy. Only global priorities let the other Worker
+        // take it before its own leaves.
+        Task* pHigh = ctx.pMicroScheduler->allocateTask<GlobalPriorityHigh>(pState);
+        addChildTaskWithoutRef(pHigh);
+        ctx.pMicroScheduler->spawnTask(pHigh, 0);
+
+        pState->go.store(true, memory_order::release);
+
+        while (!pState->highRan.load(memory_order::acquire))
+        {
+            GTS_PAUSE();
+        }
+
+        waitForAll();
+        return nullptr;
+    }
+
+    GlobalPriorityState* pState;
+    uint32_t leafCount;
+};
+
+//------------------------------------------------------------------------------
+void GlobalPriorityTest(uint32_t leafCount)
+{
+    WorkerPool workerPool;
+    workerPool.initialize(2);
+
+    MicroSchedulerDesc desc;
+    desc.pWorkerPool = &workerPool;
+    desc.priorityCount = 2;
+    desc.useGlobalPriorities = true;
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(desc);
+
+    GlobalPriorityState state;
+
+    Task* pRoot = taskScheduler.allocateTask<GlobalPriorityGenerator>(&state, leafCount);
+    taskScheduler.spawnTaskAndWait(pRoot);
+
+    ASSERT_TRUE(state.highRan.load(memory_order::acquire));
+    ASSERT_EQ(0u, state.leavesStartedBeforeHigh.load(memory_order::acquire));
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, globalPriorityBeforeLocalLowPriority)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        GlobalPriorityTest(TEST_DEPTH);
+    }
+}
+
 } // namespace testing
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 
 #include <cstdlib>
+#include <thread>
 
 #include "gts/platform/Atomic.h"
 #include "gts/analysis/Trace.h"
@@ -80,6 +81,41 @@ struct SpawnedTaskCounterGenerator : public Task
     gts::Atomic<uint32_t>* taskCountByThreadIdx;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+struct SpawnedTaskCounterBatchGenerator : public Task
+{
+    //--------------------------------------------------------------------------
+    // Root task for TestSpawnTasks
+    Task* execute(TaskContext const& ctx)
+    {
+        addRef(numTasks + 1);
+
+        std::vector<Task*> tasks(numTasks);
+        ctx.pMicroScheduler->allocateTasks<SpawnedTaskCounter>(tasks.data(), numTasks, taskCountByThreadIdx);
+
+        for (uint32_t ii = 0; ii < numTasks; ++ii)
+        {
+            addChildTaskWithoutRef(tasks[ii]);
+        }
+
+        // Pin one Task to check that it doesn't break up the batch.
+        if (pinnedWorker != ANY_WORKER)
+        {
+            tasks[numTasks / 2]->setAffinity(pinnedWorker);
+        }
+
+        ctx.pMicroScheduler->spawnTasks(tasks.data(), numTasks);
+
+        waitForAll();
+
+        return nullptr;
+    }
+
+    uint32_t numTasks;
+    uint32_t pinnedWorker = ANY_WORKER;
+    gts::Atomic<uint32_t>* taskCountByThreadIdx;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 // SPAWN TASK TESTS:
@@ -149,4 +185,208 @@ TEST(MicroScheduler, spawnTaskMultiThreaded)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// SPAWN TASKS TESTS:
+
+//------------------------------------------------------------------------------
+void TestSpawnTasks(const uint32_t numTasks, const uint32_t threadCount, uint32_t pinnedWorker = ANY_WORKER)
+{
+    WorkerPool workerPool;
+    workerPool.initialize(threadCount);
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    // Create a counter per thread.
+    std::vector<gts::Atomic<uint32_t>> taskCountByThreadIdx(threadCount);
+    for (auto& counter : taskCountByThreadIdx)
+    {
+        counter.store(0, memory_order::release);
+    }
+
+    SpawnedTaskCounterBatchGenerator* pRootTask = taskScheduler.allocateTask<SpawnedTaskCounterBatchGenerator>();
+    pRootTask->numTasks = numTasks;
+    pRootTask->pinnedWorker = pinnedWorker;
+    pRootTask->taskCountByThreadIdx = taskCountByThreadIdx.data();
+
+    taskScheduler.spawnTaskAndWait(pRootTask);
+
+    // Total up the counters
+    uint32_t numTasksCompleted = 0;
+    for (auto& counter : taskCountByThreadIdx)
+    {
+        numTasksCompleted += counter.load(memory_order::acquire);
+    }
+
+    // Verify all the tasks ran.
+    ASSERT_EQ(numTasks, numTasksCompleted);
+
+    if (pinnedWorker != ANY_WORKER)
+    {
+        ASSERT_GE(taskCountByThreadIdx[pinnedWorker].load(memory_order::acquire), 1u);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTasksSingleThreaded)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestSpawnTasks(TEST_DEPTH * 100, 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTasksMultiThreaded)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        TestSpawnTasks(TEST_DEPTH * 100, gts::Thread::getHardwareThreadCount());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTasksWithAffinity)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+        const uint32_t threadCount = gts::Thread::getHardwareThreadCount();
+        TestSpawnTasks(TEST_DEPTH * 100, threadCount, threadCount - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTasksFromNonWorker)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // +1 since the main thread will be blocked.
+        const uint32_t threadCount = gts::Thread::getHardwareThreadCount() + 1;
+        const uint32_t numTasks    = TEST_DEPTH * 100;
+
+        WorkerPool workerPool;
+        workerPool.initialize(threadCount);
+
+        MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        std::vector<gts::Atomic<uint32_t>> taskCountByThreadIdx(threadCount);
+        for (auto& counter : taskCountByThreadIdx)
+        {
+            counter.store(0, memory_order::release);
+        }
+
+        std::thread nonWorker([&]()
+        {
+            Task* pRoot = taskScheduler.allocateTask<EmptyTask>();
+            pRoot->addRef(numTasks + 1);
+
+            std::vector<Task*> tasks(numTasks);
+            taskScheduler.allocateTasks<SpawnedTaskCounter>(tasks.data(), numTasks, taskCountByThreadIdx.data());
+            for (uint32_t jj = 0; jj < numTasks; ++jj)
+            {
+                pRoot->addChildTaskWithoutRef(tasks[jj]);
+            }
+
+            taskScheduler.spawnTasks(tasks.data(), numTasks);
+            taskScheduler.waitFor(pRoot);
+            taskScheduler.destoryTask(pRoot);
+        });
+        nonWorker.join();
+
+        uint32_t numTasksCompleted = 0;
+        for (auto& counter : taskCountByThreadIdx)
+        {
+            numTasksCompleted += counter.load(memory_order::acquire);
+        }
+        ASSERT_EQ(numTasks, numTasksCompleted);
+
+        taskScheduler.shutdown();
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(MicroScheduler, spawnTaskAndWaitFromManyNonWorkers)
+{
+    // Several non-workers recycle waiter Tasks through the same pool. A
+    // completing child must never touch a waiter that has already returned,
+    // so every wait has to observe all of its own Tasks.
+    const uint32_t nonWorkerCount = 4;
+    const uint32_t numWaits       = TEST_DEPTH * 1000;
+
+    for (uint32_t ii = 0; ii < ITERATIONS_STRESS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // +1 since the main thread will be blocked.
+        const uint32_t workerCount = gts::Thread::getHardwareThreadCount() + 1;
+
+        WorkerPool workerPool;
+        workerPool.initialize(workerCount);
+
+        MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        std::vector<gts::Atomic<uint32_t>> failureCounts(nonWorkerCount);
+        for (auto& counter : failureCounts)
+        {
+            counter.store(0, memory_order::release);
+        }
+
+        std::vector<std::thread> nonWorkers;
+        for (uint32_t iThread = 0; iThread < nonWorkerCount; ++iThread)
+        {
+            nonWorkers.emplace_back([&, iThread]()
+            {
+                std::vector<gts::Atomic<uint32_t>> taskCountByThreadIdx(workerCount);
+                for (auto& counter : taskCountByThreadIdx)
+                {
+                    counter.store(0, memory_order::release);
+                }
+
+                uint32_t expectedCount = 0;
+                for (uint32_t jj = 0; jj < numWaits; ++jj)
+                {
+                    SpawnedTaskCounterGenerator* pRootTask = taskScheduler.allocateTask<SpawnedTaskCounterGenerator>();
+                    pRootTask->numTasks = jj % 3;
+                    pRootTask->taskCountByThreadIdx = taskCountByThreadIdx.data();
+                    expectedCount += pRootTask->numTasks;
+
+                    taskScheduler.spawnTaskAndWait(pRootTask);
+
+                    uint32_t numTasksCompleted = 0;
+                    for (auto& counter : taskCountByThreadIdx)
+                    {
+                        numTasksCompleted += counter.load(memory_order::acquire);
+                    }
+                    if (numTasksCompleted != expectedCount)
+                    {
+                        failureCounts[iThread].fetch_add(1, memory_order::relaxed);
+                    }
+                }
+            });
+        }
+
+        for (auto& nonWorker : nonWorkers)
+        {
+            nonWorker.join();
+        }
+
+        for (auto& counter : failureCounts)
+        {
+            ASSERT_EQ(0u, counter.load(memory_order::acquire));
+        }
+
+        taskScheduler.shutdown();
+    }
+}
+
 } // namespace testing
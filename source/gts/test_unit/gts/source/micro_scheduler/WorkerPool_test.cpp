@@ -23,10 +23,14 @@
 #include <gtest/gtest.h>
 
 #include <cstdlib>
+#include <vector>
 
 #include "gts/platform/Atomic.h"
 #include "gts/platform/Thread.h"
 #include "gts/micro_scheduler/WorkerPool.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+
+#include "micro_scheduler/StealHierarchy.h"
 
 #include "SchedulerTestsCommon.h"
 
@@ -60,4 +64,251 @@ TEST(WorkerPool, InitAndShutdown)
     }
 }
 
+//------------------------------------------------------------------------------
+TEST(WorkerPool, InitPinnedAndShutdown)
+{
+    const uint32_t workerCount = gts::Thread::getHardwareThreadCount();
+
+    WorkerPoolDesc desc;
+    desc.workerDescs.resize(workerCount);
+    for (uint32_t ii = 0; ii < workerCount; ++ii)
+    {
+        desc.workerDescs[ii].affinity.affinitySet.set(ii);
+    }
+
+    WorkerPool workerPool;
+    workerPool.initialize(desc);
+
+    ASSERT_TRUE(workerPool.isRunning());
+    ASSERT_EQ(workerCount, workerPool.workerCount());
+
+    workerPool.shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// NUMA TESTS:
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+struct NumaCounterTask : public Task
+{
+    explicit NumaCounterTask(gts::Atomic<uint32_t>* pCount) : pCount(pCount) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const&)
+    {
+        pCount->fetch_add(1, memory_order::relaxed);
+        return nullptr;
+    }
+
+    gts::Atomic<uint32_t>* pCount;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+struct NumaGenerator : public Task
+{
+    NumaGenerator(gts::Atomic<uint32_t>* pCount, uint32_t numTasks)
+        : pCount(pCount), numTasks(numTasks) {}
+
+    //--------------------------------------------------------------------------
+    Task* execute(TaskContext const& ctx)
+    {
+        addRef(numTasks + 1);
+
+        for (uint32_t ii = 0; ii < numTasks; ++ii)
+        {
+            Task* pTask = ctx.pMicroScheduler->allocateTask<NumaCounterTask>(pCount);
+            addChildTaskWithoutRef(pTask);
+            ctx.pMicroScheduler->spawnTask(pTask);
+        }
+
+        waitForAll();
+        return nullptr;
+    }
+
+    gts::Atomic<uint32_t>* pCount;
+    uint32_t numTasks;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+TEST(WorkerPool, InitNumaAwareAndShutdown)
+{
+    WorkerPoolDesc desc;
+    desc.workerDescs.resize(gts::Thread::getHardwareThreadCount());
+    desc.numaAware = true;
+    desc.initialTaskCountPerWorker = 8;
+
+    WorkerPool workerPool;
+    ASSERT_TRUE(workerPool.initialize(desc));
+
+    ASSERT_TRUE(workerPool.isRunning());
+    ASSERT_EQ(desc.workerDescs.size(), workerPool.workerCount());
+
+    workerPool.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(WorkerPool, NumaAwareRecyclesArenaTasks)
+{
+    for (uint32_t ii = 0; ii < ITERATIONS; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        WorkerPoolDesc desc;
+        desc.workerDescs.resize(gts::Thread::getHardwareThreadCount());
+        desc.numaAware = true;
+        desc.numaRemoteStealPeriod = 2;
+
+        WorkerPool workerPool;
+        workerPool.initialize(desc);
+
+        MicroScheduler taskScheduler;
+        taskScheduler.initialize(&workerPool);
+
+        // Several rounds so that freed arena Tasks are reused.
+        for (uint32_t round = 0; round < 4; ++round)
+        {
+            const uint32_t numTasks = TEST_DEPTH * 10;
+            gts::Atomic<uint32_t> count = { 0 };
+            taskScheduler.spawnTaskAndWait(taskScheduler.allocateTask<NumaGenerator>(&count, numTasks));
+            ASSERT_EQ(numTasks, count.load(memory_order::acquire));
+        }
+
+        taskScheduler.shutdown();
+        workerPool.shutdown();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+// STEAL HIERARCHY TESTS:
+
+namespace {
+
+//------------------------------------------------------------------------------
+// 2 NUMA nodes x 2 cores x 2 hardware threads. Hardware thread IDs are
+// assigned in order, so siblings are adjacent.
+void buildTestTopology(SystemTopology& topology)
+{
+    constexpr uint32_t NODE_COUNT       = 2;
+    constexpr uint32_t CORES_PER_NODE   = 2;
+    constexpr uint32_t THREADS_PER_CORE = 2;
+
+    auto initCore = [](CpuCoreInfo& core, uint32_t coreIdx)
+    {
+        core.pHardwareThreadIds = new uint32_t[THREADS_PER_CORE];
+        core.hardwareThreadIdCount = THREADS_PER_CORE;
+        for (uint32_t ii = 0; ii < THREADS_PER_CORE; ++ii)
+        {
+            core.pHardwareThreadIds[ii] = coreIdx * THREADS_PER_CORE + ii;
+        }
+    };
+
+    topology.pGroupInfoArray = new ProcessorGroupInfo[1];
+    topology.groupInfoElementCount = 1;
+    ProcessorGroupInfo& group = topology.pGroupInfoArray[0];
+
+    group.pCoreInfoArray = new CpuCoreInfo[NODE_COUNT * CORES_PER_NODE];
+    group.coreInfoElementCount = NODE_COUNT * CORES_PER_NODE;
+    for (uint32_t iCore = 0; iCore < group.coreInfoElementCount; ++iCore)
+    {
+        initCore(group.pCoreInfoArray[iCore], iCore);
+    }
+
+    group.pNumaInfoArray = new NumaNodeInfo[NODE_COUNT];
+    group.numaNodeInfoElementCount = NODE_COUNT;
+    for (uint32_t iNode = 0; iNode < NODE_COUNT; ++iNode)
+    {
+        NumaNodeInfo& node = group.pNumaInfoArray[iNode];
+        node.nodeId = iNode;
+        node.pCoreInfoArray = new CpuCoreInfo[CORES_PER_NODE];
+        node.coreInfoElementCount = CORES_PER_NODE;
+        for (uint32_t iCore = 0; iCore < CORES_PER_NODE; ++iCore)
+        {
+            initCore(node.pCoreInfoArray[iCore], iNode * CORES_PER_NODE + iCore);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+std::vector<SubIdType> levelVictims(StealHierarchy const& hierarchy, SubIdType workerId, uint32_t level)
+{
+    SubIdType const* pVictims = hierarchy.victims(workerId);
+    return std::vector<SubIdType>(
+        pVictims + hierarchy.levelBegin(workerId, level),
+        pVictims + hierarchy.levelEnd(workerId, level));
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+TEST(StealHierarchy, pinnedWorkers)
+{
+    SystemTopology topology;
+    buildTestTopology(topology);
+
+    constexpr uint32_t workerCount = 8;
+    WorkerThreadDesc::GroupAndAffinity affinities[workerCount];
+    for (uint32_t ii = 0; ii < workerCount; ++ii)
+    {
+        affinities[ii].affinitySet.set(ii);
+    }
+
+    StealHierarchy hierarchy;
+    ASSERT_TRUE(hierarchy.build(topology, affinities, workerCount));
+    ASSERT_EQ(hierarchy.workerCount(), workerCount);
+
+    ASSERT_EQ(levelVictims(hierarchy, 0, StealHierarchy::SMT_SIBLING), std::vector<SubIdType>({ 1 }));
+    ASSERT_EQ(levelVictims(hierarchy, 0, StealHierarchy::SAME_NODE), std::vector<SubIdType>({ 2, 3 }));
+    ASSERT_EQ(levelVictims(hierarchy, 0, StealHierarchy::REMOTE), std::vector<SubIdType>({ 4, 5, 6, 7 }));
+
+    ASSERT_EQ(levelVictims(hierarchy, 6, StealHierarchy::SMT_SIBLING), std::vector<SubIdType>({ 7 }));
+    ASSERT_EQ(levelVictims(hierarchy, 6, StealHierarchy::SAME_NODE), std::vector<SubIdType>({ 4, 5 }));
+    ASSERT_EQ(levelVictims(hierarchy, 6, StealHierarchy::REMOTE), std::vector<SubIdType>({ 0, 1, 2, 3 }));
+
+    ASSERT_FALSE(hierarchy.isCrossNode(0, 3));
+    ASSERT_TRUE(hierarchy.isCrossNode(0, 4));
+}
+
+//------------------------------------------------------------------------------
+TEST(StealHierarchy, unpinnedWorkerIsRemote)
+{
+    SystemTopology topology;
+    buildTestTopology(topology);
+
+    constexpr uint32_t workerCount = 4;
+    WorkerThreadDesc::GroupAndAffinity affinities[workerCount];
+    affinities[0].affinitySet.set(0);
+    affinities[1].affinitySet.set(1);
+    affinities[2].affinitySet.set(4);
+    // affinities[3] is unpinned.
+
+    StealHierarchy hierarchy;
+    ASSERT_TRUE(hierarchy.build(topology, affinities, workerCount));
+
+    ASSERT_EQ(levelVictims(hierarchy, 0, StealHierarchy::SMT_SIBLING), std::vector<SubIdType>({ 1 }));
+    ASSERT_EQ(levelVictims(hierarchy, 0, StealHierarchy::REMOTE), std::vector<SubIdType>({ 2, 3 }));
+
+    // An unpinned Worker has no nearer victims.
+    ASSERT_EQ(levelVictims(hierarchy, 3, StealHierarchy::REMOTE), std::vector<SubIdType>({ 0, 1, 2 }));
+    ASSERT_FALSE(hierarchy.isCrossNode(0, 3));
+}
+
+//------------------------------------------------------------------------------
+TEST(StealHierarchy, unpinnedWorkersHaveNoHierarchy)
+{
+    SystemTopology topology;
+    buildTestTopology(topology);
+
+    constexpr uint32_t workerCount = 4;
+    WorkerThreadDesc::GroupAndAffinity affinities[workerCount];
+
+    StealHierarchy hierarchy;
+    ASSERT_FALSE(hierarchy.build(topology, affinities, workerCount));
+}
+
 } // namespace testing
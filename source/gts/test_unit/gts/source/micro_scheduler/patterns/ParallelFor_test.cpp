@@ -22,6 +22,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "gts/platform/Thread.h"
 #include "gts/analysis/Trace.h"
 #include "gts/analysis/ConcurrentLogger.h"
@@ -103,6 +106,159 @@ TEST(ParallelFor, Adaptive1D)
     ParallelFor1D<AdaptivePartitioner>(ELEMENT_COUNT, 1);
 }
 
+//------------------------------------------------------------------------------
+TEST(ParallelFor, Affinity1D)
+{
+    ParallelFor1D<AffinityPartitioner>(ELEMENT_COUNT, 1);
+}
+
+//------------------------------------------------------------------------------
+void ParallelForAffinityReused(size_t elementCount, size_t tileSize, uint32_t workerCount, AffinityPartitioner& partitioner)
+{
+    WorkerPool workerPool;
+    workerPool.initialize(workerCount);
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelFor parallelFor(taskScheduler);
+
+    std::vector<uint32_t> vec;
+    vec.resize(elementCount, 0);
+
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR * 8; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        parallelFor(
+            Range1d<size_t>(0, elementCount, tileSize),
+            [&vec](Range1d<size_t>& range, void*, TaskContext const&)
+            {
+                for (size_t jj = range.begin(); jj != range.end(); ++jj)
+                {
+                    vec[jj]++;
+                }
+            },
+            partitioner,
+            nullptr);
+
+        // Validate that all values have been incremented only once.
+        for (size_t jj = 0; jj < vec.size(); ++jj)
+        {
+            ASSERT_EQ(vec[jj], ii + 1);
+        }
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelFor, AffinityReused)
+{
+    AffinityPartitioner partitioner;
+
+    // The record is replayed across calls and reset when the Worker count
+    // changes.
+    ParallelForAffinityReused(ELEMENT_COUNT, 1, gts::Thread::getHardwareThreadCount(), partitioner);
+    ParallelForAffinityReused(ELEMENT_COUNT, 1, 2, partitioner);
+    ParallelForAffinityReused(ELEMENT_COUNT, TILE_SIZE, 2, partitioner);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelFor, AffinityDoesNotWaitForBusyWorkers)
+{
+    constexpr uint32_t WORKER_COUNT = 4;
+
+    WorkerPool workerPool;
+    workerPool.initialize(WORKER_COUNT);
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelFor parallelFor(taskScheduler);
+
+    std::vector<uint32_t> vec;
+    vec.resize(ELEMENT_COUNT, 0);
+
+    auto increment = [&vec](Range1d<size_t>& range, void*, TaskContext const&)
+    {
+        for (size_t jj = range.begin(); jj != range.end(); ++jj)
+        {
+            vec[jj]++;
+        }
+    };
+
+    gts::Atomic<uint32_t> busyCount = { 0 };
+    gts::Atomic<bool> release = { false };
+
+    {
+        AffinityPartitioner partitioner;
+
+        // Slow sub-ranges give the other Workers time to steal, so that they
+        // own some of the record.
+        parallelFor(
+            Range1d<size_t>(0, ELEMENT_COUNT, 1),
+            [&vec](Range1d<size_t>& range, void*, TaskContext const&)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                for (size_t jj = range.begin(); jj != range.end(); ++jj)
+                {
+                    vec[jj]++;
+                }
+            },
+            partitioner,
+            nullptr);
+
+        // Keep every other Worker busy, so that they cannot poll their
+        // affinity queues.
+        for (uint32_t ii = 1; ii < WORKER_COUNT; ++ii)
+        {
+            Task* pTask = taskScheduler.allocateTask([&busyCount, &release](TaskContext const&)->Task*
+            {
+                busyCount.fetch_add(1, memory_order::acq_rel);
+                while (!release.load(memory_order::acquire))
+                {
+                    std::this_thread::yield();
+                }
+                return nullptr;
+            });
+            pTask->setAffinity(ii);
+            taskScheduler.spawnTask(pTask);
+        }
+
+        while (busyCount.load(memory_order::acquire) != WORKER_COUNT - 1)
+        {
+            std::this_thread::yield();
+        }
+
+        // Completes on this thread alone.
+        parallelFor(Range1d<size_t>(0, ELEMENT_COUNT, 1), increment, partitioner, nullptr);
+
+        for (size_t jj = 0; jj < vec.size(); ++jj)
+        {
+            ASSERT_EQ(vec[jj], 2u);
+        }
+    }
+
+    // The copies still queued for the busy Workers outlive the partitioner.
+    release.store(true, memory_order::release);
+
+    // Drain the affinity queues.
+    for (uint32_t ii = 1; ii < WORKER_COUNT; ++ii)
+    {
+        Task* pTask = taskScheduler.allocateTask<EmptyTask>();
+        pTask->setAffinity(ii);
+        taskScheduler.spawnTaskAndWait(pTask);
+    }
+
+    for (size_t jj = 0; jj < vec.size(); ++jj)
+    {
+        ASSERT_EQ(vec[jj], 2u);
+    }
+
+    taskScheduler.shutdown();
+}
+
 //------------------------------------------------------------------------------
 template<typename TPartitioner>
 void ParallelForLambdaClosure1D(size_t elementCount, size_t tileSize)
@@ -336,6 +492,18 @@ TEST(ParallelFor, QuadAdaptive2D)
     ParallelFor2D<QuadRange<size_t>, AdaptivePartitioner>(ELEMENT_COUNT, TILE_SIZE);
 }
 
+//------------------------------------------------------------------------------
+TEST(ParallelFor, KdAffinity2D)
+{
+    ParallelFor2D<KdRange2d<size_t>, AffinityPartitioner>(ELEMENT_COUNT, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelFor, QuadAffinity2D)
+{
+    ParallelFor2D<QuadRange<size_t>, AffinityPartitioner>(ELEMENT_COUNT, TILE_SIZE);
+}
+
 //------------------------------------------------------------------------------
 template<typename TRange, typename TPartitioner>
 void ParallelFor3D(size_t elementCount, size_t tileSize)
@@ -439,4 +607,16 @@ TEST(ParallelFor, OctAdaptive3D)
     ParallelFor3D<OctRange<size_t>, AdaptivePartitioner>(ELEMENT_COUNT / 4, TILE_SIZE);
 }
 
+//------------------------------------------------------------------------------
+TEST(ParallelFor, KdAffinity3D)
+{
+    ParallelFor3D<KdRange3d<size_t>, AffinityPartitioner>(ELEMENT_COUNT / 4, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelFor, OctAffinity3D)
+{
+    ParallelFor3D<OctRange<size_t>, AffinityPartitioner>(ELEMENT_COUNT / 4, TILE_SIZE);
+}
+
 } // namespace testing
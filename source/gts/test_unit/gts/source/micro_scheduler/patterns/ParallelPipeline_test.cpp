@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gts/analysis/Trace.h"
+
+#include "gts/micro_scheduler/WorkerPool.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/patterns/ParallelPipeline.h"
+
+#include "SchedulerTestsCommon.h"
+
+using namespace gts;
+
+namespace testing {
+
+//------------------------------------------------------------------------------
+struct PipelineToken
+{
+    uint32_t item  = 0;
+    uint64_t value = 0;
+};
+
+//------------------------------------------------------------------------------
+void testInOrder(uint32_t tokenCount)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelPipeline pipeline(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<PipelineToken> tokens(tokenCount);
+        std::vector<uint64_t> output;
+
+        uint32_t nextItem = 0;
+        gts::Atomic<uint32_t> inFlightCount(0);
+        uint32_t maxInFlightCount = 0;
+
+        pipeline(tokens.data(), tokenCount,
+            [&](PipelineToken& token, TaskContext const&)
+            {
+                if (nextItem == ELEMENT_COUNT)
+                {
+                    return false;
+                }
+                token.item = nextItem++;
+                uint32_t inFlight = inFlightCount.fetch_add(1, memory_order::acq_rel) + 1;
+                maxInFlightCount = gtsMax(maxInFlightCount, inFlight);
+                return true;
+            },
+            ParallelPipeline::stage(PipelineStageMode::PARALLEL, [](PipelineToken& token, TaskContext const&)
+            {
+                token.value = uint64_t(token.item) * token.item;
+            }),
+            ParallelPipeline::stage(PipelineStageMode::SERIAL_IN_ORDER, [&](PipelineToken& token, TaskContext const&)
+            {
+                output.push_back(token.value);
+            }),
+            ParallelPipeline::stage(PipelineStageMode::PARALLEL, [&](PipelineToken&, TaskContext const&)
+            {
+                inFlightCount.fetch_sub(1, memory_order::acq_rel);
+            }));
+
+        ASSERT_EQ(size_t(ELEMENT_COUNT), output.size());
+        for (uint32_t ii = 0; ii < ELEMENT_COUNT; ++ii)
+        {
+            ASSERT_EQ(uint64_t(ii) * ii, output[ii]);
+        }
+        ASSERT_LE(maxInFlightCount, tokenCount);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelPipeline, inOrderOneToken)
+{
+    testInOrder(1);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelPipeline, inOrderManyTokens)
+{
+    testInOrder(TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelPipeline, serialOutOfOrder)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelPipeline pipeline(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<PipelineToken> tokens(TILE_SIZE);
+        std::vector<uint8_t> seen(ELEMENT_COUNT, 0);
+
+        uint32_t nextItem = 0;
+        gts::Atomic<uint32_t> runningCount(0);
+        uint32_t maxRunningCount = 0;
+
+        pipeline(tokens.data(), uint32_t(tokens.size()),
+            [&](PipelineToken& token, TaskContext const&)
+            {
+                if (nextItem == ELEMENT_COUNT)
+                {
+                    return false;
+                }
+                token.item = nextItem++;
+                return true;
+            },
+            ParallelPipeline::stage(PipelineStageMode::PARALLEL, [](PipelineToken&, TaskContext const&) {}),
+            ParallelPipeline::stage(PipelineStageMode::SERIAL_OUT_OF_ORDER, [&](PipelineToken& token, TaskContext const&)
+            {
+                uint32_t running = runningCount.fetch_add(1, memory_order::acq_rel) + 1;
+                maxRunningCount = gtsMax(maxRunningCount, running);
+                ++seen[token.item];
+                runningCount.fetch_sub(1, memory_order::acq_rel);
+            }));
+
+        ASSERT_EQ(1u, maxRunningCount);
+        for (uint32_t ii = 0; ii < ELEMENT_COUNT; ++ii)
+        {
+            ASSERT_EQ(1, seen[ii]);
+        }
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelPipeline, emptyInput)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelPipeline pipeline(taskScheduler);
+
+    std::vector<PipelineToken> tokens(TILE_SIZE);
+    uint32_t stageCount = 0;
+
+    pipeline(tokens.data(), uint32_t(tokens.size()),
+        [](PipelineToken&, TaskContext const&) { return false; },
+        ParallelPipeline::stage(PipelineStageMode::SERIAL_IN_ORDER, [&](PipelineToken&, TaskContext const&)
+        {
+            ++stageCount;
+        }));
+
+    ASSERT_EQ(0u, stageCount);
+
+    taskScheduler.shutdown();
+}
+
+} // namespace testing
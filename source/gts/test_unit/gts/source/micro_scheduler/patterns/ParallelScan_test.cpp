@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gts/analysis/Trace.h"
+
+#include "gts/micro_scheduler/WorkerPool.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/patterns/ParallelScan.h"
+#include "gts/micro_scheduler/patterns/Partitioners.h"
+
+#include "SchedulerTestsCommon.h"
+
+using namespace gts;
+
+namespace testing {
+
+//------------------------------------------------------------------------------
+// Spans several blocks of the convenience functions, with a partial last block.
+static const uint32_t LARGE_ELEMENT_COUNT = ParallelScan::DEFAULT_MIN_BLOCK_SIZE * 37 + 5;
+
+//------------------------------------------------------------------------------
+template<typename TPartitioner>
+void testInclusiveScan(uint32_t elementCount)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelScan scan(taskScheduler);
+
+    std::vector<uint32_t> in(elementCount);
+    for (uint32_t ii = 0; ii < elementCount; ++ii)
+    {
+        in[ii] = ii % 7;
+    }
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<uint32_t> out(elementCount, UINT32_MAX);
+
+        uint32_t total = scan.inclusive(in.data(), in.data() + elementCount, out.data(), 0u,
+            [](uint32_t lhs, uint32_t rhs) { return lhs + rhs; },
+            TPartitioner());
+
+        uint32_t expected = 0;
+        for (uint32_t ii = 0; ii < elementCount; ++ii)
+        {
+            expected += in[ii];
+            ASSERT_EQ(expected, out[ii]);
+        }
+        ASSERT_EQ(expected, total);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, inclusiveSimplePartitioner)
+{
+    testInclusiveScan<SimplePartitioner>(LARGE_ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, inclusiveStaticPartitioner)
+{
+    testInclusiveScan<StaticPartitioner>(LARGE_ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, inclusiveAdaptivePartitioner)
+{
+    testInclusiveScan<AdaptivePartitioner>(LARGE_ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, inclusiveSingleBlock)
+{
+    testInclusiveScan<AdaptivePartitioner>(1);
+    testInclusiveScan<AdaptivePartitioner>(ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, exclusiveInPlace)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelScan scan(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<uint64_t> data(LARGE_ELEMENT_COUNT, 1);
+
+        uint64_t total = scan.exclusive(data.begin(), data.end(), data.begin(), uint64_t(0),
+            [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; });
+
+        for (uint32_t ii = 0; ii < LARGE_ELEMENT_COUNT; ++ii)
+        {
+            ASSERT_EQ(ii, data[ii]);
+        }
+        ASSERT_EQ(uint64_t(LARGE_ELEMENT_COUNT), total);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, preservesOrder)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelScan scan(taskScheduler);
+
+    // "Last non-zero value" is associative but not commutative, so joining
+    // blocks out of order gives wrong results.
+    auto lastNonZero = [](uint32_t lhs, uint32_t rhs) { return rhs != 0 ? rhs : lhs; };
+
+    std::vector<uint32_t> in(LARGE_ELEMENT_COUNT, 0);
+    for (uint32_t ii = 0; ii < LARGE_ELEMENT_COUNT; ii += 1000)
+    {
+        in[ii] = ii + 1;
+    }
+
+    std::vector<uint32_t> out(LARGE_ELEMENT_COUNT);
+    uint32_t last = scan.inclusive(in.begin(), in.end(), out.begin(), 0u, lastNonZero);
+
+    for (uint32_t ii = 0; ii < LARGE_ELEMENT_COUNT; ++ii)
+    {
+        ASSERT_EQ((ii / 1000) * 1000 + 1, out[ii]);
+    }
+    ASSERT_EQ(out.back(), last);
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, streamCompaction)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelScan scan(taskScheduler);
+
+    using range_type = Range1d<uint32_t>;
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // Keep the multiples of 3.
+        std::vector<uint32_t> compacted(ELEMENT_COUNT, UINT32_MAX);
+
+        uint32_t keptCount = scan(
+            range_type(0, ELEMENT_COUNT, TILE_SIZE),
+            [&](range_type& range, uint32_t const& prefix, bool isFinalPass, void*, TaskContext const&)
+            {
+                uint32_t count = prefix;
+                for (uint32_t ii = range.begin(); ii != range.end(); ++ii)
+                {
+                    if (ii % 3 == 0)
+                    {
+                        if (isFinalPass)
+                        {
+                            compacted[count] = ii;
+                        }
+                        ++count;
+                    }
+                }
+                return count;
+            },
+            [](uint32_t const& lhs, uint32_t const& rhs, void*, TaskContext const&)
+            {
+                return lhs + rhs;
+            },
+            0u,
+            AdaptivePartitioner());
+
+        ASSERT_EQ((ELEMENT_COUNT + 2) / 3, keptCount);
+        for (uint32_t ii = 0; ii < keptCount; ++ii)
+        {
+            ASSERT_EQ(ii * 3, compacted[ii]);
+        }
+        for (uint32_t ii = keptCount; ii < ELEMENT_COUNT; ++ii)
+        {
+            ASSERT_EQ(UINT32_MAX, compacted[ii]);
+        }
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelScan, emptyRange)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelScan scan(taskScheduler);
+
+    using range_type = Range1d<uint32_t>;
+
+    // The constructor rejects empty ranges, but a range can be emptied later.
+    range_type range(7, 8, TILE_SIZE);
+    range.end() = range.begin();
+
+    uint32_t scanCount = 0;
+    uint32_t total = scan(
+        range,
+        [&](range_type&, uint32_t const& prefix, bool, void*, TaskContext const&)
+        {
+            ++scanCount;
+            return prefix;
+        },
+        [](uint32_t const& lhs, uint32_t const& rhs, void*, TaskContext const&)
+        {
+            return lhs + rhs;
+        },
+        42u,
+        AdaptivePartitioner());
+
+    ASSERT_EQ(42u, total);
+    ASSERT_EQ(0u, scanCount);
+
+    taskScheduler.shutdown();
+}
+
+} // namespace testing
@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * Copyright 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "gts/analysis/Trace.h"
+
+#include "gts/micro_scheduler/WorkerPool.h"
+#include "gts/micro_scheduler/MicroScheduler.h"
+#include "gts/micro_scheduler/patterns/ParallelSort.h"
+
+#include "SchedulerTestsCommon.h"
+
+using namespace gts;
+
+namespace testing {
+
+//------------------------------------------------------------------------------
+// Spans many default sized blocks, with a partial last block.
+static const uint32_t LARGE_ELEMENT_COUNT = ParallelSort::DEFAULT_MIN_BLOCK_SIZE * 37 + 5;
+
+//------------------------------------------------------------------------------
+template<typename T>
+std::vector<T> randomValues(uint32_t count, T minValue, T maxValue)
+{
+    std::mt19937 rng(count);
+    std::uniform_int_distribution<T> dist(minValue, maxValue);
+
+    std::vector<T> values(count);
+    for (uint32_t ii = 0; ii < count; ++ii)
+    {
+        values[ii] = dist(rng);
+    }
+    return values;
+}
+
+//------------------------------------------------------------------------------
+struct KeyValue
+{
+    uint16_t key;
+    uint32_t inputIdx;
+};
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, mergeSort)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<uint32_t> values = randomValues<uint32_t>(LARGE_ELEMENT_COUNT + iter, 0, UINT32_MAX);
+        std::vector<uint32_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        parallelSort(values.begin(), values.end());
+
+        ASSERT_EQ(expected, values);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, mergeSortComparator)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // Few distinct values to stress the merge splits on equal values.
+        std::vector<int32_t> values = randomValues<int32_t>(ELEMENT_COUNT + iter, -8, 8);
+        std::vector<int32_t> expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<int32_t>());
+
+        parallelSort(values.data(), values.data() + values.size(), std::greater<int32_t>(), TILE_SIZE);
+
+        ASSERT_EQ(expected, values);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, mergeSortSmall)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    for (uint32_t count = 0; count < 3 * TILE_SIZE; ++count)
+    {
+        std::vector<uint32_t> values = randomValues<uint32_t>(count, 0, 100);
+        std::vector<uint32_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        parallelSort(values.begin(), values.end(), std::less<uint32_t>(), 2);
+
+        ASSERT_EQ(expected, values);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, radixSort)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<uint64_t> values = randomValues<uint64_t>(LARGE_ELEMENT_COUNT + iter, 0, UINT64_MAX);
+        std::vector<uint64_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        parallelSort.radix(values.begin(), values.end());
+
+        ASSERT_EQ(expected, values);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, radixSortSigned)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        std::vector<int32_t> values = randomValues<int32_t>(ELEMENT_COUNT + iter, INT32_MIN, INT32_MAX);
+        values[0] = INT32_MIN;
+        values[1] = INT32_MAX;
+        values[2] = -1;
+        values[3] = 0;
+
+        std::vector<int32_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        parallelSort.radix(values.data(), values.data() + values.size(),
+            [](int32_t value) { return value; }, TILE_SIZE);
+
+        ASSERT_EQ(expected, values);
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, radixSortIsStable)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        // Keys that only differ in the high byte, so the low byte's pass is skipped.
+        std::vector<uint16_t> keys = randomValues<uint16_t>(LARGE_ELEMENT_COUNT, 0, 31);
+
+        std::vector<KeyValue> values(LARGE_ELEMENT_COUNT);
+        for (uint32_t ii = 0; ii < LARGE_ELEMENT_COUNT; ++ii)
+        {
+            values[ii].key      = uint16_t(keys[ii] << 8);
+            values[ii].inputIdx = ii;
+        }
+
+        parallelSort.radix(values.begin(), values.end(), [](KeyValue const& value) { return value.key; });
+
+        for (uint32_t ii = 1; ii < LARGE_ELEMENT_COUNT; ++ii)
+        {
+            ASSERT_LE(values[ii - 1].key, values[ii].key);
+            if (values[ii - 1].key == values[ii].key)
+            {
+                ASSERT_LT(values[ii - 1].inputIdx, values[ii].inputIdx);
+            }
+        }
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelSort, radixSortEqualKeys)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelSort parallelSort(taskScheduler);
+
+    std::vector<uint32_t> values(ELEMENT_COUNT, 7);
+    parallelSort.radix(values.begin(), values.end());
+    ASSERT_EQ(std::vector<uint32_t>(ELEMENT_COUNT, 7), values);
+
+    std::vector<uint32_t> empty;
+    parallelSort.radix(empty.begin(), empty.end());
+    ASSERT_TRUE(empty.empty());
+
+    taskScheduler.shutdown();
+}
+
+} // namespace testing
@@ -53,7 +53,7 @@ using namespace std;
 
 //------------------------------------------------------------------------------
 template<typename TRange, typename TPartitioner>
-void ParallelWavefront2D(size_t elementCount, size_t tileSize)
+void ParallelWavefront2D(size_t xCount, size_t yCount, size_t tileSize)
 {
     WorkerPool workerPool;
     workerPool.initialize();
@@ -65,23 +65,23 @@ void ParallelWavefront2D(size_t elementCount, size_t tileSize)
 
     // Create a 2D matrix of 0s.
     std::vector<std::vector<uint64_t>> matrix;
-    matrix.resize(elementCount);
-    for (size_t ii = 0; ii < elementCount; ++ii)
+    matrix.resize(xCount);
+    for (size_t ii = 0; ii < xCount; ++ii)
     {
-        matrix[ii].resize(elementCount, 0);
+        matrix[ii].resize(yCount, 0);
     }
 
     // Create a 2D matrix of expected values.
     std::vector<std::vector<uint64_t>> expectedMatrix;
-    expectedMatrix.resize(elementCount);
-    for (size_t ii = 0; ii < elementCount; ++ii)
+    expectedMatrix.resize(xCount);
+    for (size_t ii = 0; ii < xCount; ++ii)
     {
-        expectedMatrix[ii].resize(elementCount, 0);
+        expectedMatrix[ii].resize(yCount, 0);
     }
     expectedMatrix[0][0] = 1;
-    for (size_t x = 0; x < elementCount; ++x)
+    for (size_t x = 0; x < xCount; ++x)
     {
-        for (size_t y = 0; y < elementCount; ++y)
+        for (size_t y = 0; y < yCount; ++y)
         {
             expectedMatrix[x][y] += (x > 0 ? expectedMatrix[x-1][y] : 0) + (y > 0 ? expectedMatrix[x][y-1] : 0);
         }
@@ -93,7 +93,7 @@ void ParallelWavefront2D(size_t elementCount, size_t tileSize)
 
         matrix[0][0] = 1; // seed
 
-        TRange range(0, elementCount, tileSize, 0, elementCount, tileSize);
+        TRange range(0, xCount, tileSize, 0, yCount, tileSize);
 
         parallelWavefront(
             range,
@@ -112,14 +112,10 @@ void ParallelWavefront2D(size_t elementCount, size_t tileSize)
             nullptr);
 
         // Validate the values.
-        for (size_t x = 0; x < elementCount; ++x)
+        for (size_t x = 0; x < xCount; ++x)
         {
-            for (size_t y = 0; y < elementCount; ++y)
+            for (size_t y = 0; y < yCount; ++y)
             {
-                //if (expectedMatrix[x][y] != matrix[x][y])
-                //{
-                //    GTS_TRACE_DUMP("fail.txt");
-                //}
                 ASSERT_EQ(expectedMatrix[x][y], matrix[x][y]);
                 matrix[x][y] = 0; // reset
             }
@@ -132,140 +128,155 @@ void ParallelWavefront2D(size_t elementCount, size_t tileSize)
 //------------------------------------------------------------------------------
 TEST(ParallelWavefront, KdSimple2D)
 {
-    ParallelWavefront2D<KdRange2d<size_t>, SimplePartitioner>(ELEMENT_COUNT, TILE_SIZE);
+    ParallelWavefront2D<KdRange2d<size_t>, SimplePartitioner>(ELEMENT_COUNT, ELEMENT_COUNT, TILE_SIZE);
 }
 
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, KdStatic2D)
-//{
-//    ParallelWavefront2D<KdRange2d<size_t>, StaticPartitioner>(ELEMENT_COUNT, TILE_SIZE);
-//}
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, KdStatic2D)
+{
+    ParallelWavefront2D<KdRange2d<size_t>, StaticPartitioner>(ELEMENT_COUNT, ELEMENT_COUNT, TILE_SIZE);
+}
 
 //------------------------------------------------------------------------------
 TEST(ParallelWavefront, KdAdaptive2D)
 {
-    ParallelWavefront2D<KdRange2d<size_t>, AdaptivePartitioner>(ELEMENT_COUNT, TILE_SIZE);
+    ParallelWavefront2D<KdRange2d<size_t>, AdaptivePartitioner>(ELEMENT_COUNT, ELEMENT_COUNT, TILE_SIZE);
 }
 
-////------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
 TEST(ParallelWavefront, QuadSimple2D)
 {
-    ParallelWavefront2D<QuadRange<size_t>, SimplePartitioner>(ELEMENT_COUNT, TILE_SIZE);
+    ParallelWavefront2D<QuadRange<size_t>, SimplePartitioner>(ELEMENT_COUNT, ELEMENT_COUNT, TILE_SIZE);
 }
 
 //------------------------------------------------------------------------------
 TEST(ParallelWavefront, QuadStatic2D)
 {
-    ParallelWavefront2D<QuadRange<size_t>, StaticPartitioner>(ELEMENT_COUNT, TILE_SIZE);
+    ParallelWavefront2D<QuadRange<size_t>, StaticPartitioner>(ELEMENT_COUNT, ELEMENT_COUNT, TILE_SIZE);
 }
 
 //------------------------------------------------------------------------------
 TEST(ParallelWavefront, QuadAdaptive2D)
 {
-    ParallelWavefront2D<QuadRange<size_t>, AdaptivePartitioner>(ELEMENT_COUNT, TILE_SIZE);
+    ParallelWavefront2D<QuadRange<size_t>, AdaptivePartitioner>(ELEMENT_COUNT, ELEMENT_COUNT, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, KdSimple2DUneven)
+{
+    // Neither dimension is a multiple of the tile size.
+    ParallelWavefront2D<KdRange2d<size_t>, SimplePartitioner>(ELEMENT_COUNT / 2 + 3, ELEMENT_COUNT / 4 - 1, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, QuadSimple2DSingleTile)
+{
+    ParallelWavefront2D<QuadRange<size_t>, SimplePartitioner>(TILE_SIZE - 1, TILE_SIZE - 1, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+template<typename TRange, typename TPartitioner>
+void ParallelWavefront3D(size_t xCount, size_t yCount, size_t zCount, size_t tileSize)
+{
+    WorkerPool workerPool;
+    workerPool.initialize();
+
+    MicroScheduler taskScheduler;
+    taskScheduler.initialize(&workerPool);
+
+    ParallelWavefront parallelWavefront(taskScheduler);
+
+    auto idx = [=](size_t x, size_t y, size_t z) { return (x * yCount + y) * zCount + z; };
+
+    // Create a 3D volume of 0s.
+    std::vector<uint64_t> volume(xCount * yCount * zCount, 0);
+
+    // Create a 3D volume of expected values.
+    std::vector<uint64_t> expectedVolume(xCount * yCount * zCount, 0);
+    expectedVolume[0] = 1;
+    for (size_t x = 0; x < xCount; ++x)
+    {
+        for (size_t y = 0; y < yCount; ++y)
+        {
+            for (size_t z = 0; z < zCount; ++z)
+            {
+                expectedVolume[idx(x, y, z)] +=
+                    (x > 0 ? expectedVolume[idx(x-1, y, z)] : 0) +
+                    (y > 0 ? expectedVolume[idx(x, y-1, z)] : 0) +
+                    (z > 0 ? expectedVolume[idx(x, y, z-1)] : 0);
+            }
+        }
+    }
+
+    for (uint32_t ii = 0; ii < ITERATIONS_CONCUR; ++ii)
+    {
+        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
+
+        volume[0] = 1; // seed
+
+        TRange range(0, xCount, tileSize, 0, yCount, tileSize, 0, zCount, tileSize);
+
+        parallelWavefront(
+            range,
+            [&volume, &idx](TRange& range, void*, TaskContext const&)
+            {
+                for (auto x = range.xRange().begin(); x != range.xRange().end(); ++x)
+                {
+                    for (auto y = range.yRange().begin(); y != range.yRange().end(); ++y)
+                    {
+                        for (auto z = range.zRange().begin(); z != range.zRange().end(); ++z)
+                        {
+                            volume[idx(x, y, z)] +=
+                                (x > 0 ? volume[idx(x-1, y, z)] : 0) +
+                                (y > 0 ? volume[idx(x, y-1, z)] : 0) +
+                                (z > 0 ? volume[idx(x, y, z-1)] : 0);
+                        }
+                    }
+                }
+            },
+            TPartitioner(),
+            nullptr);
+
+        // Validate the values.
+        for (size_t jj = 0; jj < volume.size(); ++jj)
+        {
+            ASSERT_EQ(expectedVolume[jj], volume[jj]);
+            volume[jj] = 0; // reset
+        }
+    }
+
+    taskScheduler.shutdown();
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, KdSimple3D)
+{
+    ParallelWavefront3D<KdRange3d<size_t>, SimplePartitioner>(ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, KdAdaptive3D)
+{
+    ParallelWavefront3D<KdRange3d<size_t>, AdaptivePartitioner>(ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, TILE_SIZE);
 }
 
-////------------------------------------------------------------------------------
-//template<typename TRange, typename TPartitioner>
-//void ParallelFor3D(size_t elementCount, size_t tileSize)
-//{
-//    WorkerPool workerPool;
-//    workerPool.initialize();
-//
-//    MicroScheduler taskScheduler;
-//    taskScheduler.initialize(&workerPool);
-//
-//    ParallelWavefront parallelFor(taskScheduler);
-//
-//    // Create a 3D array of 0s.
-//    std::vector<std::vector<std::vector<char>>> volume;
-//    volume.resize(elementCount);
-//    for (size_t ii = 0; ii < elementCount; ++ii)
-//    {
-//        volume[ii].resize(elementCount);
-//        for (size_t jj = 0; jj < elementCount; ++jj)
-//        {
-//            volume[ii][jj].resize(elementCount, 0);
-//        }
-//    }
-//
-//    for (uint32_t iter = 0; iter < ITERATIONS_CONCUR; ++iter)
-//    {
-//        GTS_TRACE_FRAME_MARK(gts::analysis::CaptureMask::ALL);
-//
-//        TRange range(0, elementCount, tileSize, 0, elementCount, tileSize, 0, elementCount, tileSize);
-//
-//        parallelFor(
-//            range,
-//            [](TRange& range, void* data, TaskContext const&)
-//            {
-//                std::vector<std::vector<std::vector<char>>>& volume =
-//                    *(std::vector<std::vector<std::vector<char>>>*)data;
-//
-//                for (auto ii = range.yRange().begin(); ii != range.yRange().end(); ++ii)
-//                {
-//                    for (auto jj = range.xRange().begin(); jj != range.xRange().end(); ++jj)
-//                    {
-//                        for (auto kk = range.zRange().begin(); kk != range.zRange().end(); ++kk)
-//                        {
-//                            volume[ii][jj][kk]++;
-//                        }
-//                    }
-//                }
-//            },
-//            TPartitioner(),
-//            &volume);
-//
-//        // Validate that all values have been incremented only once.
-//        for (auto ii = range.yRange().begin(); ii != range.yRange().end(); ++ii)
-//        {
-//            for (auto jj = range.xRange().begin(); jj != range.xRange().end(); ++jj)
-//            {
-//                for (auto kk = range.zRange().begin(); kk != range.zRange().end(); ++kk)
-//                {
-//                    ASSERT_EQ((size_t)volume[ii][jj][kk], iter + 1);
-//                }
-//            }
-//        }
-//    }
-//
-//    taskScheduler.shutdown();
-//}
-//
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, KdSimple3D)
-//{
-//    ParallelFor3D<KdRange3d<size_t, size_t, size_t>, SimplePartitioner>(ELEMENT_COUNT / 2, TILE_SIZE);
-//}
-//
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, KdSStatic3D)
-//{
-//    ParallelFor3D<KdRange3d<size_t, size_t, size_t>,StaticPartitioner>(ELEMENT_COUNT / 2, TILE_SIZE);
-//}
-//
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, KdSAdaptive3D)
-//{
-//    ParallelFor3D<KdRange3d<size_t, size_t, size_t>,AdaptivePartitioner>(ELEMENT_COUNT / 2, TILE_SIZE);
-//}
-//
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, OctSimple3D)
-//{
-//    ParallelFor3D<OctRange<size_t, size_t, size_t>, SimplePartitioner>(ELEMENT_COUNT / 2, TILE_SIZE);
-//}
-//
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, OctStatic3D)
-//{
-//    ParallelFor3D<OctRange<size_t, size_t, size_t>, StaticPartitioner>(ELEMENT_COUNT / 2, TILE_SIZE);
-//}
-//
-////------------------------------------------------------------------------------
-//TEST(ParallelWavefront, OctAdaptive3D)
-//{
-//    ParallelFor3D<OctRange<size_t, size_t, size_t>, AdaptivePartitioner>(ELEMENT_COUNT / 2, TILE_SIZE);
-//}
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, OctSimple3D)
+{
+    ParallelWavefront3D<OctRange<size_t>, SimplePartitioner>(ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, OctStatic3D)
+{
+    ParallelWavefront3D<OctRange<size_t>, StaticPartitioner>(ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, ELEMENT_COUNT / 8, TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+TEST(ParallelWavefront, KdSimple3DUneven)
+{
+    // No dimension is a multiple of the tile size.
+    ParallelWavefront3D<KdRange3d<size_t>, SimplePartitioner>(ELEMENT_COUNT / 8 + 3, ELEMENT_COUNT / 16 - 1, ELEMENT_COUNT / 8 + 5, TILE_SIZE);
+}
 
 } // namespace testing